@@ -47,6 +47,9 @@
 #define  _MG_EPS            1.e-06
 #define  _MG_EPSX2          2.e-06
 #define  MAXTOU         50
+#define  _MG_JACTOL         1.e-24
+#define  _MG_JACSWP         4
+#define  _MG_JACMAX         20
 
 /**
  * \def egal(x,y)
@@ -248,9 +251,225 @@ static int newton3(double p[4],double x[3]) {
 }
 
 
+/**
+ * \param app pointer toward the diagonal term \f$a_{pp}\f$.
+ * \param aqq pointer toward the diagonal term \f$a_{qq}\f$.
+ * \param apq pointer toward the term \f$a_{pq}\f$ to cancel.
+ * \param arp pointer toward the term \f$a_{rp}\f$ (r is the third index).
+ * \param arq pointer toward the term \f$a_{rq}\f$.
+ * \param vp p-th row of the eigenvectors.
+ * \param vq q-th row of the eigenvectors.
+ *
+ * Jacobi rotation in the plane (p,q) of a 3x3 symmetric matrix (the
+ * tangent of the angle is computed without division by \f$a_{pq}\f$).
+ *
+ */
+static inline void _MMG5_jacrot(double *app,double *aqq,double *apq,double *arp,
+                                double *arq,double vp[3],double vq[3]) {
+  double d,dd,t,c,s,x,y;
+  char   i;
+
+  d  = *aqq - *app;
+  dd = fabs(d) + sqrt(d*d + 4.0*(*apq)*(*apq));
+  t  = dd > 0.0 ? (d >= 0.0 ? 2.0 : -2.0) * (*apq) / dd : 0.0;
+  c  = 1.0 / sqrt(1.0 + t*t);
+  s  = t*c;
+
+  *app -= t*(*apq);
+  *aqq += t*(*apq);
+  *apq  = 0.0;
+
+  x = *arp;  y = *arq;
+  *arp = c*x - s*y;
+  *arq = s*x + c*y;
+
+  for (i=0; i<3; i++) {
+    x = vp[i];  y = vq[i];
+    vp[i] = c*x - s*y;
+    vq[i] = s*x + c*y;
+  }
+}
+
+/**
+ * \param lambda eigenvalues.
+ * \return order of eigenvalues (1,2,3) or 0 if they are not finite.
+ *
+ * Number of equal eigenvalues (at the accuracy of \ref _MMG5_eigenv).
+ *
+ */
+static inline int _MMG5_eigord3(double lambda[3]) {
+  int n;
+
+  if ( !isfinite(lambda[0]+lambda[1]+lambda[2]) )  return(0);
+
+  n = egal(lambda[0],lambda[1]) + egal(lambda[0],lambda[2])
+    + egal(lambda[1],lambda[2]);
+
+  return( n ? (n > 1 ? 3 : 2) : 1 );
+}
+
+/**
+ * \param m terms of the symetric matrix \f$3x3\f$ (\f$m_{11}, m_{12}, m_{13},
+ * m_{22}, m_{23}, m_{33}\f$).
+ * \param lambda eigenvalues of \a m.
+ * \param v eigenvectors of \a m (stored by rows).
+ * \return order of eigenvalues (1,2,3) or 0 if failed.
+ *
+ * Compute the eigenelements of a symetric matrix by cyclic Jacobi rotations
+ * (quadratic convergence, 3 or 4 sweeps in general). Unlike the root finding
+ * of the characteristic polynomial, the relative accuracy doesn't depend on
+ * the anisotropy ratio of the matrix and the eigenvectors are orthonormal.
+ *
+ */
+int _MMG5_eigensym3(double m[6],double lambda[3],double v[3][3]) {
+  double  a11,a12,a13,a22,a23,a33,eps;
+  int     k;
+
+  memcpy(v,Id,9*sizeof(double));
+  a11 = m[0];  a12 = m[1];  a13 = m[2];
+  a22 = m[3];  a23 = m[4];  a33 = m[5];
+
+  for (k=0; k<_MG_JACMAX; k++) {
+    eps = _MG_JACTOL*(a11*a11 + a22*a22 + a33*a33);
+    if ( a12*a12 <= eps && a13*a13 <= eps && a23*a23 <= eps )  break;
+
+    if ( a12*a12 > eps )  _MMG5_jacrot(&a11,&a22,&a12,&a13,&a23,v[0],v[1]);
+    if ( a13*a13 > eps )  _MMG5_jacrot(&a11,&a33,&a13,&a12,&a23,v[0],v[2]);
+    if ( a23*a23 > eps )  _MMG5_jacrot(&a22,&a33,&a23,&a12,&a13,v[1],v[2]);
+  }
+
+  lambda[0] = a11;
+  lambda[1] = a22;
+  lambda[2] = a33;
+
+  return(_MMG5_eigord3(lambda));
+}
+
+/**
+ * \param n number of matrices in the block.
+ * \param app diagonal terms \f$a_{pp}\f$ of the block.
+ * \param aqq diagonal terms \f$a_{qq}\f$.
+ * \param apq terms \f$a_{pq}\f$ to cancel.
+ * \param arp terms \f$a_{rp}\f$ (r is the third index).
+ * \param arq terms \f$a_{rq}\f$.
+ * \param vp0 first component of the p-th eigenvectors.
+ * \param vp1 second component of the p-th eigenvectors.
+ * \param vp2 third component of the p-th eigenvectors.
+ * \param vq0 first component of the q-th eigenvectors.
+ * \param vq1 second component of the q-th eigenvectors.
+ * \param vq2 third component of the q-th eigenvectors.
+ *
+ * Jacobi rotation in the plane (p,q) of a block of matrices (same computation
+ * as \ref _MMG5_jacrot, without branches).
+ *
+ */
+static inline void
+_MMG5_jacrotblk(int n,double *app,double *aqq,double *apq,double *arp,
+                double *arq,double *vp0,double *vp1,double *vp2,double *vq0,
+                double *vq1,double *vq2) {
+  double d,dd,t,c,s,x,y;
+  int    k;
+
+  for (k=0; k<n; k++) {
+    d  = aqq[k] - app[k];
+    dd = fabs(d) + sqrt(d*d + 4.0*apq[k]*apq[k]);
+    t  = dd > 0.0 ? (d >= 0.0 ? 2.0 : -2.0) * apq[k] / (dd > 0.0 ? dd : 1.0) : 0.0;
+    c  = 1.0 / sqrt(1.0 + t*t);
+    s  = t*c;
+
+    app[k] -= t*apq[k];
+    aqq[k] += t*apq[k];
+    apq[k]  = 0.0;
+
+    x = arp[k];  y = arq[k];
+    arp[k] = c*x - s*y;
+    arq[k] = s*x + c*y;
+
+    x = vp0[k];  y = vq0[k];
+    vp0[k] = c*x - s*y;
+    vq0[k] = s*x + c*y;
+    x = vp1[k];  y = vq1[k];
+    vp1[k] = c*x - s*y;
+    vq1[k] = s*x + c*y;
+    x = vp2[k];  y = vq2[k];
+    vp2[k] = c*x - s*y;
+    vq2[k] = s*x + c*y;
+  }
+}
+
+/**
+ * \param n number of matrices in the block (at most \ref _MMG5_EIGBATCH).
+ * \param a terms of the matrices stored by components (\f$a_{11}, a_{12},
+ * a_{13}, a_{22}, a_{23}, a_{33}\f$), overwritten by the rotated matrices.
+ * \param w eigenvectors stored by components (row-major).
+ *
+ * Fixed number of cyclic Jacobi sweeps over a block of matrices.
+ *
+ */
+_MMG5_TARGET_CLONES
+static void _MMG5_jacblk(int n,double a[6][_MMG5_EIGBATCH],
+                         double w[9][_MMG5_EIGBATCH]) {
+  int  sw;
+
+  for (sw=0; sw<_MG_JACSWP; sw++) {
+    _MMG5_jacrotblk(n,a[0],a[3],a[1],a[2],a[4],w[0],w[1],w[2],w[3],w[4],w[5]);
+    _MMG5_jacrotblk(n,a[0],a[5],a[2],a[1],a[4],w[0],w[1],w[2],w[6],w[7],w[8]);
+    _MMG5_jacrotblk(n,a[3],a[5],a[4],a[1],a[2],w[3],w[4],w[5],w[6],w[7],w[8]);
+  }
+}
+
+/**
+ * \param n number of matrices.
+ * \param m terms of the symetric matrices, stored consecutively (6 per
+ * matrix, as in \ref _MMG5_eigensym3).
+ * \param lambda eigenvalues of the matrices (3 per matrix).
+ * \param v eigenvectors of the matrices (9 per matrix, stored by rows).
+ * \return the number of matrices diagonalized before the first failure (\a n
+ * if success).
+ *
+ * Compute the eigenelements of \a n symetric matrices: the Jacobi sweeps are
+ * vectorized over blocks of \ref _MMG5_EIGBATCH matrices, the few matrices
+ * that are not converged after \ref _MG_JACSWP sweeps are solved again by
+ * \ref _MMG5_eigensym3. Used by the passes over the whole metric field.
+ *
+ */
+int _MMG5_eigensym3_batch(int n,double *m,double *lambda,double *v) {
+  double  a[6][_MMG5_EIGBATCH],w[9][_MMG5_EIGBATCH],eps,off;
+  int     k0,nb,k,i;
+
+  for (k0=0; k0<n; k0+=_MMG5_EIGBATCH) {
+    nb = MG_MIN(_MMG5_EIGBATCH,n-k0);
+
+    for (k=0; k<nb; k++) {
+      for (i=0; i<6; i++)  a[i][k] = m[6*(k0+k)+i];
+      for (i=0; i<9; i++)  w[i][k] = Id[i/3][i%3];
+    }
+
+    _MMG5_jacblk(nb,a,w);
+
+    for (k=0; k<nb; k++) {
+      eps = _MG_JACTOL*(a[0][k]*a[0][k] + a[3][k]*a[3][k] + a[5][k]*a[5][k]);
+      off = MG_MAX(a[1][k]*a[1][k],MG_MAX(a[2][k]*a[2][k],a[4][k]*a[4][k]));
+      if ( off > eps ) {
+        if ( !_MMG5_eigensym3(&m[6*(k0+k)],&lambda[3*(k0+k)],
+                              (double (*)[3])&v[9*(k0+k)]) )
+          return(k0+k);
+        continue;
+      }
+      lambda[3*(k0+k)]   = a[0][k];
+      lambda[3*(k0+k)+1] = a[3][k];
+      lambda[3*(k0+k)+2] = a[5][k];
+      if ( !_MMG5_eigord3(&lambda[3*(k0+k)]) )  return(k0+k);
+      for (i=0; i<9; i++)  v[9*(k0+k)+i] = w[i][k];
+    }
+  }
+  return(n);
+}
+
 /**
  * \brief Find eigenvalues and vectors of a 3x3 matrix.
- * \param symmat 0 if matrix is not symetric, 1 otherwise.
+ * \param symmat 0 if matrix is not symetric, 1 otherwise (see
+ * \ref _MMG5_eigensym3).
  * \param mat pointer toward the matrix.
  * \param lambda eigenvalues.
  * \param v eigenvectors.
@@ -262,104 +481,60 @@ int _MMG5_eigenv(int symmat,double *mat,double lambda[3],double v[3][3]) {
   double    maxd,maxm,valm,p[4],w1[3],w2[3],w3[3];
   int       k,n;
 
+  /* symetric matrix: Jacobi rotations */
+  if ( symmat )  return(_MMG5_eigensym3(mat,lambda,v));
+
   /* default */
   memcpy(v,Id,9*sizeof(double));
-  if ( symmat ) {
-    lambda[0] = (double)mat[0];
-    lambda[1] = (double)mat[3];
-    lambda[2] = (double)mat[5];
-
-    maxm = fabs(mat[0]);
-    for (k=1; k<6; k++) {
-      valm = fabs(mat[k]);
-      if ( valm > maxm )  maxm = valm;
-    }
-    /* single float accuracy */
-    if ( maxm < _MG_EPS6 )  return(1);
-
-    /* normalize matrix */
-    dd  = 1.0 / maxm;
-    a11 = mat[0] * dd;
-    a12 = mat[1] * dd;
-    a13 = mat[2] * dd;
-    a22 = mat[3] * dd;
-    a23 = mat[4] * dd;
-    a33 = mat[5] * dd;
-
-    /* diagonal matrix */
-    maxd = fabs(a12);
-    valm = fabs(a13);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a23);
-    if ( valm > maxd )  maxd = valm;
-    if ( maxd < _MG_EPSD )  return(1);
-
-    a21  = a12;
-    a31  = a13;
-    a32  = a23;
-
-    /* build characteristic polynomial
-       P(X) = X^3 - trace X^2 + (somme des mineurs)X - det = 0 */
-    aa = a11*a22;
-    bb = a23*a32;
-    cc = a12*a21;
-    dd = a13*a31;
-    p[0] =  a11*bb + a33*(cc-aa) + a22*dd -2.0*a12*a13*a23;
-    p[1] =  a11*(a22 + a33) + a22*a33 - bb - cc - dd;
-    p[2] = -a11 - a22 - a33;
-    p[3] =  1.0;
-  }
-  else {
-    lambda[0] = (double)mat[0];
-    lambda[1] = (double)mat[4];
-    lambda[2] = (double)mat[8];
-
-    maxm = fabs(mat[0]);
-    for (k=1; k<9; k++) {
-      valm = fabs(mat[k]);
-      if ( valm > maxm )  maxm = valm;
-    }
-    if ( maxm < _MG_EPS6 )  return(1);
-
-    /* normalize matrix */
-    dd  = 1.0 / maxm;
-    a11 = mat[0] * dd;
-    a12 = mat[1] * dd;
-    a13 = mat[2] * dd;
-    a21 = mat[3] * dd;
-    a22 = mat[4] * dd;
-    a23 = mat[5] * dd;
-    a31 = mat[6] * dd;
-    a32 = mat[7] * dd;
-    a33 = mat[8] * dd;
-
-    /* diagonal matrix */
-    maxd = fabs(a12);
-    valm = fabs(a13);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a23);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a21);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a31);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a32);
-    if ( valm > maxd )  maxd = valm;
-    if ( maxd < _MG_EPSD )  return(1);
-
-    /* build characteristic polynomial
-       P(X) = X^3 - trace X^2 + (somme des mineurs)X - det = 0 */
-    aa = a22*a33 - a23*a32;
-    bb = a23*a31 - a21*a33;
-    cc = a21*a32 - a31*a22;
-    ee = a11*a33 - a13*a31;
-    ii = a11*a22 - a12*a21;
-
-    p[0] =  -a11*aa - a12*bb - a13*cc;
-    p[1] =  aa + ee + ii;
-    p[2] = -a11 - a22 - a33;
-    p[3] =  1.0;
+  lambda[0] = (double)mat[0];
+  lambda[1] = (double)mat[4];
+  lambda[2] = (double)mat[8];
+
+  maxm = fabs(mat[0]);
+  for (k=1; k<9; k++) {
+    valm = fabs(mat[k]);
+    if ( valm > maxm )  maxm = valm;
   }
+  if ( maxm < _MG_EPS6 )  return(1);
+
+  /* normalize matrix */
+  dd  = 1.0 / maxm;
+  a11 = mat[0] * dd;
+  a12 = mat[1] * dd;
+  a13 = mat[2] * dd;
+  a21 = mat[3] * dd;
+  a22 = mat[4] * dd;
+  a23 = mat[5] * dd;
+  a31 = mat[6] * dd;
+  a32 = mat[7] * dd;
+  a33 = mat[8] * dd;
+
+  /* diagonal matrix */
+  maxd = fabs(a12);
+  valm = fabs(a13);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a23);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a21);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a31);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a32);
+  if ( valm > maxd )  maxd = valm;
+  if ( maxd < _MG_EPSD )  return(1);
+
+  /* build characteristic polynomial
+     P(X) = X^3 - trace X^2 + (somme des mineurs)X - det = 0 */
+  aa = a22*a33 - a23*a32;
+  bb = a23*a31 - a21*a33;
+  cc = a21*a32 - a31*a22;
+  ee = a11*a33 - a13*a31;
+  ii = a11*a22 - a12*a21;
+
+  p[0] =  -a11*aa - a12*bb - a13*cc;
+  p[1] =  aa + ee + ii;
+  p[2] = -a11 - a22 - a33;
+  p[3] =  1.0;
 
   /* solve polynomial (find roots using newton) */
   n = newton3(p,lambda);
@@ -24,5 +24,7 @@
 #include "mmg.h"
 
 int _MMG5_eigenv(int symmat,double *mat,double lambda[3],double v[3][3]);
+int _MMG5_eigensym3(double m[6],double lambda[3],double v[3][3]);
+int _MMG5_eigensym3_batch(int n,double *m,double *lambda,double *v);
 int _MMG5_eigen2(double *mm,double *lambda,double vp[2][2]);
 int _MMG5_eigensym(double m[3],double lambda[2],double vp[2][2]);
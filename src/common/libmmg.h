@@ -162,6 +162,24 @@ typedef struct {
   char          imprim,ddebug,badkal,iso,fem,lag;
   unsigned char optim,noinsert, noswap, nomove;
   int           bucket;
+  char          restart; /*!< 1 if the working state has been restored from a
+                           checkpoint (the analysis is skipped), 2 if the
+                           topology of the previous call is kept (warm start) */
+  char          warm; /*!< 1 if the topology and the analysis are kept
+                        between successive calls of the library */
+  int           lsband; /*!< Number of layers of tetrahedra added around the
+                          vertex ring of the isosurface remeshed in level-set
+                          mode (0: whole mesh) */
+  char          hess; /*!< 1 (resp. 6) if the input solution is a scalar
+                        field whose Hessian gives an isotropic (resp.
+                        anisotropic) metric, 0 otherwise */
+  double        herr; /*!< Target interpolation error of the Hessian metric */
+  int           nelem; /*!< Target number of elements (0 if not used) */
+  double        tmax; /*!< Wall-clock time budget in seconds (0 if not used) */
+  double        tini; /*!< Wall-clock time at the beginning of the run */
+  char          tout; /*!< 1 if the time budget has been exhausted, 2 if the
+                        run has been stopped by the progress function */
+  char          nosignal; /*!< 1 if the signal handlers are not installed */
   MMG5_pPar     par;
 } MMG5_Info;
 
@@ -193,6 +211,9 @@ typedef struct {
   int       type; /*!< Type of the mesh */
   long long memMax; /*!< Maximum memory available */
   long long memCur; /*!< Current memory used */
+  long long memPeak; /*!< Peak of the memory used */
+  long      nepred; /*!< Number of elements predicted for the target number of
+                      elements (mmg3d) */
   double    gap; /*!< Gap for table reallocation */
   int       npi,nti,nai,nei,np,na,nt,ne,npmax,namax,ntmax,nemax,xpmax,xtmax;
   int       nc1;
@@ -204,6 +225,12 @@ typedef struct {
   int       xp,xt; /*!< Number of surfaces points/triangles */
   int       npnil; /*!< Index of first unused point */
   int       nenil; /*!< Index of first unused element */
+  int       nplnk; /*!< Points of index greater or equal to \a nplnk have
+                     never been chained in the list of unused points
+                     (lazy initialization of the list) */
+  int       nelnk; /*!< Same as \a nplnk for the list of unused elements */
+  int       xpnil; /*!< Index of first recycled (unused) xpoint (linked through n1[0]) */
+  int       xtnil; /*!< Index of first recycled (unused) xtetra (linked through ref[0]) */
   int      *adja; /*!< Table of tetrahedron adjacency: if
                     \f$adjt[4*i+1+j]=4*k+l\f$ then the \f$i^{th}\f$ and
                     \f$k^th\f$ tetrahedra are adjacent and share their
@@ -214,6 +241,33 @@ typedef struct {
                     edges \a j and \a l (resp.) */
   char     *namein; /*!< Input mesh name */
   char     *nameout; /*!< Output mesh name */
+  char     *nameckpt; /*!< Checkpoint file name (if given, the working state
+                        is saved after the analysis and at each adaptation
+                        pass) */
+  char     *namedist; /*!< Surface mesh whose signed distance gives the
+                        level-set function (mmg3d) */
+  char     *nameprof; /*!< File in which the profile of the run is saved (the
+                        profiler is off if NULL) */
+  int       nlreg; /*!< Number of seeds of the remeshed region (number of
+                     tetrahedra listed in \a lreg once the mesh is frozen) */
+  int       nlayer; /*!< Number of layers of tetrahedra added around the seeds */
+  int       nereg; /*!< Largest index of the tetrahedra listed in \a lreg once
+                     the mesh is frozen (0 if the mesh is not frozen) */
+  int      *lreg; /*!< Seeds (tetrahedra) of the region remeshed by the
+                    library (the whole mesh is remeshed if NULL). Once the
+                    mesh is frozen: tetrahedra visited by the adaptation
+                    loops (\a nemax+1 entries) */
+  int       nfrz; /*!< Number of vertices required by the freezing */
+  int      *lfrz; /*!< Vertices required by the freezing of the mesh outside
+                    the remeshed region */
+  int       nbez; /*!< Number of entries of the cache of Bezier patches (-1 if
+                    the cache can't be allocated) */
+  struct _MMG5_BezCache *bezc; /*!< Cache of the Bezier patches of the boundary
+                                 faces */
+  struct _MMG5_Bgm *bgm; /*!< Background mesh giving the size map (mmg3d) */
+  struct _MMG5_SizFun *sizf; /*!< Size function given by the user (mmg3d) */
+  struct _MMG5_Prog *prog; /*!< Progress function given by the user (mmg3d) */
+  struct _MMG5_Prof *prof; /*!< Profiler (timers and counters) of the run */
 
   MMG5_pPoint    point; /*!< Pointer toward the \ref MMG5_Point structure */
   MMG5_pxPoint   xpoint; /*!< Pointer toward the \ref MMG5_xPoint structure */
@@ -301,6 +355,37 @@ int  MMG5_Set_inputSolName(MMG5_pMesh mesh,MMG5_pSol sol, char* solin);
  *
  */
 int  MMG5_Set_outputSolName(MMG5_pMesh mesh,MMG5_pSol sol, char* solout);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ckpt name of the checkpoint file.
+ * \return 1.
+ *
+ * Set the name of the checkpoint file in which the working state is saved
+ * after the analysis and at each pass of the adaptation (mmg3d only).
+ *
+ */
+int  MMG5_Set_checkpointName(MMG5_pMesh mesh, char* ckpt);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param surf name of the surface mesh.
+ * \return 1.
+ *
+ * Set the name of the surface mesh whose signed distance gives the level-set
+ * function in iso mode (mmg3d only).
+ *
+ */
+int  MMG5_Set_distanceMeshName(MMG5_pMesh mesh, char* surf);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param prof name of the profile file.
+ * \return 1.
+ *
+ * Turn on the profiler: the nested timers (phases, stages and operators) and
+ * the counters of the run are saved in the file \a prof in JSON format. An
+ * empty name turns the profiler off (mmg3d only).
+ *
+ */
+int  MMG5_Set_profileName(MMG5_pMesh mesh, char* prof);
 
 /* deallocations */
 /**
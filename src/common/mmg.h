@@ -0,0 +1,456 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+#ifndef _MMG_H
+#define _MMG_H
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <string.h>
+#include <signal.h>
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+
+#if (defined(__APPLE__) && defined(__MACH__))
+#include <sys/sysctl.h>
+#elif defined(__unix__) || defined(__unix) || defined(unix)
+#include <unistd.h>
+#endif
+
+#include "eigenv.h"
+#include "libmmg.h"
+#include "profile.h"
+
+#define MG_VER   "5.0.0"" c"
+#define MG_REL   "May 4, 2015"
+#define MG_CPY   "Copyright (c) IMB-LJLL, 2004-"
+#define MG_STR   "&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&"
+
+/** Maximal memory used if available memory compitation fail. */
+#define _MMG5_MEMMAX  800
+
+/* numerical accuracy */
+#define _MMG5_ANGEDG    0.707106781186548   /*0.573576436351046 */
+#define _MMG5_ANGLIM   -0.999999
+#define _MMG5_ATHIRD    0.333333333333333
+
+#define _MMG5_EPSD      1.e-30
+#define _MMG5_EPSD2     1.0e-200
+#define _MMG5_EPS       1.e-06
+
+#define _MMG5_SQR32     0.866025403784439
+
+#ifndef M_PI
+#define M_PI            3.14159265358979323846   /**< pi   */
+#define M_PI_2          1.57079632679489661923   /**< pi/2 */
+#endif
+
+
+/* Macros */
+#define MG_MAX(a,b) (((a) > (b)) ? (a) : (b))
+#define MG_MIN(a,b) (((a) < (b)) ? (a) : (b))
+
+/* tags */
+#define  MG_NOTAG     (0)
+#define  MG_REF       (1 << 0)        /**< 1  edge reference  */
+#define  MG_GEO       (1 << 1)        /**< 2  geometric ridge */
+#define  MG_REQ       (1 << 2)        /**< 4  required entity */
+#define  MG_NOM       (1 << 3)        /**< 8  non manifold    */
+#define  MG_BDY       (1 << 4)        /**< 16  boundary entity */
+#define  MG_CRN       (1 << 5)        /**< 32  corner         */
+#define  MG_NUL       (1 << 6)        /**< 64  vertex removed */
+
+#define MG_VOK(ppt)      (ppt && ((ppt)->tag < MG_NUL)) /**< Vertex OK */
+#define MG_EOK(pt)       (pt && ((pt)->v[0] > 0))       /**< Element OK */
+
+#define MG_EDG(tag) ((tag & MG_GEO) || (tag & MG_REF)) /**< Edge or Ridge */
+#define MG_SIN(tag) ((tag & MG_CRN) || (tag & MG_REQ)) /**< Corner or Required */
+
+#define MG_SET(flag,bit) ((flag) |= (1 << (bit)))  /**< bit number bit is set to 1 */
+#define MG_CLR(flag,bit) ((flag) &= ~(1 << (bit))) /**< bit number bit is set to 0 */
+#define MG_GET(flag,bit) ((flag) & (1 << (bit)))   /**< return bit number bit value */
+
+#define _MMG5_KA 7 /*!< Key for hash tables. */
+#define _MMG5_KB 11  /*!< Key for hash tables. */
+
+#define _MMG5_BEZSNP  9  /*!< Vertex data stored to validate a cached Bezier patch */
+#define _MMG5_BEZCMAX 15 /*!< Max number of entries of the Bezier cache (log2) */
+
+#define _MMG5_EIGBATCH 64 /*!< Number of metrics diagonalized by block */
+
+/** AVX2/AVX-512 instances of the batch kernels, chosen at load time on
+ *  x86-64 linux/gcc (no fma: same values than the default instance) */
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) \
+  && defined(__x86_64__) && defined(__linux__) && __GNUC__ >= 6
+#define _MMG5_TARGET_CLONES __attribute__((target_clones("avx512f","avx2","default"),\
+                                            optimize("fp-contract=off")))
+#else
+#define _MMG5_TARGET_CLONES
+#endif
+
+/* Domain refs in iso mode */
+#define MG_ISO    10
+
+/* Macros for memory management */
+/** Check if used memory overflow maximal authorized memory.
+    Execute the command law if lack of memory. */
+#define _MMG5_CHK_MEM(mesh,size,string,law) do                          \
+  {                                                                     \
+    if ( ((mesh)->memCur) > ((mesh)->memMax) ||                         \
+         ((mesh)->memCur < 0 )) {                                       \
+      fprintf(stdout,"  ## Error:");                                    \
+      fprintf(stdout," unable to allocate %s.\n",string);               \
+      fprintf(stdout,"  ## Check the mesh size or ");                   \
+      fprintf(stdout,"increase maximal authorized memory with the -m option.\n"); \
+      (mesh)->memCur -= (long long)(size);                              \
+      law;                                                              \
+    }                                                                   \
+  }while(0)
+
+/** Free pointer ptr of mesh structure and compute the new used memory.
+    size is the size of the pointer */
+#define _MMG5_DEL_MEM(mesh,ptr,size) do         \
+  {                                             \
+    (mesh)->memCur -= (long long)(size);        \
+    free(ptr);                                  \
+    ptr = NULL;                                 \
+  }while(0)
+
+/** Increment memory counter memCur and check if we don't overflow
+    the maximum authorizied memory memMax. */
+#define _MMG5_ADD_MEM(mesh,size,message,law) do \
+  {                                             \
+    (mesh)->memCur += (long long)(size);        \
+    if ( (mesh)->memCur > (mesh)->memPeak )     \
+      (mesh)->memPeak = (mesh)->memCur;         \
+    _MMG5_CHK_MEM(mesh,size,message,law);       \
+  }while(0)
+
+/** Safe deallocation */
+#define _MMG5_SAFE_FREE(ptr) do                 \
+  {                                             \
+    free(ptr);                                  \
+    ptr = NULL;                                 \
+  }while(0)
+
+/** Safe allocation with calloc */
+#define _MMG5_SAFE_CALLOC(ptr,size,type) do     \
+  {                                             \
+    ptr = (type *)calloc((size),sizeof(type));  \
+    if ( !ptr ) {                               \
+      perror("  ## Memory problem: calloc");    \
+      exit(EXIT_FAILURE);                       \
+    }                                           \
+  }while(0)
+
+/** Safe allocation with malloc */
+#define _MMG5_SAFE_MALLOC(ptr,size,type) do     \
+  {                                             \
+    ptr = (type *)malloc((size)*sizeof(type));  \
+    if ( !ptr ) {                               \
+      perror("  ## Memory problem: malloc");    \
+      exit(EXIT_FAILURE);                       \
+    }                                           \
+  }while(0)
+
+/** Safe reallocation */
+#define _MMG5_SAFE_REALLOC(ptr,size,type,message) do        \
+  {                                                         \
+    type* tmp;                                              \
+    tmp = (type *)realloc((ptr),(size)*sizeof(type));       \
+    if ( !tmp ) {                                           \
+      _MMG5_SAFE_FREE(ptr);                                 \
+      perror(" ## Memory problem: realloc");                \
+      exit(EXIT_FAILURE);                                   \
+    }                                                       \
+                                                            \
+    if ( abs(mesh->info.imprim) > 6 || mesh->info.ddebug )  \
+      fprintf(stdout,                                       \
+              "  ## Warning: %s:%d: %s reallocation.\n",    \
+              __FILE__,__LINE__,message);                   \
+                                                            \
+                                                            \
+    (ptr) = tmp;                                            \
+  }while(0)
+
+/** safe reallocation with memset at 0 for the new values of tab */
+#define _MMG5_SAFE_RECALLOC(ptr,prevSize,newSize,type,message) do \
+  {                                                               \
+    type* tmp;                                                    \
+    int k;                                                        \
+                                                                  \
+    tmp = (type *)realloc((ptr),(newSize)*sizeof(type));          \
+    if ( !tmp ) {                                                 \
+      _MMG5_SAFE_FREE(ptr);                                       \
+      perror(" ## Memory problem: realloc");                      \
+      exit(EXIT_FAILURE);                                         \
+    }                                                             \
+                                                                  \
+    if ( abs(mesh->info.imprim) > 6 || mesh->info.ddebug )        \
+      fprintf(stdout,                                             \
+              "  ## Warning: %s:%d: %s reallocation.\n",          \
+              __FILE__,__LINE__,message);                         \
+                                                                  \
+    (ptr) = tmp;                                                  \
+    for ( k=prevSize; k<newSize; k++) {                           \
+      memset(&ptr[k],0,sizeof(type));                             \
+    }                                                             \
+  }while(0)
+
+/** Reallocation of ptr of type type at size (initSize+wantedGap*initSize)
+    if possible or at maximum available size if not. Execute the command law
+    if reallocation failed. Memset to 0 for the new values of table. */
+#define _MMG5_TAB_RECALLOC(mesh,ptr,initSize,wantedGap,type,message,law) do \
+  {                                                                     \
+    int gap;                                                            \
+                                                                        \
+    if ( (mesh->memMax-mesh->memCur) <                                  \
+         (long long) (wantedGap*initSize*sizeof(type)) ) {              \
+      gap = (int)(mesh->memMax-mesh->memCur)/sizeof(type);              \
+      if(gap<1) {                                                       \
+        fprintf(stdout,"  ## Error:");                                  \
+        fprintf(stdout," unable to allocate %s.\n",message);            \
+        fprintf(stdout,"  ## Check the mesh size or ");                 \
+        fprintf(stdout,"increase maximal authorized memory with the -m option.\n"); \
+        law;                                                            \
+      }                                                                 \
+    }                                                                   \
+    else                                                                \
+      gap = wantedGap*initSize;                                         \
+                                                                        \
+    _MMG5_ADD_MEM(mesh,gap*sizeof(type),message,law);                   \
+    _MMG5_SAFE_RECALLOC((ptr),initSize+1,initSize+gap+1,type,message);  \
+    _MMG5_PROF_INC(mesh,_MMG5_PC_reatab);                               \
+    initSize = initSize+gap;                                            \
+  }while(0);
+
+/** Free allocated pointers of mesh and sol structure and return value val */
+#define _MMG5_RETURN_AND_FREE(mesh,met,val)do   \
+  {                                             \
+    MMG5_Free_all(mesh,met);                    \
+    return(val);                                \
+  }while(0)
+
+/** Error message when lack of memory */
+#define _MMG5_INCREASE_MEM_MESSAGE() do                     \
+  {                                                         \
+    printf("  ## Check the mesh size or increase maximal"); \
+    printf(" authorized memory with the -m option.\n");     \
+  } while(0)
+
+
+/** Reallocation of point table and sol table and creation
+    of point ip with coordinates o and tag tag*/
+#define _MMG5_POINT_REALLOC(mesh,sol,ip,wantedGap,law,o,tag ) do        \
+  {                                                                     \
+    _MMG5_TAB_RECALLOC(mesh,mesh->point,mesh->npmax,wantedGap,MMG5_Point, \
+                       "larger point table",law);                       \
+    _MMG5_PROF_INC(mesh,_MMG5_PC_reapt);                                \
+                                                                        \
+    mesh->npnil = mesh->np+1;                                           \
+    mesh->nplnk = mesh->npnil;                                          \
+                                                                        \
+    /* solution */                                                      \
+    if ( sol->m ) {                                                     \
+      _MMG5_ADD_MEM(mesh,sol->size*(mesh->npmax-sol->npmax)*sizeof(double), \
+                    "larger solution",law);                             \
+      _MMG5_SAFE_REALLOC(sol->m,sol->size*(mesh->npmax+1)+1,double,         \
+                         "larger solution");                            \
+    }                                                                   \
+    sol->npmax = mesh->npmax;                                           \
+                                                                        \
+    /* We try again to add the point */                                 \
+    ip = _MMG5_newPt(mesh,o,tag);                                       \
+    if ( !ip ) {law;}                                                   \
+  }while(0)
+
+/* Macro for fortran function generation */
+/**
+ * \def FORTRAN_NAME(nu,nl,pl,pc)
+ * \brief Adds function definitions.
+ * \param nu function name in upper case.
+ * \param nl function name in lower case.
+ * \param pl type of arguments.
+ * \param pc name of arguments.
+ * \note Macro coming from Scotch library.
+ *
+ * Adds function definitions with upcase, underscore and double
+ * underscore to match any fortran compiler.
+ *
+ */
+#define FORTRAN_NAME(nu,nl,pl,pc)               \
+  void nu pl;                                   \
+  void nl pl                                    \
+  { nu pc; }                                    \
+  void nl##_ pl                                 \
+  { nu pc; }                                    \
+  void nl##__ pl                                \
+  { nu pc; }                                    \
+  void nu pl
+
+/* Global variables */
+extern unsigned char _MMG5_inxt2[3]; /*!< next vertex of triangle: {1,2,0} */
+extern unsigned char _MMG5_iprv2[3]; /*!< previous vertex of triangle: {2,0,1} */
+
+/* Private structures */
+/**
+ * \struct _MMG5_Bezier
+ *
+ * Store the Bezier definition of a surface triangle.
+ *
+ */
+typedef struct {
+  double       b[10][3];/*!< Bezier basis functions */
+  double       n[6][3]; /*!< Normals at points */
+  double       t[6][3]; /*!< Tangents at points */
+  MMG5_pPoint  p[3];    /*!< Triangle vertices */
+} _MMG5_Bezier;
+typedef _MMG5_Bezier * _MMG5_pBezier;
+
+/**
+ * \struct _MMG5_BezCache
+ *
+ * Entry of the cache of the Bezier patches of the boundary faces: the control
+ * net of a face is reused as long as the vertex data it has been computed
+ * from (coordinates, tags, normals and tangents) is unchanged.
+ *
+ */
+typedef struct _MMG5_BezCache {
+  _MMG5_Bezier  b; /*!< Control net of the face */
+  double        g[3][_MMG5_BEZSNP]; /*!< Normals and tangents used at the vertices */
+  int           v[3]; /*!< Vertices of the face (in the triangle order) */
+  char          tag[3]; /*!< Tags of the edges of the face */
+  char          ptag[3]; /*!< Tags of the vertices */
+  char          ori; /*!< Orientation of the face */
+} _MMG5_BezCache;
+typedef _MMG5_BezCache * _MMG5_pBezCache;
+
+/**
+ * \struct _MMG5_hedge
+ * \brief Used to hash edges (memory economy compared to \ref MMG5_hgeom).
+ */
+typedef struct {
+  int   a,b,nxt;
+  int   s,k; /** k = point along edge a b */
+} _MMG5_hedge;
+
+/**
+ * \struct _MMG5_Hash
+ * \brief Identic as \ref MMG5_HGeom but use \ref _MMG5_hedge to store edges
+ * instead of \ref MMG5_hgeom (memory economy).
+ */
+typedef struct {
+  int     siz,max,nxt;
+  _MMG5_hedge  *item;
+} _MMG5_Hash;
+
+/**
+ * \struct _MMG5_Abuf
+ * \brief Mesh or solution file (ascii or binary) loaded (or mapped) in memory.
+ */
+typedef struct {
+  char    *buf; /*!< File content (not null terminated) */
+  size_t   siz; /*!< Size of the file */
+  size_t   pos; /*!< Current position in the buffer */
+  int      mapped; /*!< 1 if \a buf is mapped, 0 if it is allocated */
+} _MMG5_Abuf;
+
+/** Size of the buffer used to write the mesh and solution files */
+#define _MMG5_WBUFSIZ 1048576
+
+/**
+ * \struct _MMG5_Wbuf
+ * \brief Buffer used to gather the data before writing them in a file.
+ */
+typedef struct {
+  FILE    *file; /*!< Output file */
+  char    *buf; /*!< Buffer */
+  size_t   siz; /*!< Size of the buffer */
+  size_t   pos; /*!< Number of bytes stored in the buffer */
+} _MMG5_Wbuf;
+
+
+/* Functions declarations */
+int    _MMG5_buildridmet(MMG5_pMesh,MMG5_pSol,int,double,double,double,double*);
+int    _MMG5_bezierGetCP(MMG5_pMesh,MMG5_pTria,char,double g[3][_MMG5_BEZSNP],
+                         _MMG5_pBezier,_MMG5_pBezCache*);
+void   _MMG5_bezierPutCP(MMG5_pMesh,_MMG5_pBezCache,MMG5_pTria,char,
+                         double g[3][_MMG5_BEZSNP],_MMG5_pBezier);
+void   _MMG5_bezierFreeCache(MMG5_pMesh mesh);
+int    _MMG5_boundingBox(MMG5_pMesh mesh);
+int    _MMG5_boulec(MMG5_pMesh, int*, int, int i,double *tt);
+int    _MMG5_boulen(MMG5_pMesh, int*, int, int i,double *nn);
+int    _MMG5_bouler(MMG5_pMesh, int*, int, int i,int *,int *,int *, int);
+double _MMG5_caltri_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
+double _MMG5_caltri_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
+void   _MMG5_displayHisto(MMG5_pMesh,int, double*, int, int, double, int, int,
+                          double, double*, int*);
+int    _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash,int a,int b,int k);
+int    _MMG5_hashGet(_MMG5_Hash *hash,int a,int b);
+int    _MMG5_hashNew(MMG5_pMesh mesh, _MMG5_Hash *hash,int hsiz,int hmax);
+double _MMG5_lenedg_ani(MMG5_pMesh mesh,MMG5_pSol met,int ip1,int ip2,char);
+double _MMG5_lenedg_iso(MMG5_pMesh ,MMG5_pSol ,int ,int, char );
+long long _MMG5_memSize(void);
+void   _MMG5_mmgDefaultValues(MMG5_pMesh mesh);
+int    _MMG5_mmgHashTria(MMG5_pMesh mesh, int *adja, int chkISO);
+void   _MMG5_mmgInit_parameters(MMG5_pMesh mesh);
+void   _MMG5_mmgUsage(char *prog);
+int    _MMG5_norpts(MMG5_pMesh,int,int,int,double *);
+int    _MMG5_nortri(MMG5_pMesh mesh,MMG5_pTria pt,double *n);
+int    _MMG5_openAscii(const char *filename,_MMG5_Abuf *ab);
+void   _MMG5_closeAscii(_MMG5_Abuf *ab);
+int    _MMG5_profNew(MMG5_pMesh mesh);
+void   _MMG5_profFree(MMG5_pMesh mesh);
+int    _MMG5_profSave(MMG5_pMesh mesh,char *filename);
+int    _MMG5_readWord(_MMG5_Abuf *ab,char *word,int siz);
+int    _MMG5_readInt(_MMG5_Abuf *ab,int *val);
+int    _MMG5_readDouble(_MMG5_Abuf *ab,double *val);
+int    _MMG5_readFloat(_MMG5_Abuf *ab,float *val);
+int    _MMG5_readBin(_MMG5_Abuf *ab,void *val,int siz,int iswp);
+int    _MMG5_readBinBlock(_MMG5_Abuf *ab,void *val,int siz,int n,int iswp);
+void   _MMG5_openWbuf(_MMG5_Wbuf *wb,FILE *file);
+void   _MMG5_flushWbuf(_MMG5_Wbuf *wb);
+void   _MMG5_closeWbuf(_MMG5_Wbuf *wb);
+void   _MMG5_writeBin(_MMG5_Wbuf *wb,const void *val,int siz);
+void   _MMG5_writeStr(_MMG5_Wbuf *wb,const char *str);
+void   _MMG5_printWbuf(_MMG5_Wbuf *wb,const char *fmt,...);
+void   _MMG5_printTria(MMG5_pMesh mesh,char* fileName);
+int    _MMG5_rotmatrix(double n[3],double r[3][3]);
+int    _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met);
+int    _MMG5_scalePar(MMG5_pMesh mesh);
+double _MMG5_surftri_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
+double _MMG5_surftri_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
+int    _MMG5_sys33sym(double a[6], double b[3], double r[3]);
+int    _MMG5_unscaleMesh(MMG5_pMesh mesh,MMG5_pSol met);
+
+void _MMG5_Set_APIFunc();
+
+/* function pointers */
+int    (*_MMG5_bezierCP)(MMG5_pMesh ,MMG5_Tria *,_MMG5_pBezier ,char );
+double (*_MMG5_lenedg)(MMG5_pMesh mesh,MMG5_pSol sol ,int ,int, char );
+
+
+#endif
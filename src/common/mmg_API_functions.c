@@ -298,6 +298,78 @@ int MMG5_Set_outputSolName(MMG5_pMesh mesh,MMG5_pSol sol, char* solout) {
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ckpt name of the checkpoint file.
+ * \return 1.
+ *
+ * Set the name of the checkpoint file in which the working state is saved
+ * after the analysis and at each pass of the adaptation (mmg3d only).
+ *
+ */
+int MMG5_Set_checkpointName(MMG5_pMesh mesh, char* ckpt) {
+
+  if ( mesh->nameckpt )
+    _MMG5_DEL_MEM(mesh,mesh->nameckpt,(strlen(mesh->nameckpt)+1)*sizeof(char));
+
+  if ( strlen(ckpt) ) {
+    _MMG5_ADD_MEM(mesh,(strlen(ckpt)+1)*sizeof(char),"checkpoint name",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(mesh->nameckpt,strlen(ckpt)+1,char);
+    strcpy(mesh->nameckpt,ckpt);
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param surf surface mesh name.
+ * \return 1.
+ *
+ * Set the name of the surface mesh whose signed distance gives the
+ * level-set function (iso mode).
+ *
+ */
+int MMG5_Set_distanceMeshName(MMG5_pMesh mesh, char* surf) {
+
+  if ( mesh->namedist )
+    _MMG5_DEL_MEM(mesh,mesh->namedist,(strlen(mesh->namedist)+1)*sizeof(char));
+
+  if ( strlen(surf) ) {
+    _MMG5_ADD_MEM(mesh,(strlen(surf)+1)*sizeof(char),"surface mesh name",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(mesh->namedist,strlen(surf)+1,char);
+    strcpy(mesh->namedist,surf);
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param prof name of the profile file.
+ * \return 1.
+ *
+ * Set the name of the file in which the profile of the run is saved (an empty
+ * name turns the profiler off).
+ *
+ */
+int MMG5_Set_profileName(MMG5_pMesh mesh, char* prof) {
+
+  if ( mesh->nameprof )
+    _MMG5_DEL_MEM(mesh,mesh->nameprof,(strlen(mesh->nameprof)+1)*sizeof(char));
+
+  if ( strlen(prof) ) {
+    _MMG5_ADD_MEM(mesh,(strlen(prof)+1)*sizeof(char),"profile name",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(mesh->nameprof,strlen(prof)+1,char);
+    strcpy(mesh->nameprof,prof);
+  }
+  return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -316,6 +388,18 @@ void MMG5_Free_names(MMG5_pMesh mesh,MMG5_pSol met
     _MMG5_DEL_MEM(mesh,mesh->namein,(strlen(mesh->namein)+1)*sizeof(char));
   }
 
+  if ( mesh->nameckpt ) {
+    _MMG5_DEL_MEM(mesh,mesh->nameckpt,(strlen(mesh->nameckpt)+1)*sizeof(char));
+  }
+
+  if ( mesh->namedist ) {
+    _MMG5_DEL_MEM(mesh,mesh->namedist,(strlen(mesh->namedist)+1)*sizeof(char));
+  }
+
+  if ( mesh->nameprof ) {
+    _MMG5_DEL_MEM(mesh,mesh->nameprof,(strlen(mesh->nameprof)+1)*sizeof(char));
+  }
+
   /* met */
   if ( met ) {
     if ( met->namein ) {
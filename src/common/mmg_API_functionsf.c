@@ -131,6 +131,57 @@ FORTRAN_NAME(MMG5_SET_OUTPUTSOLNAME,mmg5_set_outputsolname,
   return;
 }
 
+/**
+ * See \ref MMG5_Set_checkpointName function in common/libmmg.h file.
+ */
+FORTRAN_NAME(MMG5_SET_CHECKPOINTNAME,mmg5_set_checkpointname,
+             (MMG5_pMesh *mesh, char* ckpt, int* strlen,int* retval),
+             (mesh,ckpt,strlen,retval)){
+  char *tmp = NULL;
+
+  tmp = (char*)malloc((*strlen+1)*sizeof(char));
+  strncpy(tmp,ckpt,*strlen);
+  tmp[*strlen] = '\0';
+  *retval = MMG5_Set_checkpointName(*mesh, tmp);
+  _MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_distanceMeshName function in common/libmmg.h file.
+ */
+FORTRAN_NAME(MMG5_SET_DISTANCEMESHNAME,mmg5_set_distancemeshname,
+             (MMG5_pMesh *mesh, char* surf, int* strlen,int* retval),
+             (mesh,surf,strlen,retval)){
+  char *tmp = NULL;
+
+  tmp = (char*)malloc((*strlen+1)*sizeof(char));
+  strncpy(tmp,surf,*strlen);
+  tmp[*strlen] = '\0';
+  *retval = MMG5_Set_distanceMeshName(*mesh, tmp);
+  _MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_profileName function in common/libmmg.h file.
+ */
+FORTRAN_NAME(MMG5_SET_PROFILENAME,mmg5_set_profilename,
+             (MMG5_pMesh *mesh, char* prof, int* strlen,int* retval),
+             (mesh,prof,strlen,retval)){
+  char *tmp = NULL;
+
+  tmp = (char*)malloc((*strlen+1)*sizeof(char));
+  strncpy(tmp,prof,*strlen);
+  tmp[*strlen] = '\0';
+  *retval = MMG5_Set_profileName(*mesh, tmp);
+  _MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
 /**
  * See \ref MMG5_Free_names function in \ref common/libmmg.h file.
  */
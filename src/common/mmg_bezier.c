@@ -0,0 +1,170 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/mmg_bezier.c
+ * \brief Cache of the Bezier patches of the boundary faces.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The cache is direct-mapped: a face is stored in the entry given by a hash of
+ * its (ordered) vertices and orientation, overwriting the previous
+ * occupant. An entry is only reused if the vertex data from which the control
+ * net has been computed is unchanged, thus the remeshing operators don't have
+ * to invalidate it.
+ */
+
+#include "mmg.h"
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * (Re)allocate the cache of Bezier patches, with a size adapted to the number
+ * of boundary faces and to the available memory (the cache is disabled if the
+ * memory is too short).
+ *
+ */
+static void _MMG5_bezierNewCache(MMG5_pMesh mesh) {
+  long long  avail;
+  int        n,nf;
+
+  _MMG5_bezierFreeCache(mesh);
+
+  /* the boundary grows with the refinement */
+  nf = 2*MG_MAX(mesh->nt,mesh->xt);
+  n  = 1<<8;
+  while ( n < nf && n < (1<<_MMG5_BEZCMAX) )  n <<= 1;
+
+  /* don't use more than 1/8 of the remaining memory */
+  avail = mesh->memMax - mesh->memCur;
+  while ( n >= (1<<8) && (long long)n*sizeof(_MMG5_BezCache) > avail/8 )
+    n >>= 1;
+
+  if ( n < (1<<8) ) {
+    mesh->nbez = -1;
+    return;
+  }
+
+  _MMG5_ADD_MEM(mesh,n*sizeof(_MMG5_BezCache),"bezier cache",
+                mesh->nbez = -1;
+                return;);
+  _MMG5_SAFE_CALLOC(mesh->bezc,n,_MMG5_BezCache);
+  mesh->nbez = n;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Free the cache of Bezier patches.
+ *
+ */
+void _MMG5_bezierFreeCache(MMG5_pMesh mesh) {
+  if ( mesh->bezc )
+    _MMG5_DEL_MEM(mesh,mesh->bezc,mesh->nbez*sizeof(_MMG5_BezCache));
+  mesh->nbez = 0;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the (virtual) boundary triangle.
+ * \param ori triangle orientation.
+ * \param g normals and tangents used by the Bezier patch at the vertices of
+ * \a pt (see \ref _MMG5_BEZSNP).
+ * \param pb pointer toward the Bezier structure to fill.
+ * \param pc pointer toward the cache entry of the face (NULL if no cache).
+ * \return 1 if \a pb has been filled from the cache, 0 otherwise.
+ *
+ * Look for the Bezier patch of \a pt in the cache. If the patch has to be
+ * computed, it may be stored in the entry \a pc by \ref _MMG5_bezierPutCP.
+ *
+ */
+int _MMG5_bezierGetCP(MMG5_pMesh mesh,MMG5_pTria pt,char ori,
+                      double g[3][_MMG5_BEZSNP],_MMG5_pBezier pb,
+                      _MMG5_pBezCache *pc) {
+  _MMG5_pBezCache  pe;
+  MMG5_pPoint      p0;
+  unsigned int     key;
+  int              nf;
+  char             i;
+
+  *pc = NULL;
+  /* (re)allocate the cache when the boundary has grown */
+  nf = MG_MAX(mesh->nt,mesh->xt);
+  if ( !mesh->nbez || (mesh->nbez > 0 && mesh->nbez < nf
+                       && mesh->nbez < (1<<_MMG5_BEZCMAX)) ) {
+    _MMG5_bezierNewCache(mesh);
+  }
+  if ( mesh->nbez < 0 )  return(0);
+
+  key = (unsigned int)pt->v[0]*2654435761u + (unsigned int)pt->v[1]*40503u
+    + (unsigned int)pt->v[2]*_MMG5_KA + (unsigned int)ori;
+  pe  = &mesh->bezc[ (key ^ (key >> 15)) & (mesh->nbez-1) ];
+  *pc = pe;
+
+  if ( pe->ori != ori )  return(0);
+  for (i=0; i<3; i++) {
+    p0 = &mesh->point[pt->v[i]];
+    if ( pe->v[i] != pt->v[i] || pe->tag[i] != pt->tag[i]
+         || pe->ptag[i] != p0->tag )  return(0);
+    if ( memcmp(pe->b.b[i],p0->c,3*sizeof(double)) )  return(0);
+  }
+  if ( memcmp(pe->g,g,3*_MMG5_BEZSNP*sizeof(double)) )  return(0);
+
+  memcpy(pb,&pe->b,sizeof(_MMG5_Bezier));
+  for (i=0; i<3; i++)
+    pb->p[i] = &mesh->point[pt->v[i]];
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pc pointer toward the cache entry of the face.
+ * \param pt pointer toward the (virtual) boundary triangle.
+ * \param ori triangle orientation.
+ * \param g normals and tangents used by the Bezier patch at the vertices of
+ * \a pt.
+ * \param pb pointer toward the computed Bezier structure.
+ *
+ * Store the Bezier patch of \a pt in the cache entry \a pc.
+ *
+ */
+void _MMG5_bezierPutCP(MMG5_pMesh mesh,_MMG5_pBezCache pc,MMG5_pTria pt,
+                       char ori,double g[3][_MMG5_BEZSNP],_MMG5_pBezier pb) {
+  char  i;
+
+  if ( !pc )  return;
+
+  memcpy(&pc->b,pb,sizeof(_MMG5_Bezier));
+  memcpy(pc->g,g,3*_MMG5_BEZSNP*sizeof(double));
+  for (i=0; i<3; i++) {
+    pc->v[i]    = pt->v[i];
+    pc->tag[i]  = pt->tag[i];
+    pc->ptag[i] = mesh->point[pt->v[i]].tag;
+  }
+  pc->ori = ori;
+}
@@ -194,10 +194,12 @@ int _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash, int a,int b,int k) {
   ib  = MG_MAX(a,b);
   key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
   ph  = &hash->item[key];
+  _MMG5_PROF_INC(mesh,_MMG5_PC_hashins);
 
   if ( ph->a == ia && ph->b == ib )
     return(1);
   else if ( ph->a ) {
+    _MMG5_PROF_INC(mesh,_MMG5_PC_hashcol);
     while ( ph->nxt && ph->nxt < hash->max ) {
       ph = &hash->item[ph->nxt];
       if ( ph->a == ia && ph->b == ib )  return(1);
@@ -0,0 +1,689 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/mmg_inout.c
+ * \brief Low level tools for the reading/writing of mesh and solution files.
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include "mmg.h"
+#include <stdarg.h>
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || \
+  (defined(__APPLE__) && defined(__MACH__))
+#define _MMG5_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/** Exact powers of ten (used by the fast path of \ref _MMG5_readDouble). */
+static const double _MMG5_pow10[23] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * \param filename name of the file to open.
+ * \param ab pointer toward the file buffer to fill.
+ * \return 1 if success, 0 otherwise.
+ *
+ * Map (or read in one block if the system don't provide \a mmap) the file
+ * \a filename into memory.
+ *
+ */
+int _MMG5_openAscii(const char *filename,_MMG5_Abuf *ab) {
+  FILE   *inm;
+  long    siz;
+
+  memset(ab,0,sizeof(_MMG5_Abuf));
+
+#ifdef _MMG5_USE_MMAP
+  {
+    struct stat st;
+    int         fd;
+
+    fd = open(filename,O_RDONLY);
+    if ( fd >= 0 ) {
+      if ( !fstat(fd,&st) && st.st_size > 0 ) {
+        ab->buf = (char*)mmap(NULL,(size_t)st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+        if ( ab->buf != MAP_FAILED ) {
+#ifdef MADV_SEQUENTIAL
+          madvise(ab->buf,(size_t)st.st_size,MADV_SEQUENTIAL);
+#endif
+          ab->siz    = (size_t)st.st_size;
+          ab->mapped = 1;
+          close(fd);
+          return(1);
+        }
+        ab->buf = NULL;
+      }
+      close(fd);
+    }
+  }
+#endif
+
+  /* fallback: read the whole file */
+  if ( !(inm = fopen(filename,"rb")) )  return(0);
+  fseek(inm,0,SEEK_END);
+  siz = ftell(inm);
+  rewind(inm);
+  if ( siz <= 0 ) {
+    fclose(inm);
+    return(siz==0);
+  }
+  _MMG5_SAFE_MALLOC(ab->buf,siz,char);
+  ab->siz = fread(ab->buf,1,siz,inm);
+  fclose(inm);
+  return(1);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ *
+ * Release the file buffer.
+ *
+ */
+void _MMG5_closeAscii(_MMG5_Abuf *ab) {
+#ifdef _MMG5_USE_MMAP
+  if ( ab->mapped ) {
+    munmap(ab->buf,ab->siz);
+    memset(ab,0,sizeof(_MMG5_Abuf));
+    return;
+  }
+#endif
+  if ( ab->buf )  _MMG5_SAFE_FREE(ab->buf);
+  memset(ab,0,sizeof(_MMG5_Abuf));
+}
+
+/** Skip the blanks and return 0 if we reach the end of the buffer */
+static inline int _MMG5_skipBlanks(_MMG5_Abuf *ab) {
+  while ( ab->pos < ab->siz && isspace((unsigned char)ab->buf[ab->pos]) )
+    ab->pos++;
+  return(ab->pos < ab->siz);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ * \param word string to fill.
+ * \param siz size of \a word.
+ * \return 1 if a word has been read, EOF at the end of the buffer.
+ *
+ * Read the next word of the buffer (equivalent of fscanf(file,"%s",word)
+ * except that the word is truncated to \a siz-1 characters).
+ *
+ */
+int _MMG5_readWord(_MMG5_Abuf *ab,char *word,int siz) {
+  int  i;
+
+  if ( !_MMG5_skipBlanks(ab) )  return(EOF);
+
+  i = 0;
+  while ( ab->pos < ab->siz && !isspace((unsigned char)ab->buf[ab->pos]) ) {
+    if ( i < siz-1 )  word[i++] = ab->buf[ab->pos];
+    ab->pos++;
+  }
+  word[i] = '\0';
+  return(1);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ * \param val pointer toward the integer to fill.
+ * \return 1 if success, 0 if the next word is not an integer, EOF at the end
+ * of the buffer.
+ *
+ * Read the next integer of the buffer.
+ *
+ */
+int _MMG5_readInt(_MMG5_Abuf *ab,int *val) {
+  const char *c,*end;
+  long        v;
+  int         neg;
+
+  if ( !_MMG5_skipBlanks(ab) )  return(EOF);
+
+  c   = ab->buf + ab->pos;
+  end = ab->buf + ab->siz;
+  neg = 0;
+  if ( *c == '-' || *c == '+' ) {
+    neg = (*c == '-');
+    ++c;
+  }
+  if ( c == end || *c < '0' || *c > '9' )  return(0);
+
+  v = 0;
+  while ( c < end && *c >= '0' && *c <= '9' ) {
+    v = 10*v + (*c - '0');
+    ++c;
+  }
+  *val = (int)(neg ? -v : v);
+  ab->pos = c - ab->buf;
+  return(1);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ * \param val pointer toward the double to fill.
+ * \return 1 if success, 0 if the next word is not a number, EOF at the end
+ * of the buffer.
+ *
+ * Read the next double of the buffer. Numbers with at most 15 significant
+ * digits and a small exponent are exactly converted by one multiplication
+ * or division by an exact power of ten (Clinger's fast path); other numbers
+ * are converted by \a strtod, so the result is always the one of
+ * fscanf(file,"%lf",val).
+ *
+ */
+int _MMG5_readDouble(_MMG5_Abuf *ab,double *val) {
+  const char *c,*beg,*end;
+  char        word[128];
+  long long   mant;
+  int         neg,nd,exp,eneg,e,ok;
+
+  if ( !_MMG5_skipBlanks(ab) )  return(EOF);
+
+  beg = c = ab->buf + ab->pos;
+  end = ab->buf + ab->siz;
+
+  /* sign */
+  neg = 0;
+  if ( *c == '-' || *c == '+' ) {
+    neg = (*c == '-');
+    ++c;
+  }
+
+  /* mantissa */
+  mant = 0;
+  nd = exp = ok = 0;
+  while ( c < end && *c >= '0' && *c <= '9' ) {
+    if ( mant || *c != '0' ) {
+      if ( nd < 19 )  mant = 10*mant + (*c - '0');
+      else            ++exp;
+      ++nd;
+    }
+    ok = 1;
+    ++c;
+  }
+  if ( c < end && *c == '.' ) {
+    ++c;
+    while ( c < end && *c >= '0' && *c <= '9' ) {
+      if ( mant || *c != '0' ) {
+        if ( nd < 19 ) {
+          mant = 10*mant + (*c - '0');
+          --exp;
+        }
+        ++nd;
+      }
+      else --exp;
+      ok = 1;
+      ++c;
+    }
+  }
+  if ( !ok )  goto slow;
+
+  /* exponent */
+  if ( c < end && (*c == 'e' || *c == 'E' || *c == 'd' || *c == 'D') ) {
+    if ( *c == 'd' || *c == 'D' ) goto slow;
+    ++c;
+    eneg = 0;
+    if ( c < end && (*c == '-' || *c == '+') ) {
+      eneg = (*c == '-');
+      ++c;
+    }
+    if ( c == end || *c < '0' || *c > '9' )  goto slow;
+    e = 0;
+    while ( c < end && *c >= '0' && *c <= '9' ) {
+      if ( e < 10000 )  e = 10*e + (*c - '0');
+      ++c;
+    }
+    exp += eneg ? -e : e;
+  }
+  if ( c < end && !isspace((unsigned char)*c) )  goto slow;
+
+  /* fast path: exact conversion */
+  if ( nd <= 15 && exp >= -22 && exp <= 22 ) {
+    *val = (double)mant;
+    if ( exp < 0 )  *val /= _MMG5_pow10[-exp];
+    else            *val *= _MMG5_pow10[exp];
+    if ( neg )  *val = -*val;
+    ab->pos = c - ab->buf;
+    return(1);
+  }
+
+slow:
+  /* slow path: strtod on a null terminated copy of the word */
+  c = beg;
+  nd = 0;
+  while ( c < end && !isspace((unsigned char)*c) && nd < 127 )
+    word[nd++] = *c++;
+  word[nd] = '\0';
+  *val = strtod(word,(char**)&c);
+  if ( c == word )  return(0);
+  ab->pos = (beg - ab->buf) + (c - word);
+  return(1);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ * \param val pointer toward the float to fill.
+ * \return 1 if success, 0 if the next word is not a number, EOF at the end
+ * of the buffer.
+ *
+ * Read the next float of the buffer (equivalent of fscanf(file,"%f",val)).
+ *
+ */
+int _MMG5_readFloat(_MMG5_Abuf *ab,float *val) {
+  const char *c,*beg,*end;
+  char        word[128];
+  int         nd;
+
+  if ( !_MMG5_skipBlanks(ab) )  return(EOF);
+
+  beg = c = ab->buf + ab->pos;
+  end = ab->buf + ab->siz;
+  nd = 0;
+  while ( c < end && !isspace((unsigned char)*c) && nd < 127 )
+    word[nd++] = *c++;
+  word[nd] = '\0';
+  *val = strtof(word,(char**)&c);
+  if ( c == word )  return(0);
+  ab->pos = (beg - ab->buf) + (c - word);
+  return(1);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ * \param val pointer toward the value to fill.
+ * \param siz size of the value (in bytes).
+ * \param iswp 1 if the bytes must be swapped (endianness).
+ * \return 1 if success, 0 at the end of the buffer.
+ *
+ * Read a binary value of \a siz bytes directly from the file buffer.
+ *
+ */
+int _MMG5_readBin(_MMG5_Abuf *ab,void *val,int siz,int iswp) {
+  const char *c;
+  char       *v;
+  int         i;
+
+  if ( ab->pos + siz > ab->siz )  return(0);
+
+  c = ab->buf + ab->pos;
+  if ( !iswp )
+    memcpy(val,c,siz);
+  else {
+    v = (char*)val;
+    for (i=0; i<siz; i++)  v[i] = c[siz-1-i];
+  }
+  ab->pos += siz;
+  return(1);
+}
+
+/**
+ * \param ab pointer toward the file buffer.
+ * \param val pointer toward the array to fill.
+ * \param siz size of one value (in bytes).
+ * \param n number of values.
+ * \param iswp 1 if the bytes must be swapped (endianness).
+ * \return 1 if success, 0 at the end of the buffer.
+ *
+ * Read \a n consecutive binary values of \a siz bytes with one copy from the
+ * file buffer, then swap their bytes if needed.
+ *
+ */
+int _MMG5_readBinBlock(_MMG5_Abuf *ab,void *val,int siz,int n,int iswp) {
+  char       *v,tmp;
+  size_t      nb;
+  int         i,k;
+
+  nb = (size_t)siz*n;
+  if ( ab->pos + nb > ab->siz )  return(0);
+
+  memcpy(val,ab->buf+ab->pos,nb);
+  if ( iswp ) {
+    v = (char*)val;
+    for (k=0; k<n; k++,v+=siz) {
+      for (i=0; i<siz/2; i++) {
+        tmp         = v[i];
+        v[i]        = v[siz-1-i];
+        v[siz-1-i]  = tmp;
+      }
+    }
+  }
+  ab->pos += nb;
+  return(1);
+}
+
+/**
+ * \param wb pointer toward the write buffer to initialize.
+ * \param file file in which the buffer is flushed.
+ *
+ * Allocate a write buffer over the (already opened) file \a file.
+ *
+ */
+void _MMG5_openWbuf(_MMG5_Wbuf *wb,FILE *file) {
+  wb->file = file;
+  wb->siz  = _MMG5_WBUFSIZ;
+  wb->pos  = 0;
+  _MMG5_SAFE_MALLOC(wb->buf,wb->siz,char);
+}
+
+/**
+ * \param wb pointer toward the write buffer.
+ *
+ * Write the content of the buffer in the file.
+ *
+ */
+void _MMG5_flushWbuf(_MMG5_Wbuf *wb) {
+  if ( wb->pos )
+    fwrite(wb->buf,1,wb->pos,wb->file);
+  wb->pos = 0;
+}
+
+/**
+ * \param wb pointer toward the write buffer.
+ *
+ * Flush and release the write buffer (the file is not closed).
+ *
+ */
+void _MMG5_closeWbuf(_MMG5_Wbuf *wb) {
+  _MMG5_flushWbuf(wb);
+  _MMG5_SAFE_FREE(wb->buf);
+  wb->siz = 0;
+}
+
+/**
+ * \param wb pointer toward the write buffer.
+ * \param val pointer toward the value to write.
+ * \param siz size of the value (in bytes).
+ *
+ * Append a binary value of \a siz bytes to the write buffer.
+ *
+ */
+void _MMG5_writeBin(_MMG5_Wbuf *wb,const void *val,int siz) {
+  if ( wb->pos + siz > wb->siz )  _MMG5_flushWbuf(wb);
+  memcpy(wb->buf+wb->pos,val,siz);
+  wb->pos += siz;
+}
+
+/**
+ * \param wb pointer toward the write buffer.
+ * \param siz number of bytes needed.
+ * \return pointer toward the first free byte of the buffer.
+ *
+ * Ensure that \a siz bytes are available in the write buffer (flush it
+ * otherwise).
+ *
+ */
+static inline char *_MMG5_reserveWbuf(_MMG5_Wbuf *wb,size_t siz) {
+  if ( wb->pos + siz > wb->siz )  _MMG5_flushWbuf(wb);
+  return(wb->buf+wb->pos);
+}
+
+/**
+ * \param s string to fill (at least 12 bytes).
+ * \param val integer to write.
+ * \return the number of written characters.
+ *
+ * Fast equivalent of \a sprintf(s,"%d",val) (without the final \a '\\0').
+ *
+ */
+static inline int _MMG5_fmtInt(char *s,int val) {
+  char         tmp[12];
+  unsigned int u;
+  int          i,n;
+
+  n = 0;
+  if ( val < 0 ) {
+    s[n++] = '-';
+    u = 0u - (unsigned int)val;
+  }
+  else
+    u = (unsigned int)val;
+
+  i = 0;
+  do {
+    tmp[i++] = (char)('0' + u%10);
+    u /= 10;
+  } while ( u );
+
+  while ( i )  s[n++] = tmp[--i];
+  return(n);
+}
+
+#if LDBL_MANT_DIG >= 64
+/** Exact powers of ten in extended precision (used by \ref _MMG5_fmtDouble). */
+static const long double _MMG5_lpow10[28] = {
+  1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+  1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+  1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+#endif
+
+/**
+ * \param s string to fill (at least 24 bytes).
+ * \param val double to write.
+ * \return the number of written characters, 0 if the fast path can't
+ * guarantee the result.
+ *
+ * Fast equivalent of \a sprintf(s,"%.15g",val): the 15 significant digits
+ * are computed in extended precision and the value is rejected (return 0) if
+ * the rounding of the last digit is ambiguous, if the exponent is outside of
+ * the range in which the powers of ten are exact or if the platform doesn't
+ * provide an extended precision \a long \a double.
+ *
+ */
+static int _MMG5_fmtDouble(char *s,double val) {
+#if LDBL_MANT_DIG >= 64
+  long double        y,f;
+  unsigned long long d;
+  char               dig[16];
+  int                i,n,e2,e10,k,last;
+
+  n = 0;
+  if ( signbit(val) ) {
+    s[n++] = '-';
+    val = -val;
+  }
+  if ( val == 0. ) {
+    s[n++] = '0';
+    return(n);
+  }
+  if ( !isfinite(val) )  return(0);
+
+  /* decimal exponent: the estimation may be too small by one */
+  frexp(val,&e2);
+  e10 = (int)floor((e2-1)*0.30102999566398120);
+  for ( i=0; i<2; ++i ) {
+    k = 14 - e10;
+    if ( k > 27 || k < -27 )  return(0);
+    y = k >= 0 ? (long double)val * _MMG5_lpow10[k] :
+      (long double)val / _MMG5_lpow10[-k];
+    if ( y < 1e15L )  break;
+    ++e10;
+  }
+  if ( y < 1e14L || y >= 1e15L )  return(0);
+
+  /* rounding to the nearest integer: the error on y is lower than 1e-4 */
+  d = (unsigned long long)y;
+  f = y - (long double)d;
+  if ( fabsl(f-0.5L) < 1e-3L )  return(0);
+  if ( f > 0.5L )  ++d;
+  if ( d == 1000000000000000ULL ) {
+    d = 100000000000000ULL;
+    ++e10;
+  }
+
+  for ( i=14; i>=0; --i ) {
+    dig[i] = (char)('0' + d%10);
+    d /= 10;
+  }
+  /* significant digits without the trailing zeros */
+  for ( last=14; last>0 && dig[last]=='0'; --last ) ;
+
+  if ( e10 < -4 || e10 >= 15 ) {
+    s[n++] = dig[0];
+    if ( last > 0 ) {
+      s[n++] = '.';
+      for ( i=1; i<=last; ++i )  s[n++] = dig[i];
+    }
+    s[n++] = 'e';
+    if ( e10 < 0 ) {
+      s[n++] = '-';
+      e10 = -e10;
+    }
+    else
+      s[n++] = '+';
+    if ( e10 < 10 )  s[n++] = '0';
+    n += _MMG5_fmtInt(s+n,e10);
+  }
+  else if ( e10 >= 0 ) {
+    for ( i=0; i<=e10; ++i )  s[n++] = dig[i];
+    if ( last > e10 ) {
+      s[n++] = '.';
+      for ( i=e10+1; i<=last; ++i )  s[n++] = dig[i];
+    }
+  }
+  else {
+    s[n++] = '0';
+    s[n++] = '.';
+    for ( i=-1; i>e10; --i )  s[n++] = '0';
+    for ( i=0; i<=last; ++i )  s[n++] = dig[i];
+  }
+  return(n);
+#else
+  return(0);
+#endif
+}
+
+/**
+ * \param wb pointer toward the write buffer.
+ * \param str string to write.
+ *
+ * Append the string \a str to the write buffer.
+ *
+ */
+void _MMG5_writeStr(_MMG5_Wbuf *wb,const char *str) {
+  size_t siz;
+
+  while ( *str ) {
+    if ( wb->pos == wb->siz )  _MMG5_flushWbuf(wb);
+    siz = wb->siz - wb->pos;
+    while ( siz-- && *str )  wb->buf[wb->pos++] = *str++;
+  }
+}
+
+/**
+ * \param wb pointer toward the write buffer.
+ * \param fmt format string.
+ * \param ... values to write.
+ *
+ * Buffered equivalent of \a fprintf: append the formatted values to the write
+ * buffer. The \a "%d", \a "%s" and \a "%.15lg" conversions (the ones used by
+ * the mesh and solution writers) are formatted without the C library (with
+ * the same output), the other conversions are delegated to \a snprintf.
+ *
+ */
+void _MMG5_printWbuf(_MMG5_Wbuf *wb,const char *fmt,...) {
+  va_list     args;
+  const char *p;
+  char        spec[32],*s;
+  double      dval;
+  size_t      len;
+  int         n,lng;
+
+  va_start(args,fmt);
+  for ( ; *fmt; ++fmt ) {
+    if ( *fmt != '%' ) {
+      s = _MMG5_reserveWbuf(wb,1);
+      *s = *fmt;
+      ++wb->pos;
+      continue;
+    }
+    ++fmt;
+    if ( *fmt == '%' ) {
+      s = _MMG5_reserveWbuf(wb,1);
+      *s = '%';
+      ++wb->pos;
+      continue;
+    }
+    if ( *fmt == 'd' ) {
+      s = _MMG5_reserveWbuf(wb,12);
+      wb->pos += _MMG5_fmtInt(s,va_arg(args,int));
+      continue;
+    }
+    if ( *fmt == 's' ) {
+      _MMG5_writeStr(wb,va_arg(args,const char*));
+      continue;
+    }
+    if ( !strncmp(fmt,".15lg",5) || !strncmp(fmt,".15g",4) ) {
+      dval = va_arg(args,double);
+      s    = _MMG5_reserveWbuf(wb,32);
+      n    = _MMG5_fmtDouble(s,dval);
+      if ( !n )  n = sprintf(s,"%.15g",dval);
+      wb->pos += n;
+      fmt     += fmt[3]=='l' ? 4 : 3;
+      continue;
+    }
+
+    /* generic conversion */
+    p   = fmt;
+    lng = 0;
+    while ( *fmt && !strchr("diouxXeEfFgGcsp",*fmt) ) {
+      if ( *fmt == 'l' )  ++lng;
+      ++fmt;
+    }
+    if ( !*fmt )  break;
+    len = (size_t)(fmt-p)+1;
+    if ( len+2 > sizeof(spec) )  break;
+    spec[0] = '%';
+    memcpy(spec+1,p,len);
+    spec[len+1] = '\0';
+
+    s = _MMG5_reserveWbuf(wb,128);
+    switch ( *fmt ) {
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+      n = snprintf(s,128,spec,va_arg(args,double));
+      break;
+    case 's':
+      n = snprintf(s,128,spec,va_arg(args,const char*));
+      break;
+    case 'p':
+      n = snprintf(s,128,spec,va_arg(args,void*));
+      break;
+    default:
+      if ( lng > 1 )
+        n = snprintf(s,128,spec,va_arg(args,long long));
+      else if ( lng )
+        n = snprintf(s,128,spec,va_arg(args,long));
+      else
+        n = snprintf(s,128,spec,va_arg(args,int));
+    }
+    if ( n > 0 )  wb->pos += n < 128 ? n : 127;
+  }
+  va_end(args);
+}
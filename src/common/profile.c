@@ -0,0 +1,265 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/profile.c
+ * \brief Hierarchical profiler (nested timers and counters).
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The timers form a tree (phase, stage, sweep, operator): a timer started
+ * while another one is running is accumulated in a child of the running one.
+ * A timer left open by an early return is stopped with its parent. The
+ * profile is saved in JSON format.
+ *
+ */
+
+#include "mmg.h"
+
+/** Names of the timers (see \ref _MMG5_PT) */
+static const char *_MMG5_profTimer[_MMG5_PT_NB] = {
+  "run","input","analysis","remeshing","output","levelSet",
+  "geometricMesh","computationalMesh","adaptation","optimization",
+  "defsiz","gradsiz","anatets","anatetv","coltet","splitCollapse",
+  "adpspl","adpcol","swpmsh","swptet","movtet","hashTetra",
+  "cavity","delone","coquil","bezier"
+};
+
+/** Names of the counters (see \ref _MMG5_PC) */
+static const char *_MMG5_profCounter[_MMG5_PC_NB] = {
+  "split.attempts","split.successes",
+  "collapse.attempts","collapse.successes",
+  "collapse.rejects.fem","collapse.rejects.length",
+  "collapse.rejects.volume","collapse.rejects.quality",
+  "swap.attempts","swap.successes",
+  "move.attempts","move.successes",
+  "cavity.count","cavity.tetra","cavity.max","cavity.corrections",
+  "cavity.rejects",
+  "realloc.points","realloc.tetra","realloc.tables",
+  "hash.inserts","hash.collisions"
+};
+
+/**
+ * \return wall clock time in seconds.
+ */
+static inline double _MMG5_profTime(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return((double)ts.tv_sec + 1.e-9*(double)ts.tv_nsec);
+}
+
+/**
+ * \param prof pointer toward the profiler.
+ * \param id timer to start.
+ *
+ * Start timer \a id as a child of the running timer.
+ *
+ */
+void _MMG5_profIn(_MMG5_Prof *prof,int id) {
+  _MMG5_ProfNode *pn;
+  int             n;
+
+  if ( prof->skip ) {
+    prof->skip++;
+    return;
+  }
+
+  for (n=prof->node[prof->cur].child; n; n=prof->node[n].next)
+    if ( prof->node[n].id == id )  break;
+
+  if ( !n ) {
+    if ( prof->nnode >= _MMG5_PROFNODE ) {
+      prof->skip = 1;
+      return;
+    }
+    n  = prof->nnode++;
+    pn = &prof->node[n];
+    pn->id     = id;
+    pn->parent = prof->cur;
+    pn->next   = prof->node[prof->cur].child;
+    prof->node[prof->cur].child = n;
+  }
+  pn = &prof->node[n];
+  pn->call++;
+  pn->tini  = _MMG5_profTime();
+  prof->cur = n;
+}
+
+/**
+ * \param prof pointer toward the profiler.
+ * \param id timer to stop.
+ *
+ * Stop timer \a id and the timers left open below it.
+ *
+ */
+void _MMG5_profOut(_MMG5_Prof *prof,int id) {
+  _MMG5_ProfNode *pn;
+  double          t;
+  int             n;
+
+  if ( prof->skip ) {
+    prof->skip--;
+    return;
+  }
+
+  /* nothing to do if the timer is not running */
+  for (n=prof->cur; n; n=prof->node[n].parent)
+    if ( prof->node[n].id == id )  break;
+  if ( !n )  return;
+
+  t = _MMG5_profTime();
+  do {
+    pn = &prof->node[prof->cur];
+    pn->time += t - pn->tini;
+    prof->cur = pn->parent;
+  }
+  while ( pn != &prof->node[n] );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Allocate the profiler and start the root timer.
+ *
+ */
+int _MMG5_profNew(MMG5_pMesh mesh) {
+
+  _MMG5_ADD_MEM(mesh,sizeof(_MMG5_Prof),"profiler",return(0));
+  _MMG5_SAFE_CALLOC(mesh->prof,1,_MMG5_Prof);
+
+  mesh->prof->nnode = 1;
+  mesh->prof->node[0].id   = _MMG5_PT_root;
+  mesh->prof->node[0].call = 1;
+  mesh->prof->node[0].tini = _MMG5_profTime();
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Free the profiler.
+ *
+ */
+void _MMG5_profFree(MMG5_pMesh mesh) {
+
+  if ( !mesh->prof )  return;
+  _MMG5_DEL_MEM(mesh,mesh->prof,sizeof(_MMG5_Prof));
+}
+
+/**
+ * \param prof pointer toward the profiler.
+ * \param inm pointer toward the output file.
+ * \param n node to write.
+ * \param lev depth of the node (for the indentation).
+ *
+ * Write the subtree of node \a n.
+ *
+ */
+static void _MMG5_profSaveNode(_MMG5_Prof *prof,FILE *inm,int n,int lev) {
+  _MMG5_ProfNode *pn;
+  int             c,k,nc,*lc;
+
+  pn = &prof->node[n];
+  fprintf(inm,"%*s{ \"name\": \"%s\", \"calls\": %ld, \"time\": %.6f",
+          2*lev,"",_MMG5_profTimer[pn->id],pn->call,pn->time);
+
+  if ( !pn->child ) {
+    fprintf(inm," }");
+    return;
+  }
+
+  /* the children are stored in reverse order of creation */
+  nc = 0;
+  for (c=pn->child; c; c=prof->node[c].next)  nc++;
+  lc = (int*)malloc(nc*sizeof(int));
+  if ( !lc ) {
+    fprintf(inm," }");
+    return;
+  }
+  k = nc;
+  for (c=pn->child; c; c=prof->node[c].next)  lc[--k] = c;
+
+  fprintf(inm,",\n%*s  \"children\": [\n",2*lev,"");
+  for (c=0; c<nc; c++) {
+    _MMG5_profSaveNode(prof,inm,lc[c],lev+2);
+    fprintf(inm,"%s\n",c < nc-1 ? "," : "");
+  }
+  fprintf(inm,"%*s  ] }",2*lev,"");
+  free(lc);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param filename name of the file.
+ * \return 1 if success, 0 if fail.
+ *
+ * Stop the running timers and save the profile (tree of timers and
+ * counters) in JSON format.
+ *
+ */
+int _MMG5_profSave(MMG5_pMesh mesh,char *filename) {
+  _MMG5_Prof     *prof;
+  _MMG5_ProfNode *pn;
+  FILE           *inm;
+  double          t;
+  int             k;
+
+  prof = mesh->prof;
+  if ( !prof )  return(0);
+
+  /* stop the running timers, the root included */
+  t = _MMG5_profTime();
+  while ( prof->cur ) {
+    pn = &prof->node[prof->cur];
+    pn->time += t - pn->tini;
+    prof->cur = pn->parent;
+  }
+  prof->skip = 0;
+  prof->node[0].time = t - prof->node[0].tini;
+
+  if ( !(inm = fopen(filename,"w")) ) {
+    fprintf(stderr,"  ** UNABLE TO OPEN %s.\n",filename);
+    return(0);
+  }
+  fprintf(inm,"{\n");
+  fprintf(inm,"  \"version\": \"%s\",\n",MG_VER);
+  fprintf(inm,"  \"np\": %d,\n",mesh->np);
+  fprintf(inm,"  \"ne\": %d,\n",mesh->ne);
+  fprintf(inm,"  \"timers\":\n");
+  _MMG5_profSaveNode(prof,inm,0,2);
+  fprintf(inm,",\n  \"counters\": {\n");
+  for (k=0; k<_MMG5_PC_NB; k++)
+    fprintf(inm,"    \"%s\": %ld%s\n",_MMG5_profCounter[k],prof->cnt[k],
+            k < _MMG5_PC_NB-1 ? "," : "");
+  fprintf(inm,"  }\n}\n");
+  fclose(inm);
+
+  if ( mesh->info.imprim )
+    fprintf(stdout,"  %%%% %s OPENED\n",filename);
+  return(1);
+}
@@ -0,0 +1,154 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+/** Maximal number of nodes of the tree of timers */
+#define _MMG5_PROFNODE  256
+
+/**
+ * \enum _MMG5_PT
+ * \brief Timers of the profiler (phases, stages, sweeps and operators).
+ *
+ * The same timer may appear at several places of the tree: its time is
+ * accumulated separately under each parent.
+ *
+ */
+enum _MMG5_PT {
+  _MMG5_PT_root,          /*!< Whole profiled run */
+  _MMG5_PT_input,         /*!< Data reading */
+  _MMG5_PT_analysis,      /*!< Phase 1: scaling and analysis */
+  _MMG5_PT_remeshing,     /*!< Phase 2: mesh adaptation */
+  _MMG5_PT_output,        /*!< Mesh packing and writing */
+  _MMG5_PT_levelSet,      /*!< Discretization of the level-set */
+  _MMG5_PT_geometricMesh, /*!< Stage 1: geometric mesh */
+  _MMG5_PT_computMesh,    /*!< Stage 2: computational mesh */
+  _MMG5_PT_adaptation,    /*!< Stage 3: split/collapse iterations */
+  _MMG5_PT_optimization,  /*!< Stage 4: swaps and moves */
+  _MMG5_PT_defsiz,        /*!< Definition of the metric */
+  _MMG5_PT_gradsiz,       /*!< Gradation of the metric */
+  _MMG5_PT_anatets,       /*!< Split of the surface tetrahedra */
+  _MMG5_PT_anatetv,       /*!< Split of the volume tetrahedra */
+  _MMG5_PT_coltet,        /*!< Collapse of the short edges */
+  _MMG5_PT_splcol,        /*!< Delaunay split/collapse sweep */
+  _MMG5_PT_adpspl,        /*!< Pattern split sweep */
+  _MMG5_PT_adpcol,        /*!< Pattern collapse sweep */
+  _MMG5_PT_swpmsh,        /*!< Boundary edge swaps */
+  _MMG5_PT_swptet,        /*!< Internal edge swaps */
+  _MMG5_PT_movtet,        /*!< Vertex relocation */
+  _MMG5_PT_hashTetra,     /*!< Adjacency build */
+  _MMG5_PT_cavity,        /*!< Delaunay cavity */
+  _MMG5_PT_delone,        /*!< Delaunay ball */
+  _MMG5_PT_coquil,        /*!< Shell of an edge */
+  _MMG5_PT_bezier,        /*!< Bezier patch of a boundary face (cache miss) */
+  _MMG5_PT_NB
+};
+
+/**
+ * \enum _MMG5_PC
+ * \brief Counters of the profiler.
+ */
+enum _MMG5_PC {
+  _MMG5_PC_splatt,    /*!< Attempted edge splits */
+  _MMG5_PC_splok,     /*!< Performed edge splits */
+  _MMG5_PC_colatt,    /*!< Checked edge collapses */
+  _MMG5_PC_colok,     /*!< Performed edge collapses */
+  _MMG5_PC_colfem,    /*!< Collapses rejected: internal edge between boundaries */
+  _MMG5_PC_collen,    /*!< Collapses rejected: too long edge created */
+  _MMG5_PC_colvol,    /*!< Collapses rejected: null or inverted element */
+  _MMG5_PC_colqua,    /*!< Collapses rejected: quality degradation */
+  _MMG5_PC_swpatt,    /*!< Checked edge swaps */
+  _MMG5_PC_swpok,     /*!< Performed edge swaps */
+  _MMG5_PC_movatt,    /*!< Attempted vertex moves */
+  _MMG5_PC_movok,     /*!< Performed vertex moves */
+  _MMG5_PC_cavnb,     /*!< Delaunay cavities built */
+  _MMG5_PC_cavtet,    /*!< Tetrahedra of the cavities */
+  _MMG5_PC_cavmax,    /*!< Largest cavity */
+  _MMG5_PC_cavcor,    /*!< Tetrahedra removed by the cavity correction */
+  _MMG5_PC_cavrej,    /*!< Rejected cavities */
+  _MMG5_PC_reapt,     /*!< Reallocations of the point table */
+  _MMG5_PC_reatet,    /*!< Reallocations of the tetra table */
+  _MMG5_PC_reatab,    /*!< Reallocations of a table (points and tetra included) */
+  _MMG5_PC_hashins,   /*!< Edges and faces hashed */
+  _MMG5_PC_hashcol,   /*!< Hashed edges and faces whose key is already used */
+  _MMG5_PC_NB
+};
+
+/**
+ * \struct _MMG5_ProfNode
+ * \brief Node of the tree of timers.
+ */
+typedef struct {
+  double  time; /*!< Cumulated time (in seconds) */
+  double  tini; /*!< Starting time of the running call */
+  long    call; /*!< Number of calls */
+  int     id; /*!< Timer (\ref _MMG5_PT) */
+  int     parent; /*!< Parent node */
+  int     child; /*!< First child */
+  int     next; /*!< Next sibling */
+} _MMG5_ProfNode;
+
+/**
+ * \struct _MMG5_Prof
+ * \brief Hierarchical profiler: tree of timers and counters.
+ */
+typedef struct _MMG5_Prof {
+  _MMG5_ProfNode node[_MMG5_PROFNODE]; /*!< Tree of timers (node 0 is the root) */
+  long    cnt[_MMG5_PC_NB]; /*!< Counters */
+  int     nnode; /*!< Number of used nodes */
+  int     cur; /*!< Running node */
+  int     skip; /*!< Depth of the timers ignored because the tree is full */
+} _MMG5_Prof;
+
+/** Start timer id if the profiler is on */
+#define _MMG5_PROF_IN(mesh,id) do {                     \
+    if ( (mesh)->prof )  _MMG5_profIn((mesh)->prof,id); \
+  } while(0)
+
+/** Stop timer id if the profiler is on */
+#define _MMG5_PROF_OUT(mesh,id) do {                      \
+    if ( (mesh)->prof )  _MMG5_profOut((mesh)->prof,id);  \
+  } while(0)
+
+/** Increment counter c if the profiler is on */
+#define _MMG5_PROF_INC(mesh,c) do {                 \
+    if ( (mesh)->prof )  (mesh)->prof->cnt[c]++;    \
+  } while(0)
+
+/** Add n to counter c if the profiler is on */
+#define _MMG5_PROF_ADD(mesh,c,n) do {               \
+    if ( (mesh)->prof )  (mesh)->prof->cnt[c] += (n); \
+  } while(0)
+
+/** Store n in counter c if it is larger, if the profiler is on */
+#define _MMG5_PROF_MAX(mesh,c,n) do {                                 \
+    if ( (mesh)->prof && (n) > (mesh)->prof->cnt[c] )                 \
+      (mesh)->prof->cnt[c] = (n);                                     \
+  } while(0)
+
+/* prototypes */
+void   _MMG5_profIn(_MMG5_Prof *prof,int id);
+void   _MMG5_profOut(_MMG5_Prof *prof,int id);
+
+#endif
@@ -76,33 +76,20 @@ int _MMG5_boundingBox(MMG5_pMesh mesh) {
 
 /**
  * \param mesh pointer toward the mesh structure.
- * \param met pointer toward the metric or solution structure.
- * \return 1 if success, 0 if fail (computed bounding box too small).
+ * \return 1.
  *
- * Scale the mesh and the size informations between 0 and 1.
+ * Scale the global and local size parameters (hmin, hmax, hausd) with the
+ * bounding box of the mesh (stored in \a info.delta). Undefined global
+ * sizes are set to their default values.
  *
  */
-int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
-  MMG5_pPoint    ppt;
-  double         dd,d1;
-  int            k,sethmin,sethmax;
-  MMG5_pPar      par;
+int _MMG5_scalePar(MMG5_pMesh mesh) {
+  MMG5_pPar    par;
+  double       dd;
+  int          k,sethmin,sethmax;
 
-
-  /* compute bounding box */
-  if ( ! _MMG5_boundingBox(mesh) ) return(0);
-
-  /* normalize coordinates */
   dd = 1.0 / mesh->info.delta;
-  for (k=1; k<=mesh->np; k++) {
-    ppt = &mesh->point[k];
-    if ( !MG_VOK(ppt) )  continue;
-    ppt->c[0] = dd * (ppt->c[0] - mesh->info.min[0]);
-    ppt->c[1] = dd * (ppt->c[1] - mesh->info.min[1]);
-    ppt->c[2] = dd * (ppt->c[2] - mesh->info.min[2]);
-  }
 
-  /* normalize values */
   sethmin = 0;
   sethmax = 0;
   if ( mesh->info.hmin > 0. ) {
@@ -130,14 +117,58 @@ int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
       mesh->info.hmin = 0.01 * mesh->info.hmax;
   }
 
-
   mesh->info.hausd *= dd;
 
+  /* normalize local parameters */
+  for (k=0; k<mesh->info.npar; k++) {
+    par = &mesh->info.par[k];
+    par->hmin  *= dd;
+    par->hmax  *= dd;
+    par->hausd *= dd;
+  }
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric or solution structure.
+ * \return 1 if success, 0 if fail (computed bounding box too small).
+ *
+ * Scale the mesh and the size informations between 0 and 1.
+ *
+ */
+int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pPoint    ppt;
+  double         dd,d1;
+  int            k;
+
+
+  /* compute bounding box */
+  if ( ! _MMG5_boundingBox(mesh) ) return(0);
+
+  /* normalize coordinates */
+  dd = 1.0 / mesh->info.delta;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) )  continue;
+    ppt->c[0] = dd * (ppt->c[0] - mesh->info.min[0]);
+    ppt->c[1] = dd * (ppt->c[1] - mesh->info.min[1]);
+    ppt->c[2] = dd * (ppt->c[2] - mesh->info.min[2]);
+  }
+
+  /* normalize the size parameters */
+  if ( !_MMG5_scalePar(mesh) )  return(0);
+
   /* normalize sizes */
   if ( met->m ) {
     if ( met->size == 1 ) {
       for (k=1; k<=mesh->np; k++)    met->m[k] *= dd;
     }
+    else if ( mesh->info.iso ) {
+      /* several level-set functions */
+      for (k=met->size; k<met->size*(mesh->np+1); k++)  met->m[k] *= dd;
+    }
     else if ( met->size==3 ){
       for (k=1; k<=mesh->np; k++) {
         met->m[3*(k-1)+1] *= dd;
@@ -146,18 +177,10 @@ int _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
       }
     } else { //met->size==6
       d1 = 1.0 / (dd*dd);
-      for (k=1; k<=6*mesh->np; k++)  met->m[k] *= d1;
+      for (k=7; k<=6*(mesh->np+1); k++)  met->m[k] *= d1;
     }
   }
 
-  /* normalize local parameters */
-  for (k=0; k<mesh->info.npar; k++) {
-    par = &mesh->info.par[k];
-    par->hmin  *= dd;
-    par->hmax  *= dd;
-    par->hausd *= dd;
-  }
-
   return(1);
 }
 
@@ -131,6 +131,16 @@ void _MMG5_Init_parameters(MMG5_pMesh mesh) {
   mesh->info.noswap   =  0;  /* [0/1]    ,avoid/allow edge or face flipping */
   /** MMG5_IPARAM_nomove = 0 */
   mesh->info.nomove   =  0;  /* [0/1]    ,avoid/allow point relocation */
+  /** MMG5_IPARAM_warmStart = 0 */
+  mesh->info.warm     =  0;  /* [0/1]    ,keep/free the topology between calls */
+  /** MMG5_IPARAM_lsband = 0 */
+  mesh->info.lsband   =  0;  /* [n/0]    ,narrow band of n layers/whole mesh in level-set mode */
+  /** MMG5_IPARAM_hessian = 0 */
+  mesh->info.hess     =  0;  /* [0/1/6]  ,solution used as is/metric from its Hessian */
+  /** MMG5_IPARAM_nelem = 0 */
+  mesh->info.nelem    =  0;  /* [n/0]    ,target number of elements */
+  /** MMG5_IPARAM_nosignal = 0 */
+  mesh->info.nosignal =  0;  /* [0/1]    ,install/don't install the signal handlers */
 #ifdef USE_SCOTCH
   mesh->info.renum    = 1;   /* [1/0]    , Turn on/off the renumbering using SCOTCH; */
 #else
@@ -139,6 +149,8 @@ void _MMG5_Init_parameters(MMG5_pMesh mesh) {
 
   /* default values for doubles */
   mesh->info.ls       = 0.0;      /* level set value */
+  mesh->info.herr     = 0.01;     /* interpolation error of the Hessian metric */
+  mesh->info.tmax     = 0.0;      /* wall-clock time budget (no limit) */
 
 
 #ifndef PATTERN
@@ -167,21 +179,24 @@ int MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int
     fprintf(stdout,"  ## Error: MMG3D5 need a solution imposed on vertices\n");
     return(0);
   }
-  if ( typSol != MMG5_Scalar ) {
-    fprintf(stdout,"  ## Error: anisotropic adaptation not yet implemented\n");
+  if ( typSol == MMG5_Scalar )
+    sol->size = 1;
+  else if ( typSol == MMG5_Tensor )
+    sol->size = 6;
+  else {
+    fprintf(stdout,"  ## Error: MMG3D5 need a scalar or tensorial solution\n");
     return(0);
   }
-  else sol->size = 1;
 
   sol->dim = 3;
   if ( np ) {
     sol->np  = np;
     sol->npi = np;
     if ( sol->m )
-      _MMG5_DEL_MEM(mesh,sol->m,(sol->size*sol->npmax+1)*sizeof(double));
+      _MMG5_DEL_MEM(mesh,sol->m,(sol->size*(sol->npmax+1)+1)*sizeof(double));
 
     sol->npmax = mesh->npmax;
-    _MMG5_ADD_MEM(mesh,(sol->size*sol->npmax+1)*sizeof(double),"initial solution",
+    _MMG5_ADD_MEM(mesh,(sol->size*(sol->npmax+1)+1)*sizeof(double),"initial solution",
                   printf("  Exit program.\n");
                   exit(EXIT_FAILURE));
     _MMG5_SAFE_CALLOC(sol->m,(sol->npmax*sol->size+1),double);
@@ -203,7 +218,6 @@ int MMG5_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int
  *
  */
 int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
-  int k;
 
   if ( ( (mesh->info.imprim > 5) || mesh->info.ddebug ) &&
        ( mesh->point || mesh->tria || mesh->tetra || mesh->edge) )
@@ -227,6 +241,18 @@ int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
   if ( mesh->edge )
     _MMG5_DEL_MEM(mesh,mesh->edge,(mesh->na+1)*sizeof(MMG5_Edge));
 
+  /* the topology kept for a warm start is no more valid */
+  if ( mesh->info.restart == 2 ) {
+    if ( mesh->adja )
+      _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+    if ( mesh->xtetra )
+      _MMG5_DEL_MEM(mesh,mesh->xtetra,(mesh->xtmax+1)*sizeof(MMG5_xTetra));
+    if ( mesh->xpoint )
+      _MMG5_DEL_MEM(mesh,mesh->xpoint,(mesh->xpmax+1)*sizeof(MMG5_xPoint));
+    mesh->xt = mesh->xtnil = mesh->xp = mesh->xpnil = 0;
+    mesh->info.restart = 0;
+  }
+
   /*tester si -m definie : renvoie 0 si pas ok et met la taille min dans info.mem */
   if( mesh->info.mem > 0) {
     if((mesh->npmax < mesh->np || mesh->ntmax < mesh->nt || mesh->nemax < mesh->ne)) {
@@ -279,12 +305,8 @@ int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
   /* keep track of empty links */
   mesh->npnil = mesh->np + 1;
   mesh->nenil = mesh->ne + 1;
-  for (k=mesh->npnil; k<mesh->npmax-1; k++) {
-    mesh->point[k].tmp  = k+1;
-  }
-  for (k=mesh->nenil; k<mesh->nemax-1; k++) {
-    mesh->tetra[k].v[3] = k+1;
-  }
+  mesh->nplnk = mesh->npnil;
+  mesh->nelnk = mesh->nenil;
 
   /* stats */
   if ( abs(mesh->info.imprim) > 6 ) {
@@ -314,7 +336,7 @@ int MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na) {
 int MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, int* np, int* typSol) {
 
   *typEntity = MMG5_Vertex;
-  *typSol    = sol->size;
+  *typSol    = ( sol->size == 6 ) ? MMG5_Tensor : MMG5_Scalar;
 
   assert(sol->np = mesh->np);
 
@@ -452,51 +474,134 @@ int MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* re
 
 /**
  * \param mesh pointer toward the mesh structure.
- * \param v0 first vertex of tetrahedron.
- * \param v1 second vertex of tetrahedron.
- * \param v2 third vertex of tetrahedron.
- * \param v3 fourth vertex of tetrahedron.
- * \param ref tetrahedron reference.
- * \param pos tetrahedron position in the mesh.
+ * \param vertices table of the points coordinates: the coordinates of the
+ * i-th point are stored in vertices[3*(i-1)]
+ * to vertices[3*(i-1)+2].
+ * \param refs table of the points references (may be NULL): the reference of
+ * the i-th point is stored in refs[i-1].
  * \return 0 if failed, 1 otherwise.
  *
- * Set tetrahedra of vertices \a v0, \a v1,\a v2,\a v3 and reference
- * \a ref at position \a pos in mesh structure.
+ * Set the coordinates and the references of all the vertices of the mesh.
  *
  */
-int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int ref, int pos) {
-  MMG5_pTetra pt;
+int MMG5_Set_vertices(MMG5_pMesh mesh, double *vertices, int *refs) {
   MMG5_pPoint ppt;
-  double aux, vol;
-  int    j, ip;
+  double      *c;
+  int         k;
 
-  if ( !mesh->ne ) {
-    fprintf(stdout,"  ## Error: You must set the number of elements with the");
-    fprintf(stdout," MMG5_Set_meshSize function before setting elements in mesh\n");
+  if ( !mesh->np ) {
+    fprintf(stdout,"  ## Error: You must set the number of points with the");
+    fprintf(stdout," MMG5_Set_meshSize function before setting vertices in mesh\n");
     return(0);
   }
 
-  if ( pos > mesh->nemax ) {
-    fprintf(stdout,"  ## Error: unable to allocate a new element.\n");
-    fprintf(stdout,"    max number of element: %d\n",mesh->nemax);
-    _MMG5_INCREASE_MEM_MESSAGE();
-    return(0);
+  for ( k=1; k<=mesh->np; k++ ) {
+    ppt  = &mesh->point[k];
+    c    = &vertices[3*(k-1)];
+    ppt->c[0] = c[0];
+    ppt->c[1] = c[1];
+    ppt->c[2] = c[2];
+    ppt->ref  = refs ? refs[k-1] : 0;
+    ppt->tag  = MG_NUL;
+    ppt->flag = 0;
+    ppt->tmp  = 0;
   }
 
-  if ( pos > mesh->ne ) {
-    fprintf(stdout,"  ## Error: attempt to set new tetrahedron at position %d.",pos);
-    fprintf(stdout," Overflow of the given number of tetrahedron: %d\n",mesh->ne);
-    fprintf(stdout,"  ## Check the mesh size, its compactness or the position");
-    fprintf(stdout," of the tetrahedron.\n");
-    return(0);
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices table of the points coordinates (of size at least
+ * 3*np): the coordinates of the i-th point are stored in
+ * vertices[3*(i-1)]
+ * to vertices[3*(i-1)+2].
+ * \param refs table of the points references (may be NULL).
+ * \param areCorners table of the flags saying if points are corners (may be
+ * NULL).
+ * \param areRequired table of the flags saying if points are required (may be
+ * NULL).
+ * \return 1.
+ *
+ * Get the coordinates, the references and the tags of all the vertices of the
+ * mesh.
+ *
+ */
+int MMG5_Get_vertices(MMG5_pMesh mesh, double* vertices, int* refs,
+                      int* areCorners, int* areRequired) {
+  MMG5_pPoint ppt;
+  double      *c;
+  int         k;
+
+  for ( k=1; k<=mesh->np; k++ ) {
+    ppt  = &mesh->point[k];
+    c    = &vertices[3*(k-1)];
+    c[0] = ppt->c[0];
+    c[1] = ppt->c[1];
+    c[2] = ppt->c[2];
+    if ( refs != NULL )
+      refs[k-1] = ppt->ref;
+    if ( areCorners != NULL )
+      areCorners[k-1] = ppt->tag & MG_CRN ? 1 : 0;
+    if ( areRequired != NULL )
+      areRequired[k-1] = ppt->tag & MG_REQ ? 1 : 0;
   }
+  mesh->npi = mesh->np;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param displ table of the points displacements (of size at least 3*np):
+ * the displacement of the i-th point is stored in displ[3*(i-1)] to
+ * displ[3*(i-1)+2].
+ * \return 1.
+ *
+ * Move the vertices of the mesh without modifying their references and
+ * tags. If the topology of the previous remeshing has been kept (see \ref
+ * MMG5_IPARAM_warmStart), the moved vertices are marked so that the next call
+ * of the library updates the geometry around them only.
+ *
+ */
+int MMG5_Move_vertices(MMG5_pMesh mesh, double *displ) {
+  MMG5_pPoint ppt;
+  double      *d;
+  int         k;
+
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) )  continue;
+
+    d = &displ[3*(k-1)];
+    if ( d[0] == 0. && d[1] == 0. && d[2] == 0. )  continue;
+
+    ppt->c[0] += d[0];
+    ppt->c[1] += d[1];
+    ppt->c[2] += d[2];
+    if ( mesh->info.restart == 2 )  ppt->tmp = 1;
+  }
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pos tetrahedron position in the mesh.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Unmark the vertices of the tetrahedron \a pos, reorient it if needed and
+ * compute its quality.
+ *
+ */
+static inline
+int _MMG5_initTetra(MMG5_pMesh mesh, int pos) {
+  MMG5_pTetra pt;
+  MMG5_pPoint ppt;
+  double aux, vol;
+  int    j, ip;
 
   pt = &mesh->tetra[pos];
-  pt->v[0] = v0;
-  pt->v[1] = v1;
-  pt->v[2] = v2;
-  pt->v[3] = v3;
-  pt->ref  = ref;
 
   mesh->point[pt->v[0]].tag &= ~MG_NUL;
   mesh->point[pt->v[1]].tag &= ~MG_NUL;
@@ -528,11 +633,59 @@ int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int re
     mesh->xt++;
   }
 
-  pt->qual = _MMG5_orcal(mesh,pos);
+  pt->qual = _MMG5_orcal(mesh,NULL,pos);
 
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param v0 first vertex of tetrahedron.
+ * \param v1 second vertex of tetrahedron.
+ * \param v2 third vertex of tetrahedron.
+ * \param v3 fourth vertex of tetrahedron.
+ * \param ref tetrahedron reference.
+ * \param pos tetrahedron position in the mesh.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set tetrahedra of vertices \a v0, \a v1,\a v2,\a v3 and reference
+ * \a ref at position \a pos in mesh structure.
+ *
+ */
+int MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1, int v2, int v3, int ref, int pos) {
+  MMG5_pTetra pt;
+
+  if ( !mesh->ne ) {
+    fprintf(stdout,"  ## Error: You must set the number of elements with the");
+    fprintf(stdout," MMG5_Set_meshSize function before setting elements in mesh\n");
+    return(0);
+  }
+
+  if ( pos > mesh->nemax ) {
+    fprintf(stdout,"  ## Error: unable to allocate a new element.\n");
+    fprintf(stdout,"    max number of element: %d\n",mesh->nemax);
+    _MMG5_INCREASE_MEM_MESSAGE();
+    return(0);
+  }
+
+  if ( pos > mesh->ne ) {
+    fprintf(stdout,"  ## Error: attempt to set new tetrahedron at position %d.",pos);
+    fprintf(stdout," Overflow of the given number of tetrahedron: %d\n",mesh->ne);
+    fprintf(stdout,"  ## Check the mesh size, its compactness or the position");
+    fprintf(stdout," of the tetrahedron.\n");
+    return(0);
+  }
+
+  pt = &mesh->tetra[pos];
+  pt->v[0] = v0;
+  pt->v[1] = v1;
+  pt->v[2] = v2;
+  pt->v[3] = v3;
+  pt->ref  = ref;
+
+  return(_MMG5_initTetra(mesh,pos));
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 pointer toward the first vertex of tetrahedron.
@@ -577,6 +730,78 @@ int MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra table of the tetrahedra vertices: the vertices of the
+ * i-th tetrahedron are stored in tetra[4*(i-1)] to
+ * tetra[4*(i-1)+3].
+ * \param refs table of the tetrahedra references (may be NULL): the
+ * reference of the i-th tetrahedron is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the vertices and the references of all the tetrahedra of the mesh.
+ *
+ */
+int MMG5_Set_tetrahedra(MMG5_pMesh mesh, int *tetra, int *refs) {
+  MMG5_pTetra pt;
+  int         *v,k;
+
+  if ( !mesh->ne ) {
+    fprintf(stdout,"  ## Error: You must set the number of elements with the");
+    fprintf(stdout," MMG5_Set_meshSize function before setting elements in mesh\n");
+    return(0);
+  }
+
+  for ( k=1; k<=mesh->ne; k++ ) {
+    pt = &mesh->tetra[k];
+    v  = &tetra[4*(k-1)];
+    pt->v[0] = v[0];
+    pt->v[1] = v[1];
+    pt->v[2] = v[2];
+    pt->v[3] = v[3];
+    pt->ref  = refs ? refs[k-1] : 0;
+
+    if ( !_MMG5_initTetra(mesh,k) )  return(0);
+  }
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra table of the tetrahedra vertices (of size at least 4*ne): the
+ * vertices of the i-th tetrahedron are stored in tetra[4*(i-1)] to
+ * tetra[4*(i-1)+3].
+ * \param refs table of the tetrahedra references (may be NULL).
+ * \param areRequired table of the flags saying if tetrahedra are required (may
+ * be NULL).
+ * \return 1.
+ *
+ * Get the vertices, the references and the tags of all the tetrahedra of the
+ * mesh.
+ *
+ */
+int MMG5_Get_tetrahedra(MMG5_pMesh mesh, int* tetra, int* refs, int* areRequired) {
+  MMG5_pTetra pt;
+  int         *v,k;
+
+  for ( k=1; k<=mesh->ne; k++ ) {
+    pt   = &mesh->tetra[k];
+    v    = &tetra[4*(k-1)];
+    v[0] = pt->v[0];
+    v[1] = pt->v[1];
+    v[2] = pt->v[2];
+    v[3] = pt->v[3];
+    if ( refs != NULL )
+      refs[k-1] = pt->ref;
+    if ( areRequired != NULL )
+      areRequired[k-1] = pt->tag & MG_REQ ? 1 : 0;
+  }
+  mesh->nei = mesh->ne;
+
+  return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of triangle.
@@ -899,6 +1124,290 @@ int MMG5_Get_scalarSol(MMG5_pSol met, double* s) {
 }
 
 
+/**
+ * \param met pointer toward the sol structure.
+ * \param s table of the scalar solutions: the solution at the i-th
+ * vertex is stored in s[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the scalar values of the solution at all the vertices of the mesh.
+ *
+ */
+int MMG5_Set_scalarSols(MMG5_pSol met, double *s) {
+
+  if ( !met->np || met->size != 1 ) {
+    fprintf(stdout,"  ## Error: You must set the number and the type of the");
+    fprintf(stdout," solution with the MMG5_Set_solSize function before");
+    fprintf(stdout," setting scalar values in solution structure \n");
+    return(0);
+  }
+
+  memcpy(&met->m[1],s,met->np*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param met pointer toward the sol structure.
+ * \param s table of the scalar solutions (of size at least np).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get the scalar values of the solution at all the vertices of the mesh.
+ *
+ */
+int MMG5_Get_scalarSols(MMG5_pSol met, double* s) {
+
+  if ( met->size != 1 ) {
+    fprintf(stdout,"  ## Error: the solution is not scalar.\n");
+    return(0);
+  }
+
+  memcpy(s,&met->m[1],met->np*sizeof(double));
+  met->npi = met->np;
+
+  return(1);
+}
+
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 value of the tensorial solution at position (1,1) in the tensor.
+ * \param m12 value of the tensorial solution at position (1,2) in the tensor.
+ * \param m13 value of the tensorial solution at position (1,3) in the tensor.
+ * \param m22 value of the tensorial solution at position (2,2) in the tensor.
+ * \param m23 value of the tensorial solution at position (2,3) in the tensor.
+ * \param m33 value of the tensorial solution at position (3,3) in the tensor.
+ * \param pos position of the solution in the mesh (begin to 1).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set tensorial values at position \a pos in solution structure.
+ *
+ */
+int MMG5_Set_tensorSol(MMG5_pSol met, double m11,double m12,double m13,
+                       double m22,double m23,double m33,int pos) {
+  double *m;
+
+  if ( !met->np || met->size != 6 ) {
+    fprintf(stdout,"  ## Error: You must set the number and the type of the");
+    fprintf(stdout," solution with the MMG5_Set_solSize function before");
+    fprintf(stdout," setting tensorial values in solution structure \n");
+    return(0);
+  }
+
+  if ( pos >= met->npmax ) {
+    fprintf(stdout,"  ## Error: unable to set a new solution.\n");
+    fprintf(stdout,"    max number of solutions: %d\n",met->npmax);
+    return(0);
+  }
+
+  if ( pos > met->np ) {
+    fprintf(stdout,"  ## Error: attempt to set new solution at position %d.",pos);
+    fprintf(stdout," Overflow of the given number of solutions: %d\n",met->np);
+    fprintf(stdout,"  ## Check the solution size, its compactness or the position");
+    fprintf(stdout," of the solution.\n");
+    return(0);
+  }
+
+  m    = &met->m[6*pos+1];
+  m[0] = m11;
+  m[1] = m12;
+  m[2] = m13;
+  m[3] = m22;
+  m[4] = m23;
+  m[5] = m33;
+  return(1);
+}
+
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 pointer toward the position (1,1) in the solution tensor.
+ * \param m12 pointer toward the position (1,2) in the solution tensor.
+ * \param m13 pointer toward the position (1,3) in the solution tensor.
+ * \param m22 pointer toward the position (2,2) in the solution tensor.
+ * \param m23 pointer toward the position (2,3) in the solution tensor.
+ * \param m33 pointer toward the position (3,3) in the solution tensor.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get tensorial solution of next vertex of mesh.
+ *
+ */
+int MMG5_Get_tensorSol(MMG5_pSol met, double *m11,double *m12,double *m13,
+                       double *m22,double *m23,double *m33) {
+  double *m;
+
+  met->npi++;
+
+  if ( met->npi > met->np || met->size != 6 ) {
+    fprintf(stdout,"  ## Error: unable to get solution.\n");
+    fprintf(stdout,"     The number of call of MMG5_Get_tensorSol function");
+    fprintf(stdout," can not exceed the number of points: %d\n ",met->np);
+    return(0);
+  }
+
+  m    = &met->m[6*met->npi+1];
+  *m11 = m[0];
+  *m12 = m[1];
+  *m13 = m[2];
+  *m22 = m[3];
+  *m23 = m[4];
+  *m33 = m[5];
+
+  return(1);
+}
+
+/**
+ * \param met pointer toward the sol structure.
+ * \param m table of the tensorial solutions: the solution at the i-th
+ * vertex is stored in m[6*(i-1)],...,m[6*(i-1)+5] as m11,m12,m13,m22,m23,m33.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the tensorial values of the solution at all the vertices of the mesh.
+ *
+ */
+int MMG5_Set_tensorSols(MMG5_pSol met, double *m) {
+
+  if ( !met->np || met->size != 6 ) {
+    fprintf(stdout,"  ## Error: You must set the number and the type of the");
+    fprintf(stdout," solution with the MMG5_Set_solSize function before");
+    fprintf(stdout," setting tensorial values in solution structure \n");
+    return(0);
+  }
+
+  memcpy(&met->m[7],m,6*met->np*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param met pointer toward the sol structure.
+ * \param m table of the tensorial solutions (of size at least 6*np).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get the tensorial values of the solution at all the vertices of the mesh.
+ *
+ */
+int MMG5_Get_tensorSols(MMG5_pSol met, double *m) {
+
+  if ( met->size != 6 ) {
+    fprintf(stdout,"  ## Error: the solution is not tensorial.\n");
+    return(0);
+  }
+
+  memcpy(m,&met->m[7],6*met->np*sizeof(double));
+  met->npi = met->np;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param s table of the scalar solutions, allocated with \a malloc: the
+ * solution at the i-th vertex is stored in s[i] (s[0] is unused).
+ * \param siz number of doubles allocated in \a s.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give the solution table \a s to the sol structure without copying it (the
+ * solution size must have been set by \ref MMG5_Set_solSize). The library
+ * takes the ownership of \a s: it may reallocate it (if it is smaller than
+ * the maximal number of points) and it will be freed by \ref
+ * MMG5_Free_structures. The caller must not use or free \a s afterwards.
+ *
+ */
+int MMG5_Set_scalarSolsBuffer(MMG5_pMesh mesh, MMG5_pSol met, double *s, int siz) {
+
+  if ( !met->np || met->size != 1 ) {
+    fprintf(stdout,"  ## Error: You must set the number and the type of the");
+    fprintf(stdout," solution with the MMG5_Set_solSize function before");
+    fprintf(stdout," giving the scalar solution table \n");
+    return(0);
+  }
+
+  if ( siz < met->np+1 ) {
+    fprintf(stdout,"  ## Error: solution table too small (%d doubles).",siz);
+    fprintf(stdout," At least %d doubles are needed.\n",met->np+1);
+    return(0);
+  }
+
+  if ( met->m )
+    _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
+
+  _MMG5_ADD_MEM(mesh,(met->size*(met->npmax+1)+1)*sizeof(double),"initial solution",
+                return(0));
+  met->m = s;
+  if ( siz < met->size*(met->npmax+1)+1 ) {
+    _MMG5_SAFE_REALLOC(met->m,met->size*(met->npmax+1)+1,double,"initial solution");
+    memset(&met->m[siz],0,(met->size*(met->npmax+1)+1-siz)*sizeof(double));
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param nls number of level-set functions (at most 8).
+ * \param ls table of the values of the functions: the value of the j-th
+ * function at the i-th vertex is stored in ls[nls*(i-1)+j].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set several level-set functions at the vertices of the mesh, to discretize
+ * them together in level-set mode. The ref of a resulting domain is 1 + sum_j
+ * 2^j s_j, with s_j equal to 1 if the j-th function is positive in the domain
+ * and to 0 otherwise.
+ *
+ */
+int MMG5_Set_levelSets(MMG5_pMesh mesh, MMG5_pSol sol, int nls, double *ls) {
+
+  if ( !mesh->np ) {
+    fprintf(stdout,"  ## Error: You must set the mesh size with the");
+    fprintf(stdout," MMG5_Set_meshSize function before setting the");
+    fprintf(stdout," level-set functions\n");
+    return(0);
+  }
+  if ( nls < 1 || nls > _MMG5_LSMAX ) {
+    fprintf(stdout,"  ## Error: wrong number of level-set functions (%d).",nls);
+    fprintf(stdout," It must be between 1 and %d.\n",_MMG5_LSMAX);
+    return(0);
+  }
+
+  if ( sol->m )
+    _MMG5_DEL_MEM(mesh,sol->m,(sol->size*(sol->npmax+1)+1)*sizeof(double));
+
+  sol->dim   = 3;
+  sol->size  = nls;
+  sol->np    = mesh->np;
+  sol->npi   = mesh->np;
+  sol->npmax = mesh->npmax;
+  _MMG5_ADD_MEM(mesh,(sol->size*(sol->npmax+1)+1)*sizeof(double),
+                "level-set functions",return(0));
+  _MMG5_SAFE_CALLOC(sol->m,sol->size*(sol->npmax+1)+1,double);
+
+  memcpy(&sol->m[nls],ls,nls*mesh->np*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param smesh pointer toward a surface mesh (triangles only).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the level-set function to the signed distance from the vertices of the
+ * mesh to the triangles of \a smesh.
+ *
+ */
+int MMG5_Set_signedDistance(MMG5_pMesh mesh, MMG5_pSol sol, MMG5_pMesh smesh) {
+
+  if ( !mesh->np ) {
+    fprintf(stdout,"  ## Error: You must set the mesh size with the");
+    fprintf(stdout," MMG5_Set_meshSize function before setting the");
+    fprintf(stdout," level-set function\n");
+    return(0);
+  }
+  if ( !smesh || !smesh->nt ) {
+    fprintf(stdout,"  ## Error: surface mesh without triangles.\n");
+    return(0);
+  }
+  return(_MMG5_distSetSol(mesh,sol,smesh));
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  *
@@ -1157,6 +1666,34 @@ int MMG5_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam, int val){
     mesh->info.renum    = val;
     break;
 #endif
+  case MMG5_IPARAM_warmStart :
+    mesh->info.warm     = val;
+    break;
+  case MMG5_IPARAM_lsband :
+    if ( val < 0 ) {
+      fprintf(stdout,"  ## Error: negative number of layers.\n");
+      return(0);
+    }
+    mesh->info.lsband   = val;
+    break;
+  case MMG5_IPARAM_hessian :
+    if ( val != 0 && val != 1 && val != 6 ) {
+      fprintf(stdout,"  ## Error: the metric built from the Hessian must be"
+              " isotropic (1) or anisotropic (6).\n");
+      return(0);
+    }
+    mesh->info.hess     = val;
+    break;
+  case MMG5_IPARAM_nelem :
+    if ( val < 0 ) {
+      fprintf(stdout,"  ## Error: negative number of elements.\n");
+      return(0);
+    }
+    mesh->info.nelem    = val;
+    break;
+  case MMG5_IPARAM_nosignal :
+    mesh->info.nosignal = val;
+    break;
   default :
     fprintf(stdout,"  ## Error: unknown type of parameter\n");
     return(0);
@@ -1221,6 +1758,20 @@ int MMG5_Get_iparameter(MMG5_pMesh mesh, int iparam) {
     return ( mesh->info.renum );
     break;
 #endif
+  case MMG5_IPARAM_warmStart :
+    return ( mesh->info.warm );
+  case MMG5_IPARAM_lsband :
+    return ( mesh->info.lsband );
+    break;
+  case MMG5_IPARAM_hessian :
+    return ( mesh->info.hess );
+    break;
+  case MMG5_IPARAM_nelem :
+    return ( mesh->info.nelem );
+    break;
+  case MMG5_IPARAM_nosignal :
+    return ( mesh->info.nosignal );
+    break;
   default :
     fprintf(stdout,"  ## Error: unknown type of parameter\n");
     exit(EXIT_FAILURE);
@@ -1270,6 +1821,20 @@ int MMG5_Set_dparameter(MMG5_pMesh mesh, MMG5_pSol sol, int dparam, double val){
   case MMG5_DPARAM_ls :
     mesh->info.ls       = val;
     break;
+  case MMG5_DPARAM_hessErr :
+    if ( val <= 0 ) {
+      fprintf(stdout,"  ## Error: the target error must be strictly positive.\n");
+      return(0);
+    }
+    mesh->info.herr     = val;
+    break;
+  case MMG5_DPARAM_timeMax :
+    if ( val < 0 ) {
+      fprintf(stdout,"  ## Error: the time budget must be positive.\n");
+      return(0);
+    }
+    mesh->info.tmax     = val;
+    break;
   default :
     fprintf(stdout,"  ## Error: unknown type of parameter\n");
     return(0);
@@ -1337,6 +1902,427 @@ int MMG5_Set_localParameter(MMG5_pMesh mesh,MMG5_pSol sol, int typ, int ref, dou
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param nlreg number of seeds of the region.
+ * \param nlayer number of layers of tetrahedra added around the seeds.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Allocate the list of seeds of the remeshed region (free the previous one).
+ *
+ */
+int _MMG5_newRegion(MMG5_pMesh mesh, int nlreg, int nlayer) {
+
+  if ( mesh->lreg )
+    _MMG5_DEL_MEM(mesh,mesh->lreg,(mesh->nereg ? mesh->nemax+1 : mesh->nlreg)
+                  *sizeof(int));
+  mesh->nlreg  = 0;
+  mesh->nlayer = nlayer;
+
+  if ( !nlreg )  return(1);
+
+  _MMG5_ADD_MEM(mesh,nlreg*sizeof(int),"local remeshing region",return(0));
+  _MMG5_SAFE_MALLOC(mesh->lreg,nlreg,int);
+  mesh->nlreg = nlreg;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param list table of the indices of the tetrahedra to remesh.
+ * \param ilist number of tetrahedra in \a list (0 to remesh the whole mesh).
+ * \param nlayer number of layers of adjacent tetrahedra added to \a list.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restrict the next remeshing to the tetrahedra of \a list grown by \a nlayer
+ * layers. The rest of the mesh is frozen (required) during the remeshing and
+ * the region is reset at the end of the \ref MMG5_mmg3dlib call.
+ *
+ */
+int MMG5_Set_localRegion(MMG5_pMesh mesh, int *list, int ilist, int nlayer) {
+
+  if ( !_MMG5_newRegion(mesh,ilist,nlayer) )  return(0);
+  if ( ilist )
+    memcpy(mesh->lreg,list,ilist*sizeof(int));
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param min lower corner of the box.
+ * \param max upper corner of the box.
+ * \param nlayer number of layers of adjacent tetrahedra added to the region.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restrict the next remeshing to the tetrahedra having a vertex inside the box
+ * [\a min, \a max], grown by \a nlayer layers (see \ref
+ * MMG5_Set_localRegion).
+ *
+ */
+int MMG5_Set_localRegionBox(MMG5_pMesh mesh, double *min, double *max,
+                            int nlayer) {
+  MMG5_pTetra  pt;
+  MMG5_pPoint  ppt;
+  int          k,n,pass;
+  char         i;
+
+  n = 0;
+  for (pass=0; pass<2; pass++) {
+    if ( pass && !_MMG5_newRegion(mesh,n,nlayer) )  return(0);
+    n = 0;
+    for (k=1; k<=mesh->ne; k++) {
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) )  continue;
+      for (i=0; i<4; i++) {
+        ppt = &mesh->point[pt->v[i]];
+        if ( ppt->c[0] >= min[0] && ppt->c[0] <= max[0] &&
+             ppt->c[1] >= min[1] && ppt->c[1] <= max[1] &&
+             ppt->c[2] >= min[2] && ppt->c[2] <= max[2] )  break;
+      }
+      if ( i == 4 )  continue;
+      if ( pass )  mesh->lreg[n] = k;
+      n++;
+    }
+  }
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ref reference of the tetrahedra to remesh.
+ * \param nlayer number of layers of adjacent tetrahedra added to the region.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restrict the next remeshing to the tetrahedra of reference \a ref, grown
+ * by \a nlayer layers (see \ref MMG5_Set_localRegion).
+ *
+ */
+int MMG5_Set_localRegionRef(MMG5_pMesh mesh, int ref, int nlayer) {
+  MMG5_pTetra  pt;
+  int          k,n,pass;
+
+  n = 0;
+  for (pass=0; pass<2; pass++) {
+    if ( pass && !_MMG5_newRegion(mesh,n,nlayer) )  return(0);
+    n = 0;
+    for (k=1; k<=mesh->ne; k++) {
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) || pt->ref != ref )  continue;
+      if ( pass )  mesh->lreg[n] = k;
+      n++;
+    }
+  }
+
+  return(1);
+}
+
+/**
+ * \param a pointer toward the first index.
+ * \param b pointer toward the second index.
+ * \return the sign of the difference of the indices.
+ *
+ * Comparison of two indices (sort of and search in the list of the remeshed
+ * region).
+ *
+ */
+int _MMG5_cmpidx(const void *a,const void *b) {
+  return( *(const int*)a - *(const int*)b );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Local remeshing: grow the seeds of the remeshed region by \a mesh->nlayer
+ * layers of adjacent tetrahedra and freeze the rest of the mesh. The vertices
+ * of the interface (whose ball contains an outside tetrahedron) become
+ * required and the outside tetrahedra of their balls are tagged as required
+ * (and frozen). The other outside tetrahedra are never reached by the
+ * operators, which work in the balls of the non required vertices of the
+ * region and in the shells of its edges, so they are left untouched.
+ *
+ * The seeds are replaced by the list, in the order of the tetra table, of the
+ * tetrahedra visited by the adaptation loops (see \ref _MMG5_NEACT): the
+ * region, the frozen tetrahedra touching the interface (their interface edges
+ * must not be split) and the empty slots of the tetra table. The new slots
+ * are appended by \ref _MMG5_newElt, so every slot that does not hold an
+ * outside tetrahedron stays listed and the list stays sorted. The cost is proportional to the size of
+ * the region (and to the number of empty slots), not to the size of the mesh.
+ *
+ */
+int _MMG5_freezeMesh(MMG5_pMesh mesh) {
+  MMG5_pTetra   pt,pt1;
+  MMG5_pPoint   ppt;
+  int           *pile,*adja,list[_MMG5_LMAX+2],k,l,iel,jel,cur,end;
+  int           nreg,nact,ilist,base,bfrz;
+  char          i,isint;
+
+  _MMG5_ADD_MEM(mesh,(mesh->nemax+1)*sizeof(int),"local remeshing region",
+                return(0));
+  _MMG5_SAFE_MALLOC(pile,mesh->nemax+1,int);
+
+  /* seeds and layers of adjacent tetrahedra (marked by -1, the ball
+   * computations using the flags) */
+  nreg = 0;
+  for (k=0; k<mesh->nlreg; k++) {
+    iel = mesh->lreg[k];
+    if ( iel < 1 || iel > mesh->ne )  continue;
+    pt = &mesh->tetra[iel];
+    if ( !MG_EOK(pt) || pt->mark == -1 )  continue;
+    pt->mark     = -1;
+    pile[nreg++] = iel;
+  }
+
+  cur = 0;
+  for (l=0; l<mesh->nlayer; l++) {
+    end = nreg;
+    for ( ; cur<end; cur++) {
+      adja = &mesh->adja[4*(pile[cur]-1)+1];
+      for (i=0; i<4; i++) {
+        jel = adja[i] / 4;
+        if ( !jel || mesh->tetra[jel].mark == -1 )  continue;
+        mesh->tetra[jel].mark = -1;
+        pile[nreg++] = jel;
+      }
+    }
+  }
+
+  /* balls of the vertices of the region: the outside tetrahedra of the balls
+   * are frozen and listed (marked by -2) */
+  base = ++mesh->base;
+  bfrz = ++mesh->base;
+  nact = nreg;
+  mesh->nfrz = 0;
+  for (l=0; l<nreg; l++) {
+    iel = pile[l];
+    pt  = &mesh->tetra[iel];
+    for (i=0; i<4; i++) {
+      ppt = &mesh->point[pt->v[i]];
+      if ( ppt->flag == base || ppt->flag == bfrz )  continue;
+      ppt->flag = base;
+
+      ilist = _MMG5_boulevolp(mesh,iel,i,list);
+      if ( !ilist ) {
+        fprintf(stdout,"  ## Error: unable to compute the ball of vertex %d"
+                " (local remeshing).\n",_MMG5_indPt(mesh,pt->v[i]));
+        for (k=0; k<nact; k++)
+          mesh->tetra[pile[k]].mark = 0;
+        _MMG5_DEL_MEM(mesh,pile,(mesh->nemax+1)*sizeof(int));
+        return(0);
+      }
+      isint = 0;
+      for (k=0; k<ilist; k++) {
+        jel = list[k] / 4;
+        pt1 = &mesh->tetra[jel];
+        if ( pt1->mark == -1 )  continue;
+        isint = 1;
+        if ( pt1->mark == -2 )  continue;
+        pt1->mark     = -2;
+        pile[nact++] = jel;
+        if ( !(pt1->tag & MG_REQ) )  pt1->tag |= MG_REQ + MG_FRZ;
+      }
+      if ( isint && !(ppt->tag & MG_REQ) ) {
+        ppt->flag = bfrz;
+        mesh->nfrz++;
+      }
+    }
+  }
+  for (k=0; k<nact; k++) {
+    pt = &mesh->tetra[pile[k]];
+    pt->mark = pt->flag = 0;
+  }
+
+  /* empty slots of the table (reused by _MMG5_newElt) */
+  for (k=mesh->nenil; k && k<mesh->nelnk; k=mesh->tetra[k].v[3])
+    pile[nact++] = k;
+
+  /* order of the tetra table, which is the order of the loops on the whole
+   * mesh */
+  qsort(pile,nact,sizeof(int),_MMG5_cmpidx);
+
+  _MMG5_DEL_MEM(mesh,mesh->lreg,mesh->nlreg*sizeof(int));
+  mesh->lreg  = pile;
+  mesh->nlreg = nact;
+  mesh->nereg = mesh->nelnk-1;
+
+  /* required vertices of the interface */
+  _MMG5_ADD_MEM(mesh,(mesh->nfrz+1)*sizeof(int),"frozen vertices",return(0));
+  _MMG5_SAFE_MALLOC(mesh->lfrz,mesh->nfrz+1,int);
+
+  mesh->nfrz = 0;
+  for (l=0; l<nact; l++) {
+    pt = &mesh->tetra[mesh->lreg[l]];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4; i++) {
+      ppt = &mesh->point[pt->v[i]];
+      if ( ppt->flag != bfrz )  continue;
+      ppt->flag = 0;
+      ppt->tag |= MG_REQ;
+      mesh->lfrz[mesh->nfrz++] = pt->v[i];
+    }
+  }
+
+  if ( abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     %d elements remeshed, %d interface vertices\n",
+            nreg,mesh->nfrz);
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Local remeshing: release the tetrahedra and the vertices frozen by \ref
+ * _MMG5_freezeMesh and reset the remeshed region. Only the listed
+ * tetrahedra are visited (the frozen ones are only moved into listed slots).
+ *
+ */
+void _MMG5_unfreezeMesh(MMG5_pMesh mesh) {
+  MMG5_pTetra   pt;
+  int           k,l;
+
+  if ( !mesh->lreg )  return;
+
+  if ( !mesh->nereg ) {
+    _MMG5_DEL_MEM(mesh,mesh->lreg,mesh->nlreg*sizeof(int));
+    mesh->nlreg = 0;
+    return;
+  }
+
+  for (l=0; l<mesh->nlreg; l++) {
+    k = mesh->lreg[l];
+    if ( k > mesh->ne )  continue;
+    pt = &mesh->tetra[k];
+    if ( MG_EOK(pt) && (pt->tag & MG_FRZ) )
+      pt->tag &= ~(MG_REQ + MG_FRZ);
+  }
+  if ( mesh->lfrz ) {
+    for (k=0; k<mesh->nfrz; k++)
+      mesh->point[mesh->lfrz[k]].tag &= ~MG_REQ;
+    _MMG5_DEL_MEM(mesh,mesh->lfrz,(mesh->nfrz+1)*sizeof(int));
+  }
+  mesh->nfrz = 0;
+
+  _MMG5_DEL_MEM(mesh,mesh->lreg,(mesh->nemax+1)*sizeof(int));
+  mesh->nlreg = mesh->nereg = 0;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param flag value of the flags.
+ *
+ * Set the flag of the vertices read by the adaptation loops: all the vertices,
+ * or the vertices of the listed tetrahedra once the mesh is frozen (see \ref
+ * _MMG5_NEACT).
+ *
+ */
+void _MMG5_setPtFlags(MMG5_pMesh mesh,int flag) {
+  MMG5_pTetra   pt;
+  int           k,l;
+  char          i;
+
+  if ( !mesh->nereg ) {
+    for (k=1; k<=mesh->np; k++)
+      mesh->point[k].flag = flag;
+    return;
+  }
+  for (l=0; l<mesh->nlreg; l++) {
+    pt = &mesh->tetra[mesh->lreg[l]];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4; i++)
+      mesh->point[pt->v[i]].flag = flag;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bmesh pointer toward the background mesh (NULL to remove the
+ * background mesh).
+ * \param bmet pointer toward the size map (scalar or tensor) at the vertices
+ * of \a bmesh.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give the size map on a background mesh: the solution of \a mesh is
+ * replaced by the interpolation of \a bmet at the beginning of the
+ * \ref MMG5_mmg3dlib calls and the size of each new vertex is interpolated
+ * in \a bmesh. The background mesh and its size map must be kept by the
+ * user until the background mesh is removed or \a mesh is freed. Replace
+ * the size function if any.
+ *
+ */
+int MMG5_Set_backgroundMesh(MMG5_pMesh mesh, MMG5_pMesh bmesh, MMG5_pSol bmet) {
+
+  if ( !bmesh ) {
+    _MMG5_bgmFree(mesh);
+    return(1);
+  }
+  _MMG5_sizfFree(mesh);
+  return(_MMG5_bgmNew(mesh,bmesh,bmet));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fct size function (NULL to remove the size function).
+ * \param typSol type of the values computed by \a fct (MMG5_Scalar or
+ * MMG5_Tensor).
+ * \param data user data passed to \a fct.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give the size map by a function: the solution of \a mesh is replaced by
+ * the values of \a fct at the vertices at the beginning of the
+ * \ref MMG5_mmg3dlib calls and \a fct is evaluated at each new vertex (the
+ * new vertices are passed by groups when possible). Replace the background
+ * mesh if any.
+ *
+ */
+int MMG5_Set_sizeFunction(MMG5_pMesh mesh, MMG5_sizeFunction fct, int typSol,
+                          void *data) {
+
+  if ( !fct ) {
+    _MMG5_sizfFree(mesh);
+    return(1);
+  }
+  if ( typSol != MMG5_Scalar && typSol != MMG5_Tensor ) {
+    fprintf(stdout,"  ## Error: type of size function not allowed.\n");
+    return(0);
+  }
+  _MMG5_bgmFree(mesh);
+  return(_MMG5_sizfNew(mesh,fct,typSol == MMG5_Scalar ? 1 : 6,data));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fct progress function (NULL to remove the progress function).
+ * \param data user data passed to \a fct.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give a function called by \ref MMG5_mmg3dlib at the end of the phases and
+ * at each iteration of the remeshing loops. If \a fct returns 0, the remaining
+ * operators are skipped and the (conform) mesh obtained so far is returned
+ * with the \ref MMG5_INTERRUPTED code.
+ *
+ */
+int MMG5_Set_progressFunction(MMG5_pMesh mesh, MMG5_progressFunction fct,
+                              void *data) {
+
+  if ( !fct ) {
+    if ( mesh->prog )
+      _MMG5_DEL_MEM(mesh,mesh->prog,sizeof(_MMG5_Prog));
+    return(1);
+  }
+  if ( !mesh->prog ) {
+    _MMG5_ADD_MEM(mesh,sizeof(_MMG5_Prog),"progress function",return(0));
+    _MMG5_SAFE_CALLOC(mesh->prog,1,_MMG5_Prog);
+  }
+  mesh->prog->fct  = fct;
+  mesh->prog->data = data;
+
+  return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -1365,6 +2351,13 @@ void MMG5_Free_structures(MMG5_pMesh mesh,MMG5_pSol met
   if ( mesh->xpoint )
     _MMG5_DEL_MEM(mesh,mesh->xpoint,(mesh->xpmax+1)*sizeof(MMG5_xPoint));
 
+  _MMG5_bezierFreeCache(mesh);
+  _MMG5_bgmFree(mesh);
+  _MMG5_sizfFree(mesh);
+  if ( mesh->prog )
+    _MMG5_DEL_MEM(mesh,mesh->prog,sizeof(_MMG5_Prog));
+  _MMG5_profFree(mesh);
+
   if ( mesh->htab.geom )
     _MMG5_DEL_MEM(mesh,mesh->htab.geom,(mesh->htab.max+1)*sizeof(MMG5_hgeom));
 
@@ -1374,9 +2367,16 @@ void MMG5_Free_structures(MMG5_pMesh mesh,MMG5_pSol met
   if ( mesh->xtetra )
     _MMG5_DEL_MEM(mesh,mesh->xtetra,(mesh->xtmax+1)*sizeof(MMG5_xTetra));
 
+  if ( mesh->lreg )
+    _MMG5_DEL_MEM(mesh,mesh->lreg,(mesh->nereg ? mesh->nemax+1 : mesh->nlreg)
+                  *sizeof(int));
+
+  if ( mesh->lfrz )
+    _MMG5_DEL_MEM(mesh,mesh->lfrz,(mesh->nfrz+1)*sizeof(int));
+
   /* met */
   if ( /*!mesh->info.iso &&*/ met && met->m )
-    _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
+    _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
 
   /* mesh->info */
   if ( mesh->info.npar && mesh->info.par )
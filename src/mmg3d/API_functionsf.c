@@ -133,6 +133,37 @@ FORTRAN_NAME(MMG5_GET_VERTEX,mmg5_get_vertex,
   return;
 }
 
+/**
+ * See \ref MMG5_Set_vertices function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_VERTICES,mmg5_set_vertices,
+             (MMG5_pMesh *mesh, double* vertices, int* refs, int* retval),
+             (mesh,vertices,refs,retval)) {
+  *retval = MMG5_Set_vertices(*mesh,vertices,refs);
+  return;
+}
+
+/**
+ * See \ref MMG5_Get_vertices function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_VERTICES,mmg5_get_vertices,
+             (MMG5_pMesh *mesh, double* vertices, int* refs,
+              int* areCorners, int* areRequired, int* retval),
+             (mesh,vertices,refs,areCorners,areRequired, retval)) {
+  *retval = MMG5_Get_vertices(*mesh,vertices,refs,areCorners,areRequired);
+  return;
+}
+
+/**
+ * See \ref MMG5_Move_vertices function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_MOVE_VERTICES,mmg5_move_vertices,
+             (MMG5_pMesh *mesh, double* displ, int* retval),
+             (mesh,displ,retval)) {
+  *retval = MMG5_Move_vertices(*mesh,displ);
+  return;
+}
+
 /**
  * See \ref MMG5_Set_tetrahedron function in \ref mmg3d/libmmg3d.h file.
  */
@@ -155,6 +186,27 @@ FORTRAN_NAME(MMG5_GET_TETRAHEDRON,mmg5_get_tetrahedron,
   return;
 }
 
+/**
+ * See \ref MMG5_Set_tetrahedra function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_TETRAHEDRA,mmg5_set_tetrahedra,
+             (MMG5_pMesh *mesh, int *tetra, int *refs, int* retval),
+             (mesh,tetra,refs,retval)){
+  *retval = MMG5_Set_tetrahedra(*mesh,tetra,refs);
+  return;
+}
+
+/**
+ * See \ref MMG5_Get_tetrahedra function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_TETRAHEDRA,mmg5_get_tetrahedra,
+             (MMG5_pMesh *mesh, int* tetra, int* refs, int* areRequired,
+              int* retval),
+             (mesh,tetra,refs,areRequired,retval)) {
+  *retval = MMG5_Get_tetrahedra(*mesh,tetra,refs,areRequired);
+  return;
+}
+
 /**
  * See \ref MMG5_Set_triangle function in \ref mmg3d/libmmg3d.h file.
  */
@@ -266,6 +318,48 @@ FORTRAN_NAME(MMG5_SET_SCALARSOL,mmg5_set_scalarsol,
   return;
 }
 
+/**
+ * See \ref MMG5_Set_tensorSol function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_TENSORSOL,mmg5_set_tensorsol,
+             (MMG5_pSol *met, double* m11,double *m12, double *m13,
+              double *m22,double *m23, double *m33, int *pos, int* retval),
+             (met,m11,m12,m13,m22,m23,m33,pos,retval)) {
+  *retval = MMG5_Set_tensorSol(*met,*m11,*m12,*m13,*m22,*m23,*m33,*pos);
+  return;
+}
+
+/**
+ * See \ref MMG5_Get_tensorSol function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_TENSORSOL,mmg5_get_tensorsol,
+             (MMG5_pSol *met, double* m11,double *m12, double *m13,
+              double *m22,double *m23, double *m33, int* retval),
+             (met,m11,m12,m13,m22,m23,m33,retval)) {
+  *retval = MMG5_Get_tensorSol(*met,m11,m12,m13,m22,m23,m33);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_tensorSols function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_TENSORSOLS,mmg5_set_tensorsols,
+             (MMG5_pSol *met, double *m, int* retval),
+             (met,m,retval)) {
+  *retval = MMG5_Set_tensorSols(*met,m);
+  return;
+}
+
+/**
+ * See \ref MMG5_Get_tensorSols function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_TENSORSOLS,mmg5_get_tensorsols,
+             (MMG5_pSol *met, double *m, int* retval),
+             (met,m,retval)) {
+  *retval = MMG5_Get_tensorSols(*met,m);
+  return;
+}
+
 /**
  * See \ref MMG5_Get_scalarSol function in \ref mmg3d/libmmg3d.h file.
  */
@@ -276,6 +370,46 @@ FORTRAN_NAME(MMG5_GET_SCALARSOL,mmg5_get_scalarsol,
   return;
 }
 
+/**
+ * See \ref MMG5_Set_scalarSols function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_SCALARSOLS,mmg5_set_scalarsols,
+             (MMG5_pSol *met, double *s, int* retval),
+             (met,s,retval)) {
+  *retval = MMG5_Set_scalarSols(*met,s);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_levelSets function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_LEVELSETS,mmg5_set_levelsets,
+             (MMG5_pMesh *mesh,MMG5_pSol *sol, int *nls, double *ls, int* retval),
+             (mesh,sol,nls,ls,retval)) {
+  *retval = MMG5_Set_levelSets(*mesh,*sol,*nls,ls);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_signedDistance function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_SIGNEDDISTANCE,mmg5_set_signeddistance,
+             (MMG5_pMesh *mesh,MMG5_pSol *sol, MMG5_pMesh *smesh, int* retval),
+             (mesh,sol,smesh,retval)) {
+  *retval = MMG5_Set_signedDistance(*mesh,*sol,*smesh);
+  return;
+}
+
+/**
+ * See \ref MMG5_Get_scalarSols function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_GET_SCALARSOLS,mmg5_get_scalarsols,
+             (MMG5_pSol *met, double* s, int* retval),
+             (met,s,retval)) {
+  *retval = MMG5_Get_scalarSols(*met,s);
+  return;
+}
+
 /**
  * See \ref MMG5_Set_handGivenMesh function in \ref mmg3d/libmmg3d.h file.
  */
@@ -336,6 +470,68 @@ FORTRAN_NAME(MMG5_SET_LOCALPARAMETER,mmg5_set_localparameter,
   return;
 }
 
+/**
+ * See \ref MMG5_Set_localRegion function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_LOCALREGION,mmg5_set_localregion,
+             (MMG5_pMesh *mesh, int *list, int *ilist, int *nlayer, int* retval),
+             (mesh,list,ilist,nlayer,retval)){
+  *retval = MMG5_Set_localRegion(*mesh,list,*ilist,*nlayer);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_localRegionBox function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_LOCALREGIONBOX,mmg5_set_localregionbox,
+             (MMG5_pMesh *mesh, double *min, double *max, int *nlayer, int* retval),
+             (mesh,min,max,nlayer,retval)){
+  *retval = MMG5_Set_localRegionBox(*mesh,min,max,*nlayer);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_localRegionRef function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_LOCALREGIONREF,mmg5_set_localregionref,
+             (MMG5_pMesh *mesh, int *ref, int *nlayer, int* retval),
+             (mesh,ref,nlayer,retval)){
+  *retval = MMG5_Set_localRegionRef(*mesh,*ref,*nlayer);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_backgroundMesh function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_BACKGROUNDMESH,mmg5_set_backgroundmesh,
+             (MMG5_pMesh *mesh, MMG5_pMesh *bmesh, MMG5_pSol *bmet, int* retval),
+             (mesh,bmesh,bmet,retval)){
+  *retval = MMG5_Set_backgroundMesh(*mesh,*bmesh,*bmet);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_sizeFunction function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_SIZEFUNCTION,mmg5_set_sizefunction,
+             (MMG5_pMesh *mesh, MMG5_sizeFunction fct, int *typSol, void *data,
+              int* retval),
+             (mesh,fct,typSol,data,retval)){
+  *retval = MMG5_Set_sizeFunction(*mesh,fct,*typSol,data);
+  return;
+}
+
+/**
+ * See \ref MMG5_Set_progressFunction function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SET_PROGRESSFUNCTION,mmg5_set_progressfunction,
+             (MMG5_pMesh *mesh, MMG5_progressFunction fct, void *data,
+              int* retval),
+             (mesh,fct,data,retval)){
+  *retval = MMG5_Set_progressFunction(*mesh,fct,data);
+  return;
+}
+
 
 /**
  * See \ref MMG5_Free_structures function in \ref mmg3d/libmmg3d.h file.
@@ -386,3 +582,39 @@ FORTRAN_NAME(MMG5_SAVEMET,mmg5_savemet,(MMG5_pMesh *mesh,MMG5_pSol *met,int* ret
 
   return;
 }
+
+/**
+ * See \ref MMG5_saveCheckpoint function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_SAVECHECKPOINT,mmg5_savecheckpoint,
+             (MMG5_pMesh *mesh,MMG5_pSol *met,char* filename,int* strlen,
+              int* retval),
+             (mesh,met,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  tmp = (char*)malloc((*strlen+1)*sizeof(char));
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+  *retval = MMG5_saveCheckpoint(*mesh,*met,tmp);
+  _MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref MMG5_loadCheckpoint function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG5_LOADCHECKPOINT,mmg5_loadcheckpoint,
+             (MMG5_pMesh *mesh,MMG5_pSol *met,char* filename,int* strlen,
+              int* retval),
+             (mesh,met,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  tmp = (char*)malloc((*strlen+1)*sizeof(char));
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+  *retval = MMG5_loadCheckpoint(*mesh,*met,tmp);
+  _MMG5_SAFE_FREE(tmp);
+
+  return;
+}
@@ -377,7 +377,7 @@ static int _MMG5_norver(MMG5_pMesh mesh) {
 
   /* compute normals + tangents */
   nn = ng = nt = nf = 0;
-  mesh->xp = 0;
+  mesh->xp = mesh->xpnil = 0;
   ++mesh->base;
   for (k=1; k<=mesh->nt; k++) {
     pt = &mesh->tria[k];
@@ -480,11 +480,53 @@ static int _MMG5_norver(MMG5_pMesh mesh) {
   return(1);
 }
 
-/** Define continuous geometric support at non manifold vertices, using volume information */
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param p0 pointer toward a non manifold point.
+ * \param ier 0 if the geometry of \a p0 can not be defined.
+ * \param n normal at \a p0.
+ * \param t tangent at \a p0.
+ *
+ * Store the normal and tangent of a non manifold point in its xpoint, or set
+ * the point as required if its geometry can not be defined.
+ *
+ */
+static void _MMG5_nmpoint(MMG5_pMesh mesh,MMG5_pPoint p0,int ier,
+                          double n[3],double t[3]) {
+  MMG5_pxPoint    pxp;
+
+  if ( !ier ) {
+    p0->tag |= MG_REQ;
+    if ( p0->ref != 0 )
+      p0->ref = -abs(p0->ref);
+    else
+      p0->ref = MG_ISO;
+    return;
+  }
+
+  if ( !p0->xp ) {
+    ++mesh->xp;
+    if(mesh->xp > mesh->xpmax){
+      _MMG5_TAB_RECALLOC(mesh,mesh->xpoint,mesh->xpmax,0.2,MMG5_xPoint,
+                         "larger xpoint table",
+                         mesh->xp--;
+                         printf("  Exit program.\n");
+                         exit(EXIT_FAILURE));
+    }
+    p0->xp = mesh->xp;
+  }
+  pxp = &mesh->xpoint[p0->xp];
+  memcpy(pxp->n1,n,3*sizeof(double));
+  memcpy(pxp->t,t,3*sizeof(double));
+}
+
+/** Define continuous geometric support at non manifold vertices, using volume
+    information. The non manifold points that are not reached from the outer
+    boundary (lines where three sub-domains or more meet, e.g. crossing level
+    sets) are defined from their non manifold edges. */
 static void _MMG5_nmgeom(MMG5_pMesh mesh){
   MMG5_pTetra     pt;
   MMG5_pPoint     p0;
-  MMG5_pxPoint    pxp;
   int        k,base;
   int        *adja;
   double     n[3],t[3];
@@ -504,33 +546,25 @@ static void _MMG5_nmgeom(MMG5_pMesh mesh){
 
         p0->flag = base;
         ier = _MMG5_boulenm(mesh,k,ip,i,n,t);
-
-        if ( !ier ) {
-          p0->tag |= MG_REQ;
-          if ( p0->ref != 0 )
-            p0->ref = -abs(p0->ref);
-          else
-            p0->ref = MG_ISO;
-        }
-        else {
-          if ( !p0->xp ) {
-            ++mesh->xp;
-            if(mesh->xp > mesh->xpmax){
-              _MMG5_TAB_RECALLOC(mesh,mesh->xpoint,mesh->xpmax,0.2,MMG5_xPoint,
-                                 "larger xpoint table",
-                                 mesh->xp--;
-                                 printf("  Exit program.\n");
-                                 exit(EXIT_FAILURE));
-            }
-            p0->xp = mesh->xp;
-          }
-          pxp = &mesh->xpoint[p0->xp];
-          memcpy(pxp->n1,n,3*sizeof(double));
-          memcpy(pxp->t,t,3*sizeof(double));
-        }
+        _MMG5_nmpoint(mesh,p0,ier,n,t);
       }
     }
   }
+
+  /* non manifold points inside the domain */
+  for (k=1; k<=mesh->ne; k++) {
+    pt   = &mesh->tetra[k];
+    if ( !pt->xt )  continue;
+    for (ip=0; ip<4; ip++) {
+      p0 = &mesh->point[pt->v[ip]];
+      if ( p0->flag == base )  continue;
+      else if ( !(p0->tag & MG_NOM) )  continue;
+
+      p0->flag = base;
+      ier = _MMG5_boulenmint(mesh,k,ip,n,t);
+      _MMG5_nmpoint(mesh,p0,ier,n,t);
+    }
+  }
 }
 
 /** preprocessing stage: mesh analysis */
@@ -637,3 +671,94 @@ int _MMG5_analys(MMG5_pMesh mesh) {
 
   return(1);
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 0 if some points have been skipped (the analysis must be done
+ * again to update their geometry), 1 otherwise.
+ *
+ * Update the normals at the regular boundary points of the faces touching a
+ * moved vertex (point marked by its tmp field) and keep the analysis of the
+ * previous call elsewhere (warm start, lagrangian motion). The ridge,
+ * reference, non-manifold and moved corner points of these faces (and the
+ * points whose normal can not be computed) are skipped: their geometry is
+ * kept. The tmp field of the points is reset.
+ *
+ */
+int _MMG5_updnor(MMG5_pMesh mesh) {
+  MMG5_pTetra   pt;
+  MMG5_pxTetra  pxt;
+  MMG5_pPoint   ppt;
+  MMG5_pxPoint  pxp;
+  double        n[3],nt[3],dd;
+  int           lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv;
+  int           k,l,nn,nskip;
+  char          i,j,i0,ismoved;
+
+  nn = nskip = 0;
+  ++mesh->base;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || !pt->xt )  continue;
+    pxt = &mesh->xtetra[pt->xt];
+
+    for (i=0; i<4; i++) {
+      if ( !(pxt->ftag[i] & MG_BDY) )  continue;
+
+      ismoved = 0;
+      for (j=0; j<3; j++)
+        if ( mesh->point[pt->v[_MMG5_idir[i][j]]].tmp )  ismoved = 1;
+      if ( !ismoved )  continue;
+
+      for (j=0; j<3; j++) {
+        i0  = _MMG5_idir[i][j];
+        ppt = &mesh->point[pt->v[i0]];
+        if ( ppt->flag == mesh->base )  continue;
+        ppt->flag = mesh->base;
+
+        if ( ppt->tag & MG_CRN ) {
+          if ( ppt->tmp )  nskip++;
+          continue;
+        }
+        if ( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) || !ppt->xp ) {
+          nskip++;
+          continue;
+        }
+
+        if ( _MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists) < 1 ) {
+          nskip++;
+          continue;
+        }
+
+        n[0] = n[1] = n[2] = 0.0;
+        for (l=0; l<ilists; l++) {
+          if ( !_MMG5_norface(mesh,lists[l]/4,lists[l]%4,nt) )  continue;
+          n[0] += nt[0];  n[1] += nt[1];  n[2] += nt[2];
+        }
+        dd = n[0]*n[0] + n[1]*n[1] + n[2]*n[2];
+        if ( dd < _MMG5_EPSD2 ) {
+          nskip++;
+          continue;
+        }
+
+        /* keep the orientation of the previous normal */
+        pxp = &mesh->xpoint[ppt->xp];
+        dd  = 1.0 / sqrt(dd);
+        if ( n[0]*pxp->n1[0] + n[1]*pxp->n1[1] + n[2]*pxp->n1[2] < 0.0 )
+          dd = -dd;
+        pxp->n1[0] = dd*n[0];
+        pxp->n1[1] = dd*n[1];
+        pxp->n1[2] = dd*n[2];
+        nn++;
+      }
+    }
+  }
+
+  for (k=1; k<=mesh->np; k++)
+    mesh->point[k].tmp = 0;
+
+  if ( abs(mesh->info.imprim) > 3 && (nn || nskip) )
+    fprintf(stdout,"     %d normals updated, %d points skipped\n",nn,nskip);
+
+  return(!nskip);
+}
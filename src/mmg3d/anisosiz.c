@@ -0,0 +1,403 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/anisosiz.c
+ * \brief Fonctions for anisotropic size map computation.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The metric at vertex \a k is stored in \a met->m[6*k+1] as
+ * \f$(m_{11},m_{12},m_{13},m_{22},m_{23},m_{33})\f$.
+ */
+
+#include "mmg3d.h"
+
+#define _MMG5_EPSGRAD  1.e-3  /**< relative tolerance on the metric gradation */
+
+/**
+ * \param m first metric.
+ * \param n second metric.
+ * \param sq square root of \a m.
+ * \param w eigenvectors (stored by rows) of \f$m^{-1/2} n m^{-1/2}\f$.
+ * \param lambda eigenvalues of \f$m^{-1/2} n m^{-1/2}\f$.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Simultaneous reduction of the metrics \a m and \a n: in the basis
+ * \f$ sq^{-1} w^t \f$, \a m is the identity and \a n is diagonal.
+ *
+ */
+static int _MMG5_simred3d(double *m,double *n,double sq[3][3],double w[3][3],
+                          double lambda[3]) {
+  double  mu[3],v[3][3],is[3][3],nn[3][3],isn[3][3],isnis[6],dd;
+  char    i,j,l;
+
+  if ( !_MMG5_eigenv(1,m,mu,v) )  return(0);
+
+  for (l=0; l<3; l++)
+    if ( mu[l] < _MMG5_EPSD )  return(0);
+
+  /* square root of m and its inverse */
+  for (i=0; i<3; i++) {
+    for (j=0; j<3; j++) {
+      sq[i][j] = is[i][j] = 0.0;
+      for (l=0; l<3; l++) {
+        dd        = sqrt(mu[l]);
+        sq[i][j] += dd*v[l][i]*v[l][j];
+        is[i][j] += v[l][i]*v[l][j]/dd;
+      }
+    }
+  }
+
+  nn[0][0] = n[0]; nn[0][1] = n[1]; nn[0][2] = n[2];
+  nn[1][0] = n[1]; nn[1][1] = n[3]; nn[1][2] = n[4];
+  nn[2][0] = n[2]; nn[2][1] = n[4]; nn[2][2] = n[5];
+
+  for (i=0; i<3; i++) {
+    for (j=0; j<3; j++) {
+      isn[i][j] = 0.0;
+      for (l=0; l<3; l++)  isn[i][j] += is[i][l]*nn[l][j];
+    }
+  }
+  for (i=0; i<6; i++)  isnis[i] = 0.0;
+  for (l=0; l<3; l++) {
+    isnis[0] += isn[0][l]*is[l][0];
+    isnis[1] += isn[0][l]*is[l][1];
+    isnis[2] += isn[0][l]*is[l][2];
+    isnis[3] += isn[1][l]*is[l][1];
+    isnis[4] += isn[1][l]*is[l][2];
+    isnis[5] += isn[2][l]*is[l][2];
+  }
+
+  if ( !_MMG5_eigenv(1,isnis,lambda,w) )  return(0);
+
+  return(1);
+}
+
+/**
+ * \param sq square root of the first metric of a simultaneous reduction.
+ * \param w eigenvectors of the simultaneous reduction.
+ * \param d eigenvalues of the metric to build in the reduction basis.
+ * \param mr computed metric.
+ *
+ * Build the metric \f$ sq\, w^t diag(d)\, w\, sq \f$.
+ *
+ */
+static void _MMG5_recomp3d(double sq[3][3],double w[3][3],double d[3],
+                           double *mr) {
+  double  t[3][3],st[3][3];
+  char    i,j,l;
+
+  for (i=0; i<3; i++) {
+    for (j=0; j<3; j++) {
+      t[i][j] = 0.0;
+      for (l=0; l<3; l++)  t[i][j] += d[l]*w[l][i]*w[l][j];
+    }
+  }
+  for (i=0; i<3; i++) {
+    for (j=0; j<3; j++) {
+      st[i][j] = 0.0;
+      for (l=0; l<3; l++)  st[i][j] += sq[i][l]*t[l][j];
+    }
+  }
+  for (i=0; i<6; i++)  mr[i] = 0.0;
+  for (l=0; l<3; l++) {
+    mr[0] += st[0][l]*sq[l][0];
+    mr[1] += st[0][l]*sq[l][1];
+    mr[2] += st[0][l]*sq[l][2];
+    mr[3] += st[1][l]*sq[l][1];
+    mr[4] += st[1][l]*sq[l][2];
+    mr[5] += st[2][l]*sq[l][2];
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np index of the first extremity of the edge.
+ * \param nq index of the second extremity of the edge.
+ * \param ip index of the new point.
+ * \param s parameter of the new point along the edge \f$[np;nq]\f$.
+ *
+ * Interpolate the metric at point \a ip of the edge \f$[np;nq]\f$: the sizes
+ * are linearly interpolated in the simultaneous reduction basis of the two
+ * metrics.
+ *
+ */
+void _MMG5_intmet_ani(MMG5_pMesh mesh,MMG5_pSol met,int np,int nq,int ip,
+                      double s) {
+  double  *m,*n,*mr,sq[3][3],w[3][3],lambda[3],d[3],h;
+  char    i;
+
+  m  = &met->m[6*np+1];
+  n  = &met->m[6*nq+1];
+  mr = &met->m[6*ip+1];
+
+  if ( _MMG5_simred3d(m,n,sq,w,lambda) ) {
+    for (i=0; i<3; i++) {
+      if ( lambda[i] < _MMG5_EPSD )  break;
+      h    = (1.0-s) + s/sqrt(lambda[i]);
+      d[i] = 1.0 / (h*h);
+    }
+    if ( i == 3 ) {
+      _MMG5_recomp3d(sq,w,d,mr);
+      return;
+    }
+  }
+  /* degenerate metrics: linear interpolation of the tensors */
+  for (i=0; i<6; i++)
+    mr[i] = (1.0-s)*m[i] + s*n[i];
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param iso isotropic size prescribed by the geometric approximation.
+ * \param ib indices of the vertices of the block.
+ * \param nb number of vertices in the block (at most \ref _MMG5_EIGBATCH).
+ * \param lmin minimal eigenvalue.
+ * \param lmax maximal eigenvalue.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Truncate the eigenvalues of the metrics of a block of vertices in
+ * \f$[max(lmin,lgeo),lmax]\f$, where \f$lgeo\f$ is the eigenvalue associated
+ * to the size \a iso (the metrics are diagonalized together).
+ *
+ */
+static int _MMG5_truncmet(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol iso,
+                          int *ib,int nb,double lmin,double lmax) {
+  double  mb[6*_MMG5_EIGBATCH],lambda[3*_MMG5_EIGBATCH],v[9*_MMG5_EIGBATCH];
+  double  *m,*vp,*lb,lgeo,lm;
+  int     k,ier;
+  char    i,j,l;
+
+  for (k=0; k<nb; k++)
+    memcpy(&mb[6*k],&met->m[6*ib[k]+1],6*sizeof(double));
+
+  ier = _MMG5_eigensym3_batch(nb,mb,lambda,v);
+  if ( ier < nb ) {
+    fprintf(stdout,"  ## Error: unable to diagonalize the metric at"
+            " vertex %d.\n",ib[ier]);
+    return(0);
+  }
+
+  for (k=0; k<nb; k++) {
+    m  = &met->m[6*ib[k]+1];
+    lb = &lambda[3*k];
+    vp = &v[9*k];
+
+    lgeo = MG_MAX(mesh->info.hmin,iso->m[ib[k]]);
+    lgeo = MG_MIN(lmax,1.0 / (lgeo*lgeo));
+    lm   = MG_MAX(lmin,lgeo);
+    for (l=0; l<3; l++)
+      lb[l] = MG_MIN(lmax,MG_MAX(lm,lb[l]));
+
+    for (i=0,j=0; i<3; i++) {
+      for (l=i; l<3; l++,j++)
+        m[j] = lb[0]*vp[i]*vp[l] + lb[1]*vp[3+i]*vp[3+l]
+          + lb[2]*vp[6+i]*vp[6+l];
+    }
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ *
+ * Update the qualities of the tetrahedra visited by the adaptation loops in
+ * the current metric.
+ *
+ */
+static void _MMG5_updqua_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pTetra   pt;
+  int           k,l;
+
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    pt->qual = _MMG5_orcal(mesh,met,k);
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Define the anisotropic size map: the prescribed metric is intersected with
+ * the isotropic size required by the geometric approximation at boundary
+ * vertices (see \ref _MMG5_defsiz_iso) and its sizes are truncated by hmin
+ * and hmax. Once the mesh is frozen, only the metrics at the vertices of the
+ * listed tetrahedra are modified.
+ *
+ */
+int _MMG5_defsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pPoint   ppt;
+  MMG5_Sol      iso;
+  double        lmin,lmax;
+  int           k,nb,base,ib[_MMG5_EIGBATCH];
+
+  if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+    fprintf(stdout,"  ** Defining anisotropic map\n");
+
+  if ( mesh->info.hmax < 0.0 )  mesh->info.hmax = 0.5 * mesh->info.delta;
+
+  /* isotropic size prescribed by the geometric approximation */
+  memset(&iso,0,sizeof(MMG5_Sol));
+  if ( !_MMG5_defsiz_iso(mesh,&iso) )  return(0);
+
+  base = ++mesh->base;
+  _MMG5_setPtFlags(mesh,base);
+
+  lmin = 1.0 / (mesh->info.hmax*mesh->info.hmax);
+  lmax = 1.0 / (mesh->info.hmin*mesh->info.hmin);
+  nb   = 0;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( MG_VOK(ppt) && ppt->flag == base )  ib[nb++] = k;
+    if ( nb < _MMG5_EIGBATCH && k < mesh->np )  continue;
+
+    if ( nb && !_MMG5_truncmet(mesh,met,&iso,ib,nb,lmin,lmax) ) {
+      _MMG5_DEL_MEM(mesh,iso.m,(iso.size*iso.npmax+1)*sizeof(double));
+      return(0);
+    }
+    nb = 0;
+  }
+
+  _MMG5_DEL_MEM(mesh,iso.m,(iso.size*iso.npmax+1)*sizeof(double));
+  _MMG5_updqua_ani(mesh,met);
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param ip0 index of the vertex whose metric is propagated.
+ * \param ip1 index of the vertex whose metric is graded.
+ * \return 1 if the metric at \a ip1 has been modified, 0 otherwise.
+ *
+ * Intersect the metric at \a ip1 with the metric at \a ip0 grown along the
+ * edge \f$[ip0;ip1]\f$ (sizes increase linearly with the rate hgrad).
+ *
+ */
+static int _MMG5_grad2met(MMG5_pMesh mesh,MMG5_pSol met,int ip0,int ip1) {
+  MMG5_pPoint   p0,p1;
+  double        *m0,*m1,n[6],sq[3][3],w[3][3],lambda[3],d[3],u[3],l,eta;
+  char          i,nu;
+
+  p0 = &mesh->point[ip0];
+  p1 = &mesh->point[ip1];
+  m0 = &met->m[6*ip0+1];
+  m1 = &met->m[6*ip1+1];
+
+  u[0] = p1->c[0] - p0->c[0];
+  u[1] = p1->c[1] - p0->c[1];
+  u[2] = p1->c[2] - p0->c[2];
+  l    = m0[0]*u[0]*u[0] + m0[3]*u[1]*u[1] + m0[5]*u[2]*u[2]
+    + 2.0*(m0[1]*u[0]*u[1] + m0[2]*u[0]*u[2] + m0[4]*u[1]*u[2]);
+  if ( l < _MMG5_EPSD )  return(0);
+
+  /* metric of ip0 grown up to ip1 */
+  eta = 1.0 + mesh->info.hgrad*sqrt(l);
+  eta = 1.0 / (eta*eta);
+  for (i=0; i<6; i++)  n[i] = eta*m0[i];
+
+  if ( !_MMG5_simred3d(m1,n,sq,w,lambda) )  return(0);
+
+  nu = 0;
+  for (i=0; i<3; i++) {
+    if ( lambda[i] > 1.0 + _MMG5_EPSGRAD ) {
+      d[i] = lambda[i];
+      nu   = 1;
+    }
+    else
+      d[i] = 1.0;
+  }
+  if ( !nu )  return(0);
+
+  _MMG5_recomp3d(sq,w,d,m1);
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 1.
+ *
+ * Enforce mesh gradation by intersecting the metrics along the edges.
+ *
+ */
+int _MMG5_gradsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pTetra   pt;
+  MMG5_pPoint   p0,p1;
+  int           ip0,ip1,it,maxit,nu,nup,k,l;
+  char          ia;
+
+  if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+    fprintf(stdout,"  ** Grading mesh\n");
+
+  _MMG5_setPtFlags(mesh,mesh->base);
+
+  it = nup = 0;
+  maxit = 100;
+  do {
+    mesh->base++;
+    nu = 0;
+    for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+      k  = _MMG5_EACT(mesh,l);
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+
+      for (ia=0; ia<6; ia++) {
+        ip0 = pt->v[_MMG5_iare[ia][0]];
+        ip1 = pt->v[_MMG5_iare[ia][1]];
+        p0  = &mesh->point[ip0];
+        p1  = &mesh->point[ip1];
+        if ( p0->flag < mesh->base-1 && p1->flag < mesh->base-1 )  continue;
+
+        if ( _MMG5_grad2met(mesh,met,ip0,ip1) ) {
+          p1->flag = mesh->base;
+          nu++;
+        }
+        if ( _MMG5_grad2met(mesh,met,ip1,ip0) ) {
+          p0->flag = mesh->base;
+          nu++;
+        }
+      }
+    }
+    nup += nu;
+  }
+  while( ++it < maxit && nu > 0 );
+
+  if ( abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     gradation: %7d updated, %d iter.\n",nup,it);
+
+  if ( nup )  _MMG5_updqua_ani(mesh,met);
+  return(1);
+}
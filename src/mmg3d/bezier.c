@@ -319,7 +319,8 @@ _MMG5_BezierEdge(MMG5_pMesh mesh,int ip0,int ip1,double b0[3],double b1[3],char
  * \todo merge with the _MMG5_mmg3dBeizerCP function and remove the pointer
  * toward this functions.
  */
-int _MMG5_mmg3dBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori) {
+static int
+_MMG5_mmg3dComputeBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori) {
   MMG5_pPoint    p[3];
   MMG5_xPoint   *pxp;
   double        *n1,*n2,nt[3],t1[3],t2[3],ps,ps2,dd,ux,uy,uz,l,ll,alpha;
@@ -533,6 +534,68 @@ int _MMG5_mmg3dBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori)
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the triangle structure.
+ * \param g computed vertex data.
+ *
+ * Store the normals and tangents read by \ref _MMG5_mmg3dComputeBezierCP at
+ * the vertices of \a pt (the Bezier patch of \a pt is unchanged as long as
+ * this data and the vertex coordinates and tags are unchanged).
+ *
+ */
+static inline void
+_MMG5_mmg3dBezierSnp(MMG5_pMesh mesh,MMG5_Tria *pt,double g[3][_MMG5_BEZSNP]) {
+  MMG5_pPoint    p0;
+  MMG5_xPoint   *pxp;
+  char           i;
+
+  memset(g,0,3*_MMG5_BEZSNP*sizeof(double));
+  for (i=0; i<3; i++) {
+    p0 = &mesh->point[pt->v[i]];
+    if ( MG_SIN(p0->tag) || !p0->xp )  continue;
+    pxp = &mesh->xpoint[p0->xp];
+    if ( p0->tag & MG_NOM )
+      memcpy(&g[i][6],pxp->t,3*sizeof(double));
+    else if ( MG_EDG(p0->tag) ) {
+      memcpy(&g[i][0],pxp->n1,3*sizeof(double));
+      memcpy(&g[i][3],pxp->n2,3*sizeof(double));
+      memcpy(&g[i][6],pxp->t,3*sizeof(double));
+    }
+    else
+      memcpy(&g[i][0],pxp->n1,3*sizeof(double));
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the triangle structure.
+ * \param pb pointer toward the computed Bezier structure.
+ * \param ori triangle orientation.
+ * \return 1.
+ *
+ * Get the Bezier control points on triangle \a pt from the cache of the
+ * boundary faces, compute and store them if the face isn't cached or if one of
+ * its vertices has been modified.
+ *
+ */
+int _MMG5_mmg3dBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori) {
+  _MMG5_pBezCache  pc;
+  double           g[3][_MMG5_BEZSNP];
+  int              ier;
+
+  _MMG5_mmg3dBezierSnp(mesh,pt,g);
+  if ( _MMG5_bezierGetCP(mesh,pt,ori,g,pb,&pc) )  return(1);
+
+  _MMG5_PROF_IN(mesh,_MMG5_PT_bezier);
+  ier = _MMG5_mmg3dComputeBezierCP(mesh,pt,pb,ori);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_bezier);
+  if ( !ier )  return(0);
+  _MMG5_bezierPutCP(mesh,pc,pt,ori,g,pb);
+
+  return(1);
+}
+
 /**
  * \param pb pointer toward the Bezier structure.
  * \param uv coordinates of the point in the parametric space.
@@ -0,0 +1,427 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/bgmesh.c
+ * \brief Size map given on a background mesh.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The size map is evaluated at the vertices of the mesh (at the beginning of
+ * the remeshing and at each vertex creation) by interpolation in the
+ * tetrahedron of the background mesh containing the vertex. This tetrahedron
+ * is found by a walk through the adjacencies of the background mesh, started
+ * from a tetrahedron stored in a regular grid (or from the last tetrahedron
+ * found if the grid cell is empty). The background mesh is never scaled: the
+ * coordinates and the sizes are converted at each evaluation.
+ *
+ */
+
+#include "mmg3d.h"
+
+#define _MMG5_BGMCELL  8     /**< mean number of tetrahedra per grid cell */
+#define _MMG5_BGMGRID  128   /**< max number of grid cells per direction */
+#define _MMG5_BGMWALK  1000  /**< max number of steps of a walk */
+#define _MMG5_BGMEPS   1.e-10
+
+/**
+ * \param bgm pointer toward the background mesh structure.
+ * \param c point coordinates (in the frame of the background mesh).
+ * \return index of the grid cell containing \a c.
+ *
+ */
+static inline int _MMG5_bgmCell(_MMG5_pBgm bgm,double c[3]) {
+  int  i,ic[3];
+
+  for (i=0; i<3; i++) {
+    ic[i] = (int)((c[i]-bgm->min[i])*bgm->dx);
+    ic[i] = MG_MAX(0,MG_MIN(bgm->nx-1,ic[i]));
+  }
+  return( (ic[2]*bgm->nx + ic[1])*bgm->nx + ic[0] );
+}
+
+/**
+ * \param bmesh pointer toward the background mesh.
+ * \param k index of a tetrahedron of \a bmesh.
+ * \param c point coordinates.
+ * \param bc barycentric coordinates of \a c in \a k.
+ * \return the index of the smallest barycentric coordinate.
+ *
+ */
+static inline char _MMG5_bgmBary(MMG5_pMesh bmesh,int k,double c[3],
+                                 double bc[4]) {
+  MMG5_pTetra  pt;
+  double       *a,*b,*d,*e,vol;
+  char         i,imin;
+
+  pt = &bmesh->tetra[k];
+  a  = bmesh->point[pt->v[0]].c;
+  b  = bmesh->point[pt->v[1]].c;
+  d  = bmesh->point[pt->v[2]].c;
+  e  = bmesh->point[pt->v[3]].c;
+
+  vol   = _MMG5_det4pt(a,b,d,e);
+  if ( fabs(vol) < _MMG5_EPSD2 ) {
+    bc[0] = bc[1] = bc[2] = bc[3] = 0.25;
+    return(0);
+  }
+  vol   = 1.0 / vol;
+  bc[0] = _MMG5_det4pt(c,b,d,e) * vol;
+  bc[1] = _MMG5_det4pt(a,c,d,e) * vol;
+  bc[2] = _MMG5_det4pt(a,b,c,e) * vol;
+  bc[3] = 1.0 - bc[0] - bc[1] - bc[2];
+
+  imin = 0;
+  for (i=1; i<4; i++)
+    if ( bc[i] < bc[imin] )  imin = i;
+
+  return(imin);
+}
+
+/**
+ * \param bgm pointer toward the background mesh structure.
+ * \param c point coordinates (in the frame of the background mesh).
+ * \param bc barycentric coordinates of \a c in the returned tetrahedron
+ * (clamped to the tetrahedron if \a c is outside the background mesh).
+ * \return the tetrahedron of the background mesh containing \a c (or the
+ * closest boundary tetrahedron).
+ *
+ * Walk toward the point \a c by crossing the face of smallest barycentric
+ * coordinate. If the walk doesn't end (degenerate background mesh), the
+ * tetrahedron of largest minimal barycentric coordinate is searched.
+ *
+ */
+static int _MMG5_bgmLocate(_MMG5_pBgm bgm,double c[3],double bc[4]) {
+  MMG5_pMesh  bmesh;
+  double      bb[4],best,dd;
+  int         k,kbest,jel,it;
+  char        i,imin;
+
+  bmesh = bgm->mesh;
+  bgm->nloc++;
+
+  k = bgm->grid[_MMG5_bgmCell(bgm,c)];
+  if ( !k )  k = bgm->last;
+
+  for (it=0; it<_MMG5_BGMWALK; it++) {
+    imin = _MMG5_bgmBary(bmesh,k,c,bc);
+    if ( bc[(int)imin] > -_MMG5_BGMEPS )  break;
+
+    jel = bmesh->adja[4*(k-1)+1+imin] / 4;
+    if ( !jel )  break;
+    k = jel;
+  }
+  bgm->nwalk += it;
+
+  if ( it == _MMG5_BGMWALK ) {
+    /* the walk loops: exhaustive search */
+    bgm->nfail++;
+    kbest = k;
+    best  = -DBL_MAX;
+    for (k=1; k<=bmesh->ne; k++) {
+      if ( !MG_EOK(&bmesh->tetra[k]) )  continue;
+      imin = _MMG5_bgmBary(bmesh,k,c,bb);
+      if ( bb[(int)imin] > best ) {
+        best  = bb[(int)imin];
+        kbest = k;
+        memcpy(bc,bb,4*sizeof(double));
+      }
+    }
+    k = kbest;
+  }
+
+  /* point outside the background mesh: clamp the barycentric coordinates */
+  dd = 0.0;
+  for (i=0; i<4; i++) {
+    bc[i]  = MG_MAX(0.0,bc[i]);
+    dd    += bc[i];
+  }
+  dd = 1.0 / dd;
+  for (i=0; i<4; i++)  bc[i] *= dd;
+
+  bgm->last = k;
+  return(k);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param c point coordinates (in the frame of \a mesh).
+ * \param m computed size (1 value) or metric (6 values), in the frame of
+ * \a mesh.
+ *
+ * Interpolate the size map of the background mesh at \a c.
+ *
+ */
+static void _MMG5_bgmEval(MMG5_pMesh mesh,double c[3],double *m) {
+  _MMG5_pBgm   bgm;
+  MMG5_pTetra  pt;
+  MMG5_pSol    bmet;
+  double       cb[3],bc[4],dd;
+  int          k,size;
+  char         i,j;
+
+  bgm  = mesh->bgm;
+  bmet = bgm->met;
+  size = bmet->size;
+
+  /* the mesh is scaled, not the background mesh */
+  if ( bgm->scaled ) {
+    for (i=0; i<3; i++)
+      cb[i] = c[i]*mesh->info.delta + mesh->info.min[i];
+  }
+  else
+    memcpy(cb,c,3*sizeof(double));
+
+  k  = _MMG5_bgmLocate(bgm,cb,bc);
+  pt = &bgm->mesh->tetra[k];
+
+  for (j=0; j<size; j++) {
+    m[j] = 0.0;
+    for (i=0; i<4; i++)
+      m[j] += bc[i]*bmet->m[size*pt->v[i]+(size==1 ? 0 : 1)+j];
+  }
+
+  if ( !bgm->scaled )  return;
+  if ( size == 1 )
+    m[0] /= mesh->info.delta;
+  else {
+    dd = mesh->info.delta*mesh->info.delta;
+    for (j=0; j<6; j++)  m[j] *= dd;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param m metric to truncate.
+ *
+ * Truncate the eigenvalues of \a m to the sizes \f$[hmin,hmax]\f$.
+ *
+ */
+static void _MMG5_bgmTrunc(MMG5_pMesh mesh,double *m) {
+  double  lambda[3],v[3][3],lmin,lmax;
+  char    i,j,l;
+
+  if ( !_MMG5_eigensym3(m,lambda,v) )  return;
+
+  lmin = 1.0 / (mesh->info.hmax*mesh->info.hmax);
+  lmax = 1.0 / (mesh->info.hmin*mesh->info.hmin);
+  for (l=0; l<3; l++)
+    lambda[l] = MG_MIN(lmax,MG_MAX(lmin,lambda[l]));
+
+  for (i=0,j=0; i<3; i++) {
+    for (l=i; l<3; l++,j++)
+      m[j] = lambda[0]*v[0][i]*v[0][l] + lambda[1]*v[1][i]*v[1][l]
+        + lambda[2]*v[2][i]*v[2][l];
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np index of the first extremity of the edge.
+ * \param nq index of the second extremity of the edge.
+ * \param ip index of the new point.
+ * \param s parameter of the new point along the edge \f$[np;nq]\f$.
+ *
+ * Size at the new point \a ip interpolated from the background mesh and
+ * truncated by hmin and hmax (\a np, \a nq and \a s are unused).
+ *
+ */
+void _MMG5_intmet_bgm(MMG5_pMesh mesh,MMG5_pSol met,int np,int nq,int ip,
+                      double s) {
+  double  *m;
+
+  if ( met->size == 1 ) {
+    m = &met->m[ip];
+    _MMG5_bgmEval(mesh,mesh->point[ip].c,m);
+    *m = MG_MIN(mesh->info.hmax,MG_MAX(mesh->info.hmin,*m));
+  }
+  else {
+    m = &met->m[6*ip+1];
+    _MMG5_bgmEval(mesh,mesh->point[ip].c,m);
+    _MMG5_bgmTrunc(mesh,m);
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Replace the solution \a met by the interpolation of the size map of the
+ * background mesh at the vertices of \a mesh (the mesh is not scaled yet).
+ *
+ */
+int _MMG5_bgmSetSol(MMG5_pMesh mesh,MMG5_pSol met) {
+  _MMG5_pBgm   bgm;
+  MMG5_pPoint  ppt;
+  int          k,size;
+
+  bgm  = mesh->bgm;
+  size = bgm->met->size;
+
+  if ( met->m )
+    _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
+
+  met->size  = size;
+  met->dim   = 3;
+  met->ver   = 2;
+  met->np    = mesh->np;
+  met->npmax = mesh->npmax;
+  _MMG5_ADD_MEM(mesh,(size*(met->npmax+1)+1)*sizeof(double),
+                "initial solution",return(0));
+  _MMG5_SAFE_CALLOC(met->m,size*(met->npmax+1)+1,double);
+
+  bgm->scaled = 0;
+  bgm->nloc   = bgm->nwalk = bgm->nfail = 0;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) )  continue;
+    _MMG5_bgmEval(mesh,ppt->c,&met->m[size==1 ? k : 6*k+1]);
+  }
+  bgm->scaled = 1;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Print the statistics of the localizations in the background mesh.
+ *
+ */
+void _MMG5_bgmStats(MMG5_pMesh mesh) {
+  _MMG5_pBgm  bgm;
+
+  bgm = mesh->bgm;
+  if ( !bgm || !bgm->nloc )  return;
+
+  fprintf(stdout,"     BACKGROUND MESH: %d LOCALIZATIONS, %.2f STEPS/WALK,"
+          " %d EXHAUSTIVE SEARCHES\n",bgm->nloc,(double)bgm->nwalk/bgm->nloc,
+          bgm->nfail);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Free the background mesh structure (the background mesh and its size map
+ * are owned by the user).
+ *
+ */
+void _MMG5_bgmFree(MMG5_pMesh mesh) {
+  _MMG5_pBgm  bgm;
+
+  bgm = mesh->bgm;
+  if ( !bgm )  return;
+
+  if ( bgm->grid )
+    _MMG5_DEL_MEM(mesh,bgm->grid,bgm->nx*bgm->nx*bgm->nx*sizeof(int));
+  _MMG5_DEL_MEM(mesh,mesh->bgm,sizeof(_MMG5_Bgm));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bmesh pointer toward the background mesh.
+ * \param bmet pointer toward the size map at the vertices of \a bmesh.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Build the adjacencies of the background mesh and the grid of seeds of the
+ * walks.
+ *
+ */
+int _MMG5_bgmNew(MMG5_pMesh mesh,MMG5_pMesh bmesh,MMG5_pSol bmet) {
+  _MMG5_pBgm   bgm;
+  MMG5_pTetra  pt;
+  MMG5_pPoint  ppt;
+  double       c[3],dd;
+  int          k,nc;
+  char         i,j;
+
+  _MMG5_bgmFree(mesh);
+
+  if ( !bmesh->ne || !bmesh->tetra ) {
+    fprintf(stdout,"  ## Error: background mesh without tetrahedra.\n");
+    return(0);
+  }
+  if ( !bmet->m || bmet->np != bmesh->np
+       || (bmet->size != 1 && bmet->size != 6) ) {
+    fprintf(stdout,"  ## Error: wrong size map on the background mesh.\n");
+    return(0);
+  }
+
+  /* adjacencies (the numbering of the background mesh is kept) */
+  if ( !bmesh->adja && !_MMG5_hashTetra(bmesh,0) )  return(0);
+
+  _MMG5_ADD_MEM(mesh,sizeof(_MMG5_Bgm),"background mesh",return(0));
+  _MMG5_SAFE_CALLOC(mesh->bgm,1,_MMG5_Bgm);
+  bgm       = mesh->bgm;
+  bgm->mesh = bmesh;
+  bgm->met  = bmet;
+
+  /* bounding box */
+  for (i=0; i<3; i++) {
+    bgm->min[i] =  DBL_MAX;
+    c[i]        = -DBL_MAX;
+  }
+  for (k=1; k<=bmesh->np; k++) {
+    ppt = &bmesh->point[k];
+    for (i=0; i<3; i++) {
+      bgm->min[i] = MG_MIN(bgm->min[i],ppt->c[i]);
+      c[i]        = MG_MAX(c[i],ppt->c[i]);
+    }
+  }
+  dd = MG_MAX(c[0]-bgm->min[0],MG_MAX(c[1]-bgm->min[1],c[2]-bgm->min[2]));
+  if ( dd < _MMG5_EPSD ) {
+    fprintf(stdout,"  ## Error: degenerate background mesh.\n");
+    _MMG5_bgmFree(mesh);
+    return(0);
+  }
+
+  /* grid of about _MMG5_BGMCELL tetrahedra per cell */
+  nc = (int)(pow((double)bmesh->ne/_MMG5_BGMCELL,1.0/3.0));
+  bgm->nx = MG_MAX(1,MG_MIN(_MMG5_BGMGRID,nc));
+  bgm->dx = (double)bgm->nx / (dd*(1.0+_MMG5_BGMEPS));
+
+  nc = bgm->nx*bgm->nx*bgm->nx;
+  _MMG5_ADD_MEM(mesh,nc*sizeof(int),"background mesh grid",
+                _MMG5_bgmFree(mesh);
+                return(0));
+  _MMG5_SAFE_CALLOC(bgm->grid,nc,int);
+
+  for (k=1; k<=bmesh->ne; k++) {
+    pt = &bmesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (j=0; j<3; j++) {
+      c[j] = 0.0;
+      for (i=0; i<4; i++)  c[j] += 0.25*bmesh->point[pt->v[i]].c[j];
+    }
+    bgm->grid[_MMG5_bgmCell(bgm,c)] = k;
+    if ( !bgm->last )  bgm->last = k;
+  }
+
+  return(1);
+}
@@ -247,6 +247,100 @@ int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param start tetra containing the point.
+ * \param ip local index of the point in \a start.
+ * \param n computed normal at the point.
+ * \param t computed tangent at the point.
+ * \return 0 if the point is singular (it does not have exactly two non
+ * manifold edges), 1 otherwise.
+ *
+ * Define normal and tangent vectors at a non manifold point whose ball does not
+ * touch the outer boundary (line along which three sub-domains or more meet):
+ * the tangent follows the two non manifold edges of the point and the normal
+ * is the one of an interface face of the ball.
+ *
+ */
+int _MMG5_boulenmint(MMG5_pMesh mesh,int start,int ip,double n[3],double t[3]) {
+  MMG5_pTetra   pt;
+  MMG5_pxTetra  pxt;
+  MMG5_pPoint   p0,p1,ppt;
+  double        dd,l0,l1;
+  int           list[_MMG5_LMAX+2],ilist,nump,k,l,ip0,ip1,nb,nf;
+  char          i,j;
+
+  ilist = _MMG5_boulevolp(mesh,start,ip,list);
+  if ( !ilist )  return(0);
+
+  nump = mesh->tetra[start].v[ip];
+  ip0  = ip1 = nf = 0;
+
+  for (l=0; l<ilist; l++) {
+    k  = list[l] / 4;
+    i  = list[l] % 4;
+    pt = &mesh->tetra[k];
+    if ( !pt->xt )  continue;
+    pxt = &mesh->xtetra[pt->xt];
+
+    for (j=0; j<4; j++) {
+      if ( nf )  break;
+      if ( j == i || !(pxt->ftag[j] & MG_BDY) )  continue;
+      nf = _MMG5_norface(mesh,k,j,n);
+    }
+
+    for (j=0; j<6; j++) {
+      if ( !(pxt->tag[j] & MG_NOM) )  continue;
+      if ( _MMG5_iare[j][0] == i )
+        nb = pt->v[_MMG5_iare[j][1]];
+      else if ( _MMG5_iare[j][1] == i )
+        nb = pt->v[_MMG5_iare[j][0]];
+      else
+        continue;
+
+      if ( nb == ip0 || nb == ip1 )  continue;
+      if ( !ip0 )
+        ip0 = nb;
+      else if ( !ip1 )
+        ip1 = nb;
+      else
+        return(0);
+    }
+  }
+  if ( !nf || !ip1 )  return(0);
+
+  p0  = &mesh->point[ip0];
+  p1  = &mesh->point[ip1];
+  ppt = &mesh->point[nump];
+
+  l0 = (p0->c[0] - ppt->c[0])*(p0->c[0] - ppt->c[0]) \
+    + (p0->c[1] - ppt->c[1])*(p0->c[1] - ppt->c[1]) + (p0->c[2] - ppt->c[2])*(p0->c[2] - ppt->c[2]);
+  l1 = (p1->c[0] - ppt->c[0])*(p1->c[0] - ppt->c[0]) \
+    + (p1->c[1] - ppt->c[1])*(p1->c[1] - ppt->c[1]) + (p1->c[2] - ppt->c[2])*(p1->c[2] - ppt->c[2]);
+  if ( (l0 < _MMG5_EPSD2) || (l1 < _MMG5_EPSD2) )  return(0);
+  l0 = 1.0 / sqrt(l0);
+  l1 = 1.0 / sqrt(l1);
+
+  /* tangent: bisector of the two non manifold edges */
+  t[0] = l1*(p1->c[0] - ppt->c[0]) - l0*(p0->c[0] - ppt->c[0]);
+  t[1] = l1*(p1->c[1] - ppt->c[1]) - l0*(p0->c[1] - ppt->c[1]);
+  t[2] = l1*(p1->c[2] - ppt->c[2]) - l0*(p0->c[2] - ppt->c[2]);
+
+  dd = t[0]*n[0] + t[1]*n[1] + t[2]*n[2];
+  t[0] -= dd*n[0];
+  t[1] -= dd*n[1];
+  t[2] -= dd*n[2];
+
+  dd = t[0]*t[0] + t[1]*t[1] + t[2]*t[2];
+  if ( dd < _MMG5_EPSD2 )  return(0);
+  dd = 1.0 / sqrt(dd);
+  t[0] *= dd;
+  t[1] *= dd;
+  t[2] *= dd;
+
+  return(1);
+}
+
 /** Return volumic ball of a surfacic point p, as well as the part of its surfacic ball
     supported in the outer boundary starting from tet start, with point ip, and face if in tetra
     volumic ball ; list[k] = 4*number of tet + index of point
@@ -658,7 +752,8 @@ _MMG5_settag(MMG5_pMesh mesh,int start,int ia,int tag,int edg) {
 /** Find all tets sharing edge ia of tetra start
     return 2*ilist if shell is closed, 2*ilist +1 otherwise
     return 0 if one of the tet of the shell is required */
-int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
+static _MMG5_ALWAYS_INLINE int
+_MMG5_coquil_spe(MMG5_pMesh mesh,int start,int ia,int * list) {
   MMG5_pTetra  pt;
   int     ilist,*adja,piv,adj,na,nb,ipa,ipb;
   char    i;
@@ -783,6 +878,20 @@ int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
   return( 2*ilist+1 );
 }
 
+/** Find all tets sharing edge ia of tetra start (see \ref _MMG5_coquil_spe),
+    timed if the profiler is on */
+int _MMG5_coquil(MMG5_pMesh mesh,int start,int ia,int * list) {
+  int     ilist;
+
+  if ( !mesh->prof )  return(_MMG5_coquil_spe(mesh,start,ia,list));
+
+  _MMG5_profIn(mesh->prof,_MMG5_PT_coquil);
+  ilist = _MMG5_coquil_spe(mesh,start,ia,list);
+  _MMG5_profOut(mesh->prof,_MMG5_PT_coquil);
+
+  return(ilist);
+}
+
 /** Identify whether edge ia in start is a boundary edge by unfolding its shell */
 int _MMG5_srcbdy(MMG5_pMesh mesh,int start,int ia) {
   MMG5_pTetra      pt;
@@ -114,3 +114,67 @@ int _MMG5_cenrad_iso(MMG5_pMesh mesh,double *ct,double *c,double *rad) {
 
   return(1);
 }
+
+/**
+ * \param mesh Pointer toward the mesh structure.
+ * \param *ct coordinates of vertices of the element.
+ * \param *m metric in which the circumscribing sphere is computed.
+ * \param *c center of circumscribing sphere to the element.
+ * \param *rad squared radius of circumscribing sphere to the element in the
+ * metric \a m.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Compute radius and center of circumscribing sphere to the element in the
+ * metric \a m.
+ *
+ */
+int _MMG5_cenrad_ani(MMG5_pMesh mesh,double *ct,double *m,double *c,double *rad) {
+  double      a[3][3],b[3],u[3],mu[3],*c0,*ci,dd,det,inv[3][3],ux,uy,uz;
+  char        i;
+
+  c0 = &ct[0];
+  for (i=0; i<3; i++) {
+    ci = &ct[3*(i+1)];
+    u[0] = ci[0] - c0[0];
+    u[1] = ci[1] - c0[1];
+    u[2] = ci[2] - c0[2];
+
+    /* M u and u^t M (ci+c0) */
+    mu[0] = m[0]*u[0] + m[1]*u[1] + m[2]*u[2];
+    mu[1] = m[1]*u[0] + m[3]*u[1] + m[4]*u[2];
+    mu[2] = m[2]*u[0] + m[4]*u[1] + m[5]*u[2];
+
+    a[i][0] = 2.0*mu[0];
+    a[i][1] = 2.0*mu[1];
+    a[i][2] = 2.0*mu[2];
+    b[i]    = mu[0]*(ci[0]+c0[0]) + mu[1]*(ci[1]+c0[1]) + mu[2]*(ci[2]+c0[2]);
+  }
+
+  /* center = solution of a c = b */
+  inv[0][0] = a[1][1]*a[2][2] - a[1][2]*a[2][1];
+  inv[0][1] = a[0][2]*a[2][1] - a[0][1]*a[2][2];
+  inv[0][2] = a[0][1]*a[1][2] - a[0][2]*a[1][1];
+  inv[1][0] = a[1][2]*a[2][0] - a[1][0]*a[2][2];
+  inv[1][1] = a[0][0]*a[2][2] - a[0][2]*a[2][0];
+  inv[1][2] = a[0][2]*a[1][0] - a[0][0]*a[1][2];
+  inv[2][0] = a[1][0]*a[2][1] - a[1][1]*a[2][0];
+  inv[2][1] = a[0][1]*a[2][0] - a[0][0]*a[2][1];
+  inv[2][2] = a[0][0]*a[1][1] - a[0][1]*a[1][0];
+
+  det = a[0][0]*inv[0][0] + a[0][1]*inv[1][0] + a[0][2]*inv[2][0];
+  if ( fabs(det) < _MMG5_EPSD )  return(0);
+  dd = 1.0 / det;
+
+  c[0] = dd * (inv[0][0]*b[0] + inv[0][1]*b[1] + inv[0][2]*b[2]);
+  c[1] = dd * (inv[1][0]*b[0] + inv[1][1]*b[1] + inv[1][2]*b[2]);
+  c[2] = dd * (inv[2][0]*b[0] + inv[2][1]*b[1] + inv[2][2]*b[2]);
+
+  /* radius (squared) */
+  ux = c[0] - c0[0];
+  uy = c[1] - c0[1];
+  uz = c[2] - c0[2];
+  *rad =      m[0]*ux*ux + m[3]*uy*uy + m[5]*uz*uz \
+    + 2.0*(m[1]*ux*uy + m[2]*ux*uz + m[4]*uy*uz);
+
+  return(1);
+}
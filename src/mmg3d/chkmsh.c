@@ -505,22 +505,23 @@ int _MMG5_cntbdypt(MMG5_pMesh mesh, int nump){
 }
 
 /** Count the number of tetras that have several boundary faces, as well as the number of internal
-    edges connecting points of the boundary */
+    edges connecting points of the boundary (in the remeshed region once the mesh is frozen,
+    see \ref _MMG5_NEACT) */
 int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
   MMG5_pTetra      pt,pt1;
   MMG5_pxTetra     pxt;
   MMG5_pPoint      p0,p1;
-  int         k,nf,ntet,ned,np,ischk,ilist,list[_MMG5_LMAX+2],l,np1,npchk,iel;
+  int         k,nf,ntet,ned,np,ischk,ilist,list[_MMG5_LMAX+2],l,np1,npchk,iel,m;
   char        i0,j,i,i1,ia;
 
   ntet = ned = 0;
-  for(k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = 0;
+  _MMG5_setPtFlags(mesh,0);
 
   /* Count elements with at least two boundary faces */
-  for (k=1; k<=mesh->ne; k++) {
+  for (m=1; m<=_MMG5_NEACT(mesh); m++) {
+    k  = _MMG5_EACT(mesh,m);
     pt = &mesh->tetra[k];
-    if ( !MG_EOK(pt) )  continue;
+    if ( !MG_EOK(pt) || (pt->tag & MG_FRZ) )  continue;
     else if ( !pt->xt ) continue;
     pxt = &mesh->xtetra[pt->xt];
 
@@ -533,9 +534,10 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
   if ( ntet )  printf("  *** %d tetras with at least 2 boundary faces.\n",ntet);
 
   /* Count internal edges connecting two points of the boundary */
-  for (k=1; k<=mesh->ne; k++) {
+  for (m=1; m<=_MMG5_NEACT(mesh); m++) {
+    k  = _MMG5_EACT(mesh,m);
     pt = &mesh->tetra[k];
-    if ( !MG_EOK(pt) )  continue;
+    if ( !MG_EOK(pt) || (pt->tag & MG_FRZ) )  continue;
 
     for (i=0; i<4; i++) {
       np = pt->v[i];
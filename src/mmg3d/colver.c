@@ -38,70 +38,104 @@
 extern char  ddb;
 
 /** Check whether collapse ip -> iq could be performed, ip internal ;
- *  'mechanical' tests (positive jacobian) are not performed here */
-int _MMG5_chkcol_int(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
-                     char iedg,int *list,char typchk) {
-  MMG5_pTetra   pt,pt0;
+ *  'mechanical' tests (positive jacobian) are not performed here ;
+ *  ani = 1 to measure lengths and qualities in the aniso metric */
+static _MMG5_ALWAYS_INLINE int
+_MMG5_chkcol_int_spe(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,char iedg,
+                     int *list,char typchk,const char ani) {
+  MMG5_pTetra   pt;
   MMG5_pPoint   p0;
-  double   calold,calnew,caltmp,lon;
-  int      j,iel,ilist,nq;
+  double   calold,calnew,lon,qb[_MMG5_BATCH];
+  int      j,l,nb,iel,ilist,nq,vb[4*_MMG5_BATCH];
   char     i,jj,ip,iq;
 
+  _MMG5_PROF_INC(mesh,_MMG5_PC_colatt);
   ip  = _MMG5_idir[iface][_MMG5_inxt2[iedg]];
   iq  = _MMG5_idir[iface][_MMG5_iprv2[iedg]];
   pt  = &mesh->tetra[k];
-  pt0 = &mesh->tetra[0];
   nq  = pt->v[iq];
   ilist = _MMG5_boulevolp(mesh,k,ip,list);
   lon = 1.e20;
   if ( typchk == 2 && met->m ) {
-    lon = _MMG5_lenedg(mesh,met,pt->v[ip],nq,0);
+    lon = _MMG5_LENEDG(ani,mesh,met,pt->v[ip],nq,0);
     lon = MG_MIN(lon,_MMG5_LSHRT);
     lon = MG_MAX(1.0/lon,_MMG5_LLONG);
   }
   calold = calnew = DBL_MAX;
-  for (j=0; j<ilist; j++) {
-    iel = list[j] / 4;
-    ip  = list[j] % 4;
-    pt  = &mesh->tetra[iel];
-    /* exclude elements from shell */
-    for (jj=0; jj<4; jj++)  if ( pt->v[jj] == nq )  break;
-    if ( jj < 4 )  continue;
-    memcpy(pt0,pt,sizeof(MMG5_Tetra));
+  j = 0;
+  while ( j<ilist ) {
+    /* gather a block of the new elements */
+    for (nb=0; j<ilist && nb<_MMG5_BATCH; j++) {
+      iel = list[j] / 4;
+      ip  = list[j] % 4;
+      pt  = &mesh->tetra[iel];
+      /* exclude elements from shell */
+      for (jj=0; jj<4; jj++)  if ( pt->v[jj] == nq )  break;
+      if ( jj < 4 )  continue;
+
+      /* prevent from recreating internal edge between boundaries */
+      if ( mesh->info.fem ) {
+        p0 = &mesh->point[nq];
+        if ( p0->tag & MG_BDY ) {
+          i = ip;
+          for (jj=0; jj<3; jj++) {
+            i = _MMG5_inxt3[i];
+            p0 = &mesh->point[pt->v[i]];
+            if ( p0->tag & MG_BDY ) {
+              _MMG5_PROF_INC(mesh,_MMG5_PC_colfem);
+              return(0);
+            }
+          }
+        }
+      }
 
-    /* prevent from recreating internal edge between boundaries */
-    if ( mesh->info.fem ) {
-      p0 = &mesh->point[nq];
-      if ( p0->tag & MG_BDY ) {
-        i = ip;
-        for (jj=0; jj<3; jj++) {
-          i = _MMG5_inxt3[i];
-          p0 = &mesh->point[pt->v[i]];
-          if ( p0->tag & MG_BDY )  return(0);
+      memcpy(&vb[4*nb],pt->v,4*sizeof(int));
+      vb[4*nb+ip] = nq;
+      calold = MG_MIN(calold,pt->qual);
+      /* check length */
+      if ( typchk == 2 && met->m ) {
+        for (jj=0; jj<6; jj++) {
+          if ( _MMG5_LENEDG(ani,mesh,met,vb[4*nb+_MMG5_iare[jj][0]],
+                            vb[4*nb+_MMG5_iare[jj][1]],0) > lon ) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_collen);
+            return(0);
+          }
         }
       }
+      nb++;
     }
 
-    pt0->v[ip] = nq;
-    calold = MG_MIN(calold,pt->qual);
-    caltmp = _MMG5_orcal(mesh,0);
-    if ( caltmp < _MMG5_EPSD )  return(0);
-    calnew = MG_MIN(calnew,caltmp);
-    /* check length */
-    if ( typchk == 2 && met->m ) {
-      for (jj=0; jj<6; jj++) {
-        if ( _MMG5_lenedg(mesh,met,pt0->v[_MMG5_iare[jj][0]],
-                          pt0->v[_MMG5_iare[jj][1]],0) > lon )
-          return(0);
+    /* qualities of the block */
+    _MMG5_caltet_batch(mesh,ani ? met : NULL,vb,nb,qb);
+    for (l=0; l<nb; l++) {
+      if ( qb[l] < _MMG5_EPSD ) {
+        _MMG5_PROF_INC(mesh,_MMG5_PC_colvol);
+        return(0);
       }
+      calnew = MG_MIN(calnew,qb[l]);
     }
   }
-  if ( calold < _MMG5_NULKAL && calnew <= calold )  return(0);
-  else if ( calnew < _MMG5_NULKAL || calnew < 0.3*calold )  return(0);
+  if ( (calold < _MMG5_NULKAL && calnew <= calold)
+       || calnew < _MMG5_NULKAL || calnew < 0.3*calold ) {
+    _MMG5_PROF_INC(mesh,_MMG5_PC_colqua);
+    return(0);
+  }
 
   return(ilist);
 }
 
+/** iso. instance of \ref _MMG5_chkcol_int_spe */
+int _MMG5_chkcol_int_iso(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
+                         char iedg,int *list,char typchk) {
+  return(_MMG5_chkcol_int_spe(mesh,met,k,iface,iedg,list,typchk,0));
+}
+
+/** aniso. instance of \ref _MMG5_chkcol_int_spe */
+int _MMG5_chkcol_int_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
+                         char iedg,int *list,char typchk) {
+  return(_MMG5_chkcol_int_spe(mesh,met,k,iface,iedg,list,typchk,1));
+}
+
 /** Topological check on the surface ball of np and nq in collapsing np->nq ;
  *  iface = boundary face on which lie edge iedg - in local face num.
  *  (pq, or ia in local tet notation) */
@@ -390,7 +424,7 @@ _MMG5_topchkcol_bdy(MMG5_pMesh mesh,int k,int iface,char iedg,int *lists,int ili
  *  'mechanical' tests (positive jacobian) are not performed here ;
  *  iface = boundary face on which lie edge iedg - in local face num.
  *  (pq, or ia in local tet notation) */
-int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
+int _MMG5_chkcol_bdy(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,char iedg,int *listv) {
   MMG5_pTetra        pt,pt0;
   MMG5_pxTetra       pxt;
   MMG5_pPoint        p0;
@@ -399,6 +433,7 @@ int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
   int           ipp,ilistv,nump,numq,ilists,lists[_MMG5_LMAX+2],l,iel,nbbdy,ndepmin,ndepplus;
   char          iopp,ia,ip,tag,i,iq,i0,i1,ier,isminp,isplp;
 
+  _MMG5_PROF_INC(mesh,_MMG5_PC_colatt);
   pt   = &mesh->tetra[k];
   pxt  = 0;
   pt0  = &mesh->tetra[0];
@@ -488,7 +523,7 @@ int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
     pt0->v[ipp] = numq;
 
     calold = MG_MIN(calold, pt->qual);
-    caltmp = _MMG5_orcal(mesh,0);
+    caltmp = _MMG5_orcal(mesh,met,0);
 
     if ( caltmp < _MMG5_EPSD )  return(0);
     calnew = MG_MIN(calnew,caltmp);
@@ -589,7 +624,7 @@ int _MMG5_chkcol_bdy(MMG5_pMesh mesh,int k,char iface,char iedg,int *listv) {
 /** Collapse vertex p = list[0]%4 of tetra list[0]/4 over vertex indq of tetra list[0]/4.
  *  Only physical tests (positive jacobian) are done (i.e. approximation of the surface,
  *  etc... must be performed outside). */
-int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
+int _MMG5_colver(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,char indq) {
   MMG5_pTetra          pt,pt1;
   MMG5_pxTetra         pxt,pxt1;
   MMG5_xTetra          xt,xts;
@@ -907,14 +942,8 @@ int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
               }
             }
             /* Create new field xt */
-            mesh->xt++;
-            if ( mesh->xt > mesh->xtmax ) {
-              _MMG5_TAB_RECALLOC(mesh,mesh->xtetra,mesh->xtmax,0.2,MMG5_xTetra,
-                                 "larger xtetra table",
-                                 mesh->xt--;
-                                 return(-1));
-            }
-            pt1->xt = mesh->xt;
+            pt1->xt = _MMG5_newXTet(mesh);
+            if ( !pt1->xt )  return(-1);
             pxt = &mesh->xtetra[pt1->xt];
             memcpy(pxt,pxt1,sizeof(MMG5_xTetra));
           }
@@ -1012,6 +1041,10 @@ int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
         }
       }
     }
+    /* recycle the xtetra of iel if no neighbour has recovered it */
+    if ( pt->xt && (!pel || mesh->tetra[pel].xt != pt->xt)
+         && (!qel || mesh->tetra[qel].xt != pt->xt) )
+      _MMG5_delXTet(mesh,pt->xt);
     _MMG5_delElt(mesh,iel);
   }
 
@@ -1022,7 +1055,7 @@ int _MMG5_colver(MMG5_pMesh mesh,int *list,int ilist,char indq) {
     ip  = list[k] % 4;
     pt  = &mesh->tetra[iel];
     pt->v[ip] = nq;
-    pt->qual=_MMG5_orcal(mesh,iel);
+    pt->qual=_MMG5_orcal(mesh,met,iel);
   }
   return(np);
 }
@@ -64,6 +64,7 @@ int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v)
   key = KTA*mins + KTB*maxs;
   key = key % hash->siz;
   ha  = &hash->item[key];
+  _MMG5_PROF_INC(mesh,_MMG5_PC_hashins);
 
   if ( ha->a ) {
     /* identical face */
@@ -80,6 +81,7 @@ int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v)
       return(1);
     }
     else {
+      _MMG5_PROF_INC(mesh,_MMG5_PC_hashcol);
       while ( ha->nxt && ha->nxt < hash->max ) {
         ha = &hash->item[ha->nxt];
         if ( ha->a == mins && ha->b == maxs ) {
@@ -236,7 +238,7 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
         pt1 = &mesh->tetra[iel];
         memcpy(pt1,pt,sizeof(MMG5_Tetra));
         pt1->v[i] = ip;
-        pt1->qual = _MMG5_orcal(mesh,iel);
+        pt1->qual = _MMG5_orcal(mesh,sol,iel);
         pt1->ref = mesh->tetra[old].ref;
         if(pt1->qual < 1e-10) {printf("argggg (%d) %d : %e\n",ip,iel,pt1->qual);
           printf("pt1 : %d %d %d %d\n",pt1->v[0],pt1->v[1],pt1->v[2],pt1->v[3]);/*exit(0);*/}
@@ -268,15 +270,11 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
               pxt0->ori = xt.ori;
               isused=1;
             } else {
-              mesh->xt++;
-              if ( mesh->xt > mesh->xtmax ) {
-                _MMG5_TAB_RECALLOC(mesh,mesh->xtetra,mesh->xtmax,0.2,MMG5_xTetra,
-                                   "larger xtetra table",
-                                   mesh->xt--;
-                                   printf("  Exit program.\n");
-                                   exit(EXIT_FAILURE));
+              pt1->xt = _MMG5_newXTet(mesh);
+              if ( !pt1->xt ) {
+                printf("  Exit program.\n");
+                exit(EXIT_FAILURE);
               }
-              pt1->xt = mesh->xt;
               pxt0 = &mesh->xtetra[pt1->xt];
               pxt0->ref[i]   = xt.ref[i] ; pxt0->ftag[i]  = xt.ftag[i];
               pxt0->edg[_MMG5_iarf[i][0]] = xt.edg[_MMG5_iarf[i][0]];
@@ -320,6 +318,9 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
   for (k=0; k<ilist; k++) {
     if(tref!=mesh->tetra[list[k]].ref)
       printf("arg ref ???? %d %d\n",tref,mesh->tetra[list[k]].ref);
+    /* xtetra not transmitted to a new tetra: recycle it */
+    if ( mesh->tetra[list[k]].xt )
+      _MMG5_delXTet(mesh,mesh->tetra[list[k]].xt);
     _MMG5_delElt(mesh,list[k]);
   }
 
@@ -402,6 +403,7 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
         /* remove iel from list */
         pt->mark = base-1;
         list[ipil] = list[--lon];
+        _MMG5_PROF_INC(mesh,_MMG5_PC_cavcor);
 
         ncor = 1;
         break;
@@ -416,126 +418,11 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
 }
 
 
-/* /\* mark elements in cavity *\/ */
-/* int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,pList list,int lon) { */
-/*   MMG5_pPoint    ppt; */
-/*   MMG5_pTetra    pt,pt1,ptc; */
-/*   double    c[3],eps,dd,ray,ux,uy,uz,crit; */
-/*   double    *mj,*mp,ct[12]; */
-/*   int       *adja,*adjb,k,adj,adi,voy,i,j,ia,ilist,ipil,jel,iadr,base; */
-/*   int       vois[4],l; */
-
-/*   if ( lon < 1 )  return(0); */
-/*   ppt = &mesh->point[ip]; */
-/*   if ( ppt->tag & M_UNUSED )  return(0); */
-
-/*   for (k=1; k<=lon; k++) */
-/*     list->tetra[k] = list->tetra[k] / 6; */
-
-/*   /\* grow cavity by adjacency *\/ */
-/*   base  = mesh->mark; */
-/*   eps   = _MMG5_EPSRAD * _MMG5_EPSRAD; */
-/*   ilist = lon; */
-/*   ipil  = 1; */
-/*   iadr  = (ip-1)*sol->offset + 1; */
-/*   mp    = &sol->met[iadr]; */
-
-/*   do { */
-/*     jel  = list->tetra[ipil]; */
-/*     iadr = (jel-1)*4 + 1; */
-/*     adja = &mesh->adja[iadr]; */
-/*     vois[0]  = adja[0]; */
-/*     vois[1]  = adja[1]; */
-/*     vois[2]  = adja[2]; */
-/*     vois[3]  = adja[3]; */
-/*     ptc  = &mesh->tetra[jel]; */
-
-/*     for (i=0; i<4; i++) { */
-/*       adj = vois[i] >> 2; */
-/*       voy = vois[i] % 4; */
-/*       if ( !adj )  continue; */
-/*       pt  = &mesh->tetra[adj]; */
-/*       /\* boundary face *\/ */
-/*       if ( pt->mark == base || pt->ref != ptc->ref )  continue; */
-/*       for (j=0,l=0; j<4; j++,l+=3) { */
-/*      memcpy(&ct[l],mesh->point[pt->v[j]].c,3*sizeof(double)); */
-/*       } */
-
-
-/*       /\* Delaunay kernel *\/ */
-/*       if ( !_MMG5_cenrad_ani(mesh,ct,mp,c,&ray) )  continue; */
-
-/*       ux = ppt->c[0] - c[0]; */
-/*       uy = ppt->c[1] - c[1]; */
-/*       uz = ppt->c[2] - c[2]; */
-/*       dd =      mp[0]*ux*ux + mp[3]*uy*uy + mp[5]*uz*uz \ */
-/*      + 2.0*(mp[1]*ux*uy + mp[2]*ux*uz + mp[4]*uy*uz); */
-/*       crit = eps * ray; */
-/*       if ( dd > crit )  continue; */
-
-/*       /\* mixed metrics *\/ */
-/*       crit = sqrt(dd/ray); */
-/*       for (j=0; j<4; j++) { */
-/*      ia   = pt->v[j]; */
-/*      iadr = (ia-1)*sol->offset + 1; */
-/*      mj   = &sol->met[iadr]; */
-/*      if ( !_MMG5_cenrad_ani(mesh,ct,mj,c,&ray) )  continue; */
-/*      ux = ppt->c[0] - c[0]; */
-/*      uy = ppt->c[1] - c[1]; */
-/*      uz = ppt->c[2] - c[2]; */
-/*      dd =      mj[0]*ux*ux + mj[3]*uy*uy + mj[5]*uz*uz \ */
-/*        + 2.0*(mj[1]*ux*uy + mj[2]*ux*uz + mj[4]*uy*uz); */
-/*      crit += sqrt(dd/ray); */
-/*       } */
-/*       crit *= _MMG5_EPSRAD; */
-/*       if ( crit > 5.0 ) continue; */
-
-/*       /\* lost face(s) *\/ */
-/*       iadr = (adj-1)*4 + 1; */
-/*       adjb = &mesh->adja[iadr]; */
-
-/*       for (j=0; j<4; j++) { */
-/*      if ( j == voy )  continue; */
-/*      adi = adjb[j] >> 2; */
-/*      if ( !adi )  continue; */
-/*      pt1 = &mesh->tetra[adi]; */
-/*      if ( pt1->mark == base && adi != jel ) { */
-/*        if ( !adi || pt1->ref != mesh->tetra[adi].ref )  break; */
-/*      } */
-/*       } */
-/*       /\* store tetra *\/ */
-/*       if ( j == 4 ) { */
-/*      pt->mark = base; */
-/*      ++ilist; */
-/*      list->tetra[ilist] = adj; */
-/*       } */
-/*     } */
-/*     if ( ilist > LONMAX - 3 )  return(-1); */
-/*     ++ipil; */
-/*   } */
-/*   while ( ipil <= ilist ); */
-
-/*   /\* global overflow *\/ */
-/*   if ( mesh->ne + 2*ilist >= mesh->nemax ) */
-/*     ilist = -ilist; */
-/*   else */
-/*     ilist = _MMG5_correction_ani(mesh,sol,ip,list,ilist,lon); */
-
-/*   if(MMG_cas==1) MMG_nvol++; */
-/*   else if(MMG_cas==2 || MMG_cas>20) { */
-/*     MMG_npuiss++; */
-/*     if(MMG_cas>20) MMG_npres++; */
-/*   } */
-
-/*   return(ilist); */
-/* } */
-
-
 /** Return a negative value for ilist if one of the tet of the cavity is required */
 int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon) {
   MMG5_pPoint ppt;
   MMG5_pTetra      pt,pt1,ptc;
-  double           c[3],crit,dd,eps,ray,ct[12];
+  double           c[3],crit,dd,eps,ray,ux,uy,uz,ct[12],*mp;
   int             *adja,*adjb,k,adj,adi,voy,i,j,ilist,ipil,jel,iadr,base;
   int              vois[4],l;
   int              tref,isreq;
@@ -559,6 +446,9 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
   for (k=0; k<lon; k++)
     list[k] = list[k] / 6;
 
+  /* metric of the inserted point in anisotropic mode */
+  mp = ( sol->m && sol->size == 6 ) ? &sol->m[6*ip+1] : NULL;
+
   /* grow cavity by adjacency */
   eps   = _MMG5_EPSRAD*_MMG5_EPSRAD;
   ilist = lon;
@@ -586,14 +476,28 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
         memcpy(&ct[l],mesh->point[pt->v[j]].c,3*sizeof(double));
       }
 
-      if ( !_MMG5_cenrad_iso(mesh,ct,c,&ray) )  continue;
-      crit = eps * ray;
-
-      /* Delaunay criterion */
-      dd = (ppt->c[0] - c[0]) * (ppt->c[0] - c[0]) \
-        + (ppt->c[1] - c[1]) * (ppt->c[1] - c[1]) \
-        + (ppt->c[2] - c[2]) * (ppt->c[2] - c[2]);
-      if ( dd > crit )  continue;
+      if ( mp ) {
+        /* Delaunay criterion in the metric of the inserted point */
+        if ( !_MMG5_cenrad_ani(mesh,ct,mp,c,&ray) )  continue;
+        crit = eps * ray;
+
+        ux = ppt->c[0] - c[0];
+        uy = ppt->c[1] - c[1];
+        uz = ppt->c[2] - c[2];
+        dd =      mp[0]*ux*ux + mp[3]*uy*uy + mp[5]*uz*uz \
+          + 2.0*(mp[1]*ux*uy + mp[2]*ux*uz + mp[4]*uy*uz);
+        if ( dd > crit )  continue;
+      }
+      else {
+        if ( !_MMG5_cenrad_iso(mesh,ct,c,&ray) )  continue;
+        crit = eps * ray;
+
+        /* Delaunay criterion */
+        dd = (ppt->c[0] - c[0]) * (ppt->c[0] - c[0]) \
+          + (ppt->c[1] - c[1]) * (ppt->c[1] - c[1]) \
+          + (ppt->c[2] - c[2]) * (ppt->c[2] - c[2]);
+        if ( dd > crit )  continue;
+      }
 
       /* lost face(s) */
       iadr = (adj-1)*4 + 1;
@@ -626,6 +530,10 @@ int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon)
 
   ilist = _MMG5_correction_iso(mesh,ip,list,ilist,lon);
 
+  _MMG5_PROF_INC(mesh,_MMG5_PC_cavnb);
+  _MMG5_PROF_ADD(mesh,_MMG5_PC_cavtet,ilist);
+  _MMG5_PROF_MAX(mesh,_MMG5_PC_cavmax,ilist);
+
   if ( isreq ) ilist = -abs(ilist);
 
   if(MMG_cas==1) MMG_nvol++;
@@ -0,0 +1,581 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/distance.c
+ * \brief Signed distance to a surface triangulation.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The distance of a vertex to the surface is computed by a search of the
+ * closest triangle in a bounding volume hierarchy (binary tree of axis
+ * aligned boxes) built over the triangles. The sign is given by the parity of
+ * the number of triangles crossed by a ray issued from the vertex (majority
+ * vote over 3 rays), thus the triangles don't need to be oriented. A vertex
+ * lying in the ball centered at the previous vertex and of radius its
+ * distance has the same sign (the ball doesn't meet the surface), which
+ * avoids most of the ray casts.
+ *
+ */
+
+#include "mmg3d.h"
+
+#define _MMG5_BVHLEAF   4     /**< max number of triangles per leaf */
+#define _MMG5_BVHSTACK  128   /**< size of the traversal stacks */
+
+/** Directions of the rays used for the sign (no symmetry of the mesh) */
+static const double _MMG5_distDir[3][3] = {
+  { 1.0, 0.3141592653, 0.2718281828},
+  {-0.2718281828, 1.0, 0.1414213562},
+  { 0.1732050807,-0.2236067977, 1.0}
+};
+
+/**
+ * \param a first vertex of the triangle.
+ * \param b second vertex of the triangle.
+ * \param c third vertex of the triangle.
+ * \param p point.
+ * \return the square of the distance from \a p to the triangle.
+ *
+ * Closest point of the triangle, found from the Voronoi region of \a p
+ * (vertices, edges or interior of the triangle).
+ *
+ */
+static double _MMG5_distTria(double a[3],double b[3],double c[3],double p[3]) {
+  double  ab[3],ac[3],ap[3],bp[3],cp[3],q[3];
+  double  d1,d2,d3,d4,d5,d6,va,vb,vc,v,w,dd;
+  char    i;
+
+  for (i=0; i<3; i++) {
+    ab[i] = b[i] - a[i];
+    ac[i] = c[i] - a[i];
+    ap[i] = p[i] - a[i];
+    bp[i] = p[i] - b[i];
+    cp[i] = p[i] - c[i];
+  }
+  d1 = ab[0]*ap[0] + ab[1]*ap[1] + ab[2]*ap[2];
+  d2 = ac[0]*ap[0] + ac[1]*ap[1] + ac[2]*ap[2];
+  d3 = ab[0]*bp[0] + ab[1]*bp[1] + ab[2]*bp[2];
+  d4 = ac[0]*bp[0] + ac[1]*bp[1] + ac[2]*bp[2];
+  d5 = ab[0]*cp[0] + ab[1]*cp[1] + ab[2]*cp[2];
+  d6 = ac[0]*cp[0] + ac[1]*cp[1] + ac[2]*cp[2];
+
+  vc = d1*d4 - d3*d2;
+  vb = d5*d2 - d1*d6;
+  va = d3*d6 - d5*d4;
+
+  /* vertex regions */
+  if ( d1 <= 0.0 && d2 <= 0.0 )
+    memcpy(q,a,3*sizeof(double));
+  else if ( d3 >= 0.0 && d4 <= d3 )
+    memcpy(q,b,3*sizeof(double));
+  else if ( d6 >= 0.0 && d5 <= d6 )
+    memcpy(q,c,3*sizeof(double));
+  /* edge regions */
+  else if ( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 ) {
+    v = d1 / (d1-d3);
+    for (i=0; i<3; i++)  q[i] = a[i] + v*ab[i];
+  }
+  else if ( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 ) {
+    w = d2 / (d2-d6);
+    for (i=0; i<3; i++)  q[i] = a[i] + w*ac[i];
+  }
+  else if ( va <= 0.0 && d4-d3 >= 0.0 && d5-d6 >= 0.0 ) {
+    w = (d4-d3) / ((d4-d3) + (d5-d6));
+    for (i=0; i<3; i++)  q[i] = b[i] + w*(c[i]-b[i]);
+  }
+  /* interior */
+  else {
+    dd = va + vb + vc;
+    if ( fabs(dd) < _MMG5_EPSD2 )
+      memcpy(q,a,3*sizeof(double));
+    else {
+      v = vb / dd;
+      w = vc / dd;
+      for (i=0; i<3; i++)  q[i] = a[i] + v*ab[i] + w*ac[i];
+    }
+  }
+
+  return( (p[0]-q[0])*(p[0]-q[0]) + (p[1]-q[1])*(p[1]-q[1])
+          + (p[2]-q[2])*(p[2]-q[2]) );
+}
+
+/**
+ * \param a first vertex of the triangle.
+ * \param b second vertex of the triangle.
+ * \param c third vertex of the triangle.
+ * \param o origin of the ray.
+ * \param d direction of the ray.
+ * \return 1 if the ray crosses the triangle, 0 otherwise.
+ *
+ */
+static int _MMG5_distRay(double a[3],double b[3],double c[3],double o[3],
+                         double d[3]) {
+  double  e1[3],e2[3],p[3],s[3],q[3],det,u,v,t;
+  char    i;
+
+  for (i=0; i<3; i++) {
+    e1[i] = b[i] - a[i];
+    e2[i] = c[i] - a[i];
+    s[i]  = o[i] - a[i];
+  }
+  p[0] = d[1]*e2[2] - d[2]*e2[1];
+  p[1] = d[2]*e2[0] - d[0]*e2[2];
+  p[2] = d[0]*e2[1] - d[1]*e2[0];
+  det  = e1[0]*p[0] + e1[1]*p[1] + e1[2]*p[2];
+  if ( fabs(det) < _MMG5_EPSD2 )  return(0);
+  det = 1.0 / det;
+
+  u = (s[0]*p[0] + s[1]*p[1] + s[2]*p[2]) * det;
+  if ( u < 0.0 || u > 1.0 )  return(0);
+
+  q[0] = s[1]*e1[2] - s[2]*e1[1];
+  q[1] = s[2]*e1[0] - s[0]*e1[2];
+  q[2] = s[0]*e1[1] - s[1]*e1[0];
+  v = (d[0]*q[0] + d[1]*q[1] + d[2]*q[2]) * det;
+  if ( v < 0.0 || u+v > 1.0 )  return(0);
+
+  t = (e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2]) * det;
+  return( t > 0.0 );
+}
+
+/**
+ * \param pn pointer toward a node of the hierarchy.
+ * \param c point.
+ * \return the square of the distance from \a c to the box of \a pn.
+ *
+ */
+static inline double _MMG5_bvhBoxDist(_MMG5_pBvhNode pn,double c[3]) {
+  double  dd,d;
+  char    i;
+
+  dd = 0.0;
+  for (i=0; i<3; i++) {
+    if ( c[i] < pn->min[i] )       d = pn->min[i] - c[i];
+    else if ( c[i] > pn->max[i] )  d = c[i] - pn->max[i];
+    else  continue;
+    dd += d*d;
+  }
+  return(dd);
+}
+
+/**
+ * \param pn pointer toward a node of the hierarchy.
+ * \param o origin of the ray.
+ * \param inv inverse of the components of the direction of the ray.
+ * \return 1 if the ray meets the box of \a pn, 0 otherwise.
+ *
+ */
+static inline int _MMG5_bvhBoxRay(_MMG5_pBvhNode pn,double o[3],double inv[3]) {
+  double  t0,t1,tmin,tmax;
+  char    i;
+
+  tmin = 0.0;
+  tmax = DBL_MAX;
+  for (i=0; i<3; i++) {
+    t0 = (pn->min[i] - o[i]) * inv[i];
+    t1 = (pn->max[i] - o[i]) * inv[i];
+    if ( t0 > t1 ) {
+      tmin = MG_MAX(tmin,t1);
+      tmax = MG_MIN(tmax,t0);
+    }
+    else {
+      tmin = MG_MAX(tmin,t0);
+      tmax = MG_MIN(tmax,t1);
+    }
+    if ( tmin > tmax )  return(0);
+  }
+  return(1);
+}
+
+/**
+ * \param tri triangles to partition.
+ * \param cen centroids of the triangles of the surface.
+ * \param n number of triangles in \a tri.
+ * \param k rank of the median.
+ * \param dir axis of the partition.
+ *
+ * Partial sort of \a tri such that the \a k first triangles have the smallest
+ * centroids along the axis \a dir (quickselect).
+ *
+ */
+static void _MMG5_bvhSelect(int *tri,double *cen,int n,int k,char dir) {
+  double  piv;
+  int     lo,hi,i,j,tmp;
+
+  lo = 0;
+  hi = n-1;
+  while ( lo < hi ) {
+    piv = cen[3*tri[(lo+hi)/2]+dir];
+    i = lo;
+    j = hi;
+    while ( i <= j ) {
+      while ( cen[3*tri[i]+dir] < piv )  i++;
+      while ( cen[3*tri[j]+dir] > piv )  j--;
+      if ( i <= j ) {
+        tmp    = tri[i];
+        tri[i] = tri[j];
+        tri[j] = tmp;
+        i++;
+        j--;
+      }
+    }
+    if ( k <= j )       hi = j;
+    else if ( k >= i )  lo = i;
+    else  break;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (memory count).
+ * \param bvh pointer toward the hierarchy to build.
+ * \param smesh pointer toward the surface mesh.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Build the hierarchy of the triangles of \a smesh by recursive median
+ * splits along the largest dimension of the boxes of the centroids.
+ *
+ */
+static int _MMG5_bvhNew(MMG5_pMesh mesh,_MMG5_pBvh bvh,MMG5_pMesh smesh) {
+  _MMG5_pBvhNode  pn;
+  MMG5_pTria      pt;
+  double          *cen,*c,cmin[3],cmax[3];
+  int             stack[_MMG5_BVHSTACK],beg[_MMG5_BVHSTACK],end[_MMG5_BVHSTACK];
+  int             k,l,nt,ist,node,nb,half;
+  char            i,j,dir;
+
+  memset(bvh,0,sizeof(_MMG5_Bvh));
+  bvh->smesh = smesh;
+
+  nt = 0;
+  for (k=1; k<=smesh->nt; k++)
+    if ( MG_EOK(&smesh->tria[k]) )  nt++;
+  if ( !nt ) {
+    fprintf(stdout,"  ## Error: surface mesh without triangles.\n");
+    return(0);
+  }
+
+  _MMG5_ADD_MEM(mesh,nt*sizeof(int)+2*nt*sizeof(_MMG5_BvhNode),
+                "surface hierarchy",return(0));
+  _MMG5_SAFE_MALLOC(bvh->tri,nt,int);
+  _MMG5_SAFE_MALLOC(bvh->node,2*nt,_MMG5_BvhNode);
+  bvh->nt = nt;
+
+  _MMG5_ADD_MEM(mesh,3*(smesh->nt+1)*sizeof(double),"triangle centroids",
+                _MMG5_bvhFree(mesh,bvh);
+                return(0));
+  _MMG5_SAFE_MALLOC(cen,3*(smesh->nt+1),double);
+
+  nt = 0;
+  for (k=1; k<=smesh->nt; k++) {
+    pt = &smesh->tria[k];
+    if ( !MG_EOK(pt) )  continue;
+    bvh->tri[nt++] = k;
+    for (i=0; i<3; i++) {
+      cen[3*k+i] = 0.0;
+      for (j=0; j<3; j++)
+        cen[3*k+i] += smesh->point[pt->v[j]].c[i] / 3.0;
+    }
+  }
+
+  /* the nodes are built from the root, a node being split when popped */
+  bvh->nnode = 1;
+  ist        = 0;
+  stack[ist] = 0;
+  beg[ist]   = 0;
+  end[ist]   = nt;
+  ist++;
+  while ( ist ) {
+    ist--;
+    node = stack[ist];
+    pn   = &bvh->node[node];
+    nb   = end[ist] - beg[ist];
+
+    for (i=0; i<3; i++) {
+      pn->min[i] = cmin[i] =  DBL_MAX;
+      pn->max[i] = cmax[i] = -DBL_MAX;
+    }
+    for (l=beg[ist]; l<end[ist]; l++) {
+      pt = &smesh->tria[bvh->tri[l]];
+      for (j=0; j<3; j++) {
+        c = smesh->point[pt->v[j]].c;
+        for (i=0; i<3; i++) {
+          pn->min[i] = MG_MIN(pn->min[i],c[i]);
+          pn->max[i] = MG_MAX(pn->max[i],c[i]);
+        }
+      }
+      c = &cen[3*bvh->tri[l]];
+      for (i=0; i<3; i++) {
+        cmin[i] = MG_MIN(cmin[i],c[i]);
+        cmax[i] = MG_MAX(cmax[i],c[i]);
+      }
+    }
+
+    if ( nb <= _MMG5_BVHLEAF || ist+2 > _MMG5_BVHSTACK ) {
+      pn->first = beg[ist];
+      pn->nt    = nb;
+      continue;
+    }
+
+    dir = 0;
+    for (i=1; i<3; i++)
+      if ( cmax[i]-cmin[i] > cmax[dir]-cmin[dir] )  dir = i;
+
+    half = nb/2;
+    _MMG5_bvhSelect(&bvh->tri[beg[ist]],cen,nb,half,dir);
+
+    pn->first = bvh->nnode;
+    pn->nt    = 0;
+    bvh->nnode += 2;
+
+    /* children */
+    l = beg[ist];
+    k = end[ist];
+    stack[ist]   = pn->first;
+    beg[ist]     = l;
+    end[ist]     = l+half;
+    stack[ist+1] = pn->first+1;
+    beg[ist+1]   = l+half;
+    end[ist+1]   = k;
+    ist += 2;
+  }
+
+  _MMG5_DEL_MEM(mesh,cen,3*(smesh->nt+1)*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (memory count).
+ * \param bvh pointer toward the hierarchy.
+ *
+ * Free the hierarchy of the triangles.
+ *
+ */
+void _MMG5_bvhFree(MMG5_pMesh mesh,_MMG5_pBvh bvh) {
+  if ( bvh->tri )
+    _MMG5_DEL_MEM(mesh,bvh->tri,bvh->nt*sizeof(int));
+  if ( bvh->node )
+    _MMG5_DEL_MEM(mesh,bvh->node,2*bvh->nt*sizeof(_MMG5_BvhNode));
+  bvh->nt = bvh->nnode = 0;
+}
+
+/**
+ * \param bvh pointer toward the hierarchy.
+ * \param c point.
+ * \return the square of the distance from \a c to the surface.
+ *
+ * Depth-first search of the closest triangle, the nearest child being visited
+ * first. The search is bounded by the distance to the last closest triangle
+ * (the successive points are usually close).
+ *
+ */
+static double _MMG5_bvhClosest(_MMG5_pBvh bvh,double c[3]) {
+  MMG5_pMesh      smesh;
+  MMG5_pTria      pt;
+  _MMG5_pBvhNode  pn;
+  double          dmin,dd,d0,d1;
+  int             stack[_MMG5_BVHSTACK],ist,k,l;
+
+  smesh = bvh->smesh;
+  pt    = &smesh->tria[bvh->last ? bvh->last : bvh->tri[0]];
+  dmin  = _MMG5_distTria(smesh->point[pt->v[0]].c,smesh->point[pt->v[1]].c,
+                         smesh->point[pt->v[2]].c,c);
+
+  ist = 0;
+  stack[ist++] = 0;
+  while ( ist ) {
+    pn = &bvh->node[stack[--ist]];
+    if ( _MMG5_bvhBoxDist(pn,c) >= dmin )  continue;
+
+    if ( pn->nt ) {
+      for (l=pn->first; l<pn->first+pn->nt; l++) {
+        k  = bvh->tri[l];
+        pt = &smesh->tria[k];
+        dd = _MMG5_distTria(smesh->point[pt->v[0]].c,smesh->point[pt->v[1]].c,
+                            smesh->point[pt->v[2]].c,c);
+        if ( dd < dmin ) {
+          dmin      = dd;
+          bvh->last = k;
+        }
+      }
+      continue;
+    }
+
+    d0 = _MMG5_bvhBoxDist(&bvh->node[pn->first],c);
+    d1 = _MMG5_bvhBoxDist(&bvh->node[pn->first+1],c);
+    if ( d0 <= d1 ) {
+      if ( d1 < dmin )  stack[ist++] = pn->first+1;
+      if ( d0 < dmin )  stack[ist++] = pn->first;
+    }
+    else {
+      if ( d0 < dmin )  stack[ist++] = pn->first;
+      if ( d1 < dmin )  stack[ist++] = pn->first+1;
+    }
+  }
+  return(dmin);
+}
+
+/**
+ * \param bvh pointer toward the hierarchy.
+ * \param o origin of the ray.
+ * \param d direction of the ray.
+ * \return the number of triangles crossed by the ray.
+ *
+ */
+static int _MMG5_bvhCross(_MMG5_pBvh bvh,double o[3],const double d[3]) {
+  MMG5_pMesh      smesh;
+  MMG5_pTria      pt;
+  _MMG5_pBvhNode  pn;
+  double          inv[3],dir[3];
+  int             stack[_MMG5_BVHSTACK],ist,l,nc;
+  char            i;
+
+  smesh = bvh->smesh;
+  for (i=0; i<3; i++) {
+    dir[i] = d[i];
+    inv[i] = 1.0 / d[i];
+  }
+
+  nc  = 0;
+  ist = 0;
+  stack[ist++] = 0;
+  while ( ist ) {
+    pn = &bvh->node[stack[--ist]];
+    if ( !_MMG5_bvhBoxRay(pn,o,inv) )  continue;
+
+    if ( pn->nt ) {
+      for (l=pn->first; l<pn->first+pn->nt; l++) {
+        pt  = &smesh->tria[bvh->tri[l]];
+        nc += _MMG5_distRay(smesh->point[pt->v[0]].c,smesh->point[pt->v[1]].c,
+                            smesh->point[pt->v[2]].c,o,dir);
+      }
+      continue;
+    }
+    stack[ist++] = pn->first;
+    stack[ist++] = pn->first+1;
+  }
+  return(nc);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the level-set function.
+ * \param smesh pointer toward the surface mesh.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Replace the solution \a sol by the signed distance from the vertices of \a
+ * mesh to the triangles of \a smesh (negative inside the surface). Both
+ * meshes must be in the same frame (not scaled).
+ *
+ */
+int _MMG5_distSetSol(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_pMesh smesh) {
+  _MMG5_Bvh    bvh;
+  MMG5_pPoint  ppt;
+  double       c0[3],d0,dd,r;
+  int          k,nray,nin,in0;
+  char         i;
+
+  if ( !_MMG5_bvhNew(mesh,&bvh,smesh) )  return(0);
+
+  if ( sol->m )
+    _MMG5_DEL_MEM(mesh,sol->m,(sol->size*(sol->npmax+1)+1)*sizeof(double));
+
+  sol->size  = 1;
+  sol->dim   = 3;
+  sol->ver   = 2;
+  sol->np    = mesh->np;
+  sol->npi   = mesh->np;
+  sol->npmax = mesh->npmax;
+  _MMG5_ADD_MEM(mesh,(sol->npmax+2)*sizeof(double),"level-set function",
+                _MMG5_bvhFree(mesh,&bvh);
+                return(0));
+  _MMG5_SAFE_CALLOC(sol->m,sol->npmax+2,double);
+
+  nray = 0;
+  d0   = -1.0;
+  in0  = 0;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) )  continue;
+
+    dd = sqrt(_MMG5_bvhClosest(&bvh,ppt->c));
+
+    /* same side as the previous vertex if in its empty ball */
+    r = (ppt->c[0]-c0[0])*(ppt->c[0]-c0[0]) + (ppt->c[1]-c0[1])*(ppt->c[1]-c0[1])
+      + (ppt->c[2]-c0[2])*(ppt->c[2]-c0[2]);
+    if ( d0 < 0.0 || r >= d0*d0 ) {
+      nin = 0;
+      for (i=0; i<3; i++)
+        nin += _MMG5_bvhCross(&bvh,ppt->c,_MMG5_distDir[i]) % 2;
+      in0 = ( nin >= 2 );
+      nray++;
+      memcpy(c0,ppt->c,3*sizeof(double));
+      d0 = dd;
+    }
+    sol->m[k] = in0 ? -dd : dd;
+  }
+
+  if ( abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     SIGNED DISTANCE: %d TRIANGLES, %d VERTICES,"
+            " %d SIGN COMPUTATIONS\n",bvh.nt,mesh->np,nray);
+
+  _MMG5_bvhFree(mesh,&bvh);
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the level-set function.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Load the surface mesh of name \a mesh->namedist and replace \a sol by the
+ * signed distance to its triangles.
+ *
+ */
+int _MMG5_distLoad(MMG5_pMesh mesh,MMG5_pSol sol) {
+  MMG5_Mesh  smesh;
+  MMG5_Sol   ssol;
+  int        ier;
+
+  memset(&smesh,0,sizeof(MMG5_Mesh));
+  memset(&ssol,0,sizeof(MMG5_Sol));
+  smesh.dim = ssol.dim = 3;
+  smesh.ver = ssol.ver = 2;
+  ssol.size = 1;
+  MMG5_Init_parameters(&smesh);
+  MMG5_Init_fileNames(&smesh,&ssol);
+  smesh.info.imprim = mesh->info.imprim;
+  smesh.info.mem    = mesh->info.mem;
+
+  if ( !MMG5_Set_inputMeshName(&smesh,mesh->namedist) )  return(0);
+  ier = ( _MMG5_loadSurf(&smesh) > 0 );
+  if ( ier )
+    ier = _MMG5_distSetSol(mesh,sol,&smesh);
+
+  MMG5_Free_structures(&smesh,&ssol);
+  return(ier);
+}
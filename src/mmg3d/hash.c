@@ -39,6 +39,43 @@
 
 extern char  ddb;
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Tetra packing when the mesh is frozen for a local remeshing: the outside
+ * tetrahedra must stay out of the list of the remeshed region (see \ref
+ * _MMG5_freezeMesh), so the holes (which are listed) are filled while the last
+ * tetrahedron of the table is listed. The list being sorted, the cost is
+ * proportional to its length.
+ *
+ */
+static void
+_MMG5_paktetreg(MMG5_pMesh mesh) {
+  MMG5_pTetra   pt;
+  int           k,l;
+
+  for (l=0; l<mesh->nlreg; l++) {
+    k = mesh->lreg[l];
+    if ( k >= mesh->ne )  break;
+    pt = &mesh->tetra[k];
+    if ( MG_EOK(pt) )  continue;
+    if ( !bsearch(&mesh->ne,mesh->lreg,mesh->nlreg,sizeof(int),_MMG5_cmpidx) )
+      break;
+    memcpy(pt,&mesh->tetra[mesh->ne],sizeof(MMG5_Tetra));
+    memset(&mesh->tetra[mesh->ne],0,sizeof(MMG5_Tetra));
+    while ( !MG_EOK((&mesh->tetra[mesh->ne])) )  mesh->ne--;
+  }
+
+  /* Recreate nil chain with the remaining holes */
+  mesh->nelnk = mesh->nenil = mesh->ne + 1;
+  for (l=mesh->nlreg-1; l>=0; l--) {
+    k = mesh->lreg[l];
+    if ( k >= mesh->ne || MG_EOK((&mesh->tetra[k])) )  continue;
+    mesh->tetra[k].v[3] = mesh->nenil;
+    mesh->nenil = k;
+  }
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  *
@@ -50,6 +87,11 @@ _MMG5_paktet(MMG5_pMesh mesh) {
   MMG5_pTetra   pt,pt1;
   int      k;
 
+  if ( mesh->nereg ) {
+    _MMG5_paktetreg(mesh);
+    return;
+  }
+
   k = 1;
   do {
     pt = &mesh->tetra[k];
@@ -64,10 +106,7 @@ _MMG5_paktet(MMG5_pMesh mesh) {
 
   /* Recreate nil chain */
   mesh->nenil = mesh->ne + 1;
-
-  for(k=mesh->nenil; k<=mesh->nemax-1; k++){
-    mesh->tetra[k].v[3] = k+1;
-  }
+  mesh->nelnk = mesh->nenil;
 }
 
 /**
@@ -76,7 +115,8 @@ _MMG5_paktet(MMG5_pMesh mesh) {
  * \return 0 if failed, 1 otherwise.
  *
  * Create table of adjacency. Set pack variable to 0 for a compact
- * mesh and to 1 for a mesh that need to be packed.
+ * mesh and to 1 for a mesh that need to be packed. The remaining empty slots
+ * are skipped.
  *
  */
 int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
@@ -98,7 +138,9 @@ int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
     fprintf(stdout,"  ** SETTING STRUCTURE\n");
 
-  /* packing : if not hash does not work */
+  _MMG5_PROF_IN(mesh,_MMG5_PT_hashTetra);
+
+  /* packing (the links of the hashing follow the slots) */
   if ( pack )  _MMG5_paktet(mesh);
 
   /* memory alloc */
@@ -133,7 +175,9 @@ int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
       sum = pt->v[i1] + pt->v[i2] + pt->v[i3];
       key = _MMG5_KA*mins + _MMG5_KB*maxs + KC*sum;
       key = key % hsize + 1;
-      iadr++;
+      _MMG5_PROF_INC(mesh,_MMG5_PC_hashins);
+      if ( hcode[key] != -inival )  _MMG5_PROF_INC(mesh,_MMG5_PC_hashcol);
+      iadr = 4*(k-1) + i + 1;
       link[iadr] = hcode[key];
       hcode[key] = -iadr;
     }
@@ -184,6 +228,7 @@ int _MMG5_hashTetra(MMG5_pMesh mesh, int pack) {
     }
   }
   _MMG5_SAFE_FREE(hcode);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_hashTetra);
   return(1);
 }
 
@@ -765,6 +810,7 @@ int _MMG5_bdrySet(MMG5_pMesh mesh) {
   na = 0;
 
   mesh->xt     = 0;
+  mesh->xtnil  = 0;
   mesh->xtmax  = mesh->ntmax + 2*na;
 
   _MMG5_ADD_MEM(mesh,(mesh->xtmax+1)*sizeof(MMG5_xTetra),"boundary tetrahedra",
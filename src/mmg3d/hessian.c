@@ -0,0 +1,304 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/hessian.c
+ * \brief Metric built from the Hessian of a scalar field.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The Hessian of the P1 field is recovered by two successive L2 projections:
+ * the gradients (constant by element) are averaged at the vertices with the
+ * volumes of the elements as weights, and the same is done with the
+ * gradients of the recovered gradient. Only passes over the elements are
+ * needed (no adjacency). The metric bounds the P1 interpolation error by
+ * the target error: \f$ M = \frac{c}{\varepsilon} |H| \f$, with the
+ * eigenvalues truncated by the minimal and maximal sizes. The metric is then
+ * handled as an input metric (sizes imposed by the geometry, gradation).
+ *
+ */
+
+#include "mmg3d.h"
+
+#define _MMG5_HESSCST  0.28125   /**< 9/32, constant of the 3D P1 interpolation error */
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param k index of the tetrahedron.
+ * \param u values at the vertices (stride \a s).
+ * \param s stride of \a u.
+ * \param g gradient of the P1 interpolation of \a u on \a k.
+ * \return the volume of \a k, 0 if \a k is degenerated.
+ *
+ */
+static double _MMG5_hessGrad(MMG5_pMesh mesh,int k,double *u,int s,double g[3]) {
+  MMG5_pTetra  pt;
+  double       *a,*b,*c,*d,ab[3],ac[3],ad[3],du[3],det,n[3][3];
+  char         i;
+
+  pt = &mesh->tetra[k];
+  a  = mesh->point[pt->v[0]].c;
+  b  = mesh->point[pt->v[1]].c;
+  c  = mesh->point[pt->v[2]].c;
+  d  = mesh->point[pt->v[3]].c;
+  for (i=0; i<3; i++) {
+    ab[i] = b[i] - a[i];
+    ac[i] = c[i] - a[i];
+    ad[i] = d[i] - a[i];
+  }
+  du[0] = u[s*pt->v[1]] - u[s*pt->v[0]];
+  du[1] = u[s*pt->v[2]] - u[s*pt->v[0]];
+  du[2] = u[s*pt->v[3]] - u[s*pt->v[0]];
+
+  /* rows of the inverse of the jacobian (times det) */
+  n[0][0] = ac[1]*ad[2] - ac[2]*ad[1];
+  n[0][1] = ac[2]*ad[0] - ac[0]*ad[2];
+  n[0][2] = ac[0]*ad[1] - ac[1]*ad[0];
+  n[1][0] = ad[1]*ab[2] - ad[2]*ab[1];
+  n[1][1] = ad[2]*ab[0] - ad[0]*ab[2];
+  n[1][2] = ad[0]*ab[1] - ad[1]*ab[0];
+  n[2][0] = ab[1]*ac[2] - ab[2]*ac[1];
+  n[2][1] = ab[2]*ac[0] - ab[0]*ac[2];
+  n[2][2] = ab[0]*ac[1] - ab[1]*ac[0];
+  det = ab[0]*n[0][0] + ab[1]*n[0][1] + ab[2]*n[0][2];
+  if ( fabs(det) < _MMG5_EPSD )  return(0.0);
+
+  for (i=0; i<3; i++)
+    g[i] = (du[0]*n[0][i] + du[1]*n[1][i] + du[2]*n[2][i]) / det;
+
+  return(fabs(det) / 6.0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u values at the vertices (stride \a s).
+ * \param s stride of \a u.
+ * \param grad recovered gradients (3 per vertex, from index 3).
+ * \param w volumes of the balls of the vertices.
+ *
+ * L2 projection of the gradient of \a u at the vertices.
+ *
+ */
+static void _MMG5_hessAvg(MMG5_pMesh mesh,double *u,int s,double *grad,
+                          double *w) {
+  MMG5_pTetra  pt;
+  double       g[3],vol;
+  int          k,ip;
+  char         i,j;
+
+  memset(grad,0,3*(mesh->np+1)*sizeof(double));
+  memset(w,0,(mesh->np+1)*sizeof(double));
+
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    vol = _MMG5_hessGrad(mesh,k,u,s,g);
+    if ( vol == 0.0 )  continue;
+    for (i=0; i<4; i++) {
+      ip = pt->v[i];
+      w[ip] += vol;
+      for (j=0; j<3; j++)  grad[3*ip+j] += vol*g[j];
+    }
+  }
+  for (k=1; k<=mesh->np; k++) {
+    if ( w[k] == 0.0 )  continue;
+    for (j=0; j<3; j++)  grad[3*k+j] /= w[k];
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u values at the vertices (index 1 to np).
+ * \param hes recovered Hessians (6 per vertex, from index 6).
+ * \param w volumes of the balls of the vertices.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Recover the Hessian of \a u by two L2 projections.
+ *
+ */
+static int _MMG5_hessRecover(MMG5_pMesh mesh,double *u,double *hes,double *w) {
+  double       *grad,*dg,dd;
+  int          k;
+  char         i,j;
+
+  _MMG5_ADD_MEM(mesh,6*(mesh->np+1)*sizeof(double),"Hessian recovery",
+                return(0));
+  _MMG5_SAFE_CALLOC(grad,3*(mesh->np+1),double);
+  _MMG5_SAFE_CALLOC(dg,3*(mesh->np+1),double);
+
+  _MMG5_hessAvg(mesh,u,1,grad,w);
+
+  /* i-th row of the hessian = gradient of the i-th component of the
+   * gradient, the symmetric part is stored (m11,m12,m13,m22,m23,m33) */
+  memset(hes,0,6*(mesh->np+1)*sizeof(double));
+  for (i=0; i<3; i++) {
+    _MMG5_hessAvg(mesh,&grad[i],3,dg,w);
+    for (k=1; k<=mesh->np; k++) {
+      for (j=0; j<3; j++) {
+        dd = ( i==j ) ? dg[3*k+j] : 0.5*dg[3*k+j];
+        if ( MG_MIN(i,j) == 0 )       hes[6*k+MG_MAX(i,j)]   += dd;
+        else if ( MG_MIN(i,j) == 1 )  hes[6*k+2+MG_MAX(i,j)] += dd;
+        else                          hes[6*k+5]             += dd;
+      }
+    }
+  }
+
+  _MMG5_DEL_MEM(mesh,grad,3*(mesh->np+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,dg,3*(mesh->np+1)*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the solution structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Replace the scalar field \a met by a metric computed from its Hessian: an
+ * isotropic size if \a mesh->info.hess is 1, a tensor if it is 6, for the
+ * target error \a mesh->info.herr. If \a mesh->info.nelem is given, the
+ * metric is scaled afterwards by \ref _MMG5_fitnelem (the target error only
+ * gives its initial value). Called on the unscaled mesh.
+ *
+ */
+int _MMG5_hessSetSol(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pPoint  ppt;
+  double       *hes,*w,*m,*l,*vp,hb[6*_MMG5_EIGBATCH];
+  double       lambda[3*_MMG5_EIGBATCH],v[9*_MMG5_EIGBATCH];
+  double       lmin,lmax,err,hmin,hmax,dd;
+  int          list[_MMG5_EIGBATCH],k,ip,n,nb,nfail;
+  char         i;
+
+  if ( met->size != 1 || !met->m || met->np != mesh->np ) {
+    fprintf(stdout,"  ## Error: a scalar field at the vertices is needed to"
+            " build the metric from its Hessian.\n");
+    return(0);
+  }
+  if ( mesh->info.hess != 1 && mesh->info.hess != 6 ) {
+    fprintf(stdout,"  ## Error: wrong type of metric (%d).\n",mesh->info.hess);
+    return(0);
+  }
+  if ( mesh->info.nelem <= 0 && mesh->info.herr <= 0. ) {
+    fprintf(stdout,"  ## Error: a positive target error or number of"
+            " elements is needed.\n");
+    return(0);
+  }
+  err = mesh->info.herr > 0. ? mesh->info.herr : 1.0;
+  if ( !_MMG5_boundingBox(mesh) )  return(0);
+
+  _MMG5_ADD_MEM(mesh,7*(mesh->np+1)*sizeof(double),"Hessian recovery",
+                return(0));
+  _MMG5_SAFE_CALLOC(hes,6*(mesh->np+1),double);
+  _MMG5_SAFE_CALLOC(w,mesh->np+1,double);
+
+  if ( !_MMG5_hessRecover(mesh,met->m,hes,w) ) {
+    _MMG5_DEL_MEM(mesh,hes,6*(mesh->np+1)*sizeof(double));
+    _MMG5_DEL_MEM(mesh,w,(mesh->np+1)*sizeof(double));
+    return(0);
+  }
+
+  hmin = mesh->info.hmin > 0. ? mesh->info.hmin : 0.01*mesh->info.delta;
+  hmax = mesh->info.hmax > 0. ? mesh->info.hmax : mesh->info.delta;
+  lmin = 1.0 / (hmax*hmax);
+  lmax = 1.0 / (hmin*hmin);
+
+  /* the field is replaced by the metric */
+  _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
+  met->size = mesh->info.hess;
+  _MMG5_ADD_MEM(mesh,(met->size*(met->npmax+1)+1)*sizeof(double),"metric",
+                _MMG5_DEL_MEM(mesh,hes,6*(mesh->np+1)*sizeof(double));
+                _MMG5_DEL_MEM(mesh,w,(mesh->np+1)*sizeof(double));
+                return(0));
+  _MMG5_SAFE_CALLOC(met->m,met->size*(met->npmax+1)+1,double);
+
+  nfail = 0;
+  ip    = 1;
+  while ( ip <= mesh->np ) {
+    nb = 0;
+    for (; ip<=mesh->np && nb<_MMG5_EIGBATCH; ip++) {
+      ppt = &mesh->point[ip];
+      if ( !MG_VOK(ppt) || w[ip] == 0.0 )  continue;
+      memcpy(&hb[6*nb],&hes[6*ip],6*sizeof(double));
+      list[nb++] = ip;
+    }
+    if ( !nb )  continue;
+
+    n = _MMG5_eigensym3_batch(nb,hb,lambda,v);
+    while ( n < nb ) {
+      /* not diagonalized: isotropic with the largest term */
+      dd = 0.0;
+      for (i=0; i<6; i++)  dd = MG_MAX(dd,fabs(hb[6*n+i]));
+      memset(&v[9*n],0,9*sizeof(double));
+      for (i=0; i<3; i++) {
+        lambda[3*n+i] = dd;
+        v[9*n+4*i]    = 1.0;
+      }
+      nfail++;
+      if ( ++n < nb )
+        n += _MMG5_eigensym3_batch(nb-n,&hb[6*n],&lambda[3*n],&v[9*n]);
+    }
+
+    for (n=0; n<nb; n++) {
+      k  = list[n];
+      l  = &lambda[3*n];
+      vp = &v[9*n];
+      for (i=0; i<3; i++)
+        l[i] = MG_MIN(lmax,MG_MAX(lmin,_MMG5_HESSCST*fabs(l[i])/err));
+
+      if ( met->size == 1 ) {
+        met->m[k] = 1.0 / sqrt(MG_MAX(l[0],MG_MAX(l[1],l[2])));
+        continue;
+      }
+      m = &met->m[6*k+1];
+      m[0] = l[0]*vp[0]*vp[0] + l[1]*vp[3]*vp[3] + l[2]*vp[6]*vp[6];
+      m[1] = l[0]*vp[0]*vp[1] + l[1]*vp[3]*vp[4] + l[2]*vp[6]*vp[7];
+      m[2] = l[0]*vp[0]*vp[2] + l[1]*vp[3]*vp[5] + l[2]*vp[6]*vp[8];
+      m[3] = l[0]*vp[1]*vp[1] + l[1]*vp[4]*vp[4] + l[2]*vp[7]*vp[7];
+      m[4] = l[0]*vp[1]*vp[2] + l[1]*vp[4]*vp[5] + l[2]*vp[7]*vp[8];
+      m[5] = l[0]*vp[2]*vp[2] + l[1]*vp[5]*vp[5] + l[2]*vp[8]*vp[8];
+    }
+  }
+
+  /* isolated vertices */
+  for (k=1; k<=mesh->np; k++) {
+    if ( w[k] != 0.0 )  continue;
+    if ( met->size == 1 )
+      met->m[k] = hmax;
+    else {
+      met->m[6*k+1] = met->m[6*k+4] = met->m[6*k+6] = lmin;
+    }
+  }
+
+  if ( abs(mesh->info.imprim) > 4 ) {
+    fprintf(stdout,"     HESSIAN METRIC: TARGET ERROR %e\n",err);
+    if ( nfail )
+      fprintf(stdout,"     %d HESSIANS NOT DIAGONALIZED\n",nfail);
+  }
+
+  _MMG5_DEL_MEM(mesh,hes,6*(mesh->np+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,w,(mesh->np+1)*sizeof(double));
+  return(1);
+}
@@ -0,0 +1,322 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/inlined_functions.h
+ * \brief Inlined iso/aniso kernels of the mmg3d operators.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The quality and length kernels are defined here so that they can be inlined
+ * in the hot loops of the remeshing operators. The operators that evaluate
+ * them intensively are generated in an iso and an aniso instance (see the
+ * \a ani argument of their \a _spe body): the \ref _MMG5_LENEDG, \ref
+ * _MMG5_CALTET and \ref _MMG5_ORCAL macros select the kernel at compile time
+ * inside each instance, and \ref _MMG5_setfunc picks the instances once per
+ * run.
+ *
+ */
+
+#ifndef _MMG3D_INLINED_FUNCTIONS_H
+#define _MMG3D_INLINED_FUNCTIONS_H
+
+/** Force the inlining of the generic body of the operators in their iso/aniso
+ *  instances (plain inline hint for the compilers that don't support it) */
+#ifdef __GNUC__
+#define _MMG5_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define _MMG5_ALWAYS_INLINE inline
+#endif
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param ip1 index of edge's extremity.
+ * \param ip2 index of edge's extremity.
+ * \param isedg 1 if the edge is a ridge, 0 otherwise.
+ * \return length of edge according to the prescribed iso. metric.
+ *
+ * Inlined copy of \ref _MMG5_lenedg_iso.
+ *
+ */
+static inline double
+_MMG5_lenedg33_iso(MMG5_pMesh mesh,MMG5_pSol met,int ip1,int ip2,char isedg) {
+  MMG5_pPoint   p1,p2;
+  double        h1,h2,l,r,len;
+
+  p1 = &mesh->point[ip1];
+  p2 = &mesh->point[ip2];
+  h1 = met->m[ip1];
+  h2 = met->m[ip2];
+  l = (p2->c[0]-p1->c[0])*(p2->c[0]-p1->c[0]) + (p2->c[1]-p1->c[1])*(p2->c[1]-p1->c[1])
+    + (p2->c[2]-p1->c[2])*(p2->c[2]-p1->c[2]);
+  l = sqrt(l);
+  r = h2 / h1 - 1.0;
+  len = fabs(r) < _MMG5_EPS ? l / h1 : l / (h2-h1) * log(r+1.0);
+
+  return(len);
+}
+
+/**
+ * \param ca pointer toward the coordinates of the first edge's extremity.
+ * \param cb pointer toward the coordinates of the second edge's extremity.
+ * \param sa pointer toward the metric at the first edge's extremity.
+ * \param sb pointer toward the metric at the second edge's extremity.
+ * \return edge length.
+ *
+ * Compute length of edge \f$[ca,cb]\f$ according to the anisotropic size
+ * prescription (Simpson's rule on the metrics at the extremities and at the
+ * middle of the edge).
+ *
+ */
+static inline double
+_MMG5_lenedgCoor33_ani(double *ca,double *cb,double *sa,double *sb) {
+  double   ux,uy,uz,dd1,dd2,ddm,sm[6];
+  char     i;
+
+  ux = cb[0] - ca[0];
+  uy = cb[1] - ca[1];
+  uz = cb[2] - ca[2];
+
+  for (i=0; i<6; i++)  sm[i] = 0.5*(sa[i] + sb[i]);
+
+  dd1 =      sa[0]*ux*ux + sa[3]*uy*uy + sa[5]*uz*uz
+    + 2.0*(sa[1]*ux*uy + sa[2]*ux*uz + sa[4]*uy*uz);
+  dd2 =      sb[0]*ux*ux + sb[3]*uy*uy + sb[5]*uz*uz
+    + 2.0*(sb[1]*ux*uy + sb[2]*ux*uz + sb[4]*uy*uz);
+  ddm =      sm[0]*ux*ux + sm[3]*uy*uy + sm[5]*uz*uz
+    + 2.0*(sm[1]*ux*uy + sm[2]*ux*uz + sm[4]*uy*uz);
+
+  return((sqrt(MG_MAX(0.0,dd1)) + 4.0*sqrt(MG_MAX(0.0,ddm))
+          + sqrt(MG_MAX(0.0,dd2))) / 6.0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np0 index of edge's extremity.
+ * \param np1 index of edge's extremity.
+ * \param isedg unused (the edge is measured as a straight segment).
+ * \return length of edge according to the prescribed aniso. metric.
+ *
+ */
+static inline double
+_MMG5_lenedg33_ani(MMG5_pMesh mesh,MMG5_pSol met,int np0,int np1,char isedg) {
+  return(_MMG5_lenedgCoor33_ani(mesh->point[np0].c,mesh->point[np1].c,
+                                &met->m[6*np0+1],&met->m[6*np1+1]));
+}
+
+/** compute tetra quality iso */
+static inline double _MMG5_caltet_iso(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id) {
+  double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
+  double     vol,v1,v2,v3,rap;
+  double    *a,*b,*c,*d;
+
+  a = mesh->point[ia].c;
+  b = mesh->point[ib].c;
+  c = mesh->point[ic].c;
+  d = mesh->point[id].c;
+
+  /* volume */
+  abx = b[0] - a[0];
+  aby = b[1] - a[1];
+  abz = b[2] - a[2];
+  rap = abx*abx + aby*aby + abz*abz;
+
+  acx = c[0] - a[0];
+  acy = c[1] - a[1];
+  acz = c[2] - a[2];
+  rap += acx*acx + acy*acy + acz*acz;
+
+  adx = d[0] - a[0];
+  ady = d[1] - a[1];
+  adz = d[2] - a[2];
+  rap += adx*adx + ady*ady + adz*adz;
+
+  v1  = acy*adz - acz*ady;
+  v2  = acz*adx - acx*adz;
+  v3  = acx*ady - acy*adx;
+  vol = abx * v1 + aby * v2 + abz * v3;
+  if ( vol < _MMG5_EPSD2 )  return(0.0);
+
+  bcx = c[0] - b[0];
+  bcy = c[1] - b[1];
+  bcz = c[2] - b[2];
+  rap += bcx*bcx + bcy*bcy + bcz*bcz;
+
+  bdx = d[0] - b[0];
+  bdy = d[1] - b[1];
+  bdz = d[2] - b[2];
+  rap += bdx*bdx + bdy*bdy + bdz*bdz;
+
+  cdx = d[0] - c[0];
+  cdy = d[1] - c[1];
+  cdz = d[2] - c[2];
+  rap += cdx*cdx + cdy*cdy + cdz*cdz;
+  if ( rap < _MMG5_EPSD2 )  return(0.0);
+
+  /* quality = vol / len^3/2 */
+  rap = rap * sqrt(rap);
+  return(vol / rap);
+}
+
+
+/** compute tetra quality aniso, in the mean of the metrics at the vertices */
+static inline double _MMG5_caltet_ani(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id) {
+  double     mm[6],*m,u[6][3],*a,*b,*c,*d,vol,rap,det;
+  int        iv[4];
+  char       i,j;
+
+  iv[0] = ia;
+  iv[1] = ib;
+  iv[2] = ic;
+  iv[3] = id;
+  for (j=0; j<6; j++)  mm[j] = 0.0;
+  for (i=0; i<4; i++) {
+    m = &met->m[6*iv[i]+1];
+    for (j=0; j<6; j++)  mm[j] += 0.25*m[j];
+  }
+
+  a = mesh->point[ia].c;
+  b = mesh->point[ib].c;
+  c = mesh->point[ic].c;
+  d = mesh->point[id].c;
+  for (j=0; j<3; j++) {
+    u[0][j] = b[j] - a[j];
+    u[1][j] = c[j] - a[j];
+    u[2][j] = d[j] - a[j];
+    u[3][j] = c[j] - b[j];
+    u[4][j] = d[j] - b[j];
+    u[5][j] = d[j] - c[j];
+  }
+
+  /* volume */
+  vol = u[0][0] * (u[1][1]*u[2][2] - u[1][2]*u[2][1])
+    + u[0][1] * (u[1][2]*u[2][0] - u[1][0]*u[2][2])
+    + u[0][2] * (u[1][0]*u[2][1] - u[1][1]*u[2][0]);
+  if ( vol < _MMG5_EPSD2 )  return(0.0);
+
+  /* volume in the metric */
+  det = mm[0] * (mm[3]*mm[5] - mm[4]*mm[4])
+    - mm[1] * (mm[1]*mm[5] - mm[2]*mm[4])
+    + mm[2] * (mm[1]*mm[4] - mm[2]*mm[3]);
+  if ( det < _MMG5_EPSD2 )  return(0.0);
+  vol *= sqrt(det);
+
+  /* edge lengths in the metric */
+  rap = 0.0;
+  for (i=0; i<6; i++) {
+    rap += mm[0]*u[i][0]*u[i][0] + mm[3]*u[i][1]*u[i][1] + mm[5]*u[i][2]*u[i][2]
+      + 2.0*(mm[1]*u[i][0]*u[i][1] + mm[2]*u[i][0]*u[i][2] + mm[4]*u[i][1]*u[i][2]);
+  }
+  if ( rap < _MMG5_EPSD2 )  return(0.0);
+
+  /* quality = vol / len^3/2 */
+  rap = rap * sqrt(rap);
+  return(vol / rap);
+}
+
+/** compute tetra oriented quality of iel (return 0.0 when element is inverted),
+ *  in the metric \a met when it is anisotropic */
+static inline double _MMG5_orcal(MMG5_pMesh mesh,MMG5_pSol met,int iel) {
+  MMG5_pTetra     pt;
+  double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
+  double     vol,v1,v2,v3,rap;
+  double     *a,*b,*c,*d;
+
+  pt = &mesh->tetra[iel];
+  if ( met && met->m && met->size == 6 )
+    return(_MMG5_caltet_ani(mesh,met,pt->v[0],pt->v[1],pt->v[2],pt->v[3]));
+
+  a = mesh->point[pt->v[0]].c;
+  b = mesh->point[pt->v[1]].c;
+  c = mesh->point[pt->v[2]].c;
+  d = mesh->point[pt->v[3]].c;
+
+  /* volume */
+  abx = b[0] - a[0];
+  aby = b[1] - a[1];
+  abz = b[2] - a[2];
+  rap = abx*abx + aby*aby + abz*abz;
+
+  acx = c[0] - a[0];
+  acy = c[1] - a[1];
+  acz = c[2] - a[2];
+  rap += acx*acx + acy*acy + acz*acz;
+
+  adx = d[0] - a[0];
+  ady = d[1] - a[1];
+  adz = d[2] - a[2];
+  rap += adx*adx + ady*ady + adz*adz;
+
+  v1  = acy*adz - acz*ady;
+  v2  = acz*adx - acx*adz;
+  v3  = acx*ady - acy*adx;
+  vol = abx * v1 + aby * v2 + abz * v3;
+
+  if ( vol < _MMG5_EPSD2 )  return(0.0);
+
+  bcx = c[0] - b[0];
+  bcy = c[1] - b[1];
+  bcz = c[2] - b[2];
+  rap += bcx*bcx + bcy*bcy + bcz*bcz;
+
+  bdx = d[0] - b[0];
+  bdy = d[1] - b[1];
+  bdz = d[2] - b[2];
+  rap += bdx*bdx + bdy*bdy + bdz*bdz;
+
+  cdx = d[0] - c[0];
+  cdy = d[1] - c[1];
+  cdz = d[2] - c[2];
+  rap += cdx*cdx + cdy*cdy + cdz*cdz;
+  if ( rap < _MMG5_EPSD2 )  return(0.0);
+
+  /* quality = vol / len^3/2 */
+  rap = rap * sqrt(rap);
+
+  return(vol / rap);
+}
+
+/** Length of edge \f$[ip1;ip2]\f$ in the iso (\a ani=0) or aniso metric */
+#define _MMG5_LENEDG(ani,mesh,met,ip1,ip2,isedg)                         \
+  ( (ani) ? _MMG5_lenedg33_ani(mesh,met,ip1,ip2,isedg) :                \
+    _MMG5_lenedg33_iso(mesh,met,ip1,ip2,isedg) )
+
+/** Quality of the tetra \f$[ia,ib,ic,id]\f$ in the iso (\a ani=0) or aniso metric */
+#define _MMG5_CALTET(ani,mesh,met,ia,ib,ic,id)                          \
+  ( (ani) ? _MMG5_caltet_ani(mesh,met,ia,ib,ic,id) :                    \
+    _MMG5_caltet_iso(mesh,met,ia,ib,ic,id) )
+
+/** Oriented quality of the tetra \a iel: euclidean (\a ani=0) or in the aniso metric */
+#define _MMG5_ORCAL(ani,mesh,met,iel)                                   \
+  ( (ani) ? _MMG5_caltet_ani(mesh,met,(mesh)->tetra[iel].v[0],             \
+                             (mesh)->tetra[iel].v[1],(mesh)->tetra[iel].v[2], \
+                             (mesh)->tetra[iel].v[3]) :                 \
+    _MMG5_orcal(mesh,NULL,iel) )
+
+#endif
@@ -39,75 +39,34 @@
 #define sw 4
 #define sd 8
 
-static int _MMG5_swapbin(int sbin)
-{
-  int inv;
-  char *p_in = (char *) &sbin;
-  char *p = (char *)&inv;
-
-
-  p[0] = p_in[3];
-  p[1] = p_in[2];
-  p[2] = p_in[1];
-  p[3] = p_in[0];
-
-  return(inv);
-  /*unsigned char c1, c2, c3, c4;
-
-    c1 = sbin & 255;
-    c2 = (sbin >> 8) & 255;
-    c3 = (sbin >> 16) & 255;
-    c4 = (sbin >> 24) & 255;
-
-    return ((int)c1 << 24) + ((int)c2 << 16) + ((int)c3 << 8) + c4;   */
-
-}
-static float _MMG5_swapf(float sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  p_out[0] = p_in[3];
-  p_out[1] = p_in[2];
-  p_out[2] = p_in[1];
-  p_out[3] = p_in[0];
-
-  return(out);
-}
-static double _MMG5_swapd(double sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  int i;
-
-  for(i=0;i<8;i++)
-  {
-    p_out[i] = p_in[7-i];
-  }
-  //printf("CONVERTION DOUBLE\n");
-  return(out);
-}
+/** Version of the checkpoint file format */
+#define _MMG5_CKPT_VERSION 1
+/** Number of integers in the header of a checkpoint file */
+#define _MMG5_CKPT_NHDR    11
+/** Number of integer fields of the mesh saved in a checkpoint file */
+#define _MMG5_CKPT_NMESH   27
 
 /**
  * \param mesh pointer toward the mesh structure.
+ * \param surf 1 if the mesh may have no tetrahedra (surface mesh).
  * \return 0 if failed, 1 otherwise.
  *
  * Read mesh data.
  *
  */
-int MMG5_loadMesh(MMG5_pMesh mesh) {
+static int _MMG5_loadMeshFile(MMG5_pMesh mesh,char surf) {
   FILE*       inm;
+  _MMG5_Abuf  ab;
   MMG5_pTetra pt;
   MMG5_pTria  pt1;
   MMG5_pEdge  pa;
   MMG5_pPoint ppt;
-  int         posnp,posnt,posne,posned,posncor,posnpreq,posntreq,posnereq,posnedreq;
-  int         posnr;
+  long        posnp,posnt,posne,posned,posncor,posnpreq,posntreq,posnereq,posnedreq;
+  long        posnr;
   int         npreq,ntreq,nereq,nedreq,ncor,ned,bin,iswp;
   int         binch,bdim,bpos,i,k;
   int         *ina,v[3],ref,nt,na,nr,ia,aux;
-  float            fc;
+  float       fc,fcr[3];
   char        *ptr,*name,data[128],chaine[128];
 
   posnp = posnt = posne = posncor = 0;
@@ -171,192 +130,168 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+  /* parse the file from memory */
+  fclose(inm);
+  if ( !_MMG5_openAscii(data,&ab) ) {
+    fprintf(stderr,"  ** UNABLE TO READ %s.\n",data);
+    return(0);
+  }
+
   if (!bin) {
     strcpy(chaine,"D");
-    while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
+    while(_MMG5_readWord(&ab,chaine,128)!=EOF && strncmp(chaine,"End",strlen("End")) ) {
       if(!strncmp(chaine,"MeshVersionFormatted",strlen("MeshVersionFormatted"))) {
-        fscanf(inm,"%d",&mesh->ver);
+        _MMG5_readInt(&ab,&mesh->ver);
         continue;
       } else if(!strncmp(chaine,"Dimension",strlen("Dimension"))) {
-        fscanf(inm,"%d",&mesh->dim);
+        _MMG5_readInt(&ab,&mesh->dim);
         if(mesh->dim!=3) {
           fprintf(stdout,"BAD DIMENSION : %d\n",mesh->dim);
+          _MMG5_closeAscii(&ab);
           return(-1);
         }
         continue;
       } else if(!strncmp(chaine,"Vertices",strlen("Vertices"))) {
-        fscanf(inm,"%d",&mesh->npi);
-        posnp = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->npi);
+        posnp = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredVertices",strlen("RequiredVertices"))) {
-        fscanf(inm,"%d",&npreq);
-        posnpreq = ftell(inm);
+        _MMG5_readInt(&ab,&npreq);
+        posnpreq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Triangles",strlen("Triangles"))) {
-        fscanf(inm,"%d",&mesh->nti);
-        posnt = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->nti);
+        posnt = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredTriangles",strlen("RequiredTriangles"))) {
-        fscanf(inm,"%d",&ntreq);
-        posntreq = ftell(inm);
+        _MMG5_readInt(&ab,&ntreq);
+        posntreq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Tetrahedra",strlen("Tetrahedra"))) {
-        fscanf(inm,"%d",&mesh->nei);
-        posne = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->nei);
+        posne = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredTetrahedra",strlen("RequiredTetrahedra"))) {
-        fscanf(inm,"%d",&nereq);
-        posnereq = ftell(inm);
+        _MMG5_readInt(&ab,&nereq);
+        posnereq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Corners",strlen("Corners"))) {
-        fscanf(inm,"%d",&ncor);
-        posncor = ftell(inm);
+        _MMG5_readInt(&ab,&ncor);
+        posncor = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Edges",strlen("Edges"))) {
-        fscanf(inm,"%d",&mesh->nai);
-        posned = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->nai);
+        posned = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredEdges",strlen("RequiredEdges"))) {
-        fscanf(inm,"%d",&nedreq);
-        posnedreq = ftell(inm);
+        _MMG5_readInt(&ab,&nedreq);
+        posnedreq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Ridges",strlen("Ridges"))) {
-        fscanf(inm,"%d",&nr);
-        posnr = ftell(inm);
+        _MMG5_readInt(&ab,&nr);
+        posnr = ab.pos;
         continue;
       }
     }
   } else { //binary file
     bdim = 0;
-    fread(&mesh->ver,sw,1,inm);
+    _MMG5_readBin(&ab,&mesh->ver,sw,0);
     iswp=0;
     if(mesh->ver==16777216)
       iswp=1;
     else if(mesh->ver!=1) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
-    fread(&mesh->ver,sw,1,inm);
-    if(iswp) mesh->ver = _MMG5_swapbin(mesh->ver);
-    while(fread(&binch,sw,1,inm)!=0 && binch!=54 ) {
-      if(iswp) binch=_MMG5_swapbin(binch);
-      if(binch==54) break;
+    _MMG5_readBin(&ab,&mesh->ver,sw,iswp);
+    while(_MMG5_readBin(&ab,&binch,sw,iswp) && binch!=54 ) {
       if(!bdim && binch==3) {  //Dimension
-        fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=_MMG5_swapbin(bdim);
-        fread(&bdim,sw,1,inm);
-        if(iswp) bdim=_MMG5_swapbin(bdim);
+        _MMG5_readBin(&ab,&bdim,sw,iswp);  //NulPos=>20
+        _MMG5_readBin(&ab,&bdim,sw,iswp);
         mesh->dim = bdim;
         if(bdim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",mesh->dim);
           fprintf(stdout," Exit program.\n");
+          _MMG5_closeAscii(&ab);
           return(-1);
         }
         continue;
       } else if(!mesh->npi && binch==4) {  //Vertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&mesh->npi,sw,1,inm);
-        if(iswp) mesh->npi=_MMG5_swapbin(mesh->npi);
-        posnp = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->npi,sw,iswp);
+        posnp = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==15) {  //RequiredVertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&npreq,sw,1,inm);
-        if(iswp) npreq=_MMG5_swapbin(npreq);
-        posnpreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&npreq,sw,iswp);
+        posnpreq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!mesh->nti && binch==6) {//Triangles
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&mesh->nti,sw,1,inm);
-        if(iswp) mesh->nti=_MMG5_swapbin(mesh->nti);
-        posnt = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->nti,sw,iswp);
+        posnt = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==17) {  //RequiredTriangles
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&ntreq,sw,1,inm);
-        if(iswp) ntreq=_MMG5_swapbin(ntreq);
-        posntreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&ntreq,sw,iswp);
+        posntreq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!mesh->nei && binch==8) {//Tetra
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&mesh->nei,sw,1,inm);
-        if(iswp) mesh->nei=_MMG5_swapbin(mesh->nei);
-        posne = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->nei,sw,iswp);
+        posne = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==12) {  //RequiredTetra
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&nereq,sw,1,inm);
-        if(iswp) nereq=_MMG5_swapbin(nereq);
-        posnereq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&nereq,sw,iswp);
+        posnereq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!ncor && binch==13) { //Corners
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&ncor,sw,1,inm);
-        if(iswp) ncor=_MMG5_swapbin(ncor);
-        posncor = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&ncor,sw,iswp);
+        posncor = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!mesh->nai && binch==5) { //Edges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&mesh->nai,sw,1,inm);
-        if(iswp) mesh->nai=_MMG5_swapbin(mesh->nai);
-        posned = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->nai,sw,iswp);
+        posned = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==16) {  //RequiredEdges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&nedreq,sw,1,inm);
-        if(iswp) nedreq=_MMG5_swapbin(nedreq);
-        posnedreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&nedreq,sw,iswp);
+        posnedreq = ab.pos;
+        ab.pos = bpos;
         continue;
       }  else if(binch==14) {  //Ridges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        fread(&nr,sw,1,inm);
-        if(iswp) nr=_MMG5_swapbin(nr);
-        posnr = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&nr,sw,iswp);
+        posnr = ab.pos;
+        ab.pos = bpos;
         continue;
       } else {
         //printf("on traite ? %d\n",binch);
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
         //printf("on avance... Nulpos %d\n",bpos);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        ab.pos = bpos;
       }
     }
   }
 
-  if ( !mesh->npi || !mesh->nei ) {
+  if ( !mesh->npi || (surf ? !mesh->nti : !mesh->nei) ) {
     fprintf(stdout,"  ** MISSING DATA.\n");
-    fprintf(stdout," Check that your mesh contains points and tetrahedra.\n");
+    if ( surf )
+      fprintf(stdout," Check that your mesh contains points and triangles.\n");
+    else
+      fprintf(stdout," Check that your mesh contains points and tetrahedra.\n");
     fprintf(stdout," Exit program.\n");
+    _MMG5_closeAscii(&ab);
     return(-1);
   }
   /* memory allocation */
@@ -364,41 +299,40 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
   mesh->nt = mesh->nti;
   mesh->ne = mesh->nei;
   mesh->na = mesh->nai;
-  if ( !_MMG5_zaldy(mesh) )  return(0);
+  if ( !_MMG5_zaldy(mesh) ) {
+    _MMG5_closeAscii(&ab);
+    return(0);
+  }
   if (mesh->npmax < mesh->np || mesh->ntmax < mesh->nt || mesh->nemax < mesh->ne) {
+    _MMG5_closeAscii(&ab);
     return(-1);
   }
 
-  rewind(inm);
-  fseek(inm,posnp,SEEK_SET);
+  ab.pos = posnp;
   for (k=1; k<=mesh->np; k++) {
     ppt = &mesh->point[k];
     if (mesh->ver < 2) { /*float*/
       if (!bin) {
         for (i=0 ; i<3 ; i++) {
-          fscanf(inm,"%f",&fc);
+          _MMG5_readFloat(&ab,&fc);
           ppt->c[i] = (double) fc;
         }
-        fscanf(inm,"%d",&ppt->ref);
+        _MMG5_readInt(&ab,&ppt->ref);
       } else {
-        for (i=0 ; i<3 ; i++) {
-          fread(&fc,sw,1,inm);
-          if(iswp) fc=_MMG5_swapf(fc);
-          ppt->c[i] = (double) fc;
-        }
-        fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=_MMG5_swapbin(ppt->ref);
+        _MMG5_readBinBlock(&ab,fcr,sw,3,iswp);
+        for (i=0 ; i<3 ; i++)
+          ppt->c[i] = (double) fcr[i];
+        _MMG5_readBin(&ab,&ppt->ref,sw,iswp);
       }
     } else {
-      if (!bin)
-        fscanf(inm,"%lf %lf %lf %d",&ppt->c[0],&ppt->c[1],&ppt->c[2],&ppt->ref);
-      else {
-        for (i=0 ; i<3 ; i++) {
-          fread(&ppt->c[i],sd,1,inm);
-          if(iswp) ppt->c[i]=_MMG5_swapd(ppt->c[i]);
-        }
-        fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=_MMG5_swapbin(ppt->ref);
+      if (!bin) {
+        _MMG5_readDouble(&ab,&ppt->c[0]);
+        _MMG5_readDouble(&ab,&ppt->c[1]);
+        _MMG5_readDouble(&ab,&ppt->c[2]);
+        _MMG5_readInt(&ab,&ppt->ref);
+      } else {
+        _MMG5_readBinBlock(&ab,ppt->c,sd,3,iswp);
+        _MMG5_readBin(&ab,&ppt->ref,sw,iswp);
       }
     }
     ppt->tag  = MG_NUL;
@@ -406,14 +340,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
   }
   /* get required vertices */
   if(npreq) {
-    rewind(inm);
-    fseek(inm,posnpreq,SEEK_SET);
+    ab.pos = posnpreq;
     for (k=1; k<=npreq; k++) {
       if(!bin)
-        fscanf(inm,"%d",&i);
+        _MMG5_readInt(&ab,&i);
       else {
-        fread(&i,sw,1,inm);
-        if(iswp) i=_MMG5_swapbin(i);
+        _MMG5_readBin(&ab,&i,sw,iswp);
       }
       if(i>mesh->np) {
         fprintf(stdout,"   Warning: Required Vertices number %8d IGNORED\n",i);
@@ -426,14 +358,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
 
   /* get corners */
   if(ncor) {
-    rewind(inm);
-    fseek(inm,posncor,SEEK_SET);
+    ab.pos = posncor;
     for (k=1; k<=ncor; k++) {
       if(!bin)
-        fscanf(inm,"%d",&i);
+        _MMG5_readInt(&ab,&i);
       else {
-        fread(&i,sw,1,inm);
-        if(iswp) i=_MMG5_swapbin(i);
+        _MMG5_readBin(&ab,&i,sw,iswp);
       }
       if(i>mesh->np) {
         fprintf(stdout,"   Warning: Corner number %8d IGNORED\n",i);
@@ -447,8 +377,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
   /* read mesh triangles */
   nt = 0;
   if ( mesh->nt ) {
-    rewind(inm);
-    fseek(inm,posnt,SEEK_SET);
+    ab.pos = posnt;
     /* Skip triangles with MG_ISO refs */
     if( mesh->info.iso ) {
       nt = mesh->nt;
@@ -456,15 +385,14 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
       _MMG5_SAFE_CALLOC(ina,nt+1,int);
 
       for (k=1; k<=nt; k++) {
-        if (!bin)
-          fscanf(inm,"%d %d %d %d",&v[0],&v[1],&v[2],&ref);
-        else {
-          for (i=0 ; i<3 ; i++) {
-            fread(&v[i],sw,1,inm);
-            if(iswp) v[i]=_MMG5_swapbin(v[i]);
-          }
-          fread(&ref,sw,1,inm);
-          if(iswp) ref=_MMG5_swapbin(ref);
+        if (!bin) {
+          _MMG5_readInt(&ab,&v[0]);
+          _MMG5_readInt(&ab,&v[1]);
+          _MMG5_readInt(&ab,&v[2]);
+          _MMG5_readInt(&ab,&ref);
+        } else {
+          _MMG5_readBinBlock(&ab,v,sw,3,iswp);
+          _MMG5_readBin(&ab,&ref,sw,iswp);
         }
         if( abs(ref) != MG_ISO ) {
           pt1 = &mesh->tria[++mesh->nt];
@@ -488,28 +416,25 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
     else {
       for (k=1; k<=mesh->nt; k++) {
         pt1 = &mesh->tria[k];
-        if (!bin)
-          fscanf(inm,"%d %d %d %d",&pt1->v[0],&pt1->v[1],&pt1->v[2],&pt1->ref);
-        else {
-          for (i=0 ; i<3 ; i++) {
-            fread(&pt1->v[i],sw,1,inm);
-            if(iswp) pt1->v[i]=_MMG5_swapbin(pt1->v[i]);
-          }
-          fread(&pt1->ref,sw,1,inm);
-          if(iswp) pt1->ref=_MMG5_swapbin(pt1->ref);
+        if (!bin) {
+          _MMG5_readInt(&ab,&pt1->v[0]);
+          _MMG5_readInt(&ab,&pt1->v[1]);
+          _MMG5_readInt(&ab,&pt1->v[2]);
+          _MMG5_readInt(&ab,&pt1->ref);
+        } else {
+          _MMG5_readBinBlock(&ab,pt1->v,sw,3,iswp);
+          _MMG5_readBin(&ab,&pt1->ref,sw,iswp);
         }
       }
     }
     /* get required triangles */
     if(ntreq) {
-      rewind(inm);
-      fseek(inm,posntreq,SEEK_SET);
+      ab.pos = posntreq;
       for (k=1; k<=ntreq; k++) {
         if(!bin)
-          fscanf(inm,"%d",&i);
+          _MMG5_readInt(&ab,&i);
         else {
-          fread(&i,sw,1,inm);
-          if(iswp) i=_MMG5_swapbin(i);
+          _MMG5_readBin(&ab,&i,sw,iswp);
         }
         if ( i>mesh->nt ) {
           fprintf(stdout,"   Warning: Required MMG5_Triangles number %8d IGNORED\n",i);
@@ -544,20 +469,19 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
       _MMG5_SAFE_CALLOC(ina,na+1,int);
     }
 
-    rewind(inm);
-    fseek(inm,posned,SEEK_SET);
+    ab.pos = posned;
 
     for (k=1; k<=na; k++) {
       pa = &mesh->edge[k];
-      if (!bin)
-        fscanf(inm,"%d %d %d",&pa->a,&pa->b,&pa->ref);
-      else {
-        fread(&pa->a,sw,1,inm);
-        if(iswp) pa->a=_MMG5_swapbin(pa->a);
-        fread(&pa->b,sw,1,inm);
-        if(iswp) pa->b=_MMG5_swapbin(pa->b);
-        fread(&pa->ref,sw,1,inm);
-        if(iswp) pa->ref=_MMG5_swapbin(pa->ref);
+      if (!bin) {
+        _MMG5_readInt(&ab,&pa->a);
+        _MMG5_readInt(&ab,&pa->b);
+        _MMG5_readInt(&ab,&pa->ref);
+      } else {
+        _MMG5_readBinBlock(&ab,v,sw,3,iswp);
+        pa->a   = v[0];
+        pa->b   = v[1];
+        pa->ref = v[2];
       }
       pa->tag |= MG_REF;
       if ( mesh->info.iso ) {
@@ -572,14 +496,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
 
     /* get ridges */
     if ( nr ) {
-      rewind(inm);
-      fseek(inm,posnr,SEEK_SET);
+      ab.pos = posnr;
       for (k=1; k<=nr; k++) {
         if(!bin)
-          fscanf(inm,"%d",&ia);
+          _MMG5_readInt(&ab,&ia);
         else {
-          fread(&ia,sw,1,inm);
-          if(iswp) ia=_MMG5_swapbin(ia);
+          _MMG5_readBin(&ab,&ia,sw,iswp);
         }
         if(ia>na) {
           fprintf(stdout,"   Warning Ridge number %8d IGNORED\n",ia);
@@ -601,14 +523,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
     }
     /* get required edges */
     if ( nedreq ) {
-      rewind(inm);
-      fseek(inm,posnedreq,SEEK_SET);
+      ab.pos = posnedreq;
       for (k=1; k<=nedreq; k++) {
         if(!bin)
-          fscanf(inm,"%d",&ia);
+          _MMG5_readInt(&ab,&ia);
         else {
-          fread(&ia,sw,1,inm);
-          if(iswp) ia=_MMG5_swapbin(ia);
+          _MMG5_readBin(&ab,&ia,sw,iswp);
         }
         if(ia>na) {
           fprintf(stdout,"   Warning Required Edges number %8d/%8d IGNORED\n",ia,na);
@@ -633,23 +553,22 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
   }
 
   /* read mesh tetrahedra */
-  rewind(inm);
-  fseek(inm,posne,SEEK_SET);
+  ab.pos = posne;
   mesh->xt = 0;
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
-    if (!bin)
-      fscanf(inm,"%d %d %d %d %d",&pt->v[0],&pt->v[1],&pt->v[2],&pt->v[3],&ref);
-    else {
-      for (i=0 ; i<4 ; i++) {
-        fread(&pt->v[i],sw,1,inm);
-        if(iswp) pt->v[i]=_MMG5_swapbin(pt->v[i]);
-      }
-      fread(&ref,sw,1,inm);
-      if(iswp) ref=_MMG5_swapbin(ref);
+    if (!bin) {
+      _MMG5_readInt(&ab,&pt->v[0]);
+      _MMG5_readInt(&ab,&pt->v[1]);
+      _MMG5_readInt(&ab,&pt->v[2]);
+      _MMG5_readInt(&ab,&pt->v[3]);
+      _MMG5_readInt(&ab,&ref);
+    } else {
+      _MMG5_readBinBlock(&ab,pt->v,sw,4,iswp);
+      _MMG5_readBin(&ab,&ref,sw,iswp);
     }
     pt->ref  = ref;//0;//ref ;
-    pt->qual = _MMG5_orcal(mesh,k);
+    pt->qual = _MMG5_orcal(mesh,NULL,k);
     for (i=0; i<4; i++) {
       ppt = &mesh->point[pt->v[i]];
       ppt->tag &= ~MG_NUL;
@@ -674,14 +593,12 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
   mesh->xt = 0;
   /* get required tetrahedra */
   if(nereq) {
-    rewind(inm);
-    fseek(inm,posnereq,SEEK_SET);
+    ab.pos = posnereq;
     for (k=1; k<=nereq; k++) {
       if(!bin)
-        fscanf(inm,"%d",&i);
+        _MMG5_readInt(&ab,&i);
       else {
-        fread(&i,sw,1,inm);
-        if(iswp) i=_MMG5_swapbin(i);
+        _MMG5_readBin(&ab,&i,sw,iswp);
       }
       if(i>mesh->ne) {
         fprintf(stdout,"   Warning Required Tetra number %8d IGNORED\n",i);
@@ -718,10 +635,32 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
     }
     if(ncor) fprintf(stdout,"     NUMBER OF CORNERS        %8d \n",ncor);
   }
-  fclose(inm);
+  _MMG5_closeAscii(&ab);
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read mesh data.
+ *
+ */
+int MMG5_loadMesh(MMG5_pMesh mesh) {
+  return(_MMG5_loadMeshFile(mesh,0));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read the data of a surface mesh (the tetrahedra are optional).
+ *
+ */
+int _MMG5_loadSurf(MMG5_pMesh mesh) {
+  return(_MMG5_loadMeshFile(mesh,1));
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \return 0 if failed, 1 otherwise.
@@ -732,6 +671,7 @@ int MMG5_loadMesh(MMG5_pMesh mesh) {
  */
 int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
   FILE*        inm;
+  _MMG5_Wbuf   wb;
   MMG5_pPoint  ppt;
   MMG5_pTetra  pt;
   MMG5_pTria   ptt;
@@ -768,25 +708,26 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
     }
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
+  _MMG5_openWbuf(&wb,inm);
 
   /*entete fichier*/
   binch=0; bpos=10;
   if(!bin) {
     strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
     strcpy(&chaine[0],"\n\nDimension 3\n");
-    fprintf(inm,"%s ",chaine);
+    _MMG5_printWbuf(&wb,"%s ",chaine);
   } else {
     binch = 1; //MeshVersionFormatted
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 2; //version
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 3; //Dimension
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos = 20; //Pos
-    fwrite(&bpos,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
     binch = 3;
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
 
   }
   /* vertices */
@@ -802,26 +743,26 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
 
   if(!bin) {
     strcpy(&chaine[0],"\n\nVertices\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",np);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",np);
   } else {
     binch = 4; //Vertices
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 12+(1+3*mesh->ver)*4*np; //NullPos
-    fwrite(&bpos,sw,1,inm);
-    fwrite(&np,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&np,sw);
   }
   for (k=1; k<=mesh->np; k++) {
     ppt = &mesh->point[k];
     if ( MG_VOK(ppt) ) {
       if(!bin) {
-        fprintf(inm,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
+        _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
       } else {
-        fwrite((unsigned char*)&ppt->c[0],sd,1,inm);
-        fwrite((unsigned char*)&ppt->c[1],sd,1,inm);
-        fwrite((unsigned char*)&ppt->c[2],sd,1,inm);
+        _MMG5_writeBin(&wb,&ppt->c[0],sd);
+        _MMG5_writeBin(&wb,&ppt->c[1],sd);
+        _MMG5_writeBin(&wb,&ppt->c[2],sd);
         ppt->ref = abs(ppt->ref);
-        fwrite((unsigned char*)&ppt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&ppt->ref,sw);
       }
     }
   }
@@ -830,23 +771,23 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
   if ( nc ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nCorners\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nc);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nc);
     } else {
       binch = 13; //
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+4*nc; //NullPos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nc,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nc,sw);
     }
 
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && ppt->tag & MG_CRN ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ppt->tmp);
+          _MMG5_printWbuf(&wb,"%d \n",ppt->tmp);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
         }
       }
     }
@@ -854,22 +795,22 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
   if ( nre ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nRequiredVertices\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nre);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nre);
     } else {
       binch = 15; //
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+4*nre; //NullPos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nre,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nre,sw);
     }
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && ppt->tag & MG_REQ ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ppt->tmp);
+          _MMG5_printWbuf(&wb,"%d \n",ppt->tmp);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
         }
       }
     }
@@ -890,14 +831,14 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
     /* write normals */
     if(!bin) {
       strcpy(&chaine[0],"\n\nNormals\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nn);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nn);
     } else {
       binch = 60; //normals
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+(3*mesh->ver)*4*nn; //Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nn,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nn,sw);
     }
 
     for (k=1; k<=mesh->np; k++) {
@@ -907,25 +848,25 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
                 && (!(ppt->tag & MG_GEO) || (ppt->tag & MG_NOM)) ) {
         pxp = &mesh->xpoint[ppt->xp];
         if(!bin) {
-          fprintf(inm,"%.15lg %.15lg %.15lg \n",pxp->n1[0],pxp->n1[1],pxp->n1[2]);
+          _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg \n",pxp->n1[0],pxp->n1[1],pxp->n1[2]);
         } else {
-          fwrite((unsigned char*)&pxp->n1[0],sd,1,inm);
-          fwrite((unsigned char*)&pxp->n1[1],sd,1,inm);
-          fwrite((unsigned char*)&pxp->n1[2],sd,1,inm);
+          _MMG5_writeBin(&wb,&pxp->n1[0],sd);
+          _MMG5_writeBin(&wb,&pxp->n1[1],sd);
+          _MMG5_writeBin(&wb,&pxp->n1[2],sd);
         }
       }
     }
 
     if(!bin) {
       strcpy(&chaine[0],"\n\nNormalAtVertices\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nn);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nn);
     } else {
       binch = 20; //normalatvertices
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 2*4*nn;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nn,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nn,sw);
     }
     nn = 0;
     for (k=1; k<=mesh->np; k++) {
@@ -934,11 +875,11 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
       else if ( (ppt->tag & MG_BDY)
                 && (!(ppt->tag & MG_GEO) || (ppt->tag & MG_NOM)) ) {
         if(!bin) {
-          fprintf(inm,"%d %d\n",ppt->tmp,++nn);
+          _MMG5_printWbuf(&wb,"%d %d\n",ppt->tmp,++nn);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
           ++nn;
-          fwrite(&nn,sw,1,inm);
+          _MMG5_writeBin(&wb,&nn,sw);
         }
       }
     }
@@ -947,14 +888,14 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
       /* Write tangents */
       if(!bin) {
         strcpy(&chaine[0],"\n\nTangents\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",nt);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d\n",nt);
       } else {
         binch = 59; //tangent
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12+(3*mesh->ver)*4*nt; //Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&nt,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&nt,sw);
       }
 
       for (k=1; k<=mesh->np; k++) {
@@ -963,11 +904,11 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
         else if ( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) ) {
           pxp = &mesh->xpoint[ppt->xp];
           if(!bin) {
-            fprintf(inm,"%.15lg %.15lg %.15lg \n",pxp->t[0],pxp->t[1],pxp->t[2]);
+            _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg \n",pxp->t[0],pxp->t[1],pxp->t[2]);
           } else {
-            fwrite((unsigned char*)&pxp->t[0],sd,1,inm);
-            fwrite((unsigned char*)&pxp->t[1],sd,1,inm);
-            fwrite((unsigned char*)&pxp->t[2],sd,1,inm);
+            _MMG5_writeBin(&wb,&pxp->t[0],sd);
+            _MMG5_writeBin(&wb,&pxp->t[1],sd);
+            _MMG5_writeBin(&wb,&pxp->t[2],sd);
           }
         }
       }
@@ -975,14 +916,14 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
 
       if(!bin) {
         strcpy(&chaine[0],"\n\nTangentAtVertices\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",nt);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d\n",nt);
       } else {
         binch = 61; //tangentatvertices
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12 + 2*4*nt;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&nt,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&nt,sw);
       }
       nt = 0;
       for (k=1; k<=mesh->np; k++) {
@@ -990,18 +931,18 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
         if ( !MG_VOK(ppt) || MG_SIN(ppt->tag) )  continue;
         else if ( MG_EDG(ppt->tag) || (ppt->tag & MG_NOM) ) {
           if(!bin) {
-            fprintf(inm,"%d %d\n",ppt->tmp,++nn);
+            _MMG5_printWbuf(&wb,"%d %d\n",ppt->tmp,++nn);
           } else {
-            fwrite(&ppt->tmp,sw,1,inm);
+            _MMG5_writeBin(&wb,&ppt->tmp,sw);
             ++nn;
-            fwrite(&(nn),sw,1,inm);
+            _MMG5_writeBin(&wb,&(nn),sw);
           }
         }
       }
     }
   }
   _MMG5_DEL_MEM(mesh,mesh->xpoint,(mesh->xpmax+1)*sizeof(MMG5_xPoint));
-  mesh->xp = 0;
+  mesh->xp = mesh->xpnil = 0;
 
   /* boundary mesh */
   /* tria + required tria */
@@ -1013,47 +954,47 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
   if ( _MMG5_bdryTria(mesh) ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nTriangles\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d \n",mesh->nt);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d \n",mesh->nt);
     } else {
       binch = 6; //Triangles
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+16*mesh->nt; //Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&mesh->nt,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&mesh->nt,sw);
     }
     for (k=1; k<=mesh->nt; k++) {
       ptt = &mesh->tria[k];
       if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ )  ntreq++;
       if(!bin) {
-        fprintf(inm,"%d %d %d %d\n",mesh->point[ptt->v[0]].tmp,mesh->point[ptt->v[1]].tmp
+        _MMG5_printWbuf(&wb,"%d %d %d %d\n",mesh->point[ptt->v[0]].tmp,mesh->point[ptt->v[1]].tmp
                 ,mesh->point[ptt->v[2]].tmp,ptt->ref);
       } else {
-        fwrite(&mesh->point[ptt->v[0]].tmp,sw,1,inm);
-        fwrite(&mesh->point[ptt->v[1]].tmp,sw,1,inm);
-        fwrite(&mesh->point[ptt->v[2]].tmp,sw,1,inm);
-        fwrite(&ptt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&mesh->point[ptt->v[0]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[ptt->v[1]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[ptt->v[2]].tmp,sw);
+        _MMG5_writeBin(&wb,&ptt->ref,sw);
       }
     }
     if ( ntreq ) {
       if(!bin) {
         strcpy(&chaine[0],"\n\nRequiredTriangles\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d \n",ntreq);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d \n",ntreq);
       } else {
         binch = 17; //ReqTriangles
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12+4*ntreq; //Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&ntreq,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&ntreq,sw);
       }
       for (k=0; k<=mesh->nt; k++) {
         ptt = &mesh->tria[k];
         if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ ) {
           if(!bin) {
-            fprintf(inm,"%d \n",k);
+            _MMG5_printWbuf(&wb,"%d \n",k);
           } else {
-            fwrite(&k,sw,1,inm);
+            _MMG5_writeBin(&wb,&k,sw);
           }
         }
       }
@@ -1102,37 +1043,37 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
       if ( na ) {
         if(!bin) {
           strcpy(&chaine[0],"\n\nEdges\n");
-          fprintf(inm,"%s",chaine);
-          fprintf(inm,"%d\n",na);
+          _MMG5_printWbuf(&wb,"%s",chaine);
+          _MMG5_printWbuf(&wb,"%d\n",na);
         } else {
           binch = 5; //Edges
-          fwrite(&binch,sw,1,inm);
+          _MMG5_writeBin(&wb,&binch,sw);
           bpos += 12 + 3*4*na;//Pos
-          fwrite(&bpos,sw,1,inm);
-          fwrite(&na,sw,1,inm);
+          _MMG5_writeBin(&wb,&bpos,sw);
+          _MMG5_writeBin(&wb,&na,sw);
         }
         for (k=0; k<=mesh->htab.max; k++) {
           ph = &mesh->htab.geom[k];
           if ( !ph->a )  continue;
           if(!bin) {
-            fprintf(inm,"%d %d %d \n",mesh->point[ph->a].tmp,mesh->point[ph->b].tmp,ph->ref);
+            _MMG5_printWbuf(&wb,"%d %d %d \n",mesh->point[ph->a].tmp,mesh->point[ph->b].tmp,ph->ref);
           } else {
-            fwrite(&mesh->point[ph->a].tmp,sw,1,inm);
-            fwrite(&mesh->point[ph->b].tmp,sw,1,inm);
-            fwrite(&ph->ref,sw,1,inm);
+            _MMG5_writeBin(&wb,&mesh->point[ph->a].tmp,sw);
+            _MMG5_writeBin(&wb,&mesh->point[ph->b].tmp,sw);
+            _MMG5_writeBin(&wb,&ph->ref,sw);
           }
         }
         if ( nr ) {
           if(!bin) {
             strcpy(&chaine[0],"\n\nRidges\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nr);
+            _MMG5_printWbuf(&wb,"%s",chaine);
+            _MMG5_printWbuf(&wb,"%d\n",nr);
           } else {
             binch = 14; //Ridges
-            fwrite(&binch,sw,1,inm);
+            _MMG5_writeBin(&wb,&binch,sw);
             bpos += 12 + 4*nr;//Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nr,sw,1,inm);
+            _MMG5_writeBin(&wb,&bpos,sw);
+            _MMG5_writeBin(&wb,&nr,sw);
           }
           na = 0;
           for (k=0; k<=mesh->htab.max; k++) {
@@ -1141,9 +1082,9 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
             na++;
             if ( ph->tag & MG_GEO )  {
               if(!bin) {
-                fprintf(inm,"%d \n",na);
+                _MMG5_printWbuf(&wb,"%d \n",na);
               } else {
-                fwrite(&na,sw,1,inm);
+                _MMG5_writeBin(&wb,&na,sw);
               }
             }
           }
@@ -1151,14 +1092,14 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
         if ( nedreq ) {
           if(!bin) {
             strcpy(&chaine[0],"\n\nRequiredEdges\n");
-            fprintf(inm,"%s",chaine);
-            fprintf(inm,"%d\n",nedreq);
+            _MMG5_printWbuf(&wb,"%s",chaine);
+            _MMG5_printWbuf(&wb,"%d\n",nedreq);
           } else {
             binch = 16; //RequiredEdges
-            fwrite(&binch,sw,1,inm);
+            _MMG5_writeBin(&wb,&binch,sw);
             bpos += 12 + 4*nedreq;//Pos
-            fwrite(&bpos,sw,1,inm);
-            fwrite(&nedreq,sw,1,inm);
+            _MMG5_writeBin(&wb,&bpos,sw);
+            _MMG5_writeBin(&wb,&nedreq,sw);
           }
           na = 0;
           for (k=0; k<=mesh->htab.max; k++) {
@@ -1167,9 +1108,9 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
             na++;
             if ( ph->tag & MG_REQ )  {
               if(!bin) {
-                fprintf(inm,"%d \n",na);
+                _MMG5_printWbuf(&wb,"%d \n",na);
               } else {
-                fwrite(&na,sw,1,inm);
+                _MMG5_writeBin(&wb,&na,sw);
               }
             }
           }
@@ -1195,27 +1136,27 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
 
   if(!bin) {
     strcpy(&chaine[0],"\n\nTetrahedra\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",ne);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",ne);
   } else {
     binch = 8; //Tetra
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 12 + 20*ne;//Pos
-    fwrite(&bpos,sw,1,inm);
-    fwrite((unsigned char*)&ne,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&ne,sw);
   }
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
     if ( MG_EOK(pt) ) {
       if(!bin) {
-        fprintf(inm,"%d %d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
+        _MMG5_printWbuf(&wb,"%d %d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
                 ,mesh->point[pt->v[2]].tmp,mesh->point[pt->v[3]].tmp,pt->ref);
       } else {
-        fwrite(&mesh->point[pt->v[0]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[1]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[2]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[3]].tmp,sw,1,inm);
-        fwrite(&pt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[0]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[1]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[2]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[3]].tmp,sw);
+        _MMG5_writeBin(&wb,&pt->ref,sw);
       }
     }
   }
@@ -1223,14 +1164,14 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
   if ( nereq ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nRequiredTetrahedra\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nereq);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nereq);
     } else {
       binch = 12; //RequiredTetra
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 4*nereq;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nereq,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nereq,sw);
     }
     ne = 0;
     for (k=1; k<=mesh->ne; k++) {
@@ -1239,9 +1180,9 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
       ne++;
       if ( pt->tag & MG_REQ ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ne);
+          _MMG5_printWbuf(&wb,"%d \n",ne);
         } else {
-          fwrite(&ne,sw,1,inm);
+          _MMG5_writeBin(&wb,&ne,sw);
         }
       }
     }
@@ -1259,11 +1200,12 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
   /*fin fichier*/
   if(!bin) {
     strcpy(&chaine[0],"\n\nEnd\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
   } else {
     binch = 54; //End
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
+  _MMG5_closeWbuf(&wb);
   fclose(inm);
   return(1);
 }
@@ -1278,6 +1220,7 @@ int _MMG5_saveAllMesh(MMG5_pMesh mesh) {
  */
 int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   FILE        *inm;
+  _MMG5_Wbuf   wb;
   MMG5_pPoint  ppt;
   MMG5_pTetra  pt;
   MMG5_pTria   ptt;
@@ -1312,23 +1255,24 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
     }
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
+  _MMG5_openWbuf(&wb,inm);
   /*entete fichier*/
   if(!bin) {
     strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
     strcpy(&chaine[0],"\n\nDimension 3\n");
-    fprintf(inm,"%s ",chaine);
+    _MMG5_printWbuf(&wb,"%s ",chaine);
   } else {
     binch = 1; //MeshVersionFormatted
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 2; //version
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 3; //Dimension
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos = 20; //Pos
-    fwrite(&bpos,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
     binch = 3;
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
 
   }
   /* vertices */
@@ -1343,26 +1287,26 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   }
   if(!bin) {
     strcpy(&chaine[0],"\n\nVertices\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",np);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",np);
   } else {
     binch = 4; //Vertices
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 12+(1+3*mesh->ver)*4*np; //NullPos
-    fwrite(&bpos,sw,1,inm);
-    fwrite(&np,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&np,sw);
   }
   for (k=1; k<=mesh->np; k++) {
     ppt = &mesh->point[k];
     if ( MG_VOK(ppt) ) {
       if(!bin) {
-        fprintf(inm,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
+        _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
       } else {
-        fwrite((unsigned char*)&ppt->c[0],sd,1,inm);
-        fwrite((unsigned char*)&ppt->c[1],sd,1,inm);
-        fwrite((unsigned char*)&ppt->c[2],sd,1,inm);
+        _MMG5_writeBin(&wb,&ppt->c[0],sd);
+        _MMG5_writeBin(&wb,&ppt->c[1],sd);
+        _MMG5_writeBin(&wb,&ppt->c[2],sd);
         ppt->ref = abs(ppt->ref);
-        fwrite((unsigned char*)&ppt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&ppt->ref,sw);
       }
     }
   }
@@ -1371,23 +1315,23 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   if ( nc ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nCorners\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nc);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nc);
     } else {
       binch = 13; //
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+4*nc; //NullPos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nc,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nc,sw);
     }
 
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && ppt->tag & MG_CRN ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ppt->tmp);
+          _MMG5_printWbuf(&wb,"%d \n",ppt->tmp);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
         }
       }
     }
@@ -1395,22 +1339,22 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   if ( nre ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nRequiredVertices\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nre);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nre);
     } else {
       binch = 15; //
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+4*nre; //NullPos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nre,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nre,sw);
     }
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && ppt->tag & MG_REQ ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ppt->tmp);
+          _MMG5_printWbuf(&wb,"%d \n",ppt->tmp);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
         }
       }
     }
@@ -1421,47 +1365,47 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   if ( mesh->nt ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nTriangles\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d \n",mesh->nt);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d \n",mesh->nt);
     } else {
       binch = 6; //Triangles
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+16*mesh->nt; //Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&mesh->nt,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&mesh->nt,sw);
     }
     for (k=1; k<=mesh->nt; k++) {
       ptt = &mesh->tria[k];
       if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ )  ntreq++;
       if(!bin) {
-        fprintf(inm,"%d %d %d %d\n",mesh->point[ptt->v[0]].tmp,mesh->point[ptt->v[1]].tmp
+        _MMG5_printWbuf(&wb,"%d %d %d %d\n",mesh->point[ptt->v[0]].tmp,mesh->point[ptt->v[1]].tmp
                 ,mesh->point[ptt->v[2]].tmp,ptt->ref);
       } else {
-        fwrite(&mesh->point[ptt->v[0]].tmp,sw,1,inm);
-        fwrite(&mesh->point[ptt->v[1]].tmp,sw,1,inm);
-        fwrite(&mesh->point[ptt->v[2]].tmp,sw,1,inm);
-        fwrite(&ptt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&mesh->point[ptt->v[0]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[ptt->v[1]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[ptt->v[2]].tmp,sw);
+        _MMG5_writeBin(&wb,&ptt->ref,sw);
       }
     }
     if ( ntreq ) {
       if(!bin) {
         strcpy(&chaine[0],"\n\nRequiredTriangles\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d \n",ntreq);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d \n",ntreq);
       } else {
         binch = 17; //ReqTriangles
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12+4*ntreq; //Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&ntreq,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&ntreq,sw);
       }
       for (k=0; k<=mesh->nt; k++) {
         ptt = &mesh->tria[k];
         if ( ptt->tag[0] & MG_REQ && ptt->tag[1] & MG_REQ && ptt->tag[2] & MG_REQ ) {
           if(!bin) {
-            fprintf(inm,"%d \n",k);
+            _MMG5_printWbuf(&wb,"%d \n",k);
           } else {
-            fwrite(&k,sw,1,inm);
+            _MMG5_writeBin(&wb,&k,sw);
           }
         }
       }
@@ -1472,23 +1416,23 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   if ( mesh->na ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nEdges\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",mesh->na);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",mesh->na);
     } else {
       binch = 5; //Edges
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 3*4*mesh->na;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&mesh->na,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&mesh->na,sw);
     }
     for (k=1; k<=mesh->na; k++) {
       if(!bin) {
-        fprintf(inm,"%d %d %d \n",mesh->point[mesh->edge[k].a].tmp,
+        _MMG5_printWbuf(&wb,"%d %d %d \n",mesh->point[mesh->edge[k].a].tmp,
                 mesh->point[mesh->edge[k].b].tmp,mesh->edge[k].ref);
       } else {
-        fwrite(&mesh->point[mesh->edge[k].a].tmp,sw,1,inm);
-        fwrite(&mesh->point[mesh->edge[k].b].tmp,sw,1,inm);
-        fwrite(&mesh->edge[k].ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&mesh->point[mesh->edge[k].a].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[mesh->edge[k].b].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->edge[k].ref,sw);
       }
       if ( mesh->edge[k].tag & MG_GEO ) nr++;
       if ( mesh->edge[k].tag & MG_REQ ) nedreq++;
@@ -1497,23 +1441,23 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
     if ( nr ) {
       if(!bin) {
         strcpy(&chaine[0],"\n\nRidges\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",nr);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d\n",nr);
       } else {
         binch = 14; //Ridges
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12 + 4*nr;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&nr,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&nr,sw);
       }
       na = 0;
       for (k=1; k<=mesh->na; k++) {
         na++;
         if ( mesh->edge[k].tag & MG_GEO ) {
           if(!bin) {
-            fprintf(inm,"%d \n",na);
+            _MMG5_printWbuf(&wb,"%d \n",na);
           } else {
-            fwrite(&na,sw,1,inm);
+            _MMG5_writeBin(&wb,&na,sw);
           }
         }
       }
@@ -1521,23 +1465,23 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
     if ( nedreq ) {
       if(!bin) {
         strcpy(&chaine[0],"\n\nRequiredEdges\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",nedreq);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d\n",nedreq);
       } else {
         binch = 16; //RequiredEdges
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12 + 4*nedreq;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&nedreq,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&nedreq,sw);
       }
       na = 0;
       for (k=1; k<=mesh->na; k++) {
         na++;
         if (  mesh->edge[k].tag & MG_REQ ) {
           if(!bin) {
-            fprintf(inm,"%d \n",na);
+            _MMG5_printWbuf(&wb,"%d \n",na);
           } else {
-            fwrite(&na,sw,1,inm);
+            _MMG5_writeBin(&wb,&na,sw);
           }
         }
       }
@@ -1557,27 +1501,27 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
 
   if(!bin) {
     strcpy(&chaine[0],"\n\nTetrahedra\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",ne);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",ne);
   } else {
     binch = 8; //Tetra
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 12 + 20*ne;//Pos
-    fwrite(&bpos,sw,1,inm);
-    fwrite((unsigned char*)&ne,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&ne,sw);
   }
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
     if ( MG_EOK(pt) ) {
       if(!bin) {
-        fprintf(inm,"%d %d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
+        _MMG5_printWbuf(&wb,"%d %d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
                 ,mesh->point[pt->v[2]].tmp,mesh->point[pt->v[3]].tmp,pt->ref);
       } else {
-        fwrite(&mesh->point[pt->v[0]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[1]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[2]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[3]].tmp,sw,1,inm);
-        fwrite(&pt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[0]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[1]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[2]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[3]].tmp,sw);
+        _MMG5_writeBin(&wb,&pt->ref,sw);
       }
     }
   }
@@ -1585,14 +1529,14 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   if ( nereq ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nRequiredTetrahedra\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nereq);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nereq);
     } else {
       binch = 12; //RequiredTetra
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 4*nereq;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nereq,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nereq,sw);
     }
     ne = 0;
     for (k=1; k<=mesh->ne; k++) {
@@ -1601,9 +1545,9 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
       ne++;
       if ( pt->tag & MG_REQ ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ne);
+          _MMG5_printWbuf(&wb,"%d \n",ne);
         } else {
-          fwrite(&ne,sw,1,inm);
+          _MMG5_writeBin(&wb,&ne,sw);
         }
       }
     }
@@ -1620,11 +1564,12 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
   /*fin fichier*/
   if(!bin) {
     strcpy(&chaine[0],"\n\nEnd\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
   } else {
     binch = 54; //End
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
+  _MMG5_closeWbuf(&wb);
   fclose(inm);
   return(1);
 }
@@ -1639,11 +1584,12 @@ int _MMG5_saveLibraryMesh(MMG5_pMesh mesh) {
  */
 int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
   FILE       *inm;
+  _MMG5_Abuf  ab;
   float       fbuf[6];
-  double      dbuf[6];
+  double      dbuf[6],*m,lambda[3*_MMG5_EIGBATCH],v[9*_MMG5_EIGBATCH],h;
   int         binch,bdim,iswp;
   int         i,k,bin,bpos;
-  int         compute_hmin, compute_hmax;
+  int         compute_hmin, compute_hmax,nb,ier,ret;
   long        posnp;
   char        *ptr,data[128],chaine[128];
 
@@ -1678,104 +1624,134 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+  /* parse the file from memory */
+  fclose(inm);
+  if ( !_MMG5_openAscii(data,&ab) ) {
+    fprintf(stderr,"  ** UNABLE TO READ %s.\n",data);
+    return(0);
+  }
+
 
   /* read solution or metric */
   if(!bin) {
     strcpy(chaine,"DDD");
-    while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
+    while(_MMG5_readWord(&ab,chaine,128)!=EOF && strncmp(chaine,"End",strlen("End")) ) {
       if(!strncmp(chaine,"Dimension",strlen("Dimension"))) {
-        fscanf(inm,"%d",&met->dim);
+        _MMG5_readInt(&ab,&met->dim);
         if(met->dim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",met->dim);
-          return(-1);
+          ret = -1;
+          goto end;
         }
         continue;
       } else if(!strncmp(chaine,"SolAtVertices",strlen("SolAtVertices"))) {
-        fscanf(inm,"%d",&met->np);
-        fscanf(inm,"%d",&met->type);
-        if(met->type!=1) {
+        _MMG5_readInt(&ab,&met->np);
+        _MMG5_readInt(&ab,&met->type);
+        if ( met->type!=1 &&
+             !(mesh->info.iso && met->type > 1 && met->type <= _MMG5_LSMAX) ) {
           fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",met->type);
-          return(-1);
+          ret = -1;
+          goto end;
+        }
+        for (i=0; i<met->type; i++) {
+          _MMG5_readInt(&ab,&met->size);
+          if ( met->type > 1 && met->size != 1 ) {
+            fprintf(stdout,"  ** THE LEVEL-SET FUNCTIONS MUST BE SCALAR\n");
+            ret = -1;
+            goto end;
+          }
         }
-        fscanf(inm,"%d",&met->size);
-        posnp = ftell(inm);
+        posnp = ab.pos;
         break;
       }
     }
   } else {
-    fread(&binch,sw,1,inm);
+    _MMG5_readBin(&ab,&binch,sw,0);
     iswp=0;
     if(binch==16777216) iswp=1;
     else if(binch!=1) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
-    fread(&met->ver,sw,1,inm);
-    if(iswp) met->ver = _MMG5_swapbin(met->ver);
-    while(fread(&binch,sw,1,inm)!=EOF && binch!=54 ) {
-      if(iswp) binch=_MMG5_swapbin(binch);
-      if(binch==54) break;
+    _MMG5_readBin(&ab,&met->ver,sw,iswp);
+    while(_MMG5_readBin(&ab,&binch,sw,iswp) && binch!=54 ) {
       if(binch==3) {  //Dimension
-        fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=_MMG5_swapbin(bdim);
-        fread(&met->dim,sw,1,inm);
-        if(iswp) met->dim=_MMG5_swapbin(met->dim);
+        _MMG5_readBin(&ab,&bdim,sw,iswp);  //NulPos=>20
+        _MMG5_readBin(&ab,&met->dim,sw,iswp);
         if(met->dim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",met->dim);
           printf("  Exit program.\n");
-          return(-1);
+          ret = -1;
+          goto end;
         }
         continue;
       } else if(binch==62) {  //SolAtVertices
-        fread(&binch,sw,1,inm); //NulPos
-        if(iswp) binch=_MMG5_swapbin(binch);
-        fread(&met->np,sw,1,inm);
-        if(iswp) met->np=_MMG5_swapbin(met->np);
-        fread(&met->type,sw,1,inm); //nb sol
-        if(iswp) met->type=_MMG5_swapbin(met->type);
-        if(met->type!=1) {
+        _MMG5_readBin(&ab,&binch,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&met->np,sw,iswp);
+        _MMG5_readBin(&ab,&met->type,sw,iswp); //nb sol
+        if ( met->type!=1 &&
+             !(mesh->info.iso && met->type > 1 && met->type <= _MMG5_LSMAX) ) {
           fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",met->type);
-          return(-1);
+          ret = -1;
+          goto end;
+        }
+        for (i=0; i<met->type; i++) {
+          _MMG5_readBin(&ab,&met->size,sw,iswp); //typsol
+          if ( met->type > 1 && met->size != 1 ) {
+            fprintf(stdout,"  ** THE LEVEL-SET FUNCTIONS MUST BE SCALAR\n");
+            ret = -1;
+            goto end;
+          }
         }
-        fread(&met->size,sw,1,inm); //typsol
-        if(iswp) met->size=_MMG5_swapbin(met->size);
-        posnp = ftell(inm);
+        posnp = ab.pos;
         break;
       } else {
-        fread(&bpos,sw,1,inm); //Pos
-        if(iswp) bpos=_MMG5_swapbin(bpos);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //Pos
+        ab.pos = bpos;
       }
     }
 
   }
   if ( mesh->np != met->np ) {
-    return(-1);
+    ret = -1;
+    goto end;
   }
   if ( mesh->info.lag == -1 ) {
-    if(met->size!=1) {
-      fprintf(stdout,"  ** DATA ANISO IGNORED %d \n",met->size);
-      return(-1);
+    if ( met->type > 1 ) {
+      /* several level-set functions: 1 value per function and vertex */
+      met->size = met->type;
+    }
+    else if ( met->size == 3 ) {
+      /* symmetric tensor: 6 components per vertex */
+      met->size = 6;
+    }
+    else if(met->size!=1) {
+      fprintf(stdout,"  ** DATA TYPE IGNORED %d \n",met->size);
+      ret = -1;
+      goto end;
     }
   }
   else if ( met->size != 2 ) {
-    return(-1);
+    ret = -1;
+    goto end;
+  }
+  else {
+    /* displacement: 3 components per vertex */
+    met->size = 3;
   }
 
   met->npi = met->np;
 
   /* mem alloc */
-  if ( met->m )  _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
+  if ( met->m )  _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
   met->npmax = mesh->npmax;
 
-  _MMG5_ADD_MEM(mesh,(met->size*met->npmax+1)*sizeof(double),"initial solution",
+  _MMG5_ADD_MEM(mesh,(met->size*(met->npmax+1)+1)*sizeof(double),"initial solution",
                 printf("  Exit program.\n");
                 exit(EXIT_FAILURE));
-  _MMG5_SAFE_CALLOC(met->m,met->size*met->npmax+1,double);
+  _MMG5_SAFE_CALLOC(met->m,met->size*(met->npmax+1)+1,double);
 
   /* read mesh solutions */
-  rewind(inm);
-  fseek(inm,posnp,SEEK_SET);
+  ab.pos = posnp;
 
   /* If they are not provided by the user, enforce default values for hmin and
    * hmax:
@@ -1783,7 +1759,7 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
    *    - for hmax we take 10 \times the max of the metric sizes. */
   compute_hmin = compute_hmax = 0;
 
-  if ( !mesh->info.iso ) {
+  if ( !mesh->info.iso && met->size != 3 ) {
     if ( mesh->info.hmin < 0. ) {
       compute_hmin=1;
       mesh->info.hmin = FLT_MAX;
@@ -1794,27 +1770,51 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
     }
   }
 
+  /* several level-set functions */
+  if ( met->type > 1 ) {
+    if ( bin && met->ver != 1 ) {
+      /* the values are stored in the file order: read them in one block */
+      _MMG5_readBinBlock(&ab,&met->m[met->size],sd,met->size*met->np,iswp);
+    }
+    else for (k=1; k<=met->np; k++) {
+      for (i=0; i<met->size; i++) {
+        if ( met->ver == 1 ) {
+          if(!bin){
+            _MMG5_readFloat(&ab,&fbuf[0]);
+          } else {
+            _MMG5_readBin(&ab,&fbuf[0],sw,iswp);
+          }
+          dbuf[0] = fbuf[0];
+        }
+        else {
+          if(!bin){
+            _MMG5_readDouble(&ab,&dbuf[0]);
+          } else {
+            _MMG5_readBin(&ab,&dbuf[0],sd,iswp);
+          }
+        }
+        met->m[met->size*k+i] = dbuf[0];
+      }
+    }
+  }
   /* isotropic metric */
-  if ( met->size == 1 ) {
+  else if ( met->size == 1 ) {
     if ( met->ver == 1 ) {
       for (k=1; k<=met->np; k++) {
         if(!bin){
-          fscanf(inm,"%f",&fbuf[0]);
+          _MMG5_readFloat(&ab,&fbuf[0]);
         } else {
-          fread(&fbuf[0],sw,1,inm);
-          if(iswp) fbuf[0]=_MMG5_swapf(fbuf[0]);
+          _MMG5_readBin(&ab,&fbuf[0],sw,iswp);
         }
         met->m[k] = fbuf[0];
       }
     }
+    else if ( bin ) {
+      _MMG5_readBinBlock(&ab,&met->m[1],sd,met->np,iswp);
+    }
     else {
       for (k=1; k<=met->np; k++) {
-        if(!bin){
-          fscanf(inm,"%lf",&dbuf[0]);
-        } else {
-          fread(&dbuf[0],sd,1,inm);
-          if(iswp) dbuf[0]=_MMG5_swapd(dbuf[0]);
-        }
+        _MMG5_readDouble(&ab,&dbuf[0]);
         met->m[k] = dbuf[0];
       }
     }
@@ -1831,57 +1831,80 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
     }
   }
   /* vector displacement only */
-  else if(met->size==2) {
-    met->size = 3;
+  else if(met->size==3) {
     if ( met->ver == 1 ) {
       for (k=1; k<=met->np; k++) {
         for (i=1; i<=3; i++) {
           if(!bin){
-            fscanf(inm,"%f",&fbuf[0]);
+            _MMG5_readFloat(&ab,&fbuf[0]);
           } else {
-            fread(&fbuf[0],sw,1,inm);
-            if(iswp) fbuf[0]=_MMG5_swapf(fbuf[0]);
+            _MMG5_readBin(&ab,&fbuf[0],sw,iswp);
           }
           met->m[3*(k-1)+i] = fbuf[0];
         }
       }
     }
+    else if ( bin ) {
+      _MMG5_readBinBlock(&ab,&met->m[1],sd,3*met->np,iswp);
+    }
     else {
       for (k=1; k<=met->np; k++) {
         for (i=1; i<=3; i++) {
-          if(!bin){
-            fscanf(inm,"%lf",&dbuf[0]);
-          } else {
-            fread(&dbuf[0],sd,1,inm);
-            if(iswp) dbuf[0]=_MMG5_swapd(dbuf[0]);
-          }
+          _MMG5_readDouble(&ab,&dbuf[0]);
           met->m[3*(k-1)+i] = dbuf[0];
         }
       }
     }
   }
-  /* anisotropic metric */
-  /*else { //met->size==3
-    met->size=6;
-    if ( met->ver == GmfFloat ) {
-    for (k=1; k<=met->np; k++) {
-    GmfGetLin(inm,GmfSolAtVertices,fbuf);
-    tmpf    = fbuf[2];
-    fbuf[2] = fbuf[3];
-    fbuf[3] = tmpf;
-    for (i=0; i<6; i++)  met->m[6*k+1+i] = fbuf[i];
-    }
-    }
-    else {
+  /* anisotropic metric: file order is m11 m21 m22 m31 m32 m33 */
+  else {
     for (k=1; k<=met->np; k++) {
-    GmfGetLin(inm,GmfSolAtVertices,dbuf);
-    tmpd    = dbuf[2];
-    dbuf[2] = dbuf[3];
-    dbuf[3] = tmpd;
-    for (i=0; i<met->size; i++)  met->m[6*k+1+i] = dbuf[i];
-    }
+      if ( met->ver == 1 ) {
+        if ( bin )
+          _MMG5_readBinBlock(&ab,fbuf,sw,6,iswp);
+        else
+          for (i=0; i<6; i++)  _MMG5_readFloat(&ab,&fbuf[i]);
+        for (i=0; i<6; i++)  dbuf[i] = fbuf[i];
+      }
+      else {
+        if ( bin )
+          _MMG5_readBinBlock(&ab,dbuf,sd,6,iswp);
+        else
+          for (i=0; i<6; i++)  _MMG5_readDouble(&ab,&dbuf[i]);
+      }
+      m    = &met->m[6*k+1];
+      m[0] = dbuf[0];
+      m[1] = dbuf[1];
+      m[2] = dbuf[3];
+      m[3] = dbuf[2];
+      m[4] = dbuf[4];
+      m[5] = dbuf[5];
+    }
+
+    /* the metrics are diagonalized by blocks */
+    for (k=1; k<=met->np; k+=_MMG5_EIGBATCH) {
+      nb  = MG_MIN(_MMG5_EIGBATCH,met->np-k+1);
+      ier = _MMG5_eigensym3_batch(nb,&met->m[6*k+1],lambda,v);
+      if ( ier < nb ) {
+        fprintf(stdout,"  ## Error: unable to diagonalize the metric at"
+                " vertex %d.\n",k+ier);
+        ret = -1;
+        goto end;
+      }
+      for (i=0; i<3*nb; i++) {
+        if ( lambda[i] <= 0.0 ) {
+          fprintf(stdout,"  ## Error: metric not positive definite at"
+                  " vertex %d.\n",k+i/3);
+          ret = -1;
+          goto end;
+        }
+        /* extremal sizes of the metric */
+        h = 1.0 / sqrt(lambda[i]);
+        if ( compute_hmin )  mesh->info.hmin = MG_MIN(mesh->info.hmin,h);
+        if ( compute_hmax )  mesh->info.hmax = MG_MAX(mesh->info.hmax,h);
+      }
     }
-    }*/
+  }
 
   if ( compute_hmin ) {
     mesh->info.hmin *=.1;
@@ -1901,7 +1924,12 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
   }
 
   met->npi = met->np;
-  fclose(inm);
+  ret = 1;
+
+end:
+  /* every exit releases the file buffer */
+  _MMG5_closeAscii(&ab);
+  if ( ret < 1 )  return(ret);
 
   /* stats */
   if ( abs(mesh->info.imprim) > 3 ) {
@@ -1925,9 +1953,11 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
  */
 int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
   FILE*        inm;
+  _MMG5_Wbuf   wb;
   MMG5_pPoint  ppt;
+  double       dbuf[6],*m;
   char        *ptr,data[128],chaine[128];
-  int          binch,bpos,bin,np,k,typ;
+  int          binch,bpos,bin,np,k,i,typ;
 
   if ( !met->m || !met->nameout )  return(-1);
   met->ver = 2;
@@ -1942,25 +1972,26 @@ int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
+  _MMG5_openWbuf(&wb,inm);
 
   /*entete fichier*/
   binch=bpos=0;
   if(!bin) {
     strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
     strcpy(&chaine[0],"\n\nDimension 3\n");
-    fprintf(inm,"%s ",chaine);
+    _MMG5_printWbuf(&wb,"%s ",chaine);
   } else {
     binch = 1; //MeshVersionFormatted
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 2; //version
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 3; //Dimension
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos = 20; //Pos
-    fwrite(&bpos,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
     binch = 3;
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
 
   }
 
@@ -1972,25 +2003,27 @@ int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
 
   if(met->size==1) {
     typ = 1;
+  } else if(met->size==3) {
+    typ = 2;
   } else {
     typ = 3;
   }
 
   if(!bin) {
     strcpy(&chaine[0],"\n\nSolAtVertices\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",np);
-    fprintf(inm,"%d %d\n",1,typ);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",np);
+    _MMG5_printWbuf(&wb,"%d %d\n",1,typ);
   } else {
     binch = 62; //Vertices
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 20+(met->size*met->ver)*4*np; //Pos
-    fwrite(&bpos,sw,1,inm);
-    fwrite(&np,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&np,sw);
     binch = 1; //nb sol
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = typ; //typ sol
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
 
   /* write isotropic metric */
@@ -1999,37 +2032,353 @@ int MMG5_saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) ) {
         if(!bin) {
-          fprintf(inm,"%.15lg \n ",met->m[k]);
+          _MMG5_printWbuf(&wb,"%.15lg \n ",met->m[k]);
         } else {
-          fwrite((unsigned char*)&met->m[k],sd,1,inm);
+          _MMG5_writeBin(&wb,&met->m[k],sd);
         }
       }
     }
   }
-  /* write anisotropic metric */
-  /*else {
-    typtab[0] = 3;
-    nbm = 1;
-    GmfSetKwd(outm,GmfSolAtVertices,np,nbm,typtab);
+  /* write anisotropic metric: file order is m11 m21 m22 m31 m32 m33 */
+  else {
     for (k=1; k<=mesh->np; k++) {
-    ppt = &mesh->point[k];
-    if ( MG_VOK(ppt) ) {
-    for (i=0; i<met->size; i++)  dbuf[i] = met->m[met->size*(k)+1+i];
-    tmp = dbuf[2];
-    dbuf[2] = dbuf[3];
-    dbuf[3] = tmp;
-    GmfSetLin(outm,GmfSolAtVertices,dbuf);
-    }
+      ppt = &mesh->point[k];
+      if ( !MG_VOK(ppt) )  continue;
+      m       = &met->m[6*k+1];
+      dbuf[0] = m[0];
+      dbuf[1] = m[1];
+      dbuf[2] = m[3];
+      dbuf[3] = m[2];
+      dbuf[4] = m[4];
+      dbuf[5] = m[5];
+      if(!bin) {
+        for (i=0; i<6; i++)
+          _MMG5_printWbuf(&wb,"%.15lg ",dbuf[i]);
+        _MMG5_printWbuf(&wb,"\n");
+      } else {
+        for (i=0; i<6; i++)
+          _MMG5_writeBin(&wb,&dbuf[i],sd);
+      }
     }
-    }*/
+  }
   /*fin fichier*/
   if(!bin) {
     strcpy(&chaine[0],"\n\nEnd\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
   } else {
     binch = 54; //End
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
+  _MMG5_closeWbuf(&wb);
   fclose(inm);
   return(1);
 }
+
+/**
+ * \param hdr table of size \ref _MMG5_CKPT_NHDR to fill.
+ *
+ * Fill the header of a checkpoint file: version, byte order and size of the
+ * stored structures (a checkpoint can only be restored by a build with the
+ * same memory layout).
+ *
+ */
+static inline
+void _MMG5_ckptHeader(int *hdr) {
+  hdr[0]  = _MMG5_CKPT_VERSION;
+  hdr[1]  = 0x01020304;
+  hdr[2]  = sizeof(MMG5_Point);
+  hdr[3]  = sizeof(MMG5_xPoint);
+  hdr[4]  = sizeof(MMG5_Tetra);
+  hdr[5]  = sizeof(MMG5_xTetra);
+  hdr[6]  = sizeof(MMG5_Tria);
+  hdr[7]  = sizeof(MMG5_Edge);
+  hdr[8]  = sizeof(MMG5_hgeom);
+  hdr[9]  = sizeof(MMG5_Par);
+  hdr[10] = sizeof(MMG5_Info);
+}
+
+/**
+ * \param out pointer toward the checkpoint file.
+ * \param tab table to write (may be NULL).
+ * \param n number of entities of the table.
+ * \param siz size of an entity.
+ *
+ * Write the number of entities of the table \a tab followed by its content
+ * (only the number 0 is written if the table is not allocated).
+ *
+ */
+static inline
+void _MMG5_writeCkptTab(FILE *out,const void *tab,int n,size_t siz) {
+  if ( !tab )  n = 0;
+  fwrite(&n,sizeof(int),1,out);
+  if ( n )  fwrite(tab,siz,n,out);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ab pointer toward the mapped checkpoint file.
+ * \param tab pointer toward the table to allocate and fill.
+ * \param n expected number of entities of the table.
+ * \param siz size of an entity.
+ * \param mess name of the table (for error messages).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read a table written by \ref _MMG5_writeCkptTab.
+ *
+ */
+static inline
+int _MMG5_readCkptTab(MMG5_pMesh mesh,_MMG5_Abuf *ab,void **tab,int n,
+                      size_t siz,const char *mess) {
+  int  nf;
+
+  *tab = NULL;
+  if ( !_MMG5_readBin(ab,&nf,sizeof(int),0) )  return(0);
+  if ( !nf )  return(1);
+
+  if ( nf != n || ab->pos + nf*siz > ab->siz ) {
+    fprintf(stdout,"  ## Error: corrupted %s in checkpoint file.\n",mess);
+    return(0);
+  }
+  _MMG5_ADD_MEM(mesh,nf*siz,mess,return(0));
+  _MMG5_SAFE_MALLOC(*tab,nf*siz,char);
+  memcpy(*tab,ab->buf+ab->pos,nf*siz);
+  ab->pos += nf*siz;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param filename name of the checkpoint file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Save the whole working state of the remesher (mesh entities, boundary
+ * entities, adjacencies, geometric edges hash table, metric and parameters)
+ * in a binary checkpoint file. The file stores the raw memory of the tables:
+ * it can only be restored (by \ref MMG5_loadCheckpoint) on a machine and a
+ * build with the same memory layout.
+ *
+ */
+int MMG5_saveCheckpoint(MMG5_pMesh mesh,MMG5_pSol met,const char *filename) {
+  FILE      *out;
+  MMG5_Info  info;
+  int        hdr[_MMG5_CKPT_NHDR],ms[_MMG5_CKPT_NMESH],ss[6];
+
+  out = fopen(filename,"wb");
+  if ( !out ) {
+    fprintf(stderr,"  ** UNABLE TO OPEN %s.\n",filename);
+    return(0);
+  }
+  fprintf(stdout,"  %%%% %s OPENED\n",filename);
+
+  _MMG5_ckptHeader(hdr);
+  fwrite("MMG5CKPT",sizeof(char),8,out);
+  fwrite(hdr,sizeof(int),_MMG5_CKPT_NHDR,out);
+
+  /* mesh */
+  ms[0]  = mesh->ver;    ms[1]  = mesh->dim;    ms[2]  = mesh->type;
+  ms[3]  = mesh->np;     ms[4]  = mesh->na;     ms[5]  = mesh->nt;
+  ms[6]  = mesh->ne;     ms[7]  = mesh->npmax;  ms[8]  = mesh->namax;
+  ms[9]  = mesh->ntmax;  ms[10] = mesh->nemax;  ms[11] = mesh->xpmax;
+  ms[12] = mesh->xtmax;  ms[13] = mesh->nc1;    ms[14] = mesh->base;
+  ms[15] = mesh->mark;   ms[16] = mesh->xp;     ms[17] = mesh->xt;
+  ms[18] = mesh->npnil;  ms[19] = mesh->nenil;  ms[20] = mesh->nplnk;
+  ms[21] = mesh->nelnk;  ms[22] = mesh->xpnil;  ms[23] = mesh->xtnil;
+  ms[24] = mesh->htab.siz; ms[25] = mesh->htab.max; ms[26] = mesh->htab.nxt;
+  fwrite(ms,sizeof(int),_MMG5_CKPT_NMESH,out);
+  fwrite(&mesh->gap,sizeof(double),1,out);
+
+  info     = mesh->info;
+  info.par = NULL;
+  fwrite(&info,sizeof(MMG5_Info),1,out);
+  _MMG5_writeCkptTab(out,mesh->info.par,mesh->info.npar,sizeof(MMG5_Par));
+
+  _MMG5_writeCkptTab(out,mesh->point,mesh->npmax+1,sizeof(MMG5_Point));
+  _MMG5_writeCkptTab(out,mesh->xpoint,mesh->xpmax+1,sizeof(MMG5_xPoint));
+  _MMG5_writeCkptTab(out,mesh->tetra,mesh->nemax+1,sizeof(MMG5_Tetra));
+  _MMG5_writeCkptTab(out,mesh->xtetra,mesh->xtmax+1,sizeof(MMG5_xTetra));
+  _MMG5_writeCkptTab(out,mesh->adja,4*mesh->nemax+5,sizeof(int));
+  _MMG5_writeCkptTab(out,mesh->tria,mesh->nt+1,sizeof(MMG5_Tria));
+  _MMG5_writeCkptTab(out,mesh->adjt,3*mesh->nt+4,sizeof(int));
+  _MMG5_writeCkptTab(out,mesh->edge,mesh->na+1,sizeof(MMG5_Edge));
+  _MMG5_writeCkptTab(out,mesh->htab.geom,mesh->htab.max+1,sizeof(MMG5_hgeom));
+
+  /* metric */
+  ss[0] = met->ver;   ss[1] = met->dim;   ss[2] = met->np;
+  ss[3] = met->npmax; ss[4] = met->size;  ss[5] = met->type;
+  fwrite(ss,sizeof(int),6,out);
+  _MMG5_writeCkptTab(out,met->m,met->size*(met->npmax+1)+1,sizeof(double));
+
+  if ( ferror(out) ) {
+    fprintf(stdout,"  ## Error: unable to write the checkpoint file %s.\n",
+            filename);
+    fclose(out);
+    return(0);
+  }
+  fclose(out);
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param ab pointer toward the mapped checkpoint file (after the header).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read the mesh and the metric of a checkpoint file. The parameters of
+ * \a mesh are kept (only the unset sizes and local parameters are taken
+ * from the file).
+ *
+ */
+static
+int _MMG5_readCkpt(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_Abuf *ab) {
+  MMG5_Info  info;
+  void      *tab;
+  int        ms[_MMG5_CKPT_NMESH],ss[6],k;
+
+  if ( !_MMG5_readBinBlock(ab,ms,sizeof(int),_MMG5_CKPT_NMESH,0) )  return(0);
+  if ( !_MMG5_readBin(ab,&mesh->gap,sizeof(double),0) )  return(0);
+  if ( !_MMG5_readBin(ab,&info,sizeof(MMG5_Info),0) )  return(0);
+
+  mesh->ver   = ms[0];  mesh->dim   = ms[1];  mesh->type  = ms[2];
+  mesh->np    = ms[3];  mesh->na    = ms[4];  mesh->nt    = ms[5];
+  mesh->ne    = ms[6];  mesh->npmax = ms[7];  mesh->namax = ms[8];
+  mesh->ntmax = ms[9];  mesh->nemax = ms[10]; mesh->xpmax = ms[11];
+  mesh->xtmax = ms[12]; mesh->nc1   = ms[13]; mesh->base  = ms[14];
+  mesh->mark  = ms[15]; mesh->xp    = ms[16]; mesh->xt    = ms[17];
+  mesh->npnil = ms[18]; mesh->nenil = ms[19]; mesh->nplnk = ms[20];
+  mesh->nelnk = ms[21]; mesh->xpnil = ms[22]; mesh->xtnil = ms[23];
+  mesh->htab.siz = ms[24]; mesh->htab.max = ms[25]; mesh->htab.nxt = ms[26];
+  mesh->npi = mesh->np;
+  mesh->nei = mesh->ne;
+  mesh->nti = mesh->nt;
+  mesh->nai = mesh->na;
+
+  /* the parameters of the caller are kept: only the state of the saved mesh
+   * (scaling, remeshing mode, ridge angle used by the analysis) is restored.
+   * Unset global sizes take their saved (unscaled) values, the sizes are
+   * scaled again before the adaptation (see \ref _MMG5_scalePar). */
+  mesh->info.delta  = info.delta;
+  memcpy(mesh->info.min,info.min,3*sizeof(double));
+  memcpy(mesh->info.max,info.max,3*sizeof(double));
+  mesh->info.dhd    = info.dhd;
+  mesh->info.badkal = info.badkal;
+  mesh->info.iso    = info.iso;
+  mesh->info.lag    = info.lag;
+  mesh->info.ls     = info.ls;
+  if ( mesh->info.hmin <= 0. )  mesh->info.hmin = info.hmin * info.delta;
+  if ( mesh->info.hmax <= 0. )  mesh->info.hmax = info.hmax * info.delta;
+  mesh->info.restart = 1;
+
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,info.npar,sizeof(MMG5_Par),
+                          "local parameters") )  return(0);
+  if ( tab && !mesh->info.npar ) {
+    /* no local parameters given by the caller: use the saved ones */
+    mesh->info.par   = tab;
+    mesh->info.npar  = info.npar;
+    mesh->info.npari = info.npar;
+    for (k=0; k<mesh->info.npar; k++) {
+      mesh->info.par[k].hmin  *= info.delta;
+      mesh->info.par[k].hmax  *= info.delta;
+      mesh->info.par[k].hausd *= info.delta;
+    }
+  }
+  else if ( tab )
+    _MMG5_DEL_MEM(mesh,tab,info.npar*sizeof(MMG5_Par));
+
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->npmax+1,sizeof(MMG5_Point),
+                          "points") )  return(0);
+  mesh->point = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->xpmax+1,sizeof(MMG5_xPoint),
+                          "boundary points") )  return(0);
+  mesh->xpoint = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->nemax+1,sizeof(MMG5_Tetra),
+                          "tetrahedra") )  return(0);
+  mesh->tetra = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->xtmax+1,sizeof(MMG5_xTetra),
+                          "boundary tetrahedra") )  return(0);
+  mesh->xtetra = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,4*mesh->nemax+5,sizeof(int),
+                          "adjacency table") )  return(0);
+  mesh->adja = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->nt+1,sizeof(MMG5_Tria),
+                          "triangles") )  return(0);
+  mesh->tria = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,3*mesh->nt+4,sizeof(int),
+                          "triangles adjacency table") )  return(0);
+  mesh->adjt = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->na+1,sizeof(MMG5_Edge),
+                          "edges") )  return(0);
+  mesh->edge = tab;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,mesh->htab.max+1,sizeof(MMG5_hgeom),
+                          "geometric edges") )  return(0);
+  mesh->htab.geom = tab;
+
+  /* metric */
+  if ( !_MMG5_readBinBlock(ab,ss,sizeof(int),6,0) )  return(0);
+  met->ver   = ss[0];  met->dim  = ss[1];  met->np   = ss[2];
+  met->npmax = ss[3];  met->size = ss[4];  met->type = ss[5];
+  met->npi   = met->np;
+  if ( !_MMG5_readCkptTab(mesh,ab,&tab,met->size*(met->npmax+1)+1,sizeof(double),
+                          "metric") )  return(0);
+  met->m = tab;
+
+  return(mesh->point && mesh->tetra);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (without allocated entities).
+ * \param met pointer toward the sol structure (without allocated values).
+ * \param filename name of the checkpoint file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restore the working state saved by \ref MMG5_saveCheckpoint. The \a
+ * restart field of the mesh parameters is set so that \ref MMG5_mmg3dlib
+ * skips the analysis. The parameters already given to \a mesh (time budget,
+ * sizes, verbosity...) are kept: only the unset global sizes and local
+ * parameters are restored from the file.
+ *
+ */
+int MMG5_loadCheckpoint(MMG5_pMesh mesh,MMG5_pSol met,const char *filename) {
+  _MMG5_Abuf ab;
+  int        hdr[_MMG5_CKPT_NHDR],fhdr[_MMG5_CKPT_NHDR];
+
+  if ( mesh->point || mesh->tetra || met->m ) {
+    fprintf(stdout,"  ## Error: a checkpoint must be restored in an empty");
+    fprintf(stdout," mesh.\n");
+    return(0);
+  }
+
+  if ( !_MMG5_openAscii(filename,&ab) ) {
+    fprintf(stderr,"  ** %s  NOT FOUND.\n",filename);
+    return(0);
+  }
+  fprintf(stdout,"  %%%% %s OPENED\n",filename);
+
+  if ( ab.siz < 8 || strncmp(ab.buf,"MMG5CKPT",8) ) {
+    fprintf(stdout,"  ## Error: %s is not a checkpoint file.\n",filename);
+    _MMG5_closeAscii(&ab);
+    return(0);
+  }
+  ab.pos = 8;
+
+  _MMG5_ckptHeader(hdr);
+  if ( !_MMG5_readBinBlock(&ab,fhdr,sizeof(int),_MMG5_CKPT_NHDR,0) ||
+       memcmp(hdr,fhdr,_MMG5_CKPT_NHDR*sizeof(int)) ) {
+    fprintf(stdout,"  ## Error: checkpoint file %s written by an",filename);
+    fprintf(stdout," incompatible version or machine.\n");
+    _MMG5_closeAscii(&ab);
+    return(0);
+  }
+
+  if ( !_MMG5_readCkpt(mesh,met,&ab) ) {
+    fprintf(stdout,"  ## Error: unable to restore the checkpoint %s.\n",
+            filename);
+    _MMG5_closeAscii(&ab);
+    return(0);
+  }
+
+  _MMG5_closeAscii(&ab);
+  return(1);
+}
@@ -410,7 +410,7 @@ int _MMG5_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pPoint    p0,p1;
   double    hp,v[3],b0[3],b1[3],b0p0[3],b1b0[3],p1b1[3],hausd;
   double    secder0[3],secder1[3],kappa,tau[3],gammasec[3],ntau2,intau,ps,lm,*n;
-  int       lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv,k,ip0,ip1,l;
+  int       lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv,k,ip0,ip1,l,ie;
   char      i,j,ia,ised,i0,i1;
   MMG5_pPar      par;
 
@@ -439,7 +439,8 @@ int _MMG5_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
   }
 
   /* size at regular surface points */
-  for (k=1; k<=mesh->ne; k++) {
+  for (ie=1; ie<=_MMG5_NEACT(mesh); ie++) {
+    k  = _MMG5_EACT(mesh,ie);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
     else if ( !pt->xt )  continue;
@@ -472,7 +473,8 @@ int _MMG5_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
   }
 
   /* Travel all boundary faces to update size prescription for points on ridges/edges */
-  for (k=1; k<=mesh->ne; k++) {
+  for (ie=1; ie<=_MMG5_NEACT(mesh); ie++) {
+    k  = _MMG5_EACT(mesh,ie);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     else if ( !pt->xt ) continue;
@@ -572,21 +574,21 @@ int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pTetra    pt;
   MMG5_pPoint    p0,p1;
   double    l,hn;
-  int       ip0,ip1,it,maxit,nu,nup,k;
+  int       ip0,ip1,it,maxit,nu,nup,k,ie;
   char      i,j,ia,i0,i1;
 
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
     fprintf(stdout,"  ** Grading mesh\n");
 
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = mesh->base;
+  _MMG5_setPtFlags(mesh,mesh->base);
 
   it = nup = 0;
   maxit = 100;
   do {
     mesh->base++;
     nu = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (ie=1; ie<=_MMG5_NEACT(mesh); ie++) {
+      k  = _MMG5_EACT(mesh,ie);
       pt = &mesh->tetra[k];
       if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
 
@@ -634,3 +636,19 @@ int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
     fprintf(stdout,"     gradation: %7d updated, %d iter.\n",nup,it);
   return(1);
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np index of the first extremity of the edge.
+ * \param nq index of the second extremity of the edge.
+ * \param ip index of the new point.
+ * \param s parameter of the new point along the edge \f$[np;nq]\f$.
+ *
+ * Linear interpolation of the size at point \a ip of the edge \f$[np;nq]\f$.
+ *
+ */
+void _MMG5_intmet_iso(MMG5_pMesh mesh,MMG5_pSol met,int np,int nq,int ip,
+                      double s) {
+  met->m[ip] = (1.0-s)*met->m[np] + s*met->m[nq];
+}
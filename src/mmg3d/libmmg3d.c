@@ -46,6 +46,7 @@
  */
 #define _MMG5_RETURN_AND_PACK(mesh,met,val)do   \
   {                                             \
+    _MMG5_unfreezeMesh(mesh);                    \
     MMG5_packMesh(mesh,met);                    \
     return(val);                                \
   }while(0)
@@ -71,7 +72,7 @@ static inline
 void MMG5_Free_topoTables(MMG5_pMesh mesh) {
   int k;
 
-  mesh->xp = 0;
+  mesh->xp = mesh->xpnil = 0;
   if ( mesh->adja )
     _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
 
@@ -82,6 +83,7 @@ void MMG5_Free_topoTables(MMG5_pMesh mesh) {
   for(k=1; k <=mesh->np; k++) {
     mesh->point[k].xp = 0;
   }
+  _MMG5_bezierFreeCache(mesh);
 
   return;
 }
@@ -244,12 +246,10 @@ int MMG5_packMesh(MMG5_pMesh mesh,MMG5_pSol met) {
     mesh->point[k].tmp = 0;
 
   mesh->npnil = mesh->np + 1;
-  for(k=mesh->npnil; k<mesh->npmax-1; k++)
-    mesh->point[k].tmp  = k+1;
+  mesh->nplnk = mesh->npnil;
 
   mesh->nenil = mesh->ne + 1;
-  for(k=mesh->nenil; k<mesh->nemax-1; k++)
-    mesh->tetra[k].v[3] = k+1;
+  mesh->nelnk = mesh->nenil;
 
   /* to could save the mesh, the adjacency have to be correct */
   if ( mesh->info.ddebug && (!_MMG5_chkmsh(mesh,1,1) ) ) {
@@ -257,7 +257,9 @@ int MMG5_packMesh(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
 
-  MMG5_Free_topoTables(mesh);
+  /* in warm-start mode, keep the topology for the next call */
+  if ( mesh->info.restart != 2 )
+    MMG5_Free_topoTables(mesh);
 
   if ( mesh->info.imprim ) {
     fprintf(stdout,"     NUMBER OF VERTICES   %8d   CORNERS %8d\n",mesh->np,nc);
@@ -270,12 +272,48 @@ int MMG5_packMesh(MMG5_pMesh mesh,MMG5_pSol met) {
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 1 if the analysis of the previous call is kept, 0 otherwise.
+ *
+ * Warm start: reuse the topology and the analysis kept by the previous call
+ * and only update the normals around the moved vertices. If it is not
+ * possible, free the topology so that the whole analysis is done again.
+ *
+ */
+static inline
+int MMG5_warmAnalys(MMG5_pMesh mesh) {
+  int k;
+
+  if ( !mesh->info.iso && _MMG5_updnor(mesh) ) {
+    /* triangles and edges are rebuilt when packing the mesh */
+    if ( mesh->tria )
+      _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
+    if ( mesh->edge )
+      _MMG5_DEL_MEM(mesh,mesh->edge,(mesh->na+1)*sizeof(MMG5_Edge));
+    mesh->na = 0;
+
+    if ( mesh->info.imprim )
+      fprintf(stdout,"  -- WARM START: ANALYSIS KEPT\n");
+    return(1);
+  }
+
+  for (k=1; k<=mesh->np; k++)
+    mesh->point[k].tmp = 0;
+  MMG5_Free_topoTables(mesh);
+
+  return(0);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
  * \return Return \ref MMG5_SUCCESS if success.
  * \return Return \ref MMG5_LOWFAILURE if failed but a conform mesh is saved.
  * \return Return \ref MMG5_STRONGFAILURE if failed and we can't save the mesh.
+ * \return Return \ref MMG5_TIMEOUT if the time budget is exhausted.
+ * \return Return \ref MMG5_INTERRUPTED if the progress function has stopped
+ * the run.
  *
  * Main program for the library .
  *
@@ -284,6 +322,7 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
   ) {
   mytime    ctim[TIMEMAX];
   char      stim[32];
+  int       warm;
 
   fprintf(stdout,"  -- MMG3d, Release %s (%s) \n",MG_VER,MG_REL);
   fprintf(stdout,"     %s\n",MG_CPY);
@@ -291,15 +330,24 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
 
   _MMG5_Set_APIFunc();
 
-  signal(SIGABRT,_MMG5_excfun);
-  signal(SIGFPE,_MMG5_excfun);
-  signal(SIGILL,_MMG5_excfun);
-  signal(SIGSEGV,_MMG5_excfun);
-  signal(SIGTERM,_MMG5_excfun);
-  signal(SIGINT,_MMG5_excfun);
+  if ( !mesh->info.nosignal ) {
+    signal(SIGABRT,_MMG5_excfun);
+    signal(SIGFPE,_MMG5_excfun);
+    signal(SIGILL,_MMG5_excfun);
+    signal(SIGSEGV,_MMG5_excfun);
+    signal(SIGTERM,_MMG5_excfun);
+    signal(SIGINT,_MMG5_excfun);
+  }
 
   tminit(ctim,TIMEMAX);
   chrono(ON,&(ctim[0]));
+  mesh->info.tini = ctim[0].gini;
+  mesh->info.tout = 0;
+
+  /* profiler (restarted at each call) */
+  _MMG5_profFree(mesh);
+  if ( mesh->nameprof && !_MMG5_profNew(mesh) )
+    fprintf(stdout,"  ## Warning: unable to allocate the profiler.\n");
 
 #ifdef USE_SCOTCH
   _MMG5_warnScotch(mesh);
@@ -308,61 +356,137 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
   fprintf(stdout,"\n  -- MMG3DLIB: INPUT DATA\n");
   /* load data */
   chrono(ON,&(ctim[1]));
-  _MMG5_warnOrientation(mesh);
+  _MMG5_PROF_IN(mesh,_MMG5_PT_input);
+  if ( !mesh->info.restart )
+    _MMG5_warnOrientation(mesh);
+
+  /* size map given on a background mesh */
+  if ( mesh->bgm ) {
+    if ( mesh->info.iso ) {
+      fprintf(stdout,"  ## ERROR: NO BACKGROUND MESH IN LEVEL-SET MODE.\n");
+      return(MMG5_STRONGFAILURE);
+    }
+    if ( mesh->info.restart == 1 )
+      mesh->bgm->scaled = 1;
+    else if ( !_MMG5_bgmSetSol(mesh,met) )
+      return(MMG5_STRONGFAILURE);
+  }
+  /* size map given by a function */
+  else if ( mesh->sizf ) {
+    if ( mesh->info.iso ) {
+      fprintf(stdout,"  ## ERROR: NO SIZE FUNCTION IN LEVEL-SET MODE.\n");
+      return(MMG5_STRONGFAILURE);
+    }
+    if ( mesh->info.restart != 1 && !_MMG5_sizfSetSol(mesh,met) )
+      return(MMG5_STRONGFAILURE);
+  }
+  /* metric built from the Hessian of a scalar field */
+  else if ( mesh->info.hess ) {
+    if ( mesh->info.iso ) {
+      fprintf(stdout,"  ## ERROR: NO HESSIAN METRIC IN LEVEL-SET MODE.\n");
+      return(MMG5_STRONGFAILURE);
+    }
+    if ( mesh->info.restart != 1 && !_MMG5_hessSetSol(mesh,met) )
+      return(MMG5_STRONGFAILURE);
+  }
 
   if ( met->np && (met->np != mesh->np) ) {
     fprintf(stdout,"  ## WARNING: WRONG SOLUTION NUMBER. IGNORED\n");
-    _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
+    _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
     met->np = 0;
   }
-  else if ( met->size!=1 ) {
-    fprintf(stdout,"  ## ERROR: ANISOTROPIC METRIC NOT IMPLEMENTED.\n");
+  else if ( mesh->info.iso ) {
+    if ( met->size < 1 || met->size > _MMG5_LSMAX ) {
+      fprintf(stdout,"  ## ERROR: THE LEVEL-SET MUST BE MADE OF 1 TO %d"
+              " SCALAR FUNCTIONS.\n",_MMG5_LSMAX);
+      return(MMG5_STRONGFAILURE);
+    }
+  }
+  else if ( met->size!=1 && met->size!=6 ) {
+    fprintf(stdout,"  ## ERROR: WRONG DATA TYPE.\n");
     return(MMG5_STRONGFAILURE);
   }
 
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_input);
   chrono(OFF,&(ctim[1]));
   printim(ctim[1].gdif,stim);
   fprintf(stdout,"  --  INPUT DATA COMPLETED.     %s\n",stim);
 
   /* analysis */
   chrono(ON,&(ctim[2]));
+  _MMG5_PROF_IN(mesh,_MMG5_PT_analysis);
   _MMG5_setfunc(mesh,met);
   if ( abs(mesh->info.imprim) > 0 )  _MMG5_outqua(mesh,met);
   fprintf(stdout,"\n  %s\n   MODULE MMG3D: IMB-LJLL : %s (%s)\n  %s\n",MG_STR,MG_VER,MG_REL,MG_STR);
   if ( mesh->info.imprim )  fprintf(stdout,"\n  -- PHASE 1 : ANALYSIS\n");
 
-  if ( !_MMG5_scaleMesh(mesh,met) ) return(MMG5_STRONGFAILURE);
-  if ( mesh->info.iso ) {
-    if ( !met->np ) {
-      fprintf(stdout,"\n  ## ERROR: A VALID SOLUTION FILE IS NEEDED \n");
-      return(MMG5_STRONGFAILURE);
-    }
-    if ( !_MMG5_mmg3d2(mesh,met) ) return(MMG5_STRONGFAILURE);
+  if ( mesh->info.restart == 1 ) {
+    /* working state restored from a checkpoint: the mesh is already scaled
+     * and analyzed */
+    if ( mesh->info.imprim )
+      fprintf(stdout,"  -- RESTART FROM CHECKPOINT\n");
+    if ( !_MMG5_scalePar(mesh) )  return(MMG5_STRONGFAILURE);
+    mesh->info.restart = 0;
   }
   else {
-    if ( mesh->info.optim && !met->np && !_MMG5_DoSol(mesh,met) ) {
+    if ( !_MMG5_scaleMesh(mesh,met) ) return(MMG5_STRONGFAILURE);
+
+    warm = 0;
+    if ( mesh->info.restart == 2 ) {
+      mesh->info.restart = 0;
+      warm = MMG5_warmAnalys(mesh);
+    }
+
+    if ( mesh->info.iso ) {
+      if ( !met->np ) {
+        fprintf(stdout,"\n  ## ERROR: A VALID SOLUTION FILE IS NEEDED \n");
+        return(MMG5_STRONGFAILURE);
+      }
+      if ( !_MMG5_mmg3d2(mesh,met) ) return(MMG5_STRONGFAILURE);
+    }
+    else {
+      if ( mesh->info.optim && !met->np && !_MMG5_DoSol(mesh,met) ) {
+        if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
+        _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+      }
+    }
+
+    if ( !warm && !_MMG5_analys(mesh) ) {
       if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
       _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
     }
-  }
 
-  if ( !_MMG5_analys(mesh) ) {
-    if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
-    _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+    /* metric scaled to the target number of elements */
+    if ( mesh->info.nelem > 0 && !mesh->info.iso && !_MMG5_fitnelem(mesh,met) ) {
+      if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
+      _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+    }
+
+    if ( mesh->nameckpt && !MMG5_saveCheckpoint(mesh,met,mesh->nameckpt) )
+      fprintf(stdout,"  ## Warning: unable to save the checkpoint.\n");
   }
 
   if ( mesh->info.imprim > 4 && !mesh->info.iso && met->m ) _MMG5_prilen(mesh,met);
 
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_analysis);
   chrono(OFF,&(ctim[2]));
   printim(ctim[2].gdif,stim);
   if ( mesh->info.imprim )
     fprintf(stdout,"  -- PHASE 1 COMPLETED.     %s\n",stim);
+  _MMG5_progress(mesh,MMG5_STEP_analysis,0,0,0,0,0);
 
   /* mesh adaptation */
   chrono(ON,&(ctim[3]));
+  _MMG5_PROF_IN(mesh,_MMG5_PT_remeshing);
   if ( mesh->info.imprim )
     fprintf(stdout,"\n  -- PHASE 2 : %s MESHING\n",met->size < 6 ? "ISOTROPIC" : "ANISOTROPIC");
 
+  /* local remeshing: freeze the mesh outside the region */
+  if ( mesh->lreg && !_MMG5_freezeMesh(mesh) ) {
+    if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
+    _MMG5_RETURN_AND_PACK(mesh,met,MMG5_LOWFAILURE);
+  }
+
   /* renumerotation if available */
   if ( !_MMG5_scotchCall(mesh,met) )
   {
@@ -405,25 +529,42 @@ int MMG5_mmg3dlib(MMG5_pMesh mesh,MMG5_pSol met
 
 #endif
 
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_remeshing);
   chrono(OFF,&(ctim[3]));
   printim(ctim[3].gdif,stim);
+  if ( mesh->info.imprim > 4 ) {
+    _MMG5_bgmStats(mesh);
+    _MMG5_sizfStats(mesh);
+  }
   if ( mesh->info.imprim )
     fprintf(stdout,"  -- PHASE 2 COMPLETED.     %s\n",stim);
+  _MMG5_progress(mesh,MMG5_STEP_remeshing,0,0,0,0,0);
   fprintf(stdout,"\n  %s\n   END OF MODULE MMG3d: IMB-LJLL \n  %s\n",MG_STR,MG_STR);
 
   /* save file */
   _MMG5_outqua(mesh,met);
+  _MMG5_nelemStats(mesh);
   if ( mesh->info.imprim > 4 && !mesh->info.iso )
     _MMG5_prilen(mesh,met);
 
   chrono(ON,&(ctim[1]));
+  _MMG5_PROF_IN(mesh,_MMG5_PT_output);
   if ( mesh->info.imprim )  fprintf(stdout,"\n  -- MESH PACKED UP\n");
+  _MMG5_unfreezeMesh(mesh);
   if ( !_MMG5_unscaleMesh(mesh,met) )  return(MMG5_STRONGFAILURE);
+  if ( mesh->info.warm )  mesh->info.restart = 2;
   if ( !MMG5_packMesh(mesh,met) )     return(MMG5_STRONGFAILURE);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_output);
   chrono(OFF,&(ctim[1]));
 
+  /* save the profile */
+  if ( mesh->prof && !_MMG5_profSave(mesh,mesh->nameprof) )
+    fprintf(stdout,"  ## Warning: unable to save the profile.\n");
+
   chrono(OFF,&ctim[0]);
   printim(ctim[0].gdif,stim);
   fprintf(stdout,"\n   MMG3DLIB: ELAPSED TIME  %s\n",stim);
+  if ( mesh->info.tout == 1 )  return(MMG5_TIMEOUT);
+  else if ( mesh->info.tout == 2 )  return(MMG5_INTERRUPTED);
   return(MMG5_SUCCESS);
 }
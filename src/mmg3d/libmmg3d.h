@@ -58,6 +58,22 @@
  *
  */
 #define MMG5_STRONGFAILURE 2
+/**
+ * \def MMG5_TIMEOUT
+ *
+ * Return value if the time budget has been exhausted: the remesh process
+ * has been interrupted but the mesh is conform.
+ *
+ */
+#define MMG5_TIMEOUT       3
+/**
+ * \def MMG5_INTERRUPTED
+ *
+ * Return value if the progress function has stopped the run: the remesh
+ * process has been interrupted but the mesh is conform.
+ *
+ */
+#define MMG5_INTERRUPTED   4
 
 /**
  * \enum MMG5_type
@@ -88,7 +104,8 @@ enum MMG5_entities
  *
  * Input parameters for mmg library. Options prefixed by \a
  * MMG5_IPARAM asked for integers values ans options prefixed by \a
- * MMG5_DPARAM asked for real values.
+ * MMG5_DPARAM asked for real values. New parameters are appended at the end
+ * of the list so that the values of the existing ones do not change.
  *
  */
 enum MMG5_Param
@@ -112,10 +129,72 @@ enum MMG5_Param
   MMG5_DPARAM_hausd,             /*!< [val], Control global Hausdorff distance (on all the boundary surfaces of the mesh) */
   MMG5_DPARAM_hgrad,             /*!< [val], Control gradation */
   MMG5_DPARAM_ls,                /*!< [val], Value of level-set (not use for now) */
+  MMG5_IPARAM_warmStart,         /*!< [1/0], Keep/free the topology and the analysis between successive remeshings */
+  MMG5_IPARAM_lsband,            /*!< [n/0], Restrict the remeshing to the vertex ring of the isosurface grown by n layers of tetrahedra / whole mesh */
+  MMG5_IPARAM_hessian,           /*!< [0/1/6], Input solution used as is / scalar field whose Hessian gives an isotropic / anisotropic metric */
+  MMG5_IPARAM_nelem,             /*!< [n/0], Scale the metric (the Hessian one included, or the sizes of the input mesh) to produce about n elements / keep the metric */
+  MMG5_IPARAM_nosignal,          /*!< [1/0], Don't install / install the signal handlers of the library */
+  MMG5_DPARAM_hessErr,           /*!< [val], Target interpolation error of the metric built from the Hessian */
+  MMG5_DPARAM_timeMax,           /*!< [val/0], Wall-clock time budget of the remeshing in seconds / no limit */
   MMG5_PARAM_size,               /*!< [n], Number of parameters */
 };
 
 
+/**
+ * \typedef MMG5_sizeFunction
+ * \brief Size function given by the user.
+ *
+ * \param n number of points.
+ * \param c coordinates of the points (3 values per point).
+ * \param m computed sizes (1 value per point) or metrics (6 values per
+ * point, stored as the solutions of type \a MMG5_Tensor).
+ * \param data user data.
+ * \return 0 if failed, 1 otherwise.
+ *
+ */
+typedef int (*MMG5_sizeFunction)(int n,double *c,double *m,void *data);
+
+/**
+ * \enum MMG5_step
+ * \brief Steps of the remeshing reported to the progress function.
+ */
+enum MMG5_step
+{
+  MMG5_STEP_analysis,      /*!< End of the analysis (phase 1) */
+  MMG5_STEP_geometricMesh, /*!< Iteration of the splitting on the geometry */
+  MMG5_STEP_computMesh,    /*!< Iteration of the splitting on the metric */
+  MMG5_STEP_adaptation,    /*!< Iteration of the split/collapse loop */
+  MMG5_STEP_optimization,  /*!< Iteration of the swap/move loop */
+  MMG5_STEP_remeshing,     /*!< End of the remeshing (phase 2) */
+};
+
+/**
+ * \struct MMG5_Progress
+ * \brief Progress of the run passed to the progress function.
+ */
+typedef struct {
+  int     step; /*!< Current step (see \ref MMG5_step) */
+  int     it; /*!< Iteration of the step */
+  int     ns,nc,nf,nm; /*!< Number of splits, collapses, swaps and moves of the
+                         iteration */
+  int     np,ne; /*!< Current number of vertices and tetrahedra */
+  double  time; /*!< Wall-clock time elapsed since the beginning of the run (s) */
+} MMG5_Progress;
+typedef MMG5_Progress * MMG5_pProgress;
+
+/**
+ * \typedef MMG5_progressFunction
+ * \brief Progress function given by the user.
+ *
+ * \param mesh pointer toward the mesh being remeshed (read only).
+ * \param prog progress of the run.
+ * \param data user data.
+ * \return 0 to stop the run, 1 to continue.
+ *
+ */
+typedef int (*MMG5_progressFunction)(MMG5_pMesh mesh,MMG5_pProgress prog,
+                                     void *data);
+
 /*----------------------------- functions header -----------------------------*/
 /* Initialization functions */
 /* init structures */
@@ -172,6 +251,19 @@ int  MMG5_Set_meshSize(MMG5_pMesh mesh, int np, int ne, int nt, int na);
  */
 int  MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1,
                      double c2, int ref,int pos);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices table of the points coordinates: the coordinates of the
+ * i-th point are stored in vertices[3*(i-1)]
+ * to vertices[3*(i-1)+2].
+ * \param refs table of the points references (may be NULL): the reference of
+ * the i-th point is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the coordinates and the references of all the vertices of the mesh.
+ *
+ */
+int  MMG5_Set_vertices(MMG5_pMesh mesh, double *vertices, int *refs);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of tetrahedron.
@@ -188,6 +280,19 @@ int  MMG5_Set_vertex(MMG5_pMesh mesh, double c0, double c1,
  */
 int  MMG5_Set_tetrahedron(MMG5_pMesh mesh, int v0, int v1,
                           int v2, int v3, int ref, int pos);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra table of the tetrahedra vertices: the vertices of the
+ * i-th tetrahedron are stored in tetra[4*(i-1)] to
+ * tetra[4*(i-1)+3].
+ * \param refs table of the tetrahedra references (may be NULL): the
+ * reference of the i-th tetrahedron is stored in refs[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the vertices and the references of all the tetrahedra of the mesh.
+ *
+ */
+int  MMG5_Set_tetrahedra(MMG5_pMesh mesh, int *tetra, int *refs);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 first vertex of triangle.
@@ -280,6 +385,88 @@ int  MMG5_Set_requiredEdge(MMG5_pMesh mesh, int pos);
  *
  */
 int  MMG5_Set_scalarSol(MMG5_pSol met, double s,int pos);
+/**
+ * \param met pointer toward the sol structure.
+ * \param s table of the scalar solutions: the solution at the i-th
+ * vertex is stored in s[i-1].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the scalar values of the solution at all the vertices of the mesh.
+ *
+ */
+int  MMG5_Set_scalarSols(MMG5_pSol met, double *s);
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 value of the tensorial solution at position (1,1) in the tensor.
+ * \param m12 value of the tensorial solution at position (1,2) in the tensor.
+ * \param m13 value of the tensorial solution at position (1,3) in the tensor.
+ * \param m22 value of the tensorial solution at position (2,2) in the tensor.
+ * \param m23 value of the tensorial solution at position (2,3) in the tensor.
+ * \param m33 value of the tensorial solution at position (3,3) in the tensor.
+ * \param pos position of the solution in the mesh (begin to 1).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set tensorial values at position \a pos in solution structure (the
+ * solution type must have been set to \a MMG5_Tensor by \ref
+ * MMG5_Set_solSize).
+ *
+ */
+int  MMG5_Set_tensorSol(MMG5_pSol met, double m11,double m12,double m13,
+                        double m22,double m23,double m33,int pos);
+/**
+ * \param met pointer toward the sol structure.
+ * \param m table of the tensorial solutions: the solution at the i-th
+ * vertex is stored in m[6*(i-1)],...,m[6*(i-1)+5] as m11,m12,m13,m22,m23,m33.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the tensorial values of the solution at all the vertices of the mesh.
+ *
+ */
+int  MMG5_Set_tensorSols(MMG5_pSol met, double *m);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param s table of the scalar solutions, allocated with \a malloc: the
+ * solution at the i-th vertex is stored in s[i] (s[0] is unused).
+ * \param siz number of doubles allocated in \a s.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give the solution table \a s to the sol structure without copying it (the
+ * solution size must have been set by \ref MMG5_Set_solSize). The library
+ * takes the ownership of \a s: it may reallocate it (if it is smaller than
+ * the maximal number of points) and it will be freed by \ref
+ * MMG5_Free_structures. The caller must not use or free \a s afterwards.
+ *
+ */
+int  MMG5_Set_scalarSolsBuffer(MMG5_pMesh mesh, MMG5_pSol met, double *s, int siz);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param nls number of level-set functions (at most 8).
+ * \param ls table of the values of the functions: the value of the j-th
+ * function at the i-th vertex is stored in ls[nls*(i-1)+j].
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set several level-set functions at the vertices of the mesh, to discretize
+ * them together in level-set mode. The ref of a resulting domain is 1 + sum_j
+ * 2^j s_j, with s_j equal to 1 if the j-th function is positive in the domain
+ * and to 0 otherwise.
+ *
+ */
+int  MMG5_Set_levelSets(MMG5_pMesh mesh, MMG5_pSol sol, int nls, double *ls);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param smesh pointer toward a surface mesh (triangles only).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Set the level-set function to the signed distance from the vertices of the
+ * mesh to the triangles of \a smesh (negative inside the surface, which must
+ * be closed but needs not be oriented). Both meshes must be given in the same
+ * frame.
+ *
+ */
+int  MMG5_Set_signedDistance(MMG5_pMesh mesh, MMG5_pSol sol, MMG5_pMesh smesh);
 /**
  * \param mesh pointer toward the mesh structure.
  *
@@ -337,6 +524,97 @@ int  MMG5_Set_dparameter(MMG5_pMesh mesh,MMG5_pSol sol, int dparam, double val);
  *
  */
 int  MMG5_Set_localParameter(MMG5_pMesh mesh, MMG5_pSol sol, int typ, int ref, double val);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param list table of the indices of the tetrahedra to remesh.
+ * \param ilist number of tetrahedra in \a list (0 to remesh the whole mesh).
+ * \param nlayer number of layers of adjacent tetrahedra added to \a list.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restrict the next remeshing to the tetrahedra of \a list grown by \a nlayer
+ * layers. The rest of the mesh is frozen (required) during the remeshing and
+ * the region is reset at the end of the \ref MMG5_mmg3dlib call.
+ *
+ * \remark The remeshing operators only visit the region but some steps of
+ * \ref MMG5_mmg3dlib remain proportional to the whole mesh: the scaling of
+ * the mesh, the rebuild of the adjacency, the quality and length statistics
+ * (verbosity), the truncation of the sizes and the final renumbering of the
+ * mesh (\ref MMG5_packMesh) needed by the outputs.
+ *
+ */
+int  MMG5_Set_localRegion(MMG5_pMesh mesh, int *list, int ilist, int nlayer);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param min lower corner of the box.
+ * \param max upper corner of the box.
+ * \param nlayer number of layers of adjacent tetrahedra added to the region.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restrict the next remeshing to the tetrahedra having a vertex inside the box
+ * [\a min, \a max], grown by \a nlayer layers (see \ref
+ * MMG5_Set_localRegion).
+ *
+ */
+int  MMG5_Set_localRegionBox(MMG5_pMesh mesh, double *min, double *max, int nlayer);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ref reference of the tetrahedra to remesh.
+ * \param nlayer number of layers of adjacent tetrahedra added to the region.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restrict the next remeshing to the tetrahedra of reference \a ref, grown
+ * by \a nlayer layers (see \ref MMG5_Set_localRegion).
+ *
+ */
+int  MMG5_Set_localRegionRef(MMG5_pMesh mesh, int ref, int nlayer);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bmesh pointer toward the background mesh (NULL to remove the
+ * background mesh).
+ * \param bmet pointer toward the size map (scalar or tensor) at the vertices
+ * of \a bmesh.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give the size map on a background mesh: the solution of \a mesh is
+ * replaced by the interpolation of \a bmet at the beginning of the
+ * \ref MMG5_mmg3dlib calls and the size of each new vertex is interpolated
+ * in \a bmesh. The background mesh and its size map must be kept by the
+ * user until the background mesh is removed or \a mesh is freed. Replace
+ * the size function if any.
+ *
+ */
+int  MMG5_Set_backgroundMesh(MMG5_pMesh mesh, MMG5_pMesh bmesh, MMG5_pSol bmet);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fct size function (NULL to remove the size function).
+ * \param typSol type of the values computed by \a fct (MMG5_Scalar or
+ * MMG5_Tensor).
+ * \param data user data passed to \a fct.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give the size map by a function: the solution of \a mesh is replaced by
+ * the values of \a fct at the vertices at the beginning of the
+ * \ref MMG5_mmg3dlib calls and \a fct is evaluated at each new vertex (the
+ * new vertices are passed by groups when possible). Replace the background
+ * mesh if any.
+ *
+ */
+int  MMG5_Set_sizeFunction(MMG5_pMesh mesh, MMG5_sizeFunction fct, int typSol,
+                           void *data);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fct progress function (NULL to remove the progress function).
+ * \param data user data passed to \a fct.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Give a function called by \ref MMG5_mmg3dlib at the end of the phases and
+ * at each iteration of the remeshing loops. If \a fct returns 0, the remaining
+ * operators are skipped and the (conform) mesh obtained so far is returned
+ * with the \ref MMG5_INTERRUPTED code.
+ *
+ */
+int  MMG5_Set_progressFunction(MMG5_pMesh mesh, MMG5_progressFunction fct,
+                               void *data);
 
 /** recover datas */
 /**
@@ -380,6 +658,39 @@ int  MMG5_Get_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int* typEntity, int* np,
  */
 int  MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* ref,
                      int* isCorner, int* isRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param vertices table of the points coordinates (of size at least
+ * 3*np): the coordinates of the i-th point are stored in
+ * vertices[3*(i-1)]
+ * to vertices[3*(i-1)+2].
+ * \param refs table of the points references (may be NULL).
+ * \param areCorners table of the flags saying if points are corners (may be
+ * NULL).
+ * \param areRequired table of the flags saying if points are required (may be
+ * NULL).
+ * \return 1.
+ *
+ * Get the coordinates, the references and the tags of all the vertices of the
+ * mesh.
+ *
+ */
+int  MMG5_Get_vertices(MMG5_pMesh mesh, double* vertices, int* refs,
+                       int* areCorners, int* areRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param displ table of the points displacements (of size at least 3*np):
+ * the displacement of the i-th point is stored in displ[3*(i-1)] to
+ * displ[3*(i-1)+2].
+ * \return 1.
+ *
+ * Move the vertices of the mesh without modifying their references and
+ * tags. If the topology of the previous remeshing has been kept (see \ref
+ * MMG5_IPARAM_warmStart), the moved vertices are marked so that the next call
+ * of the library updates the geometry around them only.
+ *
+ */
+int  MMG5_Move_vertices(MMG5_pMesh mesh, double *displ);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 pointer toward the first vertex of tetrahedron.
@@ -396,6 +707,21 @@ int  MMG5_Get_vertex(MMG5_pMesh mesh, double* c0, double* c1, double* c2, int* r
  */
 int  MMG5_Get_tetrahedron(MMG5_pMesh mesh, int* v0, int* v1, int* v2, int* v3,
                           int* ref, int* isRequired);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param tetra table of the tetrahedra vertices (of size at least 4*ne): the
+ * vertices of the i-th tetrahedron are stored in tetra[4*(i-1)] to
+ * tetra[4*(i-1)+3].
+ * \param refs table of the tetrahedra references (may be NULL).
+ * \param areRequired table of the flags saying if tetrahedra are required (may
+ * be NULL).
+ * \return 1.
+ *
+ * Get the vertices, the references and the tags of all the tetrahedra of the
+ * mesh.
+ *
+ */
+int  MMG5_Get_tetrahedra(MMG5_pMesh mesh, int* tetra, int* refs, int* areRequired);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param v0 pointer toward the first vertex of triangle.
@@ -434,6 +760,39 @@ int  MMG5_Get_edge(MMG5_pMesh mesh, int* e0, int* e1, int* ref,
  *
  */
 int  MMG5_Get_scalarSol(MMG5_pSol met, double* s);
+/**
+ * \param met pointer toward the sol structure.
+ * \param s table of the scalar solutions (of size at least np).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get the scalar values of the solution at all the vertices of the mesh.
+ *
+ */
+int  MMG5_Get_scalarSols(MMG5_pSol met, double* s);
+/**
+ * \param met pointer toward the sol structure.
+ * \param m11 pointer toward the position (1,1) in the solution tensor.
+ * \param m12 pointer toward the position (1,2) in the solution tensor.
+ * \param m13 pointer toward the position (1,3) in the solution tensor.
+ * \param m22 pointer toward the position (2,2) in the solution tensor.
+ * \param m23 pointer toward the position (2,3) in the solution tensor.
+ * \param m33 pointer toward the position (3,3) in the solution tensor.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get tensorial solution of next vertex of mesh.
+ *
+ */
+int  MMG5_Get_tensorSol(MMG5_pSol met, double *m11,double *m12,double *m13,
+                        double *m22,double *m23,double *m33);
+/**
+ * \param met pointer toward the sol structure.
+ * \param m table of the tensorial solutions (of size at least 6*np).
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Get the tensorial values of the solution at all the vertices of the mesh.
+ *
+ */
+int  MMG5_Get_tensorSols(MMG5_pSol met, double *m);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param iparam integer parameter to set (see \a MMG5_Param structure).
@@ -479,6 +838,30 @@ int  MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met);
  *
  */
 int  MMG5_saveMet(MMG5_pMesh mesh, MMG5_pSol met);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol structure.
+ * \param filename name of the checkpoint file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Save the whole working state of the remesher (entities, boundary entities,
+ * adjacencies, metric and parameters) in a binary checkpoint file.
+ *
+ */
+int  MMG5_saveCheckpoint(MMG5_pMesh mesh,MMG5_pSol met,const char *filename);
+/**
+ * \param mesh pointer toward the mesh structure (without allocated entities).
+ * \param met pointer toward the sol structure (without allocated values).
+ * \param filename name of the checkpoint file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Restore the working state saved by \ref MMG5_saveCheckpoint: a following
+ * call to \ref MMG5_mmg3dlib skips the analysis. The parameters already set
+ * in \a mesh are kept (only the unset global sizes and the local parameters
+ * are taken from the file).
+ *
+ */
+int  MMG5_loadCheckpoint(MMG5_pMesh mesh,MMG5_pSol met,const char *filename);
 
 /* deallocations */
 /**
@@ -504,10 +887,16 @@ void MMG5_Free_structures(MMG5_pMesh mesh, MMG5_pSol met);
  * \param mesh pointer toward the mesh structure.
  * \param sol pointer toward the sol structure.
  * \return Return \ref MMG5_SUCCESS if success,
- * \ref MMG5_LOWFAILURE if fail but a conform mesh is saved or
- * \ref MMG5_STRONGFAILURE if fail and we can't save the mesh.
- *
- * Main program for the library.
+ * \ref MMG5_LOWFAILURE if fail but a conform mesh is saved,
+ * \ref MMG5_STRONGFAILURE if fail and we can't save the mesh,
+ * \ref MMG5_TIMEOUT if the time budget is exhausted or
+ * \ref MMG5_INTERRUPTED if the progress function has stopped the run.
+ *
+ * Main program for the library. If a time budget is given (\ref
+ * MMG5_DPARAM_timeMax), the remeshing operators are interrupted when it is
+ * exhausted and the (conform and packed) mesh obtained so far is returned.
+ * The signal handlers of the library are installed for the whole process
+ * unless \ref MMG5_IPARAM_nosignal is set.
  *
  */
 int  MMG5_mmg3dlib(MMG5_pMesh mesh, MMG5_pSol sol);
@@ -302,7 +302,7 @@ static inline
 void _MMG5_swapNod(MMG5_pPoint points, double* sols, int* perm,
                    int ind1, int ind2, int solsiz) {
   MMG5_Point ptttmp;
-  MMG5_Sol   soltmp;
+  double     soltmp[6];
   int        tmp,addr2,addr1;
 
   /* swap the points */
@@ -314,9 +314,9 @@ void _MMG5_swapNod(MMG5_pPoint points, double* sols, int* perm,
   if ( sols ) {
     addr1 = (ind1-1)*solsiz + 1;
     addr2 = (ind2-1)*solsiz + 1;
-    memcpy(&soltmp     ,&sols[addr2],solsiz*sizeof(double));
+    memcpy(soltmp      ,&sols[addr2],solsiz*sizeof(double));
     memcpy(&sols[addr2],&sols[addr1],solsiz*sizeof(double));
-    memcpy(&sols[addr1],&soltmp     ,solsiz*sizeof(double));
+    memcpy(&sols[addr1],soltmp      ,solsiz*sizeof(double));
   }
 
   /* swap the permutaion table */
@@ -344,7 +344,7 @@ int _MMG5_renumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
   SCOTCH_Num  *vertTab, *edgeTab, *permVrtTab;
   SCOTCH_Graph graf ;
   int    vertNbr, nodeGlbIdx, tetraIdx, ballTetIdx;
-  int    i, j, k;
+  int    i, j;
   int    edgeSiz;
   int    *vertOldTab, *permNodTab, nereal, npreal;
   int    *adja,iadr;
@@ -563,13 +563,8 @@ int _MMG5_renumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
   else
     mesh->nenil = mesh->ne + 1;
 
-  if ( mesh->npnil )
-    for (k=mesh->npnil; k<mesh->npmax-1; k++)
-      mesh->point[k].tmp  = k+1;
-
-  if ( mesh->nenil )
-    for (k=mesh->nenil; k<mesh->nemax-1; k++)
-      mesh->tetra[k].v[3] = k+1;
+  mesh->nplnk = mesh->npnil;
+  mesh->nelnk = mesh->nenil;
 
   if( !_MMG5_hashTetra(mesh,0) ) return(0);
 
@@ -590,8 +585,9 @@ int _MMG5_renumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
 int _MMG5_scotchCall(MMG5_pMesh mesh, MMG5_pSol met)
 {
 #ifdef USE_SCOTCH
-  /*check enough vertex to renum*/
-  if ( mesh->info.renum && (mesh->np/2. > _MMG5_BOXSIZE) && mesh->np>100000 ) {
+  /*check enough vertex to renum (and no renum of a partly frozen mesh)*/
+  if ( mesh->info.renum && !mesh->nlreg &&
+       (mesh->np/2. > _MMG5_BOXSIZE) && mesh->np>100000 ) {
     /* renumbering begin */
     if ( mesh->info.imprim > 5 )
       fprintf(stdout,"  -- RENUMBERING. \n");
@@ -79,6 +79,7 @@ static void _MMG5_endcod() {
  * \return \ref MMG5_SUCCESS if success.
  * \return \ref MMG5_LOWFAILURE if failed but a conform mesh is saved.
  * \return \ref MMG5_STRONGFAILURE if failed and we can't save the mesh.
+ * \return \ref MMG5_TIMEOUT if the time budget is exhausted (the mesh is saved).
  *
  * Main program for MMG3D executable: perform mesh adaptation.
  *
@@ -118,6 +119,11 @@ int main(int argc,char *argv[]) {
 
   /* command line */
   if ( !MMG5_parsar(argc,argv,&mesh,&met) )  return(MMG5_STRONGFAILURE);
+  mesh.info.tini = MMG5_ctim[0].gini;
+
+  /* profiler */
+  if ( mesh.nameprof && !_MMG5_profNew(&mesh) )
+    fprintf(stdout,"  ## Warning: unable to allocate the profiler.\n");
 
 #ifdef USE_SCOTCH
   _MMG5_warnScotch(&mesh);
@@ -126,48 +132,80 @@ int main(int argc,char *argv[]) {
   /* load data */
   fprintf(stdout,"\n  -- INPUT DATA\n");
   chrono(ON,&MMG5_ctim[1]);
-  _MMG5_warnOrientation(&mesh);
-  /* read mesh file */
-  if ( MMG5_loadMesh(&mesh) < 1 )  _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-
-  /* read displacement if any */
-  if ( mesh.info.lag > -1 ) {
-    if ( !MMG5_Set_inputSolName(&mesh,&disp,met.namein) )
-      exit(EXIT_FAILURE);
-    ier = MMG5_loadMet(&mesh,&disp);
-    if ( ier == 0 ) {
-      fprintf(stdout,"  ## ERROR: NO DISPLACEMENT FOUND.\n");
-      _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
-    }
-    else if ( ier == -1 ) {
-      fprintf(stdout,"  ## ERROR: WRONG DATA TYPE OR WRONG SOLUTION NUMBER.\n");
-      _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
-    }
+  _MMG5_PROF_IN(&mesh,_MMG5_PT_input);
+  if ( mesh.info.restart ) {
+    /* restore the working state saved in a checkpoint */
+    if ( !MMG5_loadCheckpoint(&mesh,&met,mesh.namein) )
+      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
   }
-  /* read metric if any */
   else {
-    ier = MMG5_loadMet(&mesh,&met);
-    if ( ier == -1 ) {
-      fprintf(stdout,"  ## ERROR: WRONG DATA TYPE OR WRONG SOLUTION NUMBER.\n");
+    _MMG5_warnOrientation(&mesh);
+    /* read mesh file */
+    if ( MMG5_loadMesh(&mesh) < 1 )
       _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+
+    /* read displacement if any */
+    if ( mesh.info.lag > -1 ) {
+      if ( !MMG5_Set_inputSolName(&mesh,&disp,met.namein) )
+        exit(EXIT_FAILURE);
+      ier = MMG5_loadMet(&mesh,&disp);
+      if ( ier == 0 ) {
+        fprintf(stdout,"  ## ERROR: NO DISPLACEMENT FOUND.\n");
+        _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
+      }
+      else if ( ier == -1 ) {
+        fprintf(stdout,"  ## ERROR: WRONG DATA TYPE OR WRONG SOLUTION NUMBER.\n");
+        _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
+      }
     }
-    else if ( met.size != 1 ) {
-      fprintf(stdout,"  ## ERROR: ANISOTROPIC METRIC NOT IMPLEMENTED.\n");
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+    /* level-set given by the distance to a surface mesh */
+    else if ( mesh.info.iso && mesh.namedist ) {
+      if ( !_MMG5_distLoad(&mesh,&met) ) {
+        fprintf(stdout,"  ## ERROR: UNABLE TO COMPUTE THE DISTANCE TO %s.\n",
+                mesh.namedist);
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+      }
+      if ( !MMG5_parsop(&mesh,&met) )
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
     }
-    if ( mesh.info.iso && !ier ) {
-      fprintf(stdout,"  ## ERROR: NO ISOVALUE DATA.\n");
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+    /* read metric if any */
+    else {
+      ier = MMG5_loadMet(&mesh,&met);
+      if ( ier == -1 ) {
+        fprintf(stdout,"  ## ERROR: WRONG DATA TYPE OR WRONG SOLUTION NUMBER.\n");
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+      }
+      else if ( met.size > _MMG5_LSMAX && mesh.info.iso ) {
+        fprintf(stdout,"  ## ERROR: THE LEVEL-SET MUST BE MADE OF 1 TO %d"
+                " SCALAR FUNCTIONS.\n",_MMG5_LSMAX);
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+      }
+      if ( mesh.info.iso && !ier ) {
+        fprintf(stdout,"  ## ERROR: NO ISOVALUE DATA.\n");
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+      }
+      /* metric built from the Hessian of the scalar field */
+      if ( mesh.info.hess ) {
+        if ( mesh.info.iso || !ier ) {
+          fprintf(stdout,"  ## ERROR: A SCALAR FIELD IS NEEDED TO BUILD THE"
+                  " METRIC FROM ITS HESSIAN.\n");
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        }
+        if ( !_MMG5_hessSetSol(&mesh,&met) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+      }
+      if ( !MMG5_parsop(&mesh,&met) )
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
     }
-    if ( !MMG5_parsop(&mesh,&met) )
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
   }
+  _MMG5_PROF_OUT(&mesh,_MMG5_PT_input);
   chrono(OFF,&MMG5_ctim[1]);
   printim(MMG5_ctim[1].gdif,stim);
   fprintf(stdout,"  -- DATA READING COMPLETED.     %s\n",stim);
 
   /* analysis */
   chrono(ON,&MMG5_ctim[2]);
+  _MMG5_PROF_IN(&mesh,_MMG5_PT_analysis);
   _MMG5_setfunc(&mesh,&met);
   MMG5_Set_saveFunc(&mesh);
 
@@ -176,36 +214,51 @@ int main(int argc,char *argv[]) {
           MG_STR,MG_VER,MG_REL,MG_STR);
   if ( mesh.info.imprim )  fprintf(stdout,"\n  -- PHASE 1 : ANALYSIS\n");
 
-  /* scaling mesh */
-  if ( mesh.info.lag == -1 ) {
-    if ( !_MMG5_scaleMesh(&mesh,&met) )
+  if ( mesh.info.restart ) {
+    /* the restored mesh is already scaled and analyzed */
+    if ( mesh.info.imprim )
+      fprintf(stdout,"  -- RESTART FROM CHECKPOINT\n");
+    if ( !_MMG5_scalePar(&mesh) )
       _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+    mesh.info.restart = 0;
   }
   else {
-    if ( !_MMG5_scaleMesh(&mesh,&disp) )
-      _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
-  }
+    /* scaling mesh */
+    if ( mesh.info.lag == -1 ) {
+      if ( !_MMG5_scaleMesh(&mesh,&met) )
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+    }
+    else {
+      if ( !_MMG5_scaleMesh(&mesh,&disp) )
+        _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
+    }
 
-  /* specific meshing */
-  if ( mesh.info.iso ) {
-    if ( !_MMG5_mmg3d2(&mesh,&met) )
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-  }
-  else if ( mesh.info.lag >= 0 ) {
-    if ( !_MMG5_mmg3d3(&mesh,&disp) )
-      _MMG5_RETURN_AND_FREE(&mesh,&disp,MMG5_STRONGFAILURE);
-  }
-  else {
-    if ( mesh.info.optim && (!met.np && !_MMG5_DoSol(&mesh,&met)) )
+    /* specific meshing */
+    if ( mesh.info.iso ) {
+      if ( !_MMG5_mmg3d2(&mesh,&met) )
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+    }
+    else if ( mesh.info.lag == -1 ) {
+      if ( mesh.info.optim && (!met.np && !_MMG5_DoSol(&mesh,&met)) )
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
+    }
+
+    /* mesh analysis */
+    if ( !_MMG5_analys(&mesh) )
       _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
-  }
 
-  /* mesh analysis */
-  if ( !_MMG5_analys(&mesh) )
-    _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
+    /* metric scaled to the target number of elements */
+    if ( mesh.info.nelem > 0 && !mesh.info.iso && mesh.info.lag == -1
+         && !_MMG5_fitnelem(&mesh,&met) )
+      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
+
+    if ( mesh.nameckpt && !MMG5_saveCheckpoint(&mesh,&met,mesh.nameckpt) )
+      fprintf(stdout,"  ## Warning: unable to save the checkpoint.\n");
+  }
 
   if ( mesh.info.imprim > 1 && !mesh.info.iso && met.m ) _MMG5_prilen(&mesh,&met);
 
+  _MMG5_PROF_OUT(&mesh,_MMG5_PT_analysis);
   chrono(OFF,&MMG5_ctim[2]);
   printim(MMG5_ctim[2].gdif,stim);
   if ( mesh.info.imprim )
@@ -213,36 +266,15 @@ int main(int argc,char *argv[]) {
 
   /* mesh adaptation */
   chrono(ON,&MMG5_ctim[3]);
+  _MMG5_PROF_IN(&mesh,_MMG5_PT_remeshing);
   if ( mesh.info.imprim )
     fprintf(stdout,"\n  -- PHASE 2 : %s MESHING\n",met.size < 6 ? "ISOTROPIC" : "ANISOTROPIC");
 
-  /* renumerotation if available */
-  if ( !_MMG5_scotchCall(&mesh,&met) )
-    _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-
-
-#ifdef PATTERN
-  if ( !_MMG5_mmg3d1_pattern(&mesh,&met) ) {
-    if ( !(mesh.adja) && !_MMG5_hashTetra(&mesh,1) ) {
-      fprintf(stdout,"  ## Hashing problem. Unable to save mesh.\n");
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-    }
-    if ( !_MMG5_unscaleMesh(&mesh,&met) )
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-    if ( !MMG5_saveMesh(&mesh) )
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-    if ( met.m && !MMG5_saveMet(&mesh,&met) )
-      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-    _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
-  }
-#else
-  /* Pattern in iso mode, delauney otherwise */
-  if ( !mesh.info.iso ) {
-    if( !_MMG5_mmg3d1_delone(&mesh,&met) ) {
-      if ( !(mesh.adja) && !_MMG5_hashTetra(&mesh,1) ) {
-        fprintf(stdout,"  ## Hashing problem. Unable to save mesh.\n");
-        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
-      }
+  if ( mesh.info.lag >= 0 ) {
+    /* lagrangian motion with local repair of the degraded elements */
+    ier = _MMG5_mmg3d3(&mesh,&disp,&met);
+    _MMG5_DEL_MEM(&mesh,disp.m,(disp.size*(disp.npmax+1)+1)*sizeof(double));
+    if ( !ier ) {
       if ( !_MMG5_unscaleMesh(&mesh,&met) )
         _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
       if ( !MMG5_saveMesh(&mesh) )
@@ -253,11 +285,22 @@ int main(int argc,char *argv[]) {
     }
   }
   else {
-    if( !_MMG5_mmg3d1_pattern(&mesh,&met) ) {
+    /* local remeshing: freeze the mesh outside the region */
+    if ( mesh.lreg && !_MMG5_freezeMesh(&mesh) )
+      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
+
+    /* renumerotation if available */
+    if ( !_MMG5_scotchCall(&mesh,&met) )
+      _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+
+
+#ifdef PATTERN
+    if ( !_MMG5_mmg3d1_pattern(&mesh,&met) ) {
       if ( !(mesh.adja) && !_MMG5_hashTetra(&mesh,1) ) {
         fprintf(stdout,"  ## Hashing problem. Unable to save mesh.\n");
         _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
       }
+      _MMG5_unfreezeMesh(&mesh);
       if ( !_MMG5_unscaleMesh(&mesh,&met) )
         _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
       if ( !MMG5_saveMesh(&mesh) )
@@ -266,9 +309,44 @@ int main(int argc,char *argv[]) {
         _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
       _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
     }
-  }
+#else
+    /* Pattern in iso mode, delauney otherwise */
+    if ( !mesh.info.iso ) {
+      if( !_MMG5_mmg3d1_delone(&mesh,&met) ) {
+        if ( !(mesh.adja) && !_MMG5_hashTetra(&mesh,1) ) {
+          fprintf(stdout,"  ## Hashing problem. Unable to save mesh.\n");
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        }
+        _MMG5_unfreezeMesh(&mesh);
+        if ( !_MMG5_unscaleMesh(&mesh,&met) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        if ( !MMG5_saveMesh(&mesh) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        if ( met.m && !MMG5_saveMet(&mesh,&met) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
+      }
+    }
+    else {
+      if( !_MMG5_mmg3d1_pattern(&mesh,&met) ) {
+        if ( !(mesh.adja) && !_MMG5_hashTetra(&mesh,1) ) {
+          fprintf(stdout,"  ## Hashing problem. Unable to save mesh.\n");
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        }
+        _MMG5_unfreezeMesh(&mesh);
+        if ( !_MMG5_unscaleMesh(&mesh,&met) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        if ( !MMG5_saveMesh(&mesh) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        if ( met.m && !MMG5_saveMet(&mesh,&met) )
+          _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+        _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_LOWFAILURE);
+      }
+    }
 #endif
+  }
 
+  _MMG5_PROF_OUT(&mesh,_MMG5_PT_remeshing);
   chrono(OFF,&MMG5_ctim[3]);
   printim(MMG5_ctim[3].gdif,stim);
   if ( mesh.info.imprim )
@@ -277,12 +355,15 @@ int main(int argc,char *argv[]) {
 
   /* save file */
   _MMG5_outqua(&mesh,&met);
+  _MMG5_nelemStats(&mesh);
 
   if ( mesh.info.imprim > 1 && !mesh.info.iso )
     _MMG5_prilen(&mesh,&met);
 
   chrono(ON,&MMG5_ctim[1]);
+  _MMG5_PROF_IN(&mesh,_MMG5_PT_output);
   if ( mesh.info.imprim )  fprintf(stdout,"\n  -- WRITING DATA FILE %s\n",mesh.nameout);
+  _MMG5_unfreezeMesh(&mesh);
   if ( !_MMG5_unscaleMesh(&mesh,&met) )
     _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
 
@@ -291,9 +372,15 @@ int main(int argc,char *argv[]) {
 
   if ( !MMG5_saveMet(&mesh,&met) )
     _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_STRONGFAILURE);
+  _MMG5_PROF_OUT(&mesh,_MMG5_PT_output);
   chrono(OFF,&MMG5_ctim[1]);
   if ( mesh.info.imprim )  fprintf(stdout,"  -- WRITING COMPLETED\n");
 
+  /* save the profile */
+  if ( mesh.prof && !_MMG5_profSave(&mesh,mesh.nameprof) )
+    fprintf(stdout,"  ## Warning: unable to save the profile.\n");
+
   /* free mem */
-  _MMG5_RETURN_AND_FREE(&mesh,&met,MMG5_SUCCESS);
+  ier = mesh.info.tout ? MMG5_TIMEOUT : MMG5_SUCCESS;
+  _MMG5_RETURN_AND_FREE(&mesh,&met,ier);
 }
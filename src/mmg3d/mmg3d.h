@@ -39,7 +39,7 @@
     of point ip with coordinates o and tag tag*/
 #define _MMG5_POINT_AND_BUCKET_REALLOC(mesh,sol,ip,wantedGap,law,o,tag ) do \
   {                                                                     \
-    int klink,gap;                                                      \
+    int gap;                                                            \
                                                                         \
     if ( (mesh->memMax-mesh->memCur) <                                  \
          (long long) (wantedGap*mesh->npmax*                            \
@@ -64,16 +64,18 @@
     _MMG5_SAFE_RECALLOC(bucket->link,mesh->npmax+1,                     \
                         mesh->npmax+gap+1,int,"larger bucket table");   \
     mesh->npmax = mesh->npmax+gap;                                      \
+    _MMG5_PROF_INC(mesh,_MMG5_PC_reapt);                                \
+    _MMG5_PROF_INC(mesh,_MMG5_PC_reatab);                               \
                                                                         \
     mesh->npnil = mesh->np+1;                                           \
-    for (klink=mesh->npnil; klink<mesh->npmax-1; klink++)               \
-      mesh->point[klink].tmp  = klink+1;                                \
+    mesh->nplnk = mesh->npnil;                                          \
                                                                         \
     /* solution */                                                      \
     if ( sol->m ) {                                                     \
-      _MMG5_ADD_MEM(mesh,(mesh->npmax-sol->npmax)*sizeof(double),       \
+      _MMG5_ADD_MEM(mesh,sol->size*(mesh->npmax-sol->npmax)*sizeof(double), \
                     "larger solution",law);                             \
-      _MMG5_SAFE_REALLOC(sol->m,mesh->npmax+1,double,"larger solution"); \
+      _MMG5_SAFE_REALLOC(sol->m,sol->size*(mesh->npmax+1)+1,double,         \
+                         "larger solution");                            \
     }                                                                   \
     sol->npmax = mesh->npmax;                                           \
                                                                         \
@@ -86,15 +88,15 @@
     of tetra jel */
 #define _MMG5_TETRA_REALLOC(mesh,jel,wantedGap,law ) do                 \
   {                                                                     \
-    int klink,oldSiz;                                                   \
+    int oldSiz;                                                         \
                                                                         \
     oldSiz = mesh->nemax;                                               \
     _MMG5_TAB_RECALLOC(mesh,mesh->tetra,mesh->nemax,wantedGap,MMG5_Tetra, \
                        "larger tetra table",law);                       \
+    _MMG5_PROF_INC(mesh,_MMG5_PC_reatet);                               \
                                                                         \
     mesh->nenil = mesh->ne+1;                                           \
-    for (klink=mesh->nenil; klink<mesh->nemax-1; klink++)               \
-      mesh->tetra[klink].v[3]  = klink+1;                               \
+    mesh->nelnk = mesh->nenil;                                          \
                                                                         \
     if ( mesh->adja ) {                                                 \
       /* adja table */                                                  \
@@ -104,11 +106,27 @@
                           ,"larger adja table");                        \
     }                                                                   \
                                                                         \
+    if ( mesh->nereg ) {                                                \
+      /* list of the remeshed region (local remeshing) */               \
+      _MMG5_ADD_MEM(mesh,(mesh->nemax-oldSiz)*sizeof(int),              \
+                    "larger local remeshing region",law);               \
+      _MMG5_SAFE_REALLOC(mesh->lreg,mesh->nemax+1,int,                  \
+                         "larger local remeshing region");              \
+    }                                                                   \
+                                                                        \
     /* We try again to add the point */                                 \
     jel = _MMG5_newElt(mesh);                                           \
     if ( !jel ) {law;}                                                  \
   }while(0)
 
+/** Number of tetrahedra visited by the adaptation loops: the list of the
+    remeshed region once the mesh is frozen (see \ref _MMG5_freezeMesh), the
+    whole tetra table otherwise */
+#define _MMG5_NEACT(mesh) ( (mesh)->nereg ? (mesh)->nlreg : (mesh)->ne )
+
+/** Index of the \a l-th tetrahedron visited by the adaptation loops */
+#define _MMG5_EACT(mesh,l) ( (mesh)->nereg ? (mesh)->lreg[(l)-1] : (l) )
+
 /* numerical accuracy */
 #define _MMG5_ALPHAD    20.7846096908265    //0.04811252243247      /* 12*sqrt(3) */
 #define _MMG5_LLONG     2.5//2.0   // 1.414213562373
@@ -119,11 +137,14 @@
 #define _MMG5_LMAX      10240
 #define _MMG5_BADKAL    0.2
 #define _MMG5_NULKAL    1.e-30
+#define _MMG5_SHORTMAX  0x7fff  /**< unit of the lagrangian displacement steps */
+#define _MMG5_BATCH     64      /**< block size of the batch quality/length kernels */
 
-#define _MMG5_NPMAX  1000000 //200000
-#define _MMG5_NAMAX   200000 //40000
-#define _MMG5_NTMAX  2000000 //400000
-#define _MMG5_NEMAX  6000000 //1200000
+/* minimal initial sizes of the tables (reallocated on demand) */
+#define _MMG5_NPMAX    10000 //1000000
+#define _MMG5_NAMAX     2000 //200000
+#define _MMG5_NTMAX    20000 //2000000
+#define _MMG5_NEMAX    60000 //6000000
 
 #define _MMG5_BOXSIZE 500
 
@@ -132,6 +153,25 @@
 #define MG_PLUS    2
 #define MG_MINUS   3
 
+/* Maximal number of level-set functions discretized together. With several
+ * functions, the ref of a domain is 1 + sum_i 2^i s_i, s_i being 1 if the
+ * i-th function is positive and 0 otherwise. */
+#define _MMG5_LSMAX   8
+
+/* Scaling of the metric to a target number of elements: maximal number of
+ * iterations of the analytic estimation, maximal number of evaluations with
+ * the graded metric and relative tolerance on the predicted number */
+#define _MMG5_NELEMIT   8
+#define _MMG5_NELEMCOR  8
+#define _MMG5_NELEMTOL  0.05
+
+/* Number of elements processed between two checks of the time budget */
+#define _MMG5_TIMECHK   1024
+
+/* Tag of the tetrahedra frozen (and required) outside the region of a local
+ * remeshing (the MG_NUL bit is unused for tetrahedra) */
+#define MG_FRZ     MG_NUL
+
 extern unsigned char _MMG5_inxt3[7];   /*!< next vertex of tetra: {1,2,3,0,1,2,3} */
 extern unsigned char _MMG5_iprv3[7];   /*!< previous vertex of tetra: {3,0,1,2,3,0,1} */
 extern unsigned char _MMG5_idir[4][3]; /*!< idir[i] : vertices of face opposite to vertex i */
@@ -151,11 +191,103 @@ typedef struct {
 } _MMG5_Bucket;
 typedef _MMG5_Bucket * _MMG5_pBucket;
 
+/** Background mesh giving the size map (see \ref mmg3d/bgmesh.c) */
+typedef struct _MMG5_Bgm {
+  MMG5_pMesh  mesh; /*!< Background mesh (owned by the user) */
+  MMG5_pSol   met; /*!< Size map at the vertices of the background mesh */
+  double      min[3]; /*!< Origin of the grid of seeds */
+  double      dx; /*!< Inverse of the step of the grid */
+  int         nx; /*!< Number of cells of the grid per direction */
+  int        *grid; /*!< A tetrahedron of the background mesh per cell */
+  int         last; /*!< Last tetrahedron found */
+  int         nloc,nwalk,nfail; /*!< Statistics of the localizations */
+  char        scaled; /*!< 1 if the mesh is scaled (not the background mesh) */
+} _MMG5_Bgm;
+typedef _MMG5_Bgm * _MMG5_pBgm;
+
+/** Entry of the cache of the size function */
+typedef struct {
+  double  c[3]; /*!< Coordinates of the query */
+  double  m[6]; /*!< Size (1 value) or metric (6 values) at \a c */
+  char    ok; /*!< 1 if the entry is used */
+} _MMG5_SizCache;
+typedef _MMG5_SizCache * _MMG5_pSizCache;
+
+/** Size function given by the user (see \ref mmg3d/sizfun.c) */
+typedef struct _MMG5_SizFun {
+  MMG5_sizeFunction fct; /*!< User function */
+  void       *data; /*!< User data passed to \a fct */
+  int         size; /*!< 1 for a size, 6 for a metric */
+  void      (*intmet)(MMG5_pMesh,MMG5_pSol,int,int,int,double); /*!< Interpolation
+                                                                   along the edges,
+                                                                   kept if \a fct fails */
+  int         pend[_MMG5_EIGBATCH]; /*!< Points waiting for their evaluation */
+  int         npend; /*!< Number of waiting points */
+  _MMG5_pSizCache cache; /*!< Cache of the last evaluations */
+  int         nquery,ncall,nhit,nfail; /*!< Statistics of the evaluations */
+  char        defer; /*!< 1 if the evaluations are delayed */
+} _MMG5_SizFun;
+typedef _MMG5_SizFun * _MMG5_pSizFun;
+
+/** Progress function given by the user */
+typedef struct _MMG5_Prog {
+  MMG5_progressFunction fct; /*!< User function */
+  void       *data; /*!< User data passed to \a fct */
+} _MMG5_Prog;
+typedef _MMG5_Prog * _MMG5_pProg;
+
+/** Node of the hierarchy of the triangles of a surface */
+typedef struct {
+  double  min[3],max[3]; /*!< Bounding box of the triangles of the node */
+  int     first; /*!< First triangle (leaf) or first child (inner node) */
+  int     nt; /*!< Number of triangles (0 for an inner node) */
+} _MMG5_BvhNode;
+typedef _MMG5_BvhNode * _MMG5_pBvhNode;
+
+/** Bounding volume hierarchy of a surface (see \ref mmg3d/distance.c) */
+typedef struct {
+  MMG5_pMesh      smesh; /*!< Surface mesh (owned by the caller) */
+  _MMG5_pBvhNode  node; /*!< Nodes of the tree, the root being the first one */
+  int            *tri; /*!< Triangles of the surface sorted by leaf */
+  int             nt; /*!< Number of triangles */
+  int             nnode; /*!< Number of nodes */
+  int             last; /*!< Last closest triangle */
+} _MMG5_Bvh;
+typedef _MMG5_Bvh * _MMG5_pBvh;
+
 /* bucket */
 _MMG5_pBucket _MMG5_newBucket(MMG5_pMesh ,int );
 int     _MMG5_addBucket(MMG5_pMesh ,_MMG5_pBucket ,int );
 int     _MMG5_delBucket(MMG5_pMesh ,_MMG5_pBucket ,int );
 int     _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip);
+int     _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip);
+/* background mesh */
+int  _MMG5_bgmNew(MMG5_pMesh mesh,MMG5_pMesh bmesh,MMG5_pSol bmet);
+void _MMG5_bgmFree(MMG5_pMesh mesh);
+int  _MMG5_bgmSetSol(MMG5_pMesh mesh,MMG5_pSol met);
+void _MMG5_bgmStats(MMG5_pMesh mesh);
+void _MMG5_intmet_bgm(MMG5_pMesh,MMG5_pSol,int,int,int,double);
+/* signed distance */
+void _MMG5_bvhFree(MMG5_pMesh mesh,_MMG5_pBvh bvh);
+int  _MMG5_distSetSol(MMG5_pMesh mesh,MMG5_pSol sol,MMG5_pMesh smesh);
+int  _MMG5_distLoad(MMG5_pMesh mesh,MMG5_pSol sol);
+int  _MMG5_loadSurf(MMG5_pMesh mesh);
+/* metric from a scalar field */
+int  _MMG5_hessSetSol(MMG5_pMesh mesh,MMG5_pSol met);
+/* local remeshing */
+int  _MMG5_newRegion(MMG5_pMesh mesh,int nlreg,int nlayer);
+int  _MMG5_freezeMesh(MMG5_pMesh mesh);
+void _MMG5_unfreezeMesh(MMG5_pMesh mesh);
+void _MMG5_setPtFlags(MMG5_pMesh mesh,int flag);
+int  _MMG5_cmpidx(const void *a,const void *b);
+/* size function */
+int  _MMG5_sizfNew(MMG5_pMesh mesh,MMG5_sizeFunction fct,int size,void *data);
+void _MMG5_sizfFree(MMG5_pMesh mesh);
+int  _MMG5_sizfSetSol(MMG5_pMesh mesh,MMG5_pSol met);
+void _MMG5_sizfDefer(MMG5_pMesh mesh);
+void _MMG5_sizfFlush(MMG5_pMesh mesh,MMG5_pSol met);
+void _MMG5_sizfStats(MMG5_pMesh mesh);
+void _MMG5_intmet_sizf(MMG5_pMesh,MMG5_pSol,int,int,int,double);
 /* prototypes */
 double _MMG5_det3pt1vec(double c0[3],double c1[3],double c2[3],double v[3]);
 double _MMG5_det4pt(double c0[3],double c1[3],double c2[3],double c3[3]);
@@ -168,6 +300,9 @@ void _MMG5_delElt(MMG5_pMesh mesh,int iel);
 void _MMG5_delPt(MMG5_pMesh mesh,int ip);
 int  _MMG5_zaldy(MMG5_pMesh mesh);
 void _MMG5_freeXTets(MMG5_pMesh mesh);
+int  _MMG5_newXTet(MMG5_pMesh mesh);
+void _MMG5_delXTet(MMG5_pMesh mesh,int ixt);
+int  _MMG5_pakXEnt(MMG5_pMesh mesh);
 char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_pTria pt,char ori);
 int  _MMG5_chkNumberOfTri(MMG5_pMesh mesh);
 void _MMG5_tet2tri(MMG5_pMesh mesh,int k,char ie,MMG5_Tria *ptt);
@@ -182,6 +317,7 @@ int  _MMG5_BezierRidge(MMG5_pMesh mesh,int ip0, int ip1, double s, double *o, do
 int  _MMG5_BezierNom(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,double *no,double *to);
 int  _MMG5_norface(MMG5_pMesh mesh ,int k, int iface, double v[3]);
 int  _MMG5_boulenm(MMG5_pMesh mesh, int start, int ip, int iface, double n[3],double t[3]);
+int  _MMG5_boulenmint(MMG5_pMesh mesh,int start,int ip,double n[3],double t[3]);
 int  _MMG5_boulevolp(MMG5_pMesh mesh, int start, int ip, int * list);
 int  _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,int *listv,int *ilistv,int *lists,int*ilists);
 int  _MMG5_startedgsurfball(MMG5_pMesh mesh,int nump,int numq,int *list,int ilist);
@@ -189,12 +325,14 @@ int  _MMG5_srcbdy(MMG5_pMesh mesh,int start,int ia);
 int  _MMG5_coquil(MMG5_pMesh mesh, int start, int ia, int * list);
 int  _MMG5_coquilface(MMG5_pMesh mesh, int start, int ia, int * list, int * it1, int *it2);
 int  _MMG5_settag(MMG5_pMesh,int,int,int,int);
-int  _MMG5_chkcol_int(MMG5_pMesh ,MMG5_pSol met,int,char,char,int *,char typchk);
-int  _MMG5_chkcol_bdy(MMG5_pMesh,int,char,char,int *);
+int  _MMG5_chkcol_int_iso(MMG5_pMesh ,MMG5_pSol met,int,char,char,int *,char typchk);
+int  _MMG5_chkcol_int_ani(MMG5_pMesh ,MMG5_pSol met,int,char,char,int *,char typchk);
+int  _MMG5_chkcol_bdy(MMG5_pMesh,MMG5_pSol,int,char,char,int *);
 int  _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int ndepplus,char isminp,char isplp);
 int  _MMG5_chkmani(MMG5_pMesh mesh);
-int  _MMG5_colver(MMG5_pMesh,int *,int,char);
+int  _MMG5_colver(MMG5_pMesh,MMG5_pSol,int *,int,char);
 int  _MMG5_analys(MMG5_pMesh mesh);
+int  _MMG5_updnor(MMG5_pMesh mesh);
 int  _MMG5_hashTetra(MMG5_pMesh mesh, int pack);
 int  _MMG5_hashTria(MMG5_pMesh mesh);
 int  _MMG5_hashPop(_MMG5_Hash *hash,int a,int b);
@@ -216,10 +354,11 @@ void _MMG5_memOption(MMG5_pMesh mesh);
 int  _MMG5_mmg3d1_pattern(MMG5_pMesh ,MMG5_pSol );
 int  _MMG5_mmg3d1_delone(MMG5_pMesh ,MMG5_pSol );
 int  _MMG5_mmg3d2(MMG5_pMesh ,MMG5_pSol );
-int  _MMG5_mmg3d3(MMG5_pMesh ,MMG5_pSol );
+int  _MMG5_mmg3d3(MMG5_pMesh ,MMG5_pSol ,MMG5_pSol );
 int  _MMG5_split1_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]);
 void _MMG5_split1(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]);
-int  _MMG5_split1b(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int ip,int cas);
+int  _MMG5_split1b_iso(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int ip,int cas);
+int  _MMG5_split1b_ani(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int ip,int cas);
 int  _MMG5_split2sf_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]);
 void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]);
 void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]);
@@ -235,8 +374,8 @@ int  _MMG5_split4bar(MMG5_pMesh mesh,MMG5_pSol met,int k);
 int  _MMG5_simbulgept(MMG5_pMesh mesh, int *list, int ilist, double o[3]);
 int  _MMG5_dichoto1b(MMG5_pMesh mesh,int *list,int ret,double o[3],double ro[3]);
 void _MMG5_nsort(int ,double *,char *);
-double _MMG5_orcal(MMG5_pMesh mesh,int iel);
-int    _MMG5_movintpt(MMG5_pMesh mesh, int *list, int ilist, int improve);
+int    _MMG5_movintpt_iso(MMG5_pMesh mesh, MMG5_pSol met, int *list, int ilist, int improve);
+int    _MMG5_movintpt_ani(MMG5_pMesh mesh, MMG5_pSol met, int *list, int ilist, int improve);
 int    _MMG5_movbdyregpt(MMG5_pMesh, MMG5_pSol, int*, int, int*, int);
 int    _MMG5_movbdyrefpt(MMG5_pMesh, MMG5_pSol, int*, int, int*, int);
 int    _MMG5_movbdynompt(MMG5_pMesh, MMG5_pSol, int*, int, int*, int);
@@ -244,18 +383,25 @@ int    _MMG5_movbdyridpt(MMG5_pMesh, MMG5_pSol, int*, int, int*, int);
 int  _MMG5_chkswpbdy(MMG5_pMesh, MMG5_pSol,int*, int, int, int);
 int  _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,_MMG5_pBucket bucket);
 int  _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf, int ilist, int *list,_MMG5_pBucket bucket);
-int  _MMG5_chkswpgen(MMG5_pMesh mesh, int start, int ia, int *ilist, int *list,double crit);
+int  _MMG5_chkswpgen_iso(MMG5_pMesh mesh, MMG5_pSol met, int start, int ia, int *ilist, int *list,double crit);
+int  _MMG5_chkswpgen_ani(MMG5_pMesh mesh, MMG5_pSol met, int start, int ia, int *ilist, int *list,double crit);
 int  _MMG5_srcface(MMG5_pMesh mesh,int n0,int n1,int n2);
 int  _MMG5_bouleext(MMG5_pMesh mesh, int start, int ip, int iface, int *listv, int *ilistv, int *lists, int*ilists);
 int _MMG5_chkptonbdy(MMG5_pMesh,int);
 double _MMG5_orcal_poi(double a[3],double b[3],double c[3],double d[3]);
 int _MMG5_countelt(MMG5_pMesh mesh,MMG5_pSol sol, double *weightelt, long *npcible);
+int _MMG5_fitnelem(MMG5_pMesh mesh,MMG5_pSol met);
+void _MMG5_nelemStats(MMG5_pMesh mesh);
+int  _MMG5_timeout(MMG5_pMesh mesh);
+void _MMG5_progress(MMG5_pMesh mesh,int step,int it,int ns,int nc,int nf,int nm);
 int _MMG5_trydisp(MMG5_pMesh,double *,short);
 int _MMG5_dichodisp(MMG5_pMesh,double *);
 int _MMG5_lapantilap(MMG5_pMesh,double *);
 int _MMG5_ppgdisp(MMG5_pMesh,double *);
 int _MMG5_denoisbdy(MMG5_pMesh);
 void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met);
+void _MMG5_caltet_batch(MMG5_pMesh mesh,MMG5_pSol met,int *v,int n,double *qual);
+void _MMG5_lenedg_batch(MMG5_pMesh mesh,MMG5_pSol met,int *e,int n,double *len);
 int  _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met);
 int _MMG5_prilen(MMG5_pMesh mesh,MMG5_pSol met);
 int _MMG5_DoSol(MMG5_pMesh mesh,MMG5_pSol met);
@@ -283,6 +429,7 @@ double _MMG5_volint(MMG5_pMesh);
 int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist);
 int _MMG5_cavity(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon);
 int _MMG5_cenrad_iso(MMG5_pMesh mesh,double *ct,double *c,double *rad);
+int _MMG5_cenrad_ani(MMG5_pMesh mesh,double *ct,double *m,double *c,double *rad);
 
 /*mmg3d1.c*/
 void _MMG5_tet2tri(MMG5_pMesh mesh,int k,char ie,MMG5_Tria *ptt);
@@ -300,18 +447,27 @@ int  _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket
 /* init structures */
 void  _MMG5_Init_parameters(MMG5_pMesh mesh);
 /* iso/aniso computations */
-double _MMG5_caltet_ani(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id);
-double _MMG5_caltet_iso(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id);
 double _MMG5_lenedgCoor_ani(double*, double*, double*, double*);
 double _MMG5_lenedgCoor_iso(double*, double*, double*, double*);
 int    _MMG5_defsiz_iso(MMG5_pMesh,MMG5_pSol );
 int    _MMG5_defsiz_ani(MMG5_pMesh ,MMG5_pSol );
 int    _MMG5_gradsiz_iso(MMG5_pMesh ,MMG5_pSol );
 int    _MMG5_gradsiz_ani(MMG5_pMesh ,MMG5_pSol );
+void   _MMG5_intmet_iso(MMG5_pMesh,MMG5_pSol,int,int,int,double);
+void   _MMG5_intmet_ani(MMG5_pMesh,MMG5_pSol,int,int,int,double);
 
 double (*_MMG5_caltet)(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id);
 double (*_MMG5_caltri)(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
 int    (*_MMG5_defsiz)(MMG5_pMesh ,MMG5_pSol );
 int    (*_MMG5_gradsiz)(MMG5_pMesh ,MMG5_pSol );
+void   (*_MMG5_intmet)(MMG5_pMesh,MMG5_pSol,int,int,int,double);
+int    (*_MMG5_buckin)(MMG5_pMesh,MMG5_pSol,_MMG5_pBucket,int);
+/* iso/aniso instances of the operators */
+int    (*_MMG5_chkcol_int)(MMG5_pMesh,MMG5_pSol,int,char,char,int*,char);
+int    (*_MMG5_chkswpgen)(MMG5_pMesh,MMG5_pSol,int,int,int*,int*,double);
+int    (*_MMG5_movintpt)(MMG5_pMesh,MMG5_pSol,int*,int,int);
+int    (*_MMG5_split1b)(MMG5_pMesh,MMG5_pSol,int*,int,int,int);
+
+#include "inlined_functions.h"
 
 #endif
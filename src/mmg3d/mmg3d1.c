@@ -407,14 +407,18 @@ char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_Tria *pt,char ori) {
 int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
   MMG5_pTetra   pt;
   MMG5_pxTetra  pxt;
-  int      k,it,list[_MMG5_LMAX+2],ilist,ret,it1,it2,ns,nns,maxit;
+  int      k,l,it,list[_MMG5_LMAX+2],ilist,ret,it1,it2,ns,nns,maxit;
   char     i,j,ia,ier;
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_swpmsh);
   it = nns = 0;
   maxit = 2;
   do {
     ns = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+      if ( !(l % _MMG5_TIMECHK) && _MMG5_timeout(mesh) )  break;
+
+      k  = _MMG5_EACT(mesh,l);
       pt = &mesh->tetra[k];
       if ( (!MG_EOK(pt)) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
       else if ( !pt->xt ) continue;
@@ -425,16 +429,23 @@ int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
         if ( !(pxt->ftag[i] & MG_BDY) ) continue;
         for (j=0; j<3; j++) {
           ia  = _MMG5_iarf[i][j];
-          if ( (pxt->tag[ia] & MG_REQ) ) continue;
+          /* geometric and non-manifold edges are not swapped: don't travel
+           * their shells (that may contain more than 2 boundary faces) */
+          if ( (pxt->tag[ia] & MG_REQ) || (pxt->tag[ia] & MG_NOM)
+               || MG_EDG(pxt->tag[ia]) || pxt->edg[ia] > 0 ) continue;
           ret = _MMG5_coquilface(mesh,k,ia,list,&it1,&it2);
           ilist = ret / 2;
           if ( ret < 0 )  return(-1);
           /* CAUTION: trigger collapse with 2 elements */
           if ( ilist <= 1 )  continue;
+          _MMG5_PROF_INC(mesh,_MMG5_PC_swpatt);
           ier = _MMG5_chkswpbdy(mesh,met,list,ilist,it1,it2);
           if ( ier ) {
             ier = _MMG5_swpbdy(mesh,met,list,ret,it1,bucket);
-            if ( ier > 0 )  ns++;
+            if ( ier > 0 ) {
+              _MMG5_PROF_INC(mesh,_MMG5_PC_swpok);
+              ns++;
+            }
             else if ( ier < 0 )  return(-1);
             break;
           }
@@ -444,9 +455,10 @@ int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
     }
     nns += ns;
   }
-  while ( ++it < maxit && ns > 0 );
+  while ( ++it < maxit && ns > 0 && !mesh->info.tout );
   if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nns > 0 )
     fprintf(stdout,"     %8d edge swapped\n",nns);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_swpmsh);
 
   return(nns);
 }
@@ -464,15 +476,19 @@ int _MMG5_swpmsh(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
 int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket) {
   MMG5_pTetra   pt;
   MMG5_pxTetra  pxt;
-  int      list[_MMG5_LMAX+2],ilist,k,it,nconf,maxit,ns,nns,ier;
+  int      list[_MMG5_LMAX+2],ilist,k,l,it,nconf,maxit,ns,nns,ier;
   char     i;
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_swptet);
   maxit = 2;
   it = nns = 0;
 
   do {
     ns = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+      if ( !(l % _MMG5_TIMECHK) && _MMG5_timeout(mesh) )  break;
+
+      k  = _MMG5_EACT(mesh,l);
       pt = &mesh->tetra[k];
       if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
       if ( pt->qual > 0.0288675 /*0.6/_MMG5_ALPHAD*/ )  continue;
@@ -484,10 +500,14 @@ int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket)
           if ( pxt->edg[i] || pxt->tag[i] ) continue;
         }
 
-        nconf = _MMG5_chkswpgen(mesh,k,i,&ilist,list,crit);
+        _MMG5_PROF_INC(mesh,_MMG5_PC_swpatt);
+        nconf = _MMG5_chkswpgen(mesh,met,k,i,&ilist,list,crit);
         if ( nconf ) {
           ier = _MMG5_swpgen(mesh,met,nconf,ilist,list,bucket);
-          if ( ier > 0 )  ns++;
+          if ( ier > 0 ) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_swpok);
+            ns++;
+          }
           else if ( ier < 0 ) return(-1);
           break;
         }
@@ -495,9 +515,10 @@ int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket bucket)
     }
     nns += ns;
   }
-  while ( ++it < maxit && ns > 0 );
+  while ( ++it < maxit && ns > 0 && !mesh->info.tout );
   if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nns > 0 )
     fprintf(stdout,"     %8d edge swapped\n",nns);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_swptet);
 
   return(nns);
 }
@@ -517,7 +538,7 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
   MMG5_pPoint        ppt;
   MMG5_pxTetra       pxt;
   double        *n;
-  int           i,k,ier,nm,nnm,ns,lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv,it;
+  int           i,k,l,ier,nm,nnm,ns,lists[_MMG5_LMAX+2],listv[_MMG5_LMAX+2],ilists,ilistv,it;
   int           improve;
   unsigned char j,i0,base;
   int           internal,maxit;
@@ -533,15 +554,18 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
     fprintf(stdout,"  ** OPTIMIZING MESH\n");
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_movtet);
   base = 1;
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = base;
+  _MMG5_setPtFlags(mesh,base);
 
   it = nnm = 0;
   do {
     base++;
     nm = ns = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+      if ( !(l % _MMG5_TIMECHK) && _MMG5_timeout(mesh) )  break;
+
+      k  = _MMG5_EACT(mesh,l);
       pt = &mesh->tetra[k];
       if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
 
@@ -608,9 +632,11 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
           else if ( internal ) {
             ilistv = _MMG5_boulevolp(mesh,k,i0,listv);
             if ( !ilistv )  continue;
-            ier = _MMG5_movintpt(mesh,listv,ilistv,improve);
+            ier = _MMG5_movintpt(mesh,met,listv,ilistv,improve);
           }
+          _MMG5_PROF_INC(mesh,_MMG5_PC_movatt);
           if ( ier ) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_movok);
             nm++;
             if(maxit==1){
               ppt->flag = base;
@@ -622,10 +648,11 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
     nnm += nm;
     if ( mesh->info.ddebug )  fprintf(stdout,"     %8d moved, %d geometry\n",nm,ns);
   }
-  while( ++it < maxit && nm > 0 );
+  while( ++it < maxit && nm > 0 && !mesh->info.tout );
 
   if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nnm )
     fprintf(stdout,"     %8d vertices moved, %d iter.\n",nnm,it);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_movtet);
 
   return(nnm);
 }
@@ -645,7 +672,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   MMG5_pxTetra    pxt;
   MMG5_pPoint     p0,p1;
   double     ll,ux,uy,uz,hmi2;
-  int        k,nc,list[_MMG5_LMAX+2],ilist,base,nnm;
+  int        k,l,nc,list[_MMG5_LMAX+2],ilist,base,nnm;
   char       i,j,tag,ip,iq,isnm;
   int        ier;
 
@@ -653,11 +680,11 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   hmi2 = mesh->info.hmin*mesh->info.hmin;
 
   /* init of point flags, otherwise it can be uninitialized */
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = 0;
+  _MMG5_setPtFlags(mesh,0);
 
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
     base = ++mesh->base;
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )   continue;
 
@@ -701,7 +728,7 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
             if ( mesh->adja[4*(k-1)+1+i] )  continue;
           }
           if ( (tag & MG_REQ) || p0->tag > tag )  continue;
-          ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
+          ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
         }
         /* internal face */
         else {
@@ -711,9 +738,10 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
         }
 
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,list,ilist,iq);
+          ier = _MMG5_colver(mesh,met,list,ilist,iq);
           if ( ier < 0 ) return(-1);
           else if ( ier ) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
             _MMG5_delPt(mesh,ier);
             break;
           }
@@ -751,7 +779,7 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   MMG5_xTetra  *pxt;
   _MMG5_Hash     hash;
   double   ll,o[3],ux,uy,uz,hma2;
-  int      vx[6],k,ip,ip1,ip2,nap,ns,ne,memlack;
+  int      vx[6],k,l,ip,ip1,ip2,nap,ns,ne,memlack;
   char     i,j,ia;
 
   /** 1. analysis */
@@ -760,15 +788,21 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   hma2 = _MMG5_LLONG*_MMG5_LLONG*mesh->info.hmax*mesh->info.hmax;
 
   /* Hash all boundary and required edges, and put ip = -1 in hash structure */
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) )  continue;
 
-    /* avoid split of edges belonging to a required tet */
+    /* avoid split of edges belonging to a required tet (only the edges of
+     * the interface, whose vertices are required, may be shared by a frozen
+     * tet and a remeshed tet) */
     if ( pt->tag & MG_REQ ) {
       for (i=0; i<6; i++) {
         ip1 = pt->v[_MMG5_iare[i][0]];
         ip2 = pt->v[_MMG5_iare[i][1]];
+        if ( (pt->tag & MG_FRZ) && !((mesh->point[ip1].tag & MG_REQ)
+                                     && (mesh->point[ip2].tag & MG_REQ)) )
+          continue;
         ip  = -1;
         if ( !_MMG5_hashEdge(mesh,&hash,ip1,ip2,ip) )  return(-1);
       }
@@ -792,10 +826,13 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   }
 
   /** 2. Set flags and split internal edges */
-  for (k=1; k<=mesh->ne; k++) {
+  _MMG5_sizfDefer(mesh);
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) )  continue;
     pt->flag = 0;
+    if ( pt->tag & MG_REQ )  continue;
     for (i=0; i<6; i++) {
       ip  = -1;
       ip1 = pt->v[_MMG5_iare[i][0]];
@@ -848,13 +885,14 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
         }
 
         if ( met->m )
-          met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
         if ( !_MMG5_hashEdge(mesh,&hash,ip1,ip2,ip) )  return(-1);
         MG_SET(pt->flag,i);
         nap++;
       }
     }
   }
+  _MMG5_sizfFlush(mesh,met);
   if ( !nap )  {
     _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
     return(0);
@@ -863,8 +901,9 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   /** 3. check and split */
 split:
   ns = 0;
-  ne = mesh->ne;
-  for (k=1; k<=ne; k++) {
+  ne = _MMG5_NEACT(mesh);
+  for (l=1; l<=ne; l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     memset(vx,0,6*sizeof(int));
@@ -961,7 +1000,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   _MMG5_Bezier  pb;
   _MMG5_Hash    hash;
   double   o[3],no[3],to[3],dd,len;
-  int      vx[6],k,ip,ic,it,nap,nc,ni,ne,npinit,ns,ip1,ip2,ier;
+  int      vx[6],k,l,ip,ic,it,nap,nc,ni,ne,npinit,ns,ip1,ip2,ier;
   char     i,j,ia,i1,i2;
   static double uv[3][2] = { {0.5,0.5}, {0.,0.5}, {0.5,0.} };
 
@@ -969,7 +1008,9 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) ) return(-1);
   ns = nap = 0;
   npinit=mesh->np;
-  for (k=1; k<=mesh->ne; k++) {
+  _MMG5_sizfDefer(mesh);
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || !pt->xt )  continue;
 
@@ -1050,7 +1091,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
         p1  = &mesh->point[ip1];
         p2  = &mesh->point[ip2];
         if ( met->m )
-          met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
         if ( MG_EDG(ptt.tag[j]) || (ptt.tag[j] & MG_NOM) )
           ppt->ref = ptt.edg[j] ? ptt.edg[j] : ptt.ref;
         else
@@ -1084,6 +1125,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
       }
     }
   }
+  _MMG5_sizfFlush(mesh,met);
   if ( !ns ) {
     _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
     return(ns);
@@ -1092,7 +1134,8 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   /** 2. check if split by adjacent; besides, a triangle may have been splitted and not its adjacent
       (thus, the associated n2 may not exist) : update this normal if need be */
   nc = 0;
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
@@ -1139,14 +1182,14 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   }
 
   /** 3. Simulate splitting and delete points leading to invalid configurations */
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = 0;
+  _MMG5_setPtFlags(mesh,0);
 
   it = 1;
   nc = 0;
   do {
     ni = 0;
-    for (k=1; k<=mesh->ne; k++) {
+    for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+      k  = _MMG5_EACT(mesh,l);
       pt = &mesh->tetra[k];
       if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || !pt->flag )  continue;
       memset(vx,0,6*sizeof(int));
@@ -1205,8 +1248,9 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
 
   /** 4. splitting */
   ns = 0;
-  ne = mesh->ne;
-  for (k=1; k<=ne; k++) {
+  ne = _MMG5_NEACT(mesh);
+  for (l=1; l<=ne; l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || !pt->flag || (pt->tag & MG_REQ) )  continue;
     memset(vx,0,6*sizeof(int));
@@ -1255,11 +1299,12 @@ static int _MMG5_anatet4(MMG5_pMesh mesh, MMG5_pSol met) {
   MMG5_pTetra      pt;
   MMG5_pPoint      ppt;
   MMG5_pxTetra     pxt;
-  int         k,ns;
+  int         k,l,ns;
   char        nf,j;
 
   ns = 0;
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
     nf = 0;
@@ -1309,8 +1354,12 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
   maxit = 5;
   mesh->gap = 0.5;
   do {
-    /* memory free */
-    _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+    if ( _MMG5_timeout(mesh) )  break;
+
+    /* memory free (in local remeshing mode, the adjacency is kept unless
+     * some tetrahedra are split: hashing the whole mesh is avoided) */
+    if ( !mesh->nereg )
+      _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
 
     if ( !mesh->info.noinsert ) {
 
@@ -1320,7 +1369,9 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
       ns = ier;
 
       /* analyze surface tetras */
+      _MMG5_PROF_IN(mesh,_MMG5_PT_anatets);
       ier = _MMG5_anatets(mesh,met,typchk);
+      _MMG5_PROF_OUT(mesh,_MMG5_PT_anatets);
 
       if ( ier < 0 ) {
         fprintf(stdout,"  ## Unable to complete surface mesh. Exit program.\n");
@@ -1329,7 +1380,9 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
       ns += ier;
       if ( patternMode ) {
         /* analyze internal tetras */
+        _MMG5_PROF_IN(mesh,_MMG5_PT_anatetv);
         ier = _MMG5_anatetv(mesh,met,typchk);
+        _MMG5_PROF_OUT(mesh,_MMG5_PT_anatetv);
         if ( ier < 0 ) {
           fprintf(stdout,"  ## Unable to complete volume mesh. Exit program.\n");
           return(0);
@@ -1339,6 +1392,9 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
     }
     else  ns = 0;
 
+    /* the split patterns don't update the adjacency */
+    if ( ns && mesh->adja )
+      _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
     if ( !_MMG5_hashTetra(mesh,1) ) {
       fprintf(stdout,"  ## Hashing problem. Exit program.\n");
       return(0);
@@ -1347,7 +1403,9 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
 
     /* collapse short edges */
     if ( !mesh->info.noinsert ) {
+      _MMG5_PROF_IN(mesh,_MMG5_PT_coltet);
       nc = _MMG5_coltet(mesh,met,typchk);
+      _MMG5_PROF_OUT(mesh,_MMG5_PT_coltet);
       if ( nc < 0 ) {
         fprintf(stdout,"  ## Unable to collapse mesh. Exiting.\n");
         return(0);
@@ -1381,6 +1439,8 @@ int _MMG5_anatet(MMG5_pMesh mesh,MMG5_pSol met,char typchk, int patternMode) {
 #endif
       fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped\n",ns,nc,nf);
     }
+    _MMG5_progress(mesh,typchk == 1 ? MMG5_STEP_geometricMesh : MMG5_STEP_computMesh,
+                   it,ns,nc,nf,0);
     if ( it > 3 && abs(nc-ns) < 0.1 * MG_MAX(nc,ns) )  break;
   }
   while ( ++it < maxit && ns+nc+nf > 0 );
@@ -55,6 +55,8 @@ int MMG_npuiss,MMG_nvol,MMG_npres,MMG_npd;
  * \param warn pointer to store a flag that warn the user in case of
  * reallocation difficulty.
  * \param it iteration index.
+ * \param ani 1 to measure the edge lengths in the aniso metric (the loop is
+ * instantiated for each value of \a ani).
  * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
  * the mesh, 1 otherwise.
  *
@@ -62,16 +64,16 @@ int MMG_npuiss,MMG_nvol,MMG_npres,MMG_npd;
  * collapse edges shorter than \ref _MMG5_LOPTS_MMG5_DEL.
  *
  */
-static inline int
+static _MMG5_ALWAYS_INLINE int
 _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
-                 int* ifilt,int* ns,int* nc,int* warn,int it) {
+                 int* ifilt,int* ns,int* nc,int* warn,int it,const char ani) {
   MMG5_pTetra     pt;
   MMG5_pxTetra    pxt;
   MMG5_Tria       ptt;
   MMG5_pPoint     p0,p1,ppt;
   MMG5_pxPoint    pxp;
   double     dd,len,lmax,o[3],to[3],ro[3],no1[3],no2[3],v[3];
-  int        k,ip,ip1,ip2,list[_MMG5_LMAX+2],ilist,ref;
+  int        k,l,ip,ip1,ip2,list[_MMG5_LMAX+2],ilist,ref;
   char       imax,tag,j,i,i1,i2,ifa0,ifa1;
   int        lon,ret,ier;
   double     lmin;
@@ -80,7 +82,10 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
   double     lmaxtet,lmintet;
   int        imaxtet,imintet;
 
-  for (k=1; k<=ne; k++) {
+  for (l=1; l<=ne; l++) {
+    if ( !(l % _MMG5_TIMECHK) && _MMG5_timeout(mesh) )  break;
+
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt)  || (pt->tag & MG_REQ) )   continue;
 
@@ -94,10 +99,10 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
       ip1  = _MMG5_iare[ii][0];
       ip2  = _MMG5_iare[ii][1];
       if ( pt->xt )
-        len = _MMG5_lenedg(mesh,met,pt->v[ip1],pt->v[ip2],
+        len = _MMG5_LENEDG(ani,mesh,met,pt->v[ip1],pt->v[ip2],
                            (pxt->tag[ii] & MG_GEO));
       else
-        len = _MMG5_lenedg(mesh,met,pt->v[ip1],pt->v[ip2],0);
+        len = _MMG5_LENEDG(ani,mesh,met,pt->v[ip1],pt->v[ip2],0);
 
       if ( len > lmax ) {
         lmax = len;
@@ -200,7 +205,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         }
 
         if ( met->m )
-          met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
         ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
 
@@ -226,7 +231,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
             ppt->ref = pxt->ref[i];
           ppt->tag = tag;
           if ( met->m )
-            met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
           pxp = &mesh->xpoint[ppt->xp];
           if ( tag & MG_NOM ){
@@ -275,7 +280,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         }
 
         if ( met->m )
-          met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
         ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
         if ( ier < 0 ) {
@@ -289,7 +294,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         }
         else {
           ppt = &mesh->point[ip];
-          met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
           _MMG5_addBucket(mesh,bucket,ip);
           (*ns)++;
           continue;
@@ -321,24 +326,31 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         }
 
         if ( met->m )
-          met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
         /* Delaunay */
-        if ( !_MMG5_buckin_iso(mesh,met,bucket,ip) ) {
+        if ( !_MMG5_buckin(mesh,met,bucket,ip) ) {
           _MMG5_delPt(mesh,ip);
           (*ifilt)++;
           goto collapse;
         } else {
+          _MMG5_PROF_INC(mesh,_MMG5_PC_splatt);
+          _MMG5_PROF_IN(mesh,_MMG5_PT_cavity);
           lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2);
+          _MMG5_PROF_OUT(mesh,_MMG5_PT_cavity);
           if ( lon < 1 ) {
             MMG_npd++;
+            _MMG5_PROF_INC(mesh,_MMG5_PC_cavrej);
             _MMG5_delPt(mesh,ip);
             goto collapse;
           } else {
+            _MMG5_PROF_IN(mesh,_MMG5_PT_delone);
             ret = _MMG5_delone(mesh,met,ip,list,lon);
+            _MMG5_PROF_OUT(mesh,_MMG5_PT_delone);
             if ( ret > 0 ) {
+              _MMG5_PROF_INC(mesh,_MMG5_PC_splok);
               ppt = &mesh->point[ip];
-              met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
+              _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
               _MMG5_addBucket(mesh,bucket,ip);
               (*ns)++;
@@ -346,6 +358,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
             }
             else if ( ret == 0 ) {
               MMG_npd++;
+              _MMG5_PROF_INC(mesh,_MMG5_PC_cavrej);
               _MMG5_delPt(mesh,ip);
               goto collapse;//continue;
             }
@@ -380,12 +393,13 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         tag |= MG_BDY;
         if ( p0->tag > tag )   continue;
         if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-        ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
+        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,list,ilist,i2);
+          ier = _MMG5_colver(mesh,met,list,ilist,i2);
 
           if ( ier < 0 ) return(-1);
           else if(ier) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
             _MMG5_delPt(mesh,ier);
             (*nc)++;
             continue;
@@ -398,10 +412,11 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         if ( p0->tag & MG_BDY )  continue;
         ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,list,ilist,i2);
+          ier = _MMG5_colver(mesh,met,list,ilist,i2);
           if ( ilist < 0 ) continue;
           if ( ier < 0 ) return(-1);
           else if(ier) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
             _MMG5_delBucket(mesh,bucket,ier);
             _MMG5_delPt(mesh,ier);
             (*nc)++;
@@ -425,10 +440,10 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
       ip1  = _MMG5_iare[ii][0];
       ip2  = _MMG5_iare[ii][1];
       if ( pt->xt )
-        len = _MMG5_lenedg(mesh,met,pt->v[ip1],pt->v[ip2],
+        len = _MMG5_LENEDG(ani,mesh,met,pt->v[ip1],pt->v[ip2],
                            (pxt->tag[ii] & MG_GEO));
       else
-        len = _MMG5_lenedg(mesh,met,pt->v[ip1],pt->v[ip2],0);
+        len = _MMG5_LENEDG(ani,mesh,met,pt->v[ip1],pt->v[ip2],0);
 
       imax = ii;
       lmax = len;
@@ -519,7 +534,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
           }
 
           if ( met->m )
-            met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
           ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
           /* if we realloc memory in _MMG5_split1b pt and pxt pointers are not valid */
@@ -544,7 +559,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
               ppt->ref = pxt->ref[i];
             ppt->tag = tag;
             if ( met->m )
-              met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+              _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
             pxp = &mesh->xpoint[ppt->xp];
             if ( tag & MG_NOM ){
@@ -592,7 +607,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
           }
 
           if ( met->m )
-            met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
           ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
           if ( ier < 0 ) {
@@ -606,7 +621,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
           }
           else {
             ppt = &mesh->point[ip];
-            met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
             _MMG5_addBucket(mesh,bucket,ip);
             (*ns)++;
             break;//imax continue;
@@ -637,23 +652,30 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
           }
 
           if ( met->m )
-            met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+            _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
-          if ( /*lmax>4 &&*/ /*it &&*/  !_MMG5_buckin_iso(mesh,met,bucket,ip) ) {
+          if ( /*lmax>4 &&*/ /*it &&*/  !_MMG5_buckin(mesh,met,bucket,ip) ) {
             _MMG5_delPt(mesh,ip);
             (*ifilt)++;
             goto collapse2;
           } else {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_splatt);
+            _MMG5_PROF_IN(mesh,_MMG5_PT_cavity);
             lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2);
+            _MMG5_PROF_OUT(mesh,_MMG5_PT_cavity);
             if ( lon < 1 ) {
               MMG_npd++;
+              _MMG5_PROF_INC(mesh,_MMG5_PC_cavrej);
               _MMG5_delPt(mesh,ip);
               goto collapse2;
             } else {
+              _MMG5_PROF_IN(mesh,_MMG5_PT_delone);
               ret = _MMG5_delone(mesh,met,ip,list,lon);
+              _MMG5_PROF_OUT(mesh,_MMG5_PT_delone);
               if ( ret > 0 ) {
+                _MMG5_PROF_INC(mesh,_MMG5_PC_splok);
                 ppt = &mesh->point[ip];
-                met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
+                _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
                 _MMG5_addBucket(mesh,bucket,ip);
                 (*ns)++;
@@ -661,6 +683,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
               }
               else if ( ret == 0 ) {
                 MMG_npd++;
+                _MMG5_PROF_INC(mesh,_MMG5_PC_cavrej);
                 _MMG5_delPt(mesh,ip);
                 goto collapse2;//continue;
               }
@@ -695,11 +718,12 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         tag |= MG_BDY;
         if ( p0->tag > tag )   continue;
         if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-        ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
+        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,list,ilist,i2);
+          ier = _MMG5_colver(mesh,met,list,ilist,i2);
           if ( ier < 0 ) return(-1);
           else if(ier) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
             _MMG5_delPt(mesh,ier);
             (*nc)++;
             break;
@@ -712,10 +736,11 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         if ( p0->tag & MG_BDY )  continue;
         ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,list,ilist,i2);
+          ier = _MMG5_colver(mesh,met,list,ilist,i2);
           if ( ilist < 0 ) continue;
           if ( ier < 0 ) return(-1);
           else if(ier) {
+            _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
             _MMG5_delBucket(mesh,bucket,ier);
             _MMG5_delPt(mesh,ier);
             (*nc)++;
@@ -748,24 +773,31 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
   double     maxgap;
 
   /* Iterative mesh modifications */
-  it = nnc = nns = nnf = nnm = 0;
+  it = nnc = nns = nnf = nnm = ifilt = 0;
   maxit = 10;
   mesh->gap = maxgap = 0.5;
   MMG_npuiss = MMG_nvol = MMG_npres = MMG_npd = 0;
   do {
+    if ( _MMG5_timeout(mesh) )  break;
+
     if ( !mesh->info.noinsert ) {
       *warn=0;
       ns = nc = 0;
       nf = nm = 0;
       ifilt = 0;
-      ne = mesh->ne;
-      ier = _MMG5_boucle_for(mesh,met,bucket,ne,&ifilt,&ns,&nc,warn,it);
+      ne = _MMG5_NEACT(mesh);
+      _MMG5_PROF_IN(mesh,_MMG5_PT_splcol);
+      if ( met->size == 6 )
+        ier = _MMG5_boucle_for(mesh,met,bucket,ne,&ifilt,&ns,&nc,warn,it,1);
+      else
+        ier = _MMG5_boucle_for(mesh,met,bucket,ne,&ifilt,&ns,&nc,warn,it,0);
+      _MMG5_PROF_OUT(mesh,_MMG5_PT_splcol);
       if(ier<0) exit(EXIT_FAILURE);
       else if(!ier) return(-1);
     } /* End conditional loop on mesh->info.noinsert */
     else  ns = nc = ifilt = 0;
 
-    if ( !mesh->info.noswap ) {
+    if ( !mesh->info.noswap && !_MMG5_timeout(mesh) ) {
       nf = _MMG5_swpmsh(mesh,met,bucket);
       if ( nf < 0 ) {
         fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
@@ -784,7 +816,7 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
     }
     else  nf = 0;
 
-    if ( !mesh->info.nomove ) {
+    if ( !mesh->info.nomove && !_MMG5_timeout(mesh) ) {
       nm = _MMG5_movtet(mesh,met,-1);
       if ( nm < 0 ) {
         fprintf(stdout,"  ## Unable to improve mesh.\n");
@@ -804,10 +836,19 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
     else
       mesh->gap -= mesh->gap/(double)maxit;
 
+    /* pack the boundary tables if they contain too many holes */
+    if ( !_MMG5_pakXEnt(mesh) )  return(0);
 
     if ( (abs(mesh->info.imprim) > 4 || mesh->info.ddebug) && ns+nc+nm+nf > 0)
       fprintf(stdout,"     %8d filtered, %8d splitted, %8d collapsed,"
               " %8d swapped, %8d moved\n",ifilt,ns,nc,nf,nm);
+    _MMG5_progress(mesh,MMG5_STEP_adaptation,it,ns,nc,nf,nm);
+
+    /* save the working state at the end of each pass (not in local remeshing
+     * mode: the frozen part of the mesh can not be restored) */
+    if ( mesh->nameckpt && !mesh->nlreg
+         && !MMG5_saveCheckpoint(mesh,met,mesh->nameckpt) )
+      fprintf(stdout,"  ## Warning: unable to save the checkpoint.\n");
 
     if ( ns < 10 && abs(nc-ns) < 3 )  break;
     else if ( it > 3 && abs(nc-ns) < 0.3 * MG_MAX(nc,ns) )  break;
@@ -842,6 +883,8 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
   maxit = 4;
   declic = 1.053;
   do {
+    if ( _MMG5_timeout(mesh) )  break;
+
     /* badly shaped process */
     if ( !mesh->info.noswap ) {
       nf = _MMG5_swpmsh(mesh,met,bucket);
@@ -859,7 +902,7 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
     }
     else  nf = 0;
 
-    if ( !mesh->info.nomove ) {
+    if ( !mesh->info.nomove && !_MMG5_timeout(mesh) ) {
       nm = _MMG5_movtet(mesh,met,0);
       if ( nm < 0 ) {
         fprintf(stdout,"  ## Unable to improve mesh.\n");
@@ -879,10 +922,11 @@ _MMG5_optet(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket) {
       fprintf(stdout,"                                                   ");
       fprintf(stdout,"      ""      %8d swapped, %8d moved\n",nf,nm);
     }
+    _MMG5_progress(mesh,MMG5_STEP_optimization,it,0,0,nf,nm);
   }
   while( ++it < maxit && nm+nf > 0 );
 
-  if ( !mesh->info.nomove ) {
+  if ( !mesh->info.nomove && !_MMG5_timeout(mesh) ) {
     nm = _MMG5_movtet(mesh,met,3);
     if ( nm < 0 ) {
       fprintf(stdout,"  ## Unable to improve mesh.\n");
@@ -920,8 +964,10 @@ _MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
   int      nnf,ns,nf;
   int      warn;
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_adaptation);
+
   /*initial swap*/
-  if ( !mesh->info.noswap ) {
+  if ( !mesh->info.noswap && !_MMG5_timeout(mesh) ) {
     nf = _MMG5_swpmsh(mesh,met,bucket);
     if ( nf < 0 ) {
       fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
@@ -959,12 +1005,15 @@ _MMG5_adptet_delone(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket) {
     fprintf(stdout,"  ## Uncomplete mesh. Exiting\n" );
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_adaptation);
 
   /* renumerotation if available */
   if ( !_MMG5_scotchCall(mesh,met) )
     return(0);
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_optimization);
   if(!_MMG5_optet(mesh,met,bucket)) return(0);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_optimization);
 
   return(1);
 }
@@ -992,10 +1041,12 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** GEOMETRIC MESH\n");
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_geometricMesh);
   if ( !_MMG5_anatet(mesh,met,1,0) ) {
     fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_geometricMesh);
 
 #ifdef DEBUG
   _MMG5_outqua(mesh,met);
@@ -1005,20 +1056,29 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** COMPUTATIONAL MESH\n");
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_computMesh);
+
   /* define metric map */
+  _MMG5_PROF_IN(mesh,_MMG5_PT_defsiz);
   if ( !_MMG5_defsiz(mesh,met) ) {
     fprintf(stdout,"  ## Metric undefined. Exit program.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_defsiz);
 
-  if ( mesh->info.hgrad > 0. && !_MMG5_gradsiz(mesh,met) ) {
+  _MMG5_PROF_IN(mesh,_MMG5_PT_gradsiz);
+  if ( mesh->info.hgrad > 0. && !_MMG5_timeout(mesh)
+       && !_MMG5_gradsiz(mesh,met) ) {
     fprintf(stdout,"  ## Gradation problem. Exit program.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_gradsiz);
+
   if ( !_MMG5_anatet(mesh,met,2,0) ) {
     fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_computMesh);
 
 #ifdef DEBUG
   puts("---------------------------Fin anatet---------------------");
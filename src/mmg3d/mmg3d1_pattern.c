@@ -55,12 +55,15 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
   MMG5_pPoint     p0,p1,ppt;
   MMG5_pxPoint    pxp;
   double     dd,len,lmax,o[3],to[3],ro[3],no1[3],no2[3],v[3];
-  int        k,ip,ip1,ip2,list[_MMG5_LMAX+2],ilist,ns,ref,ier;
+  int        k,l,ip,ip1,ip2,list[_MMG5_LMAX+2],ilist,ns,ref,ier;
   char       imax,tag,j,i,i1,i2,ifa0,ifa1;
 
   *warn=0;
   ns = 0;
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    if ( !(l % _MMG5_TIMECHK) && _MMG5_timeout(mesh) )  break;
+
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )   continue;
     pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
@@ -163,7 +166,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
                             ,o,tag);
       }
       if ( met->m )
-        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
       ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
       /* if we realloc memory in _MMG5_split1b pt and pxt pointers are not valid */
       pt = &mesh->tetra[k];
@@ -184,7 +187,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
       else
         ppt->ref = pxt->ref[i];
       if ( met->m )
-        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
 
       pxp = &mesh->xpoint[ppt->xp];
       if ( tag & MG_NOM ){
@@ -224,7 +227,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
                             ,o,MG_NOTAG);
       }
       if ( met->m )
-        met->m[ip] = 0.5 * (met->m[ip1]+met->m[ip2]);
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
       ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
       if ( ier < 0 ) {
         fprintf(stdout,"  ## Error: unable to split.\n");
@@ -235,7 +238,7 @@ static int _MMG5_adpspl(MMG5_pMesh mesh,MMG5_pSol met, int* warn) {
       }
       else {
         ppt = &mesh->point[ip];
-        met->m[ip] = 0.5 * (met->m[ip1] + met->m[ip2]);
+        _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
         ns++;
       }
     }
@@ -259,12 +262,15 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pxTetra    pxt;
   MMG5_pPoint     p0,p1;
   double     len,lmin;
-  int        k,ip,iq,list[_MMG5_LMAX+2],ilist,nc;
+  int        k,l,ip,iq,list[_MMG5_LMAX+2],ilist,nc;
   char       imin,tag,j,i,i1,i2,ifa0,ifa1;
   int        ier;
 
   nc = 0;
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=1; l<=_MMG5_NEACT(mesh); l++) {
+    if ( !(l % _MMG5_TIMECHK) && _MMG5_timeout(mesh) )  break;
+
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
@@ -312,7 +318,7 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
       tag |= MG_BDY;
       if ( p0->tag > tag )   continue;
       if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-      ilist = _MMG5_chkcol_bdy(mesh,k,i,j,list);
+      ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list);
     }
     /* Case of an internal face */
     else {
@@ -320,9 +326,10 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
       ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
     }
     if ( ilist > 0 ) {
-      ier = _MMG5_colver(mesh,list,ilist,i2);
+      ier = _MMG5_colver(mesh,met,list,ilist,i2);
       if ( ier < 0 )  return(-1);
       else if ( ier ) {
+        _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
         _MMG5_delPt(mesh,ier);
         nc++;
       }
@@ -348,12 +355,17 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
   double   maxgap;
 
   /* Iterative mesh modifications */
+  _MMG5_PROF_IN(mesh,_MMG5_PT_adaptation);
   it = nnc = nns = nnf = nnm = warn = 0;
   maxit = 10;
   mesh->gap = maxgap = 0.5;
   do {
+    if ( _MMG5_timeout(mesh) )  break;
+
     if ( !mesh->info.noinsert ) {
+      _MMG5_PROF_IN(mesh,_MMG5_PT_adpspl);
       ns = _MMG5_adpspl(mesh,met,&warn);
+      _MMG5_PROF_OUT(mesh,_MMG5_PT_adpspl);
       if ( ns < 0 ) {
         fprintf(stdout,"  ## Unable to complete mesh. Exit program.\n");
         return(0);
@@ -365,8 +377,10 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( it==1 && !_MMG5_scotchCall(mesh,met) )
       return(0);
 
-    if ( !mesh->info.noinsert ) {
+    if ( !mesh->info.noinsert && !_MMG5_timeout(mesh) ) {
+      _MMG5_PROF_IN(mesh,_MMG5_PT_adpcol);
       nc = _MMG5_adpcol(mesh,met);
+      _MMG5_PROF_OUT(mesh,_MMG5_PT_adpcol);
       if ( nc < 0 ) {
         fprintf(stdout,"  ## Unable to complete mesh. Exit program.\n");
         return(0);
@@ -379,7 +393,7 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
     }
     else  nc = 0;
 
-    if ( !mesh->info.nomove ) {
+    if ( !mesh->info.nomove && !_MMG5_timeout(mesh) ) {
       nm = _MMG5_movtet(mesh,met,1);
       if ( nm < 0 ) {
         fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
@@ -388,7 +402,7 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
     }
     else  nm = 0;
 
-    if ( !mesh->info.noswap ) {
+    if ( !mesh->info.noswap && !_MMG5_timeout(mesh) ) {
       nf = _MMG5_swpmsh(mesh,met,NULL);
       if ( nf < 0 ) {
         fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
@@ -414,8 +428,19 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
     else
       mesh->gap -= mesh->gap/(double)maxit;
 
+    /* pack the boundary tables if they contain too many holes */
+    if ( !_MMG5_pakXEnt(mesh) )  return(0);
+
     if ( (abs(mesh->info.imprim) > 4 || mesh->info.ddebug) && ns+nc > 0 )
       fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped, %8d moved\n",ns,nc,nf,nm);
+    _MMG5_progress(mesh,MMG5_STEP_adaptation,it,ns,nc,nf,nm);
+
+    /* save the working state at the end of each pass (not in local remeshing
+     * mode: the frozen part of the mesh can not be restored) */
+    if ( mesh->nameckpt && !mesh->nlreg
+         && !MMG5_saveCheckpoint(mesh,met,mesh->nameckpt) )
+      fprintf(stdout,"  ## Warning: unable to save the checkpoint.\n");
+
     if ( ns < 10 && abs(nc-ns) < 3 )  break;
     else if ( it > 3 && abs(nc-ns) < 0.3 * MG_MAX(nc,ns) )  break;
   }
@@ -429,16 +454,20 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
     fprintf(stdout,"  ## Uncomplete mesh. Exiting\n" );
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_adaptation);
 
   /* renumbering if available */
   if ( !_MMG5_scotchCall(mesh,met) )
     return(0);
 
   /*shape optim*/
+  _MMG5_PROF_IN(mesh,_MMG5_PT_optimization);
   it1 = it;
   it  = 0;
   maxit = 2;
   do {
+    if ( _MMG5_timeout(mesh) )  break;
+
     /* badly shaped process */
     /*ier = _MMG5_badelt(mesh,met);
       if ( ier < 0 ) {
@@ -476,10 +505,11 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
       fprintf(stdout,"                                            ");
       fprintf(stdout,"%8d swapped, %8d moved\n",nf,nm);
     }
+    _MMG5_progress(mesh,MMG5_STEP_optimization,it,0,0,nf,nm);
   }
   while( ++it < maxit && nm+nf > 0 );
 
-  if ( !mesh->info.nomove ) {
+  if ( !mesh->info.nomove && !_MMG5_timeout(mesh) ) {
     nm = _MMG5_movtet(mesh,met,3);
     if ( nm < 0 ) {
       fprintf(stdout,"  ## Unable to improve mesh.\n");
@@ -498,6 +528,7 @@ static int _MMG5_adptet(MMG5_pMesh mesh,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) < 5 && (nnc > 0 || nns > 0) )
     fprintf(stdout,"     %8d splitted, %8d collapsed, %8d swapped, %8d moved, %d iter. \n",
             nns,nnc,nnf,nnm,it+it1);
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_optimization);
 
   return(1);
 }
@@ -524,10 +555,12 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** GEOMETRIC MESH\n");
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_geometricMesh);
   if ( !_MMG5_anatet(mesh,met,1,1) ) {
     fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_geometricMesh);
 
   /* renumbering if available */
   if ( !_MMG5_scotchCall(mesh,met) )
@@ -537,21 +570,29 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** COMPUTATIONAL MESH\n");
 
+  _MMG5_PROF_IN(mesh,_MMG5_PT_computMesh);
+
   /* define metric map */
+  _MMG5_PROF_IN(mesh,_MMG5_PT_defsiz);
   if ( !_MMG5_defsiz(mesh,met) ) {
     fprintf(stdout,"  ## Metric undefined. Exit program.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_defsiz);
 
-  if ( mesh->info.hgrad > 0. && !_MMG5_gradsiz(mesh,met) ) {
+  _MMG5_PROF_IN(mesh,_MMG5_PT_gradsiz);
+  if ( mesh->info.hgrad > 0. && !_MMG5_timeout(mesh)
+       && !_MMG5_gradsiz(mesh,met) ) {
     fprintf(stdout,"  ## Gradation problem. Exit program.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_gradsiz);
 
   if ( !_MMG5_anatet(mesh,met,2,1) ) {
     fprintf(stdout,"  ## Unable to split mesh. Exiting.\n");
     return(0);
   }
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_computMesh);
 
   /* renumbering if available */
   if ( !_MMG5_scotchCall(mesh,met) )
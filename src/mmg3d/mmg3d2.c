@@ -296,6 +296,25 @@ _MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
   return(1);
 }
 
+/**
+ * \param sol pointer toward the level-set function.
+ * \param pt pointer toward a tetrahedron.
+ * \return 1 if an edge of \a pt is cut by the isosurface, 0 otherwise.
+ *
+ */
+static inline int _MMG5_crossls(MMG5_pSol sol,MMG5_pTetra pt) {
+  double  v,vmin,vmax;
+  char    i;
+
+  vmin = vmax = sol->m[pt->v[0]];
+  for (i=1; i<4; i++) {
+    v    = sol->m[pt->v[i]];
+    vmin = MG_MIN(vmin,v);
+    vmax = MG_MAX(vmax,v);
+  }
+  return( vmin < -_MMG5_EPSD2 && vmax > _MMG5_EPSD2 );
+}
+
 /** Snap values of the level set function very close to 0 to exactly 0,
     and prevent nonmanifold patterns from being generated */
 static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
@@ -353,9 +372,46 @@ static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fields pointer toward the level-set functions.
+ * \param ip0 first extremity of the cut edge.
+ * \param ip1 second extremity of the cut edge.
+ * \param np new point.
+ * \param s parameter of \a np along the edge.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Interpolate the level-set functions at the point \a np inserted on the edge
+ * \a ip0 \a ip1, with several level-set functions.
+ *
+ */
+static int _MMG5_intls(MMG5_pMesh mesh,MMG5_pSol fields,int ip0,int ip1,
+                       int np,double s) {
+  double   *v0,*v1,*v;
+  int      i;
+
+  if ( fields->npmax < mesh->npmax ) {
+    _MMG5_ADD_MEM(mesh,fields->size*(mesh->npmax-fields->npmax)*sizeof(double),
+                  "larger solution",return(0));
+    _MMG5_SAFE_REALLOC(fields->m,fields->size*(mesh->npmax+1)+1,double,
+                       "larger solution");
+    fields->npmax = mesh->npmax;
+  }
+
+  v0 = &fields->m[fields->size*ip0];
+  v1 = &fields->m[fields->size*ip1];
+  v  = &fields->m[fields->size*np];
+  for (i=0; i<fields->size; i++)
+    v[i] = v0[i] + s*(v1[i]-v0[i]);
+
+  return(1);
+}
+
 /** Proceed to discretization of the implicit function carried by sol into mesh, once values
-    of sol have been snapped/checked */
-static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
+    of sol have been snapped/checked. With several level-set functions, sol is
+    the function being discretized and the other ones are interpolated at the
+    new points (\a fields is NULL otherwise) */
+static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol, MMG5_pSol fields/*,double *tmp*/){
   MMG5_pTetra   pt;
   MMG5_pPoint   p0,p1;
   _MMG5_Hash     hash;
@@ -376,6 +432,7 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
   nb = 0;
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
+    if ( !_MMG5_crossls(sol,pt) )  continue;
     for (ia=0; ia<6; ia++) {
       ip0 = pt->v[_MMG5_iare[ia][0]];
       ip1 = pt->v[_MMG5_iare[ia][1]];
@@ -451,7 +508,7 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
   if ( !_MMG5_hashNew(mesh,&hash,nb,7*nb) ) return(0);
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
-    if ( !MG_EOK(pt) )  continue;
+    if ( !MG_EOK(pt) || !_MMG5_crossls(sol,pt) )  continue;
 
     for (ia=0; ia<6; ia++) {
       ip0 = pt->v[_MMG5_iare[ia][0]];
@@ -504,6 +561,11 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
                             ,c,0);
       }
       sol->m[np] = 0.0;
+      if ( fields && !_MMG5_intls(mesh,fields,ip0,ip1,np,s) ) {
+        fprintf(stdout,"  ## Error: unable to interpolate the level-set functions\n");
+        _MMG5_INCREASE_MEM_MESSAGE();
+        return(0);
+      }
       _MMG5_hashEdge(mesh,&hash,ip0,ip1,np);
     }
   }
@@ -586,6 +648,88 @@ static int _MMG5_setref_ls(MMG5_pMesh mesh, MMG5_pSol sol) {
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the discretized level-set functions.
+ * \return 1.
+ *
+ * Set references to tets according to the combination of the signs of
+ * several level-set functions: bit \a i of ref-1 is set if the \a i-th function
+ * is positive in the tetrahedron.
+ *
+ */
+static int _MMG5_setref_mls(MMG5_pMesh mesh, MMG5_pSol sol) {
+  MMG5_pTetra   pt;
+  double        v;
+  int           k,j,ref;
+  char          i;
+
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    ref = 0;
+    for (j=0; j<sol->size; j++) {
+      /* the tetra lies on one side of each discretized isosurface */
+      for (i=0; i<4; i++) {
+        v = sol->m[sol->size*pt->v[i]+j];
+        if ( v != 0.0 )  break;
+      }
+      if ( i < 4 && v > 0.0 )  ref |= 1 << j;
+    }
+    pt->ref = ref+1;
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the discretized level-set functions.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Narrow-band mode: restrict the remeshing to the tetrahedra sharing a vertex
+ * with the tetrahedra touching the discretized isosurfaces, grown by \a
+ * mesh->info.lsband layers (see \ref MMG5_Set_localRegion). The rest of the
+ * mesh is frozen. Taking the whole vertex ring of the cut tetrahedra ensures
+ * that no vertex of an element touching the isosurface lies on the frozen
+ * interface, whatever the number of layers (otherwise the slivers created by
+ * the discretization next to the interface cannot be removed).
+ *
+ */
+static int _MMG5_bandls(MMG5_pMesh mesh, MMG5_pSol sol) {
+  MMG5_pTetra   pt;
+  int      k,n,pass,base;
+  char     i;
+
+  /* mark the vertices of the tetrahedra touching the isosurfaces */
+  base = ++mesh->base;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4*sol->size; i++)
+      if ( sol->m[sol->size*pt->v[i/sol->size]+i%sol->size] == 0.0 )  break;
+    if ( i == 4*sol->size )  continue;
+    for (i=0; i<4; i++)
+      mesh->point[pt->v[i]].flag = base;
+  }
+
+  /* first pass to count the seeds, second pass to store them */
+  n = 0;
+  for (pass=0; pass<2; pass++) {
+    if ( pass && !_MMG5_newRegion(mesh,n,mesh->info.lsband) )  return(0);
+    n = 0;
+    for (k=1; k<=mesh->ne; k++) {
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) )  continue;
+      for (i=0; i<4; i++)
+        if ( mesh->point[pt->v[i]].flag == base )  break;
+      if ( i == 4 )  continue;
+      if ( pass )  mesh->lreg[n] = k;
+      n++;
+    }
+  }
+  return(1);
+}
+
 /** Check whether implicit surface is orientable in ball of point ip in tet iel ;
     Beware : may return 0 when implicit boundary is tangent to outer boundary */
 int _MMG5_chkmaniball(MMG5_pMesh mesh, int start, char ip){
@@ -689,19 +833,19 @@ int _MMG5_chkmaniball(MMG5_pMesh mesh, int start, char ip){
   return(1);
 }
 
-/** Check whether implicit surface enclosed in volume is orientable */
+/** Check whether implicit surface enclosed in volume is orientable (in the
+    listed region once the mesh is frozen, see \ref _MMG5_NEACT) */
 int _MMG5_chkmani(MMG5_pMesh mesh){
   MMG5_pTetra    pt,pt1;
-  int       k,iel,ref;
+  int       k,l,iel,ref;
   int       *adja;
   char      i,j,ip,cnt;
 
-  for(k=1; k<=mesh->np; k++){
-    mesh->point[k].flag = 0;
-  }
+  _MMG5_setPtFlags(mesh,0);
 
   /** First test : check whether a tetra has 4 boundary faces */
-  for(k=1; k<=mesh->ne; k++) {
+  for(l=1; l<=_MMG5_NEACT(mesh); l++) {
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) )   continue;
     adja = &mesh->adja[4*(k-1)+1];
@@ -724,7 +868,8 @@ int _MMG5_chkmani(MMG5_pMesh mesh){
   }
 
   /** Second test : Check whether configuration is manifold in each ball */
-  for(k=1; k<=mesh->ne; k++){
+  for(l=1; l<=_MMG5_NEACT(mesh); l++){
+    k  = _MMG5_EACT(mesh,l);
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ))   continue;
     adja = &mesh->adja[4*(k-1)+1];
@@ -1311,69 +1456,123 @@ int _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int n
   return(1);
 }
 
-/** Create implicit surface in mesh */
+/** Create implicit surface in mesh. With several level-set functions, they are
+    snapped and discretized one after the other in the same mesh, the
+    remaining ones being interpolated at the new points */
 int _MMG5_mmg3d2(MMG5_pMesh mesh,MMG5_pSol sol) {
+  MMG5_Sol  ls;
+  MMG5_pSol psl;
   double   *tmp;
+  int       k,ifld;
 
   if ( abs(mesh->info.imprim) > 3 )
     fprintf(stdout,"  ** ISOSURFACE EXTRACTION\n");
 
-  _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(double),"temporary table",
-                printf("  Exit program.\n");
-                exit(EXIT_FAILURE));
-  _MMG5_SAFE_CALLOC(tmp,mesh->npmax+1,double);
-
-  /* Snap values of level set function if need be, then discretize it */
-  if ( !_MMG5_snpval_ls(mesh,sol,tmp) ) {
-    fprintf(stdout,"  ## Problem with implicit function. Exit program.\n");
-    return(0);
+  _MMG5_PROF_IN(mesh,_MMG5_PT_levelSet);
+
+  /* scalar copy of the function being discretized */
+  if ( sol->size > 1 ) {
+    memset(&ls,0,sizeof(MMG5_Sol));
+    ls.dim   = 3;
+    ls.size  = 1;
+    ls.np    = mesh->np;
+    ls.npmax = mesh->npmax;
+    _MMG5_ADD_MEM(mesh,(ls.npmax+2)*sizeof(double),"level-set function",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(ls.m,ls.npmax+2,double);
+    psl = &ls;
   }
-  _MMG5_DEL_MEM(mesh,tmp,(mesh->npmax+1)*sizeof(double));
+  else
+    psl = sol;
+
+  for (ifld=0; ifld<sol->size; ifld++) {
+    if ( sol->size > 1 ) {
+      if ( abs(mesh->info.imprim) > 4 )
+        fprintf(stdout,"     level-set function %d\n",ifld+1);
+      for (k=1; k<=mesh->np; k++)
+        ls.m[k] = sol->m[sol->size*k+ifld];
+    }
 
-  if ( !_MMG5_hashTetra(mesh,1) ) {
-    fprintf(stdout,"  ## Hashing problem. Exit program.\n");
-    return(0);
-  }
-  if ( !_MMG5_chkNumberOfTri(mesh) ) {
-    if ( !_MMG5_bdryTria(mesh) ) {
-      fprintf(stdout,"  ## Boundary problem. Exit program.\n");
+    _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(double),"temporary table",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(tmp,mesh->npmax+1,double);
+
+    /* Snap values of level set function if need be, then discretize it */
+    if ( !_MMG5_snpval_ls(mesh,psl,tmp) ) {
+      fprintf(stdout,"  ## Problem with implicit function. Exit program.\n");
       return(0);
     }
-    _MMG5_freeXTets(mesh);
-  }
-  else if ( !_MMG5_bdryPerm(mesh) ) {
-    fprintf(stdout,"  ## Boundary orientation problem. Exit program.\n");
-    return(0);
-  }
+    _MMG5_DEL_MEM(mesh,tmp,(mesh->npmax+1)*sizeof(double));
 
-  /* build hash table for initial edges */
-  if ( !_MMG5_hGeom(mesh) ) {
-    fprintf(stdout,"  ## Hashing problem (0). Exit program.\n");
-    return(0);
-  }
+    /* the boundary is set once: the splittings keep it up to date */
+    if ( !ifld ) {
+      if ( !_MMG5_hashTetra(mesh,1) ) {
+        fprintf(stdout,"  ## Hashing problem. Exit program.\n");
+        return(0);
+      }
+      if ( !_MMG5_chkNumberOfTri(mesh) ) {
+        if ( !_MMG5_bdryTria(mesh) ) {
+          fprintf(stdout,"  ## Boundary problem. Exit program.\n");
+          return(0);
+        }
+        _MMG5_freeXTets(mesh);
+      }
+      else if ( !_MMG5_bdryPerm(mesh) ) {
+        fprintf(stdout,"  ## Boundary orientation problem. Exit program.\n");
+        return(0);
+      }
 
-  if ( !_MMG5_bdrySet(mesh) ) {
-    fprintf(stdout,"  ## Problem in setting boundary. Exit program.\n");
-    return(0);
-  }
+      /* build hash table for initial edges */
+      if ( !_MMG5_hGeom(mesh) ) {
+        fprintf(stdout,"  ## Hashing problem (0). Exit program.\n");
+        return(0);
+      }
 
-  if ( !_MMG5_cuttet_ls(mesh,sol/*,tmp*/) ) {
-    fprintf(stdout,"  ## Problem in discretizing implicit function. Exit program.\n");
-    return(0);
-  }
+      if ( !_MMG5_bdrySet(mesh) ) {
+        fprintf(stdout,"  ## Problem in setting boundary. Exit program.\n");
+        return(0);
+      }
+    }
 
-  _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+    if ( !_MMG5_cuttet_ls(mesh,psl,sol->size > 1 ? sol : NULL/*,tmp*/) ) {
+      fprintf(stdout,"  ## Problem in discretizing implicit function. Exit program.\n");
+      return(0);
+    }
+
+    _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
+
+    if ( sol->size > 1 ) {
+      for (k=1; k<=mesh->np; k++)
+        sol->m[sol->size*k+ifld] = ls.m[k];
+    }
+  }
   _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
   mesh->nt = 0;
 
-  if ( !_MMG5_setref_ls(mesh,sol) ) {
+  if ( sol->size > 1 ) {
+    _MMG5_DEL_MEM(mesh,ls.m,(ls.npmax+2)*sizeof(double));
+    if ( !_MMG5_setref_mls(mesh,sol) ) {
+      fprintf(stdout,"  ## Problem in setting references. Exit program.\n");
+      return(0);
+    }
+  }
+  else if ( !_MMG5_setref_ls(mesh,sol) ) {
     fprintf(stdout,"  ## Problem in setting references. Exit program.\n");
     return(0);
   }
 
+  /* narrow band around the isosurface */
+  if ( mesh->info.lsband && !_MMG5_bandls(mesh,sol) ) {
+    fprintf(stdout,"  ## Unable to build the narrow band. Exit program.\n");
+    return(0);
+  }
+
   /* Clean memory (but not pointer) */
-  _MMG5_DEL_MEM(mesh,sol->m,(sol->size*sol->npmax+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,sol->m,(sol->size*(sol->npmax+1)+1)*sizeof(double));
   memset(sol,0,sizeof(MMG5_Sol));
+  _MMG5_PROF_OUT(mesh,_MMG5_PT_levelSet);
 
   return(1);
 }
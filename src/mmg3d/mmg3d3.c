@@ -35,17 +35,562 @@
 
 #include "mmg3d.h"
 
-extern char  ddb;
+#define _MMG5_LAGBAD    0.0288675 /**< 0.6/_MMG5_ALPHAD: bad element for the
+                                       lagrangian repair */
+#define _MMG5_LAGMAXIT  200       /**< maximal number of displacement steps */
+#define _MMG5_LAGTOL    5.e-4     /**< tolerance of the displacement
+                                       propagation, relative to the largest
+                                       boundary displacement */
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u displacement field.
+ * \param t fraction of the displacement (in _MMG5_SHORTMAX unit).
+ * \return 1 if the mesh remains valid, 0 otherwise.
+ *
+ * Check if moving the vertices by \a t times the displacement \a u keeps all
+ * the tetrahedra positively oriented (the mesh is not modified).
+ *
+ */
+int _MMG5_trydisp(MMG5_pMesh mesh,double *u,short t) {
+  MMG5_pTetra  pt;
+  MMG5_pPoint  ppt;
+  double       tau,c[4][3],*v;
+  int          k;
+  char         i,j;
+
+  tau = (double)t / _MMG5_SHORTMAX;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+
+    for (i=0; i<4; i++) {
+      ppt = &mesh->point[pt->v[i]];
+      v   = &u[3*(pt->v[i]-1)+1];
+      for (j=0; j<3; j++)
+        c[i][j] = ppt->c[j] + tau*v[j];
+    }
+    if ( _MMG5_det4pt(c[0],c[1],c[2],c[3]) <= _MMG5_NULKAL )  return(0);
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u displacement field.
+ * \return the fraction of the displacement (in _MMG5_SHORTMAX unit) applied
+ * to the mesh.
+ *
+ * Find by dichotomy the largest fraction of the displacement \a u that keeps
+ * the mesh valid, move the vertices by this fraction and keep the remaining
+ * part of the displacement in \a u. The moved boundary vertices are marked by
+ * their tmp field.
+ *
+ */
+int _MMG5_dichodisp(MMG5_pMesh mesh,double *u) {
+  MMG5_pPoint  ppt;
+  double       tau,*v;
+  int          k,tmin,tmax,t;
+
+  if ( _MMG5_trydisp(mesh,u,_MMG5_SHORTMAX) )
+    t = _MMG5_SHORTMAX;
+  else {
+    tmin = 0;
+    tmax = _MMG5_SHORTMAX;
+    while ( tmax - tmin > _MMG5_SHORTMAX/1024 ) {
+      t = (tmin + tmax) / 2;
+      if ( _MMG5_trydisp(mesh,u,t) )  tmin = t;
+      else                            tmax = t;
+    }
+    t = tmin;
+  }
+  if ( !t )  return(0);
+
+  tau = (double)t / _MMG5_SHORTMAX;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) )  continue;
+    v = &u[3*(k-1)+1];
+    if ( v[0] == 0.0 && v[1] == 0.0 && v[2] == 0.0 )  continue;
+
+    ppt->c[0] += tau*v[0];
+    ppt->c[1] += tau*v[1];
+    ppt->c[2] += tau*v[2];
+    v[0] -= tau*v[0];
+    v[1] -= tau*v[1];
+    v[2] -= tau*v[2];
+    if ( ppt->tag & MG_BDY )  ppt->tmp = 1;
+  }
+  return(t);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u displacement field.
+ * \param s sum of the displacements of the neighbours of the vertices.
+ * \param nb number of neighbours of the vertices.
+ *
+ * Sum the displacements of the edge neighbours of each vertex (an edge is
+ * counted once per tetrahedron of its shell).
+ *
+ */
+static inline
+void _MMG5_sumdisp(MMG5_pMesh mesh,double *u,double *s,int *nb) {
+  MMG5_pTetra  pt;
+  int          k,ia,ib;
+  char         i,j;
+
+  memset(s,0,3*(mesh->np+1)*sizeof(double));
+  memset(nb,0,(mesh->np+1)*sizeof(int));
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<6; i++) {
+      ia = pt->v[_MMG5_iare[i][0]];
+      ib = pt->v[_MMG5_iare[i][1]];
+      for (j=0; j<3; j++) {
+        s[3*ia+j] += u[3*(ib-1)+1+j];
+        s[3*ib+j] += u[3*(ia-1)+1+j];
+      }
+      nb[ia]++;
+      nb[ib]++;
+    }
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u displacement field.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Regularize the displacement of the internal vertices by a few passes of
+ * laplacian/antilaplacian (Taubin) smoothing: the field is smoothed without
+ * shrinking and the boundary displacement is kept.
+ *
+ */
+int _MMG5_lapantilap(MMG5_pMesh mesh,double *u) {
+  MMG5_pPoint  ppt;
+  double       *s,lambda,mu,coef;
+  int          *nb,k,it,maxit;
+  char         j,l;
+
+  _MMG5_ADD_MEM(mesh,3*(mesh->np+1)*sizeof(double),"displacement sums",
+                return(0));
+  _MMG5_SAFE_MALLOC(s,3*(mesh->np+1),double);
+  _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"number of neighbours",
+                _MMG5_DEL_MEM(mesh,s,3*(mesh->np+1)*sizeof(double));
+                return(0));
+  _MMG5_SAFE_MALLOC(nb,mesh->np+1,int);
+
+  lambda = 0.5;
+  mu     = -0.53;
+  maxit  = 3;
+  for (it=0; it<maxit; it++) {
+    for (l=0; l<2; l++) {
+      coef = l ? mu : lambda;
+      _MMG5_sumdisp(mesh,u,s,nb);
+      for (k=1; k<=mesh->np; k++) {
+        ppt = &mesh->point[k];
+        if ( !MG_VOK(ppt) || (ppt->tag & MG_BDY) || !nb[k] )  continue;
+        for (j=0; j<3; j++)
+          u[3*(k-1)+1+j] += coef*(s[3*k+j]/nb[k] - u[3*(k-1)+1+j]);
+      }
+    }
+  }
+
+  _MMG5_DEL_MEM(mesh,nb,(mesh->np+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,s,3*(mesh->np+1)*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param u displacement field.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * If the displacement is only prescribed at the boundary vertices (null at
+ * all the internal ones), propagate it inside the volume by Jacobi iterations
+ * of the laplacian (harmonic extension), until the largest update is below
+ * \ref _MMG5_LAGTOL times the largest boundary displacement.
+ *
+ */
+int _MMG5_ppgdisp(MMG5_pMesh mesh,double *u) {
+  MMG5_pPoint  ppt;
+  double       *s,*v,res,dd,tol;
+  int          *nb,k,it,maxit;
+  char         j;
+
+  tol = 0.0;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) )  continue;
+    v = &u[3*(k-1)+1];
+    if ( ppt->tag & MG_BDY ) {
+      tol = MG_MAX(tol,v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+      continue;
+    }
+    if ( v[0] != 0.0 || v[1] != 0.0 || v[2] != 0.0 )  return(1);
+  }
+  if ( tol == 0.0 )  return(1);
+  tol = _MMG5_LAGTOL*sqrt(tol);
+
+  _MMG5_ADD_MEM(mesh,3*(mesh->np+1)*sizeof(double),"displacement sums",
+                return(0));
+  _MMG5_SAFE_MALLOC(s,3*(mesh->np+1),double);
+  _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"number of neighbours",
+                _MMG5_DEL_MEM(mesh,s,3*(mesh->np+1)*sizeof(double));
+                return(0));
+  _MMG5_SAFE_MALLOC(nb,mesh->np+1,int);
+
+  maxit = 500;
+  for (it=0; it<maxit; it++) {
+    _MMG5_sumdisp(mesh,u,s,nb);
+    res = 0.0;
+    for (k=1; k<=mesh->np; k++) {
+      ppt = &mesh->point[k];
+      if ( !MG_VOK(ppt) || (ppt->tag & MG_BDY) || !nb[k] )  continue;
+      v = &u[3*(k-1)+1];
+      for (j=0; j<3; j++) {
+        dd    = s[3*k+j]/nb[k] - v[j];
+        v[j] += dd;
+        res   = MG_MAX(res,fabs(dd));
+      }
+    }
+    if ( res < tol )  break;
+  }
+  if ( abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     displacement propagated, %d iter.\n",it);
+
+  _MMG5_DEL_MEM(mesh,nb,(mesh->np+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,s,3*(mesh->np+1)*sizeof(double));
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param disp pointer toward the displacement structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Enlarge the displacement field to the size of the point table (which may
+ * be reallocated by the swaps). The displacement of the new slots is null.
+ *
+ */
+static int _MMG5_lagsiz(MMG5_pMesh mesh,MMG5_pSol disp) {
+
+  if ( disp->npmax >= mesh->npmax )  return(1);
+
+  _MMG5_ADD_MEM(mesh,disp->size*(mesh->npmax-disp->npmax)*sizeof(double),
+                "larger displacement",return(0));
+  _MMG5_SAFE_RECALLOC(disp->m,disp->size*(disp->npmax+1)+1,
+                      disp->size*(mesh->npmax+1)+1,double,
+                      "larger displacement");
+  disp->npmax = mesh->npmax;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param lbad list of the degraded elements.
+ * \param nbad number of degraded elements.
+ * \return number of moved vertices.
+ *
+ * Relocate the internal vertices of the degraded elements that are still bad.
+ *
+ */
+static int _MMG5_movtetlag(MMG5_pMesh mesh,MMG5_pSol met,int *lbad,int nbad) {
+  MMG5_pTetra  pt;
+  MMG5_pPoint  ppt;
+  int          k,l,nm,ilist,list[_MMG5_LMAX+2];
+  char         i;
+
+  nm = 0;
+  ++mesh->base;
+  for (l=0; l<nbad; l++) {
+    k  = lbad[l];
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || pt->qual > _MMG5_LAGBAD )
+      continue;
+
+    for (i=0; i<4; i++) {
+      ppt = &mesh->point[pt->v[i]];
+      if ( ppt->flag == mesh->base || MG_SIN(ppt->tag) || (ppt->tag & MG_BDY) )
+        continue;
+      ppt->flag = mesh->base;
+
+      ilist = _MMG5_boulevolp(mesh,k,i,list);
+      if ( !ilist )  continue;
+      if ( _MMG5_movintpt(mesh,met,list,ilist,1) )  nm++;
+      if ( !MG_EOK(pt) )  break;
+    }
+  }
+  return(nm);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param u displacement field.
+ * \param lbad list of the degraded elements.
+ * \param nbad number of degraded elements.
+ * \param ns number of splitted edges.
+ * \param nc number of collapsed edges.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Split the longest internal edge of the degraded elements if it is too long
+ * and collapse their shortest internal edge if it is too short. The metric
+ * at the new vertices is interpolated by \ref _MMG5_intmet (isotropic or
+ * anisotropic).
+ *
+ */
+static int _MMG5_adptetlag(MMG5_pMesh mesh,MMG5_pSol met,double *u,
+                           int *lbad,int nbad,int *ns,int *nc) {
+  MMG5_pTetra  pt;
+  MMG5_pPoint  p0,p1;
+  double       len,lmax,lmin,o[3];
+  int          k,l,ip,ip1,ip2,ilist,ier,list[_MMG5_LMAX+2];
+  char         i,j,ia,imax,imin,i1,i2;
+
+  *ns = *nc = 0;
+  for (l=0; l<nbad; l++) {
+    k  = lbad[l];
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || pt->qual > _MMG5_LAGBAD )
+      continue;
+
+    imax = imin = -1;
+    lmax = 0.0;
+    lmin = DBL_MAX;
+    for (ia=0; ia<6; ia++) {
+      if ( pt->xt && mesh->xtetra[pt->xt].tag[ia] )  continue;
+      len = _MMG5_lenedg(mesh,met,pt->v[_MMG5_iare[ia][0]],
+                         pt->v[_MMG5_iare[ia][1]],0);
+      if ( len > lmax ) {
+        lmax = len;
+        imax = ia;
+      }
+      if ( len < lmin ) {
+        lmin = len;
+        imin = ia;
+      }
+    }
+
+    /* split the longest internal edge */
+    if ( imax >= 0 && lmax > _MMG5_LOPTL ) {
+      ip1 = pt->v[_MMG5_iare[imax][0]];
+      ip2 = pt->v[_MMG5_iare[imax][1]];
+      p0  = &mesh->point[ip1];
+      p1  = &mesh->point[ip2];
+      ilist = _MMG5_coquil(mesh,k,imax,list);
+      if ( ilist < 0 )  return(0);
+      if ( ilist && !(ilist%2) && !((p0->tag & MG_BDY) && (p1->tag & MG_BDY)) ) {
+        o[0] = 0.5*(p0->c[0] + p1->c[0]);
+        o[1] = 0.5*(p0->c[1] + p1->c[1]);
+        o[2] = 0.5*(p0->c[2] + p1->c[2]);
+        ip = _MMG5_newPt(mesh,o,MG_NOTAG);
+        if ( ip ) {
+          _MMG5_intmet(mesh,met,ip1,ip2,ip,0.5);
+          ier = _MMG5_split1b(mesh,met,list,ilist,ip,1);
+          if ( ier < 0 )  return(0);
+          else if ( !ier )  _MMG5_delPt(mesh,ip);
+          else {
+            for (j=1; j<=3; j++)
+              u[3*(ip-1)+j] = 0.5*(u[3*(ip1-1)+j] + u[3*(ip2-1)+j]);
+            (*ns)++;
+            continue;
+          }
+        }
+      }
+    }
+
+    /* collapse the shortest internal edge */
+    if ( imin >= 0 && lmin < _MMG5_LOPTS ) {
+      i  = _MMG5_ifar[imin][0];
+      if ( pt->xt && (mesh->xtetra[pt->xt].ftag[i] & MG_BDY) )
+        i = _MMG5_ifar[imin][1];
+      if ( pt->xt && (mesh->xtetra[pt->xt].ftag[i] & MG_BDY) )  continue;
+      j  = _MMG5_iarfinv[i][imin];
+      i1 = _MMG5_idir[i][_MMG5_inxt2[j]];
+      i2 = _MMG5_idir[i][_MMG5_iprv2[j]];
+      p0 = &mesh->point[pt->v[i1]];
+      if ( (p0->tag & MG_BDY) || MG_SIN(p0->tag) )  continue;
+
+      ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
+      if ( ilist > 0 ) {
+        ier = _MMG5_colver(mesh,met,list,ilist,i2);
+        if ( ier < 0 )  return(0);
+        else if ( ier ) {
+          _MMG5_PROF_INC(mesh,_MMG5_PC_colok);
+          _MMG5_delPt(mesh,ier);
+          (*nc)++;
+        }
+      }
+      else if ( ilist < 0 )  return(0);
+    }
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param lbad list of the degraded elements.
+ * \param nbad number of degraded elements.
+ * \return -1 if fail, the number of swaps otherwise.
+ *
+ * Flip the internal edges of the degraded elements that are still bad (as
+ * \ref _MMG5_swptet does on the whole mesh).
+ *
+ */
+static int _MMG5_swptetlag(MMG5_pMesh mesh,MMG5_pSol met,int *lbad,int nbad) {
+  MMG5_pTetra   pt;
+  MMG5_pxTetra  pxt;
+  int           list[_MMG5_LMAX+2],ilist,k,l,nconf,ns,ier;
+  char          i;
+
+  ns = 0;
+  for (l=0; l<nbad; l++) {
+    k  = lbad[l];
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) || pt->qual > _MMG5_LAGBAD )
+      continue;
+
+    for (i=0; i<6; i++) {
+      if ( pt->xt ) {
+        pxt = &mesh->xtetra[pt->xt];
+        if ( pxt->edg[i] || pxt->tag[i] ) continue;
+      }
+      nconf = _MMG5_chkswpgen(mesh,met,k,i,&ilist,list,1.053);
+      if ( nconf ) {
+        ier = _MMG5_swpgen(mesh,met,nconf,ilist,list,NULL);
+        if ( ier > 0 )  ns++;
+        else if ( ier < 0 )  return(-1);
+        break;
+      }
+    }
+  }
+  return(ns);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param u displacement field.
+ * \return -1 if fail, the number of modifications otherwise.
+ *
+ * Repair the elements whose quality collapses during a displacement step
+ * (mode \a mesh->info.lag: 0 = vertex relocation, 1 = and swaps, 2 = and
+ * splits/collapses). Only the bad elements whose quality has decreased since
+ * the previous step (stored in their qual field) are treated.
+ *
+ */
+static int _MMG5_replag(MMG5_pMesh mesh,MMG5_pSol met,double *u) {
+  MMG5_pTetra  pt;
+  double       qual;
+  int          *lbad,k,nemem,nbad,nm,nf,ns,nc;
+
+  nemem = mesh->ne+1;
+  _MMG5_ADD_MEM(mesh,nemem*sizeof(int),"degraded elements",return(-1));
+  _MMG5_SAFE_MALLOC(lbad,nemem,int);
+
+  nbad = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    qual = _MMG5_orcal(mesh,met,k);
+    if ( qual <= _MMG5_LAGBAD && qual < pt->qual )  lbad[nbad++] = k;
+    pt->qual = qual;
+  }
+
+  ns = nc = nf = nm = 0;
+  if ( nbad ) {
+    if ( mesh->info.lag > 1 && !mesh->info.noinsert ) {
+      if ( !_MMG5_adptetlag(mesh,met,u,lbad,nbad,&ns,&nc) ) {
+        _MMG5_DEL_MEM(mesh,lbad,nemem*sizeof(int));
+        return(-1);
+      }
+    }
+    if ( mesh->info.lag > 0 && !mesh->info.noswap ) {
+      nf = _MMG5_swptetlag(mesh,met,lbad,nbad);
+      if ( nf < 0 ) {
+        _MMG5_DEL_MEM(mesh,lbad,nemem*sizeof(int));
+        return(-1);
+      }
+    }
+    if ( !mesh->info.nomove )  nm = _MMG5_movtetlag(mesh,met,lbad,nbad);
+
+    if ( abs(mesh->info.imprim) > 4 )
+      fprintf(stdout,"     %8d degraded elements: %8d splitted, %8d collapsed,"
+              " %8d swapped, %8d moved\n",nbad,ns,nc,nf,nm);
+  }
+
+  _MMG5_DEL_MEM(mesh,lbad,nemem*sizeof(int));
+  return(ns+nc+nf+nm);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param disp pointer toward the displacement structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Lagrangian node displacement and meshing: move the vertices along the
+ * displacement by steps that keep the mesh valid and repair the elements
+ * degraded by each step.
+ *
+ */
+int _MMG5_mmg3d3(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met) {
+  double  *u;
+  int     k,it,t,nrep,nstep;
+
+  if ( abs(mesh->info.imprim) > 3 )
+    fprintf(stdout,"  ** LAGRANGIAN MOTION\n");
+
+  if ( !disp->m || disp->size != 3 ) {
+    fprintf(stdout,"  ## Error: no displacement field.\n");
+    return(0);
+  }
+  u = disp->m;
+
+  if ( !met->m && !_MMG5_DoSol(mesh,met) )  return(0);
+
+  if ( !_MMG5_ppgdisp(mesh,u) || !_MMG5_lapantilap(mesh,u) )  return(0);
+
+  for (k=1; k<=mesh->np; k++)
+    mesh->point[k].tmp = 0;
+
+  /* qualities before the first step */
+  for (k=1; k<=mesh->ne; k++)
+    if ( MG_EOK(&mesh->tetra[k]) )
+      mesh->tetra[k].qual = _MMG5_orcal(mesh,met,k);
+
+  nstep = 0;
+  t     = 0;
+  for (it=0; it<_MMG5_LAGMAXIT; it++) {
+    t = _MMG5_dichodisp(mesh,u);
+    if ( t )  nstep++;
+
+    nrep = _MMG5_replag(mesh,met,u);
+    if ( nrep < 0 || !_MMG5_lagsiz(mesh,disp) ) {
+      fprintf(stdout,"  ## Error: unable to repair the mesh.\n");
+      return(0);
+    }
+    u = disp->m;
+    if ( t == _MMG5_SHORTMAX )  break;
+    else if ( !t && !nrep ) {
+      fprintf(stdout,"  ## Warning: unable to complete the displacement.\n");
+      break;
+    }
+  }
 
-/** Lagragian node displacement and meshing */
-int _MMG5_mmg3d3(MMG5_pMesh mesh,MMG5_pSol disp) {
-    if ( abs(mesh->info.imprim) > 3 )
-        fprintf(stdout,"  ** LAGRANGIAN MOTION\n");
+  /* update the normals at the moved boundary points */
+  if ( !_MMG5_updnor(mesh) && abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"  ## Warning: geometry of the moved ridge or corner"
+            " points not updated.\n");
 
-    /* Clean memory (but not pointer) */
-    _MMG5_DEL_MEM(mesh,disp->m,(disp->size*disp->npmax+1)*sizeof(double));
-    _MMG5_DEL_MEM(mesh,disp,sizeof(MMG5_pSol));
+  if ( abs(mesh->info.imprim) > 3 )
+    fprintf(stdout,"     %d displacement steps, %.0f%% of the last one\n",nstep,
+            100.0*t/_MMG5_SHORTMAX);
 
-    return(1);
-}
\ No newline at end of file
+  return(t == _MMG5_SHORTMAX);
+}
@@ -35,18 +35,33 @@
 
 #include "mmg3d.h"
 
+/**
+ * \param met pointer toward the metric structure.
+ * \param ip index of the moved point.
+ *
+ * Copy the metric at \a ip in the slot of the virtual point 0 used to
+ * evaluate the quality of the elements in the new configuration.
+ *
+ */
+static inline void _MMG5_movmet0(MMG5_pSol met,int ip) {
+  if ( met && met->m && met->size == 6 )
+    memcpy(&met->m[1],&met->m[6*ip+1],6*sizeof(double));
+}
+
 
-/** Move internal point */
-int _MMG5_movintpt(MMG5_pMesh mesh,int *list,int ilist,int improve) {
-  MMG5_pTetra               pt,pt0;
+/** Move internal point ; ani = 1 to measure the qualities in the aniso metric */
+static _MMG5_ALWAYS_INLINE int
+_MMG5_movintpt_spe(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,
+                   int improve,const char ani) {
+  MMG5_pTetra               pt;
   MMG5_pPoint               p0,p1,p2,p3,ppt0;
   double               vol,totvol;
   double               calold,calnew,callist[ilist];
-  int                  k,iel,i0;
+  int                  k,l,nb,iel,i0,vb[4*_MMG5_BATCH];
 
-  pt0    = &mesh->tetra[0];
   ppt0 = &mesh->point[0];
   ppt0->c[0] = ppt0->c[1] = ppt0->c[2] = 0.0;
+  _MMG5_movmet0(met,mesh->tetra[list[0]/4].v[list[0]%4]);
 
   /* Coordinates of optimal point */
   calold = DBL_MAX;
@@ -74,15 +89,20 @@ int _MMG5_movintpt(MMG5_pMesh mesh,int *list,int ilist,int improve) {
 
   /* Check new position validity */
   calnew = DBL_MAX;
-  for (k=0; k<ilist; k++) {
-    iel = list[k] / 4;
-    i0  = list[k] % 4;
-    pt  = &mesh->tetra[iel];
-    memcpy(pt0,pt,sizeof(MMG5_Tetra));
-    pt0->v[i0] = 0;
-    callist[k] = _MMG5_orcal(mesh,0);
-    if ( callist[k] < _MMG5_EPSD2 )        return(0);
-    calnew = MG_MIN(calnew,callist[k]);
+  for (k=0; k<ilist; k+=_MMG5_BATCH) {
+    nb = MG_MIN(_MMG5_BATCH,ilist-k);
+    for (l=0; l<nb; l++) {
+      iel = list[k+l] / 4;
+      i0  = list[k+l] % 4;
+      pt  = &mesh->tetra[iel];
+      memcpy(&vb[4*l],pt->v,4*sizeof(int));
+      vb[4*l+i0] = 0;
+    }
+    _MMG5_caltet_batch(mesh,ani ? met : NULL,vb,nb,&callist[k]);
+    for (l=0; l<nb; l++) {
+      if ( callist[k+l] < _MMG5_EPSD2 )        return(0);
+      calnew = MG_MIN(calnew,callist[k+l]);
+    }
   }
   if ( calold < _MMG5_NULKAL && calnew <= calold )    return(0);
   else if (calnew < _MMG5_NULKAL) return(0);
@@ -101,6 +121,18 @@ int _MMG5_movintpt(MMG5_pMesh mesh,int *list,int ilist,int improve) {
   return(1);
 }
 
+/** iso. instance of \ref _MMG5_movintpt_spe */
+int _MMG5_movintpt_iso(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,
+                       int improve) {
+  return(_MMG5_movintpt_spe(mesh,met,list,ilist,improve,0));
+}
+
+/** aniso. instance of \ref _MMG5_movintpt_spe */
+int _MMG5_movintpt_ani(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,
+                       int improve) {
+  return(_MMG5_movintpt_spe(mesh,met,list,ilist,improve,1));
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
@@ -394,6 +426,7 @@ int _MMG5_movbdyregpt(MMG5_pMesh mesh, MMG5_pSol met,int *listv,
   ppt0->c[0] = o[0];
   ppt0->c[1] = o[1];
   ppt0->c[2] = o[2];
+  _MMG5_movmet0(met,mesh->tetra[listv[0]/4].v[listv[0]%4]);
 
   ppt0->tag      = p0->tag;
   ppt0->ref      = p0->ref;
@@ -444,7 +477,7 @@ int _MMG5_movbdyregpt(MMG5_pMesh mesh, MMG5_pSol met,int *listv,
     memcpy(pt0,pt,sizeof(MMG5_Tetra));
     pt0->v[i0] = 0;
     calold = MG_MIN(calold, pt->qual);
-    callist[l]=_MMG5_orcal(mesh,0);
+    callist[l]=_MMG5_orcal(mesh,met,0);
     if ( callist[l] < _MMG5_EPSD )        return(0);
     calnew = MG_MIN(calnew,callist[l]);
   }
@@ -672,6 +705,7 @@ int _MMG5_movbdyrefpt(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
   ppt0->c[0] = o[0];
   ppt0->c[1] = o[1];
   ppt0->c[2] = o[2];
+  _MMG5_movmet0(met,mesh->tetra[listv[0]/4].v[listv[0]%4]);
   ppt0->tag  = p0->tag;
   ppt0->ref  = p0->ref;
 
@@ -732,7 +766,7 @@ int _MMG5_movbdyrefpt(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
     memcpy(pt0,pt,sizeof(MMG5_Tetra));
     pt0->v[i0] = 0;
     calold = MG_MIN(calold, pt->qual);
-    callist[l] = _MMG5_orcal(mesh,0);
+    callist[l] = _MMG5_orcal(mesh,met,0);
     if ( callist[l] < _MMG5_EPSD )        return(0);
     calnew = MG_MIN(calnew,callist[l]);
   }
@@ -965,6 +999,7 @@ int _MMG5_movbdynompt(MMG5_pMesh mesh,MMG5_pSol met, int *listv,
   ppt0->c[0] = o[0];
   ppt0->c[1] = o[1];
   ppt0->c[2] = o[2];
+  _MMG5_movmet0(met,mesh->tetra[listv[0]/4].v[listv[0]%4]);
   ppt0->tag  = p0->tag;
   ppt0->ref  = p0->ref;
 
@@ -1026,7 +1061,7 @@ int _MMG5_movbdynompt(MMG5_pMesh mesh,MMG5_pSol met, int *listv,
     memcpy(pt0,pt,sizeof(MMG5_Tetra));
     pt0->v[i0] = 0;
     calold = MG_MIN(calold, pt->qual);
-    callist[l]= _MMG5_orcal(mesh,0);
+    callist[l]= _MMG5_orcal(mesh,met,0);
     if ( callist[l] < _MMG5_EPSD )        return(0);
     calnew = MG_MIN(calnew,callist[l]);
   }
@@ -1263,6 +1298,7 @@ int _MMG5_movbdyridpt(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
   ppt0->c[0] = o[0];
   ppt0->c[1] = o[1];
   ppt0->c[2] = o[2];
+  _MMG5_movmet0(met,mesh->tetra[listv[0]/4].v[listv[0]%4]);
   ppt0->tag      = p0->tag;
   ppt0->ref      = p0->ref;
 
@@ -1327,7 +1363,7 @@ int _MMG5_movbdyridpt(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
     memcpy(pt0,pt,sizeof(MMG5_Tetra));
     pt0->v[i0] = 0;
     calold = MG_MIN(calold, pt->qual);
-    callist[l]=_MMG5_orcal(mesh,0);
+    callist[l]=_MMG5_orcal(mesh,met,0);
     if ( callist[l] < _MMG5_EPSD )        return(0);
     calnew = MG_MIN(calnew,callist[l]);
   }
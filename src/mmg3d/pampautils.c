@@ -148,8 +148,15 @@ void _MMG5_usage(char *prog) {
 
   _MMG5_mmgUsage(prog);
 
-  // fprintf(stdout,"-lag [0/1/2] Lagrangian mesh displacement according to mode 0/1/2\n");
+  fprintf(stdout,"-lag [0/1/2] Lagrangian mesh displacement according to mode 0/1/2\n");
   fprintf(stdout,"-ls     val  create mesh of isovalue val\n");
+  fprintf(stdout,"-lsband n    remesh only the vertex ring of the isovalue grown by n layers of elements\n");
+  fprintf(stdout,"-lssurf file create mesh of the surface mesh file (signed distance as level-set)\n");
+  fprintf(stdout,"-hess   val  anisotropic metric from the Hessian of the input scalar field, for the error val\n");
+  fprintf(stdout,"-hessiso val isotropic metric from the Hessian of the input scalar field, for the error val\n");
+  fprintf(stdout,"-nelem  n    scale the metric to produce about n elements\n");
+  fprintf(stdout,"-tmax   val  stop the remeshing after val seconds (wall-clock)\n");
+  fprintf(stdout,"-prof  file  save the timers and counters of the run in file (JSON)\n");
   fprintf(stdout,"-optim       mesh optimization\n");
   fprintf(stdout,"-noswap      no edge or face flipping\n");
   fprintf(stdout,"-nomove      no point relocation\n");
@@ -157,6 +164,8 @@ void _MMG5_usage(char *prog) {
 #ifndef PATTERN
   fprintf(stdout,"-bucket val  Specify the size of bucket per dimension \n");
 #endif
+  fprintf(stdout,"-ckpt file   save the working state in file at each adaptation pass\n");
+  fprintf(stdout,"-restart file  restart from the checkpoint file\n");
 #ifdef USE_SCOTCH
   fprintf(stdout,"-rn [n]      Turn on or off the renumbering using SCOTCH [1/0] \n");
 #endif
@@ -226,6 +235,18 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
             exit(EXIT_FAILURE);
         break;
 #endif
+      case 'c':
+        if ( !strcmp(argv[i],"-ckpt") ) {
+          if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
+            if ( !MMG5_Set_checkpointName(mesh,argv[i]) )
+              exit(EXIT_FAILURE);
+          }
+          else {
+            fprintf(stderr,"Missing filname for %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
+        break;
       case 'd':  /* debug */
         if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_debug,1) )
           exit(EXIT_FAILURE);
@@ -251,6 +272,15 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
                                     atof(argv[i])) )
             exit(EXIT_FAILURE);
         }
+        else if ( (!strcmp(argv[i],"-hess") || !strcmp(argv[i],"-hessiso"))
+                  && ++i < argc ) {
+          if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_hessian,
+                                    strcmp(argv[i-1],"-hess") ? 1 : 6) )
+            exit(EXIT_FAILURE);
+          if ( !MMG5_Set_dparameter(mesh,met,MMG5_DPARAM_hessErr,
+                                    atof(argv[i])) )
+            exit(EXIT_FAILURE);
+        }
         else
           _MMG5_usage(argv[0]);
         break;
@@ -297,6 +327,28 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
           }
           else i--;
         }
+        else if ( !strcmp(argv[i],"-lsband") ) {
+          if ( ++i < argc && isdigit(argv[i][0]) ) {
+            if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_lsband,atoi(argv[i])) )
+              exit(EXIT_FAILURE);
+          }
+          else {
+            fprintf(stderr,"Missing argument option %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
+        else if ( !strcmp(argv[i],"-lssurf") ) {
+          if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
+            if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_iso,1) )
+              exit(EXIT_FAILURE);
+            if ( !MMG5_Set_distanceMeshName(mesh,argv[i]) )
+              exit(EXIT_FAILURE);
+          }
+          else {
+            fprintf(stderr,"Missing filname for %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
         break;
       case 'm':  /* memory */
         if ( ++i < argc && isdigit(argv[i][0]) ) {
@@ -325,6 +377,16 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
           if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_nomove,1) )
             exit(EXIT_FAILURE);
         }
+        else if ( !strcmp(argv[i],"-nelem") ) {
+          if ( ++i < argc && isdigit(argv[i][0]) ) {
+            if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_nelem,atoi(argv[i])) )
+              exit(EXIT_FAILURE);
+          }
+          else {
+            fprintf(stderr,"Missing argument option %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
         break;
       case 'o':
         if ( !strcmp(argv[i],"-out") ) {
@@ -342,9 +404,37 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
             exit(EXIT_FAILURE);
         }
         break;
-#ifdef USE_SCOTCH
+      case 'p':
+        if ( !strcmp(argv[i],"-prof") ) {
+          if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
+            if ( !MMG5_Set_profileName(mesh,argv[i]) )
+              exit(EXIT_FAILURE);
+          }
+          else {
+            fprintf(stderr,"Missing filname for %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
+        break;
       case 'r':
-        if ( !strcmp(argv[i],"-rn") ) {
+        if ( !strcmp(argv[i],"-restart") ) {
+          if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
+            /* the checkpoint replaces the input mesh */
+            if ( !MMG5_Set_inputMeshName(mesh,argv[i]) )
+              exit(EXIT_FAILURE);
+            mesh->info.restart = 1;
+            if ( mesh->info.imprim == -99 ) {
+              if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_verbose,5) )
+                exit(EXIT_FAILURE);
+            }
+          }
+          else {
+            fprintf(stderr,"Missing filname for %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
+#ifdef USE_SCOTCH
+        else if ( !strcmp(argv[i],"-rn") ) {
           if ( ++i < argc ) {
             if ( isdigit(argv[i][0]) ) {
               if ( !MMG5_Set_iparameter(mesh,met,MMG5_IPARAM_renum,atoi(argv[i])) )
@@ -360,8 +450,8 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
             _MMG5_usage(argv[0]);
           }
         }
-        break;
 #endif
+        break;
       case 's':
         if ( !strcmp(argv[i],"-sol") ) {
           if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
@@ -374,6 +464,18 @@ int MMG5_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
           }
         }
         break;
+      case 't':
+        if ( !strcmp(argv[i],"-tmax") ) {
+          if ( ++i < argc && (isdigit(argv[i][0]) || argv[i][0]=='.') ) {
+            if ( !MMG5_Set_dparameter(mesh,met,MMG5_DPARAM_timeMax,atof(argv[i])) )
+              exit(EXIT_FAILURE);
+          }
+          else {
+            fprintf(stderr,"Missing argument option %s\n",argv[i-1]);
+            _MMG5_usage(argv[0]);
+          }
+        }
+        break;
       case 'v':
         if ( ++i < argc ) {
           if ( argv[i][0] == '-' || isdigit(argv[i][0]) ) {
@@ -579,7 +681,7 @@ int MMG5_mmg3dcheck(MMG5_pMesh mesh,MMG5_pSol met,
 
   if ( met->np && (met->np != mesh->np) ) {
     fprintf(stdout,"  ## WARNING: WRONG SOLUTION NUMBER. IGNORED\n");
-    _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
+    _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
     met->np = 0;
   }
   else if ( met->size!=1 ) {
@@ -625,19 +727,27 @@ int MMG5_mmg3dcheck(MMG5_pMesh mesh,MMG5_pSol met,
  */
 void MMG5_searchqua(MMG5_pMesh mesh,MMG5_pSol met,double critmin, int *eltab) {
   MMG5_pTetra   pt;
-  double   rap;
-  int      k;
+  double   rap,qb[_MMG5_BATCH];
+  int      k,j,nb,kb[_MMG5_BATCH],vb[4*_MMG5_BATCH];
 
-  for (k=1; k<=mesh->ne; k++) {
-    pt = &mesh->tetra[k];
+  for (k=1; k<=mesh->ne; k+=_MMG5_BATCH) {
+    nb = 0;
+    for (j=k; j<=MG_MIN(mesh->ne,k+_MMG5_BATCH-1); j++) {
+      pt = &mesh->tetra[j];
+
+      if( !MG_EOK(pt) )
+        continue;
 
-    if( !MG_EOK(pt) )
-      continue;
+      memcpy(&vb[4*nb],pt->v,4*sizeof(int));
+      kb[nb++] = j;
+    }
+    _MMG5_caltet_batch(mesh,met,vb,nb,qb);
 
-    rap = _MMG5_ALPHAD *
-      _MMG5_caltet(mesh,met,pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
-    if ( rap == 0.0 || rap < critmin ) {
-      eltab[k] = 1;
+    for (j=0; j<nb; j++) {
+      rap = _MMG5_ALPHAD * qb[j];
+      if ( rap == 0.0 || rap < critmin ) {
+        eltab[kb[j]] = 1;
+      }
     }
   }
   return;
@@ -657,8 +767,7 @@ void MMG5_searchqua(MMG5_pMesh mesh,MMG5_pSol met,double critmin, int *eltab) {
  *
  */
 inline double _MMG5_lenedgCoor_ani(double *ca,double *cb,double *sa,double *sb) {
-  fprintf(stdout,"under develop : first thing to do\n");
-  return(0.0);
+  return(_MMG5_lenedgCoor33_ani(ca,cb,sa,sb));
 }
 
 /**
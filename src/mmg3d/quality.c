@@ -37,124 +37,6 @@
 
 extern char ddb;
 
-/** compute tetra oriented quality of iel (return 0.0 when element is inverted) */
-inline double _MMG5_orcal(MMG5_pMesh mesh,int iel) {
-  MMG5_pTetra     pt;
-  double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
-  double     vol,v1,v2,v3,rap;
-  double     *a,*b,*c,*d;
-
-  pt = &mesh->tetra[iel];
-  a = mesh->point[pt->v[0]].c;
-  b = mesh->point[pt->v[1]].c;
-  c = mesh->point[pt->v[2]].c;
-  d = mesh->point[pt->v[3]].c;
-
-  /* volume */
-  abx = b[0] - a[0];
-  aby = b[1] - a[1];
-  abz = b[2] - a[2];
-  rap = abx*abx + aby*aby + abz*abz;
-
-  acx = c[0] - a[0];
-  acy = c[1] - a[1];
-  acz = c[2] - a[2];
-  rap += acx*acx + acy*acy + acz*acz;
-
-  adx = d[0] - a[0];
-  ady = d[1] - a[1];
-  adz = d[2] - a[2];
-  rap += adx*adx + ady*ady + adz*adz;
-
-  v1  = acy*adz - acz*ady;
-  v2  = acz*adx - acx*adz;
-  v3  = acx*ady - acy*adx;
-  vol = abx * v1 + aby * v2 + abz * v3;
-
-  if ( vol < _MMG5_EPSD2 )  return(0.0);
-
-  bcx = c[0] - b[0];
-  bcy = c[1] - b[1];
-  bcz = c[2] - b[2];
-  rap += bcx*bcx + bcy*bcy + bcz*bcz;
-
-  bdx = d[0] - b[0];
-  bdy = d[1] - b[1];
-  bdz = d[2] - b[2];
-  rap += bdx*bdx + bdy*bdy + bdz*bdz;
-
-  cdx = d[0] - c[0];
-  cdy = d[1] - c[1];
-  cdz = d[2] - c[2];
-  rap += cdx*cdx + cdy*cdy + cdz*cdz;
-  if ( rap < _MMG5_EPSD2 )  return(0.0);
-
-  /* quality = vol / len^3/2 */
-  rap = rap * sqrt(rap);
-
-  return(vol / rap);
-}
-
-
-/** compute tetra quality iso */
-inline double _MMG5_caltet_iso(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id) {
-  double     abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
-  double     vol,v1,v2,v3,rap;
-  double    *a,*b,*c,*d;
-
-  a = mesh->point[ia].c;
-  b = mesh->point[ib].c;
-  c = mesh->point[ic].c;
-  d = mesh->point[id].c;
-
-  /* volume */
-  abx = b[0] - a[0];
-  aby = b[1] - a[1];
-  abz = b[2] - a[2];
-  rap = abx*abx + aby*aby + abz*abz;
-
-  acx = c[0] - a[0];
-  acy = c[1] - a[1];
-  acz = c[2] - a[2];
-  rap += acx*acx + acy*acy + acz*acz;
-
-  adx = d[0] - a[0];
-  ady = d[1] - a[1];
-  adz = d[2] - a[2];
-  rap += adx*adx + ady*ady + adz*adz;
-
-  v1  = acy*adz - acz*ady;
-  v2  = acz*adx - acx*adz;
-  v3  = acx*ady - acy*adx;
-  vol = abx * v1 + aby * v2 + abz * v3;
-  if ( vol < _MMG5_EPSD2 )  return(0.0);
-
-  bcx = c[0] - b[0];
-  bcy = c[1] - b[1];
-  bcz = c[2] - b[2];
-  rap += bcx*bcx + bcy*bcy + bcz*bcz;
-
-  bdx = d[0] - b[0];
-  bdy = d[1] - b[1];
-  bdz = d[2] - b[2];
-  rap += bdx*bdx + bdy*bdy + bdz*bdz;
-
-  cdx = d[0] - c[0];
-  cdy = d[1] - c[1];
-  cdz = d[2] - c[2];
-  rap += cdx*cdx + cdy*cdy + cdz*cdz;
-  if ( rap < _MMG5_EPSD2 )  return(0.0);
-
-  /* quality = vol / len^3/2 */
-  rap = rap * sqrt(rap);
-  return(vol / rap);
-}
-
-
-inline double _MMG5_caltet_ani(MMG5_pMesh mesh,MMG5_pSol met,int ia,int ib,int ic,int id) {
-  return(0.0);
-}
-
 /* identify type of element :
    ityp= 0: 4 faces bonnes          (elt ok)
    1: 4 faces bonnes, vol nul (sliver) ou "quasi sliver" ie 4 faces ok
@@ -462,7 +344,7 @@ int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
       /*treat bad elt*/
       /*1) try to swp one edge*/
       for(i=0 ; i<6 ; i++) {
-        nconf = _MMG5_chkswpgen(mesh,k,i,&ilist,list,1.01);
+        nconf = _MMG5_chkswpgen(mesh,met,k,i,&ilist,list,1.01);
         if ( nconf ) {
           ns++;
           if(!_MMG5_swpgen(mesh,met,nconf,ilist,list,NULL)) return(-1);
@@ -481,6 +363,241 @@ int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
   return(nd);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param v vertices of the tetra (4 indices per tetra).
+ * \param n number of tetra (at most \ref _MMG5_BATCH).
+ * \param qual computed qualities.
+ *
+ * Euclidean qualities of a block of tetra (see \ref _MMG5_caltet_batch).
+ *
+ */
+_MMG5_TARGET_CLONES
+static void _MMG5_caltetblk_iso(MMG5_pMesh mesh,int *v,int n,double *qual) {
+  double   c[12][_MMG5_BATCH],*p;
+  double   abx,aby,abz,acx,acy,acz,adx,ady,adz,bcx,bcy,bcz,bdx,bdy,bdz,cdx,cdy,cdz;
+  double   vol,v1,v2,v3,rap;
+  int      l;
+  char     i,ok;
+
+  /* gather the coordinates in contiguous arrays */
+  for (l=0; l<n; l++) {
+    for (i=0; i<4; i++) {
+      p = mesh->point[v[4*l+i]].c;
+      c[3*i  ][l] = p[0];
+      c[3*i+1][l] = p[1];
+      c[3*i+2][l] = p[2];
+    }
+  }
+
+  /* same operations than _MMG5_caltet_iso */
+  for (l=0; l<n; l++) {
+    abx = c[3][l] - c[0][l];
+    aby = c[4][l] - c[1][l];
+    abz = c[5][l] - c[2][l];
+    rap = abx*abx + aby*aby + abz*abz;
+
+    acx = c[6][l] - c[0][l];
+    acy = c[7][l] - c[1][l];
+    acz = c[8][l] - c[2][l];
+    rap += acx*acx + acy*acy + acz*acz;
+
+    adx = c[9][l]  - c[0][l];
+    ady = c[10][l] - c[1][l];
+    adz = c[11][l] - c[2][l];
+    rap += adx*adx + ady*ady + adz*adz;
+
+    v1  = acy*adz - acz*ady;
+    v2  = acz*adx - acx*adz;
+    v3  = acx*ady - acy*adx;
+    vol = abx * v1 + aby * v2 + abz * v3;
+
+    bcx = c[6][l] - c[3][l];
+    bcy = c[7][l] - c[4][l];
+    bcz = c[8][l] - c[5][l];
+    rap += bcx*bcx + bcy*bcy + bcz*bcz;
+
+    bdx = c[9][l]  - c[3][l];
+    bdy = c[10][l] - c[4][l];
+    bdz = c[11][l] - c[5][l];
+    rap += bdx*bdx + bdy*bdy + bdz*bdz;
+
+    cdx = c[9][l]  - c[6][l];
+    cdy = c[10][l] - c[7][l];
+    cdz = c[11][l] - c[8][l];
+    rap += cdx*cdx + cdy*cdy + cdz*cdz;
+
+    /* null quality for inverted or degenerated elements, without branch */
+    ok  = ( vol >= _MMG5_EPSD2 ) & ( rap >= _MMG5_EPSD2 );
+    vol = ok ? vol : 0.0;
+    rap = ok ? rap : 1.0;
+    rap = rap * sqrt(rap);
+    qual[l] = vol / rap;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param v vertices of the tetra (4 indices per tetra).
+ * \param n number of tetra (at most \ref _MMG5_BATCH).
+ * \param qual computed qualities.
+ *
+ * Anisotropic qualities of a block of tetra (see \ref _MMG5_caltet_batch).
+ *
+ */
+_MMG5_TARGET_CLONES
+static void _MMG5_caltetblk_ani(MMG5_pMesh mesh,MMG5_pSol met,int *v,int n,
+                                double *qual) {
+  double   c[12][_MMG5_BATCH],mm[6][_MMG5_BATCH],*p,*m;
+  double   u[6][3],mu[6],vol,det,rap;
+  int      l;
+  char     i,j,ok;
+
+  /* gather the coordinates and the mean metrics in contiguous arrays */
+  for (l=0; l<n; l++) {
+    for (j=0; j<6; j++)  mm[j][l] = 0.0;
+    for (i=0; i<4; i++) {
+      p = mesh->point[v[4*l+i]].c;
+      c[3*i  ][l] = p[0];
+      c[3*i+1][l] = p[1];
+      c[3*i+2][l] = p[2];
+      m = &met->m[6*v[4*l+i]+1];
+      for (j=0; j<6; j++)  mm[j][l] += 0.25*m[j];
+    }
+  }
+
+  /* same operations than _MMG5_caltet_ani */
+  for (l=0; l<n; l++) {
+    for (j=0; j<3; j++) {
+      u[0][j] = c[3+j][l] - c[j][l];
+      u[1][j] = c[6+j][l] - c[j][l];
+      u[2][j] = c[9+j][l] - c[j][l];
+      u[3][j] = c[6+j][l] - c[3+j][l];
+      u[4][j] = c[9+j][l] - c[3+j][l];
+      u[5][j] = c[9+j][l] - c[6+j][l];
+    }
+    for (j=0; j<6; j++)  mu[j] = mm[j][l];
+
+    vol = u[0][0] * (u[1][1]*u[2][2] - u[1][2]*u[2][1])
+      + u[0][1] * (u[1][2]*u[2][0] - u[1][0]*u[2][2])
+      + u[0][2] * (u[1][0]*u[2][1] - u[1][1]*u[2][0]);
+
+    det = mu[0] * (mu[3]*mu[5] - mu[4]*mu[4])
+      - mu[1] * (mu[1]*mu[5] - mu[2]*mu[4])
+      + mu[2] * (mu[1]*mu[4] - mu[2]*mu[3]);
+
+    rap = 0.0;
+    for (i=0; i<6; i++) {
+      rap += mu[0]*u[i][0]*u[i][0] + mu[3]*u[i][1]*u[i][1] + mu[5]*u[i][2]*u[i][2]
+        + 2.0*(mu[1]*u[i][0]*u[i][1] + mu[2]*u[i][0]*u[i][2] + mu[4]*u[i][1]*u[i][2]);
+    }
+
+    ok  = ( vol >= _MMG5_EPSD2 ) & ( det >= _MMG5_EPSD2 ) & ( rap >= _MMG5_EPSD2 );
+    vol = ok ? vol : 0.0;
+    det = ok ? det : 1.0;
+    rap = ok ? rap : 1.0;
+    vol *= sqrt(det);
+    rap = rap * sqrt(rap);
+    qual[l] = vol / rap;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure (NULL for the euclidean
+ * quality).
+ * \param v vertices of the tetra (4 indices per tetra).
+ * \param n number of tetra.
+ * \param qual computed qualities.
+ *
+ * Compute the qualities of \a n tetra (same values than \ref _MMG5_orcal):
+ * the tetra are processed by blocks of \ref _MMG5_BATCH whose coordinates
+ * are first gathered in contiguous arrays, so that the quality loops
+ * vectorize.
+ *
+ */
+void _MMG5_caltet_batch(MMG5_pMesh mesh,MMG5_pSol met,int *v,int n,double *qual) {
+  int      k,nb;
+
+  for (k=0; k<n; k+=_MMG5_BATCH) {
+    nb = MG_MIN(_MMG5_BATCH,n-k);
+    if ( met && met->m && met->size == 6 )
+      _MMG5_caltetblk_ani(mesh,met,&v[4*k],nb,&qual[k]);
+    else
+      _MMG5_caltetblk_iso(mesh,&v[4*k],nb,&qual[k]);
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param e extremities of the edges (2 indices per edge).
+ * \param n number of edges.
+ * \param len computed lengths.
+ *
+ * Compute the lengths of \a n edges in the metric (same values than \ref
+ * _MMG5_lenedg33_iso and \ref _MMG5_lenedg33_ani), by blocks of \ref
+ * _MMG5_BATCH edges gathered in contiguous arrays.
+ *
+ */
+_MMG5_TARGET_CLONES
+void _MMG5_lenedg_batch(MMG5_pMesh mesh,MMG5_pSol met,int *e,int n,double *len) {
+  double   c[6][_MMG5_BATCH],h[12][_MMG5_BATCH],*p,*m;
+  double   ux,uy,uz,dd1,dd2,ddm,sm[6],l,r;
+  int      k,nb,i;
+  char     j;
+
+  for (k=0; k<n; k+=_MMG5_BATCH) {
+    nb = MG_MIN(_MMG5_BATCH,n-k);
+
+    for (i=0; i<nb; i++) {
+      p = mesh->point[e[2*(k+i)]].c;
+      c[0][i] = p[0];  c[1][i] = p[1];  c[2][i] = p[2];
+      p = mesh->point[e[2*(k+i)+1]].c;
+      c[3][i] = p[0];  c[4][i] = p[1];  c[5][i] = p[2];
+    }
+
+    if ( met->size == 6 ) {
+      for (i=0; i<nb; i++) {
+        m = &met->m[6*e[2*(k+i)]+1];
+        for (j=0; j<6; j++)  h[j][i] = m[j];
+        m = &met->m[6*e[2*(k+i)+1]+1];
+        for (j=0; j<6; j++)  h[6+j][i] = m[j];
+      }
+      for (i=0; i<nb; i++) {
+        ux = c[3][i] - c[0][i];
+        uy = c[4][i] - c[1][i];
+        uz = c[5][i] - c[2][i];
+        for (j=0; j<6; j++)  sm[j] = 0.5*(h[j][i] + h[6+j][i]);
+
+        dd1 =      h[0][i]*ux*ux + h[3][i]*uy*uy + h[5][i]*uz*uz
+          + 2.0*(h[1][i]*ux*uy + h[2][i]*ux*uz + h[4][i]*uy*uz);
+        dd2 =      h[6][i]*ux*ux + h[9][i]*uy*uy + h[11][i]*uz*uz
+          + 2.0*(h[7][i]*ux*uy + h[8][i]*ux*uz + h[10][i]*uy*uz);
+        ddm =      sm[0]*ux*ux + sm[3]*uy*uy + sm[5]*uz*uz
+          + 2.0*(sm[1]*ux*uy + sm[2]*ux*uz + sm[4]*uy*uz);
+
+        len[k+i] = (sqrt(MG_MAX(0.0,dd1)) + 4.0*sqrt(MG_MAX(0.0,ddm))
+                    + sqrt(MG_MAX(0.0,dd2))) / 6.0;
+      }
+    }
+    else {
+      for (i=0; i<nb; i++) {
+        h[0][i] = met->m[e[2*(k+i)]];
+        h[1][i] = met->m[e[2*(k+i)+1]];
+      }
+      for (i=0; i<nb; i++) {
+        l = (c[3][i]-c[0][i])*(c[3][i]-c[0][i]) + (c[4][i]-c[1][i])*(c[4][i]-c[1][i])
+          + (c[5][i]-c[2][i])*(c[5][i]-c[2][i]);
+        l = sqrt(l);
+        r = h[1][i] / h[0][i] - 1.0;
+        len[k+i] = fabs(r) < _MMG5_EPS ? l / h[0][i] : l / (h[1][i]-h[0][i]) * log(r+1.0);
+      }
+    }
+  }
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
@@ -491,10 +608,9 @@ int _MMG5_badelt(MMG5_pMesh mesh,MMG5_pSol met) {
  */
 int _MMG5_prilen(MMG5_pMesh mesh, MMG5_pSol met) {
   MMG5_pTetra     pt;
-  MMG5_pxTetra    pxt;
   _MMG5_Hash      hash;
-  double          len,avlen,lmin,lmax;
-  int             k,np,nq,amin,bmin,amax,bmax,ned,hl[9];
+  double          len,avlen,lmin,lmax,lb[_MMG5_BATCH];
+  int             k,j,np,nq,amin,bmin,amax,bmax,ned,nb,hl[9],eb[2*_MMG5_BATCH];
   char            ia,i0,i1,ier,i;
   static double   bd[9]= {0.0, 0.3, 0.6, 0.7071, 0.9, 1.3, 1.4142, 2.0, 5.0};
   //{0.0, 0.2, 0.5, 0.7071, 0.9, 1.111, 1.4142, 2.0, 5.0};
@@ -527,50 +643,59 @@ int _MMG5_prilen(MMG5_pMesh mesh, MMG5_pSol met) {
     }
   }
 
-  /* Pop edges from hash table, and analyze their length */
-  for(k=1; k<=mesh->ne; k++) {
-    pt = &mesh->tetra[k];
-    if ( !MG_EOK(pt) ) continue;
-    pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
+  /* Pop edges from hash table by blocks, and analyze their length */
+  k = 1;
+  while ( k<=mesh->ne ) {
+    nb = 0;
+    for ( ; k<=mesh->ne && nb<=_MMG5_BATCH-6; k++) {
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) ) continue;
+
+      for(ia=0; ia<6; ia++) {
+        i0 = _MMG5_iare[ia][0];
+        i1 = _MMG5_iare[ia][1];
+        np = pt->v[i0];
+        nq = pt->v[i1];
+
+        /* Remove edge from hash ; ier = 1 if edge has been found */
+        ier = _MMG5_hashPop(&hash,np,nq);
+        if( ier ) {
+          eb[2*nb]   = np;
+          eb[2*nb+1] = nq;
+          nb++;
+        }
+      }
+    }
+    _MMG5_lenedg_batch(mesh,met,eb,nb,lb);
 
-    for(ia=0; ia<6; ia++) {
-      i0 = _MMG5_iare[ia][0];
-      i1 = _MMG5_iare[ia][1];
-      np = pt->v[i0];
-      nq = pt->v[i1];
+    for (j=0; j<nb; j++) {
+      np  = eb[2*j];
+      nq  = eb[2*j+1];
+      len = lb[j];
+      ned ++;
+      avlen += len;
 
-      /* Remove edge from hash ; ier = 1 if edge has been found */
-      ier = _MMG5_hashPop(&hash,np,nq);
-      if( ier ) {
-        ned ++;
-        if ( pt->xt )
-          len = _MMG5_lenedg(mesh,met,np,nq,(pxt->tag[ia] & MG_GEO));
-        else
-          len = _MMG5_lenedg(mesh,met,np,nq,0);
-
-        avlen += len;
-
-        if( len < lmin ) {
-          lmin = len;
-          amin = np;
-          bmin = nq;
-        }
 
-        if ( len > lmax ) {
-          lmax = len;
-          amax = np;
-          bmax = nq;
-        }
+      if( len < lmin ) {
+        lmin = len;
+        amin = np;
+        bmin = nq;
+      }
 
-        /* Locate size of edge among given table */
-        for(i=0; i<8; i++) {
-          if ( bd[i] <= len && len < bd[i+1] ) {
-            hl[i]++;
-            break;
-          }
+      if ( len > lmax ) {
+        lmax = len;
+        amax = np;
+        bmax = nq;
+      }
+
+      /* Locate size of edge among given table */
+      for(i=0; i<8; i++) {
+        if ( bd[i] <= len && len < bd[i+1] ) {
+          hl[i]++;
+          break;
         }
-        if( i == 8 ) hl[8]++;
       }
+      if( i == 8 ) hl[8]++;
     }
   }
 
@@ -591,8 +716,8 @@ int _MMG5_prilen(MMG5_pMesh mesh, MMG5_pSol met) {
  */
 void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pTetra    pt;
-  double   rap,rapmin,rapmax,rapavg,med,good;
-  int      i,k,iel,ok,ir,imax,nex,his[5];
+  double   rap,rapmin,rapmax,rapavg,med,good,qb[_MMG5_BATCH];
+  int      i,j,k,iel,ok,ir,imax,nex,nb,his[5],vb[4*_MMG5_BATCH];
 
   rapmin  = 2.0;
   rapmax  = 0.0;
@@ -602,29 +727,38 @@ void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met) {
   for (k=0; k<5; k++)  his[k] = 0;
 
   nex = ok = 0;
-  for (k=1; k<=mesh->ne; k++) {
-    pt = &mesh->tetra[k];
-    if( !MG_EOK(pt) ) {
-      nex++;
-      continue;
-    }
-    ok++;
-    if ( _MMG5_orvol(mesh->point,pt->v) < 0.0 ) {
-      fprintf(stdout,"dans quality vol negatif\n");
+  for (k=1; k<=mesh->ne; k+=_MMG5_BATCH) {
+    /* gather a block of tetra and compute their qualities */
+    nb = 0;
+    for (j=k; j<=MG_MIN(mesh->ne,k+_MMG5_BATCH-1); j++) {
+      pt = &mesh->tetra[j];
+      if( !MG_EOK(pt) ) {
+        nex++;
+        continue;
+      }
+      if ( _MMG5_orvol(mesh->point,pt->v) < 0.0 ) {
+        fprintf(stdout,"dans quality vol negatif\n");
+      }
+      memcpy(&vb[4*nb],pt->v,4*sizeof(int));
+      nb++;
     }
-    rap = _MMG5_ALPHAD *
-      _MMG5_caltet(mesh,met,pt->v[0],pt->v[1],pt->v[2],pt->v[3]);
-    if ( rap < rapmin ) {
-      rapmin = rap;
-      iel    = ok;
+    _MMG5_caltet_batch(mesh,met,vb,nb,qb);
+
+    for (j=0; j<nb; j++) {
+      ok++;
+      rap = _MMG5_ALPHAD * qb[j];
+      if ( rap < rapmin ) {
+        rapmin = rap;
+        iel    = ok;
+      }
+      if ( rap > 0.5 )  med++;
+      if ( rap > 0.12 ) good++;
+      if ( rap < _MMG5_BADKAL )  mesh->info.badkal = 1;
+      rapavg += rap;
+      rapmax  = MG_MAX(rapmax,rap);
+      ir = MG_MIN(4,(int)(5.0*rap));
+      his[ir] += 1;
     }
-    if ( rap > 0.5 )  med++;
-    if ( rap > 0.12 ) good++;
-    if ( rap < _MMG5_BADKAL )  mesh->info.badkal = 1;
-    rapavg += rap;
-    rapmax  = MG_MAX(rapmax,rap);
-    ir = MG_MIN(4,(int)(5.0*rap));
-    his[ir] += 1;
   }
 
 #ifndef DEBUG
@@ -669,10 +803,15 @@ void _MMG5_outqua(MMG5_pMesh mesh,MMG5_pSol met) {
 }
 
 /**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param weightelt estimated work per element (may be NULL).
+ * \param npcible estimated final number of vertices.
+ * \return 1.
  *
- * Approximation of the final number of vertex.
+ * Approximation of the final number of vertex, from the lengths of the edges
+ * in the metric (needs the adjacency). Used by \ref _MMG5_fitnelem.
  *
- * \warning Not used.
  */
 int _MMG5_countelt(MMG5_pMesh mesh,MMG5_pSol sol, double *weightelt, long *npcible) {
   MMG5_pTetra pt;
@@ -894,10 +1033,206 @@ int _MMG5_countelt(MMG5_pMesh mesh,MMG5_pSol sol, double *weightelt, long *npcib
 
   nptot += (long) dnadd - (long) dnpdel;
   *npcible = nptot;
-  fprintf(stdout,"ESTIMATION OF THE FINAL NUMBER OF NODES : %ld  _MMG5_ADD %f  _MMG5_DEL %f\n",nptot,dnadd,dnpdel);
+  if ( abs(mesh->info.imprim) > 6 || mesh->info.ddebug )
+    fprintf(stdout,"ESTIMATION OF THE FINAL NUMBER OF NODES : %ld  _MMG5_ADD %f  _MMG5_DEL %f\n",nptot,dnadd,dnpdel);
 
   free(pdel);
 
   //fclose(inm);
   return(1);
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param m0 initial metric.
+ * \param s scaling of the sizes.
+ *
+ * Set the metric to the initial metric whose sizes are multiplied by \a s
+ * (truncated by the minimal and maximal sizes in the isotropic case).
+ *
+ */
+static void _MMG5_nelemScale(MMG5_pMesh mesh,MMG5_pSol met,double *m0,double s) {
+  int      k;
+  char     i;
+
+  if ( met->size == 1 ) {
+    for (k=1; k<=mesh->np; k++)
+      met->m[k] = MG_MIN(mesh->info.hmax,MG_MAX(mesh->info.hmin,s*m0[k]));
+  }
+  else {
+    for (k=1; k<=mesh->np; k++)
+      for (i=0; i<6; i++)
+        met->m[6*k+1+i] = m0[6*k+1+i] / (s*s);
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param m0 initial metric.
+ * \param s scaling of the sizes.
+ * \return the number of elements of the metric.
+ *
+ * Number of unit regular tetrahedra (of volume \f$\sqrt{2}/12\f$) needed to
+ * fill the mesh in the metric \a m0 whose sizes are multiplied by \a s (and
+ * truncated as in \ref _MMG5_nelemScale), without gradation. It scales like
+ * \f$s^{-3}\f$.
+ *
+ */
+static double _MMG5_nelemCplx(MMG5_pMesh mesh,MMG5_pSol met,double *m0,double s) {
+  MMG5_pTetra pt;
+  double      *m,cplx,dd,h;
+  int         k;
+  char        i;
+
+  cplx = 0.0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+
+    dd = 0.0;
+    for (i=0; i<4; i++) {
+      if ( met->size == 1 ) {
+        h   = MG_MIN(mesh->info.hmax,MG_MAX(mesh->info.hmin,s*m0[pt->v[i]]));
+        dd += 1.0 / (h*h*h);
+      }
+      else {
+        m   = &m0[6*pt->v[i]+1];
+        h   = m[0]*(m[3]*m[5]-m[4]*m[4]) - m[1]*(m[1]*m[5]-m[2]*m[4])
+          + m[2]*(m[1]*m[4]-m[2]*m[3]);
+        dd += sqrt(MG_MAX(h,0.0)) / (s*s*s);
+      }
+    }
+    cplx += 0.25*dd*fabs(_MMG5_orvol(mesh->point,pt->v))/6.0;
+  }
+  return(12.0*cplx/sqrt(2.0));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Scale the metric so that the mesh has about \a mesh->info.nelem elements.
+ * The scaling is first estimated analytically from the ungraded metric (\ref
+ * _MMG5_nelemCplx), then corrected with the final number of elements
+ * estimated by \ref _MMG5_countelt, the metric being graded as in the
+ * remeshing, until the prediction is within \ref _MMG5_NELEMTOL of the target
+ * (at most \ref _MMG5_NELEMCOR evaluations, with a warning if the target is
+ * not reached). The number of elements is deduced from
+ * the estimated number of vertices \f$n_p\f$ by the Euler-Poincare relation
+ * \f$n_e \simeq 6(n_p - n_b/2)\f$, the number of boundary vertices \f$n_b\f$
+ * growing like \f$n_p^{2/3}\f$. Without metric, the sizes of the current
+ * mesh are scaled. Called on the analyzed mesh.
+ *
+ */
+int _MMG5_fitnelem(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pPoint ppt;
+  double     *m0,s,s0,r,r0,e,nb,bytes;
+  long       npc;
+  int        it,nv,nvb;
+
+  if ( !met->np && !_MMG5_DoSol(mesh,met) )  return(0);
+
+  nv = nvb = 0;
+  for (it=1; it<=mesh->np; it++) {
+    ppt = &mesh->point[it];
+    if ( !MG_VOK(ppt) )  continue;
+    nv++;
+    if ( ppt->tag & MG_BDY )  nvb++;
+  }
+  if ( !nv )  return(0);
+  npc = nv;
+  nb  = nvb;
+
+  _MMG5_ADD_MEM(mesh,(met->size*(mesh->np+1)+1)*sizeof(double),"initial metric",
+                return(0));
+  _MMG5_SAFE_MALLOC(m0,met->size*(mesh->np+1)+1,double);
+  memcpy(m0,met->m,(met->size*(mesh->np+1)+1)*sizeof(double));
+
+  /* analytic estimation (only the truncation of the sizes needs iterations) */
+  s = 1.0;
+  for (it=0; it<_MMG5_NELEMIT; it++) {
+    r = _MMG5_nelemCplx(mesh,met,m0,s) / (double)mesh->info.nelem;
+    if ( r <= 0. || fabs(r-1.) < _MMG5_NELEMTOL )  break;
+    s *= pow(r,1./3.);
+  }
+
+  /* corrections with the graded metric: secant steps on log(nepred) as a
+   * function of log(s), starting from the s^-3 law of the ungraded metric */
+  e  = -3.;
+  s0 = r0 = 0.;
+  for (it=0; it<_MMG5_NELEMCOR; it++) {
+    _MMG5_nelemScale(mesh,met,m0,s);
+    if ( mesh->info.hgrad > 0. && !_MMG5_gradsiz(mesh,met) ) {
+      _MMG5_DEL_MEM(mesh,m0,(met->size*(mesh->np+1)+1)*sizeof(double));
+      return(0);
+    }
+    _MMG5_countelt(mesh,met,NULL,&npc);
+    nb = nvb*pow((double)npc/(double)nv,2./3.);
+    mesh->nepred = (long)(6.*(npc - 0.5*nb));
+    if ( abs(mesh->info.imprim) > 4 )
+      fprintf(stdout,"     SIZES SCALED BY %f: %ld ELEMENTS PREDICTED\n",
+              s,mesh->nepred);
+
+    r = (double)mesh->nepred / (double)mesh->info.nelem;
+    if ( r <= 0. || fabs(r-1.) < _MMG5_NELEMTOL )  break;
+    /* the sizes are bounded: the prediction does not move any more */
+    if ( it && fabs(r/r0-1.) < _MMG5_EPS )  break;
+
+    if ( it && fabs(log(s/s0)) > _MMG5_EPSD ) {
+      e = log(r/r0) / log(s/s0);
+      /* the graded number of elements still decreases with the sizes: keep
+       * the slope between the 2D and 3D laws */
+      e = MG_MAX(-3.,MG_MIN(-1.,e));
+    }
+    s0 = s;
+    r0 = r;
+    s *= pow(r,-1./e);
+  }
+  if ( it == _MMG5_NELEMCOR )
+    /* keep the last evaluated metric */
+    s = s0;
+  _MMG5_nelemScale(mesh,met,m0,s);
+  _MMG5_DEL_MEM(mesh,m0,(met->size*(mesh->np+1)+1)*sizeof(double));
+
+  /* memory needed by the predicted mesh (as in _MMG5_memOption) */
+  bytes = (double)mesh->nepred*(sizeof(MMG5_Tetra) + 4*sizeof(int))
+    + (double)npc*(sizeof(MMG5_Point) + met->size*sizeof(double))
+    + nb*(sizeof(MMG5_xPoint) + sizeof(MMG5_xTetra));
+
+  if ( mesh->info.imprim )
+    fprintf(stdout,"  -- TARGET %d ELEMENTS: %ld PREDICTED (%.0f Mo)\n",
+            mesh->info.nelem,mesh->nepred,bytes/1048576.);
+  if ( fabs(r-1.) >= _MMG5_NELEMTOL )
+    fprintf(stdout,"  ## Warning: unable to reach the target number of"
+            " elements within %d%% (bounded sizes?).\n",
+            (int)(100*_MMG5_NELEMTOL));
+  if ( bytes > mesh->memMax )
+    fprintf(stdout,"  ## Warning: the predicted mesh may exceed the authorized"
+            " memory (%lld Mo).\n",mesh->memMax/1048576);
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Print the predicted and obtained numbers of elements (if a number of
+ * elements is targeted) and the peak of memory.
+ *
+ */
+void _MMG5_nelemStats(MMG5_pMesh mesh) {
+  int  k,ne;
+
+  if ( mesh->info.nelem > 0 && mesh->info.imprim ) {
+    ne = 0;
+    for (k=1; k<=mesh->ne; k++)
+      if ( MG_EOK(&mesh->tetra[k]) )  ne++;
+    fprintf(stdout,"     NUMBER OF ELEMENTS: %d (TARGET %d, PREDICTED %ld)\n",
+            ne,mesh->info.nelem,mesh->nepred);
+  }
+  if ( (mesh->info.nelem > 0 && mesh->info.imprim) || abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     PEAK OF MEMORY: %lld Mo\n",mesh->memPeak/1048576);
+}
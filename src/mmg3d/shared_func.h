@@ -112,23 +112,45 @@ void _MMG5_excfun(int sigid) {
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
  *
- * Set function pointers.
+ * Set function pointers: kernels and iso/aniso instances of the operators.
  *
  */
 void _MMG5_setfunc(MMG5_pMesh mesh,MMG5_pSol met) {
-  if ( met->size == 1 || ( met->size == 3 && mesh->info.lag >= 0 ) ) {
+  if ( met->size == 1 || mesh->info.iso || ( met->size == 3 && mesh->info.lag >= 0 ) ) {
     _MMG5_caltet  = _MMG5_caltet_iso;
     _MMG5_caltri  = _MMG5_caltri_iso;
     _MMG5_lenedg  = _MMG5_lenedg_iso;
     _MMG5_defsiz  = _MMG5_defsiz_iso;
     _MMG5_gradsiz = _MMG5_gradsiz_iso;
+    _MMG5_intmet  = _MMG5_intmet_iso;
+    _MMG5_buckin  = _MMG5_buckin_iso;
+
+    _MMG5_chkcol_int = _MMG5_chkcol_int_iso;
+    _MMG5_chkswpgen  = _MMG5_chkswpgen_iso;
+    _MMG5_movintpt   = _MMG5_movintpt_iso;
+    _MMG5_split1b    = _MMG5_split1b_iso;
   }
   else if ( met->size == 6 ) {
-    _MMG5_caltet = _MMG5_caltet_ani;
-    // _MMG5_caltri  = _MMG5_caltri_ani;
-    _MMG5_lenedg = _MMG5_lenedg_ani;
-    /*defsiz = defsiz_ani;
-      gradsiz = gradsiz_ani;*/
+    _MMG5_caltet  = _MMG5_caltet_ani;
+    /* the surface quality remains euclidean */
+    _MMG5_caltri  = _MMG5_caltri_iso;
+    _MMG5_lenedg  = _MMG5_lenedg33_ani;
+    _MMG5_defsiz  = _MMG5_defsiz_ani;
+    _MMG5_gradsiz = _MMG5_gradsiz_ani;
+    _MMG5_intmet  = _MMG5_intmet_ani;
+    _MMG5_buckin  = _MMG5_buckin_ani;
+
+    _MMG5_chkcol_int = _MMG5_chkcol_int_ani;
+    _MMG5_chkswpgen  = _MMG5_chkswpgen_ani;
+    _MMG5_movintpt   = _MMG5_movintpt_ani;
+    _MMG5_split1b    = _MMG5_split1b_ani;
+  }
+  /* sizes of the new points given by the background mesh or by the user
+   * function */
+  if ( mesh->bgm )  _MMG5_intmet = _MMG5_intmet_bgm;
+  else if ( mesh->sizf ) {
+    mesh->sizf->intmet = _MMG5_intmet;
+    _MMG5_intmet       = _MMG5_intmet_sizf;
   }
 }
 
@@ -0,0 +1,334 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Inria - IMB (Université de Bordeaux) - LJLL (UPMC), 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/sizfun.c
+ * \brief Size map given by a user function.
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The size function is evaluated at the vertices of the mesh at the beginning
+ * of the remeshing, then at each vertex creation. The new vertices are first
+ * given the size interpolated along the split edge (kept if the function
+ * fails); when the vertices are created by a splitting pass, their
+ * evaluation is delayed until the end of the pass so that the function is
+ * called on groups of points. The last results are kept in a direct-mapped
+ * cache indexed by the coordinates: a point rejected by an operator is
+ * often created again at the same place.
+ *
+ */
+
+#include "mmg3d.h"
+
+#define _MMG5_SIZCACHE  1024  /**< number of entries of the cache (power of 2) */
+
+/**
+ * \param sizf pointer toward the size function structure.
+ * \param c point coordinates.
+ * \return pointer toward the cache entry of \a c.
+ *
+ */
+static inline
+_MMG5_pSizCache _MMG5_sizfCache(_MMG5_pSizFun sizf,double c[3]) {
+  unsigned int  key,u[6];
+
+  memcpy(u,c,3*sizeof(double));
+  key = (u[0]^u[1])*2654435761u + (u[2]^u[3])*40503u + (u[4]^u[5])*_MMG5_KA;
+
+  return(&sizf->cache[(key ^ (key >> 15)) & (_MMG5_SIZCACHE-1)]);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ *
+ * Evaluate the size function at the waiting points. The results are
+ * converted to the frame of the (scaled) mesh and truncated by hmin and
+ * hmax.
+ *
+ */
+static void _MMG5_sizfEval(MMG5_pMesh mesh,MMG5_pSol met) {
+  _MMG5_pSizFun   sizf;
+  _MMG5_pSizCache pe,pc[_MMG5_EIGBATCH];
+  MMG5_pPoint     ppt;
+  double          c[3*_MMG5_EIGBATCH],m[6*_MMG5_EIGBATCH];
+  double          lambda[3*_MMG5_EIGBATCH],v[9*_MMG5_EIGBATCH];
+  double          *mp,*lb,*vp,dd,lmin,lmax;
+  int             ib[_MMG5_EIGBATCH],k,n,ip,ier,size;
+  char            i,j,l;
+
+  sizf = mesh->sizf;
+  size = sizf->size;
+
+  /* look for the points in the cache */
+  n = 0;
+  for (k=0; k<sizf->npend; k++) {
+    ip  = sizf->pend[k];
+    ppt = &mesh->point[ip];
+    if ( !MG_VOK(ppt) )  continue;
+
+    sizf->nquery++;
+    pe = _MMG5_sizfCache(sizf,ppt->c);
+    if ( pe->ok && !memcmp(pe->c,ppt->c,3*sizeof(double)) ) {
+      memcpy(&met->m[size==1 ? ip : 6*ip+1],pe->m,size*sizeof(double));
+      sizf->nhit++;
+      continue;
+    }
+    for (i=0; i<3; i++)
+      c[3*n+i] = ppt->c[i]*mesh->info.delta + mesh->info.min[i];
+    ib[n] = ip;
+    pc[n] = pe;
+    n++;
+  }
+  sizf->npend = 0;
+  if ( !n )  return;
+
+  sizf->ncall++;
+  if ( !sizf->fct(n,c,m,sizf->data) ) {
+    sizf->nfail += n;
+    return;
+  }
+
+  if ( size == 1 ) {
+    for (k=0; k<n; k++) {
+      if ( !(m[k] > 0.0) || !isfinite(m[k]) ) {
+        sizf->nfail++;
+        continue;
+      }
+      m[k] /= mesh->info.delta;
+      met->m[ib[k]] = MG_MIN(mesh->info.hmax,MG_MAX(mesh->info.hmin,m[k]));
+      memcpy(pc[k]->c,mesh->point[ib[k]].c,3*sizeof(double));
+      pc[k]->m[0] = met->m[ib[k]];
+      pc[k]->ok   = 1;
+    }
+    return;
+  }
+
+  dd = mesh->info.delta*mesh->info.delta;
+  for (k=0; k<6*n; k++)  m[k] *= dd;
+
+  lmin = 1.0 / (mesh->info.hmax*mesh->info.hmax);
+  lmax = 1.0 / (mesh->info.hmin*mesh->info.hmin);
+  ier  = _MMG5_eigensym3_batch(n,m,lambda,v);
+  for (k=0; k<n; k++) {
+    lb = &lambda[3*k];
+    vp = &v[9*k];
+    if ( k >= ier && !_MMG5_eigensym3(&m[6*k],lb,(double (*)[3])vp) ) {
+      sizf->nfail++;
+      continue;
+    }
+    for (l=0; l<3; l++)
+      lb[l] = MG_MIN(lmax,MG_MAX(lmin,lb[l]));
+
+    mp = &met->m[6*ib[k]+1];
+    for (i=0,j=0; i<3; i++) {
+      for (l=i; l<3; l++,j++)
+        mp[j] = lb[0]*vp[i]*vp[l] + lb[1]*vp[3+i]*vp[3+l]
+          + lb[2]*vp[6+i]*vp[6+l];
+    }
+    memcpy(pc[k]->c,mesh->point[ib[k]].c,3*sizeof(double));
+    memcpy(pc[k]->m,mp,6*sizeof(double));
+    pc[k]->ok = 1;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Delay the evaluations of the size function at the new vertices until the
+ * call of \ref _MMG5_sizfFlush.
+ *
+ */
+void _MMG5_sizfDefer(MMG5_pMesh mesh) {
+  if ( mesh->sizf )  mesh->sizf->defer = 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ *
+ * Evaluate the size function at the waiting vertices and stop delaying the
+ * evaluations.
+ *
+ */
+void _MMG5_sizfFlush(MMG5_pMesh mesh,MMG5_pSol met) {
+  if ( !mesh->sizf )  return;
+
+  if ( mesh->sizf->npend )  _MMG5_sizfEval(mesh,met);
+  mesh->sizf->defer = 0;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param np index of the first extremity of the edge.
+ * \param nq index of the second extremity of the edge.
+ * \param ip index of the new point.
+ * \param s parameter of the new point along the edge \f$[np;nq]\f$.
+ *
+ * Size at the new point \a ip given by the size function. The size is first
+ * interpolated along the edge \f$[np;nq]\f$ and the evaluation of the
+ * function may be delayed (see \ref _MMG5_sizfDefer).
+ *
+ */
+void _MMG5_intmet_sizf(MMG5_pMesh mesh,MMG5_pSol met,int np,int nq,int ip,
+                       double s) {
+  _MMG5_pSizFun  sizf;
+
+  sizf = mesh->sizf;
+  sizf->intmet(mesh,met,np,nq,ip,s);
+
+  sizf->pend[sizf->npend++] = ip;
+  if ( !sizf->defer || sizf->npend == _MMG5_EIGBATCH )
+    _MMG5_sizfEval(mesh,met);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Replace the solution \a met by the values of the size function at the
+ * vertices of \a mesh (the mesh is not scaled yet).
+ *
+ */
+int _MMG5_sizfSetSol(MMG5_pMesh mesh,MMG5_pSol met) {
+  _MMG5_pSizFun  sizf;
+  MMG5_pPoint    ppt;
+  double         c[3*_MMG5_EIGBATCH],m[6*_MMG5_EIGBATCH];
+  int            ib[_MMG5_EIGBATCH],k,l,nb,size;
+  char           i;
+
+  sizf = mesh->sizf;
+  size = sizf->size;
+
+  if ( met->m )
+    _MMG5_DEL_MEM(mesh,met->m,(met->size*(met->npmax+1)+1)*sizeof(double));
+
+  met->size  = size;
+  met->dim   = 3;
+  met->ver   = 2;
+  met->np    = mesh->np;
+  met->npmax = mesh->npmax;
+  _MMG5_ADD_MEM(mesh,(size*(met->npmax+1)+1)*sizeof(double),
+                "initial solution",return(0));
+  _MMG5_SAFE_CALLOC(met->m,size*(met->npmax+1)+1,double);
+
+  /* the cache is in the frame of the scaled mesh */
+  memset(sizf->cache,0,_MMG5_SIZCACHE*sizeof(_MMG5_SizCache));
+  sizf->npend  = sizf->defer = 0;
+  sizf->nquery = sizf->ncall = sizf->nhit = sizf->nfail = 0;
+
+  nb = 0;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( MG_VOK(ppt) ) {
+      for (i=0; i<3; i++)  c[3*nb+i] = ppt->c[i];
+      ib[nb++] = k;
+    }
+    if ( nb < _MMG5_EIGBATCH && k < mesh->np )  continue;
+    if ( !nb )  break;
+
+    if ( !sizf->fct(nb,c,m,sizf->data) ) {
+      fprintf(stdout,"  ## Error: size function failed at vertices %d-%d.\n",
+              ib[0],ib[nb-1]);
+      return(0);
+    }
+    for (l=0; l<nb; l++)
+      memcpy(&met->m[size==1 ? ib[l] : 6*ib[l]+1],&m[size*l],
+             size*sizeof(double));
+    nb = 0;
+  }
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Print the statistics of the evaluations of the size function.
+ *
+ */
+void _MMG5_sizfStats(MMG5_pMesh mesh) {
+  _MMG5_pSizFun  sizf;
+
+  sizf = mesh->sizf;
+  if ( !sizf || !sizf->nquery )  return;
+
+  fprintf(stdout,"     SIZE FUNCTION: %d NEW VERTICES, %.2f VERTICES/CALL,"
+          " %.1f%% CACHE HITS, %d FAILURES\n",sizf->nquery,
+          sizf->ncall ? (double)(sizf->nquery-sizf->nhit)/sizf->ncall : 0.0,
+          100.0*sizf->nhit/sizf->nquery,sizf->nfail);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Free the size function structure.
+ *
+ */
+void _MMG5_sizfFree(MMG5_pMesh mesh) {
+  _MMG5_pSizFun  sizf;
+
+  sizf = mesh->sizf;
+  if ( !sizf )  return;
+
+  if ( sizf->cache )
+    _MMG5_DEL_MEM(mesh,sizf->cache,_MMG5_SIZCACHE*sizeof(_MMG5_SizCache));
+  _MMG5_DEL_MEM(mesh,mesh->sizf,sizeof(_MMG5_SizFun));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param fct size function.
+ * \param size 1 if \a fct computes sizes, 6 if it computes metrics.
+ * \param data user data passed to \a fct.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Store the size function and allocate its cache.
+ *
+ */
+int _MMG5_sizfNew(MMG5_pMesh mesh,MMG5_sizeFunction fct,int size,void *data) {
+  _MMG5_pSizFun  sizf;
+
+  _MMG5_sizfFree(mesh);
+
+  _MMG5_ADD_MEM(mesh,sizeof(_MMG5_SizFun),"size function",return(0));
+  _MMG5_SAFE_CALLOC(mesh->sizf,1,_MMG5_SizFun);
+  sizf = mesh->sizf;
+
+  _MMG5_ADD_MEM(mesh,_MMG5_SIZCACHE*sizeof(_MMG5_SizCache),"size function cache",
+                _MMG5_DEL_MEM(mesh,mesh->sizf,sizeof(_MMG5_SizFun));
+                return(0));
+  _MMG5_SAFE_CALLOC(sizf->cache,_MMG5_SIZCACHE,_MMG5_SizCache);
+
+  sizf->fct  = fct;
+  sizf->data = data;
+  sizf->size = size;
+
+  return(1);
+}
@@ -245,8 +245,8 @@ nextstep1:
     }
   }
   /* Quality update */
-  pt->qual=_MMG5_orcal(mesh,k);
-  pt1->qual=_MMG5_orcal(mesh,iel);
+  pt->qual=_MMG5_orcal(mesh,met,k);
+  pt1->qual=_MMG5_orcal(mesh,met,iel);
 }
 
 /**
@@ -285,13 +285,13 @@ int _MMG5_simbulgept(MMG5_pMesh mesh,int *list,int ret,double o[3]) {
     memcpy(pt0,pt,sizeof(MMG5_Tetra));
     pt0->v[ia] = 0;
     calold = MG_MIN(calold,pt->qual);
-    caltmp = _MMG5_orcal(mesh,0);
+    caltmp = _MMG5_orcal(mesh,NULL,0);
     if ( caltmp < _MMG5_EPSD )  return(0);
     calnew = MG_MIN(calnew,caltmp);
 
     memcpy(pt0,pt,sizeof(MMG5_Tetra));
     pt0->v[ib] = 0;
-    caltmp = _MMG5_orcal(mesh,0);
+    caltmp = _MMG5_orcal(mesh,NULL,0);
     if ( caltmp < _MMG5_EPSD )  return(0);
     calnew = MG_MIN(calnew,caltmp);
   }
@@ -309,6 +309,7 @@ int _MMG5_simbulgept(MMG5_pMesh mesh,int *list,int ret,double o[3]) {
  * \param ret size of the shell of edge.
  * \param ip idex of new point.
  * \param cas flag to watch the length of the new edges.
+ * \param ani 1 to measure lengths and qualities in the aniso metric.
  * \return -1 if lack of memory, 0 if we don't split the edge, 1 if success.
  *
  * Split edge \f$list[0]%6\f$, whose shell list is passed, introducing point \a
@@ -316,7 +317,9 @@ int _MMG5_simbulgept(MMG5_pMesh mesh,int *list,int ret,double o[3]) {
  * sense).
  *
  */
-int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int cas){
+static _MMG5_ALWAYS_INLINE int
+_MMG5_split1b_spe(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int ip,
+                  int cas,const char ani) {
   MMG5_pTetra         pt,pt1;
   MMG5_xTetra         xt,xt1;
   MMG5_pxTetra        pxt0;
@@ -329,6 +332,8 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
   ilist = ret / 2;
   open  = ret % 2;
 
+  if ( cas )  _MMG5_PROF_INC(mesh,_MMG5_PC_splatt);
+
   if ( cas && met->m ) {
     lmin = 0.6;
     lmax = 1.3;
@@ -336,7 +341,7 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
       for (i=0; i<6; i++) {
         pt   = &mesh->tetra[list[j]/6];
         tag  = pt->xt ? (mesh->xtetra[pt->xt].tag[i]) : 0;
-        len  = _MMG5_lenedg(mesh,met, pt->v[_MMG5_iare[i][0]],
+        len  = _MMG5_LENEDG(ani,mesh,met, pt->v[_MMG5_iare[i][0]],
                             pt->v[_MMG5_iare[i][1]],tag);
         if ( len < lmin) {
           lmin = len;
@@ -351,9 +356,9 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
       iel = list[j] / 6;
       pt  = &mesh->tetra[iel];
       ie  = list[j] % 6;
-      len = _MMG5_lenedg(mesh,met, pt->v[_MMG5_isar[ie][0]],ip,0);
+      len = _MMG5_LENEDG(ani,mesh,met, pt->v[_MMG5_isar[ie][0]],ip,0);
       if ( len < lmin )  break;
-      len = _MMG5_lenedg(mesh,met, pt->v[_MMG5_isar[ie][1]],ip,0);
+      len = _MMG5_LENEDG(ani,mesh,met, pt->v[_MMG5_isar[ie][1]],ip,0);
       if ( len < lmin )  break;
     }
     if ( j < ilist )  return(0);
@@ -534,8 +539,8 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
       adjan[voy] = 4*jel + tau[0];
     }
     /* Quality update */
-    pt->qual=_MMG5_orcal(mesh,iel);
-    pt1->qual=_MMG5_orcal(mesh,jel);
+    pt->qual=_MMG5_ORCAL(ani,mesh,met,iel);
+    pt1->qual=_MMG5_ORCAL(ani,mesh,met,jel);
 
     _MMG5_SAFE_FREE(newtet);
     return(1);
@@ -824,14 +829,27 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,int
       adjan[voy] = 4*jel + tau[0];
     }
     /* Quality update */
-    pt->qual=_MMG5_orcal(mesh,iel);
-    pt1->qual=_MMG5_orcal(mesh,jel);
+    pt->qual=_MMG5_ORCAL(ani,mesh,met,iel);
+    pt1->qual=_MMG5_ORCAL(ani,mesh,met,jel);
   }
 
   _MMG5_SAFE_FREE(newtet);
+  if ( cas )  _MMG5_PROF_INC(mesh,_MMG5_PC_splok);
   return(1);
 }
 
+/** iso. instance of \ref _MMG5_split1b_spe */
+int _MMG5_split1b_iso(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int ip,
+                      int cas) {
+  return(_MMG5_split1b_spe(mesh,met,list,ret,ip,cas,0));
+}
+
+/** aniso. instance of \ref _MMG5_split1b_spe */
+int _MMG5_split1b_ani(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int ip,
+                      int cas) {
+  return(_MMG5_split1b_spe(mesh,met,list,ret,ip,cas,1));
+}
+
 /** Simulate split of two edges that belong to a common face */
 int _MMG5_split2sf_sim(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
   MMG5_pTetra        pt,pt0;
@@ -1138,9 +1156,9 @@ void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]){
     }
   }
   /* Quality update */
-  pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-  pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-  pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
+  pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+  pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+  pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
 
 }
 
@@ -1328,10 +1346,10 @@ void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   /* Quality update */
-  pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-  pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-  pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-  pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+  pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+  pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+  pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+  pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
 }
 
@@ -1579,10 +1597,10 @@ void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   /* Quality update */
-  pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-  pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-  pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-  pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+  pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+  pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+  pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+  pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
 }
 
@@ -1921,10 +1939,10 @@ void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   /* Quality update */
-  pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-  pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-  pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-  pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+  pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+  pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+  pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+  pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
 }
 
@@ -2469,12 +2487,12 @@ void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, int k, int vx[6]){
     }
   }
   /* Quality update */
-  pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-  pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-  pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-  pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+  pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+  pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+  pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+  pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
   if ( !((imin12 == ip1) && (imin03 == ip3)) ) {
-    pt[4]->qual=_MMG5_orcal(mesh,newtet[4]);
+    pt[4]->qual=_MMG5_orcal(mesh,met,newtet[4]);
   }
 
 }
@@ -2486,8 +2504,8 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
   MMG5_pPoint   ppt;
   MMG5_xTetra   xt[4];
   MMG5_pxTetra  pxt0;
-  double   o[3],hnew;
-  int      i,ib,iel;
+  double   o[3],hnew,*mr,*mv;
+  int      i,j,ib,iel;
   int      newtet[4];
   unsigned char isxt[4],firstxt;
 
@@ -2503,7 +2521,7 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
     o[0] += ppt->c[0];
     o[1] += ppt->c[1];
     o[2] += ppt->c[2];
-    if ( met->m )  hnew += met->m[ib];
+    if ( met->m && met->size == 1 )  hnew += met->m[ib];
   }
   o[0] *= 0.25;
   o[1] *= 0.25;
@@ -2518,7 +2536,19 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
                         return(0)
                         ,o,0);
   }
-  if ( met->m )  met->m[ib] = hnew;
+  if ( met->m ) {
+    if ( met->size == 1 )
+      met->m[ib] = hnew;
+    else {
+      /* mean of the metrics at the vertices */
+      mr = &met->m[6*ib+1];
+      for (j=0; j<6; j++)  mr[j] = 0.0;
+      for (i=0; i<4; i++) {
+        mv = &met->m[6*pt[0]->v[i]+1];
+        for (j=0; j<6; j++)  mr[j] += 0.25*mv[j];
+      }
+    }
+  }
 
   /* create 3 new tetras */
   iel = _MMG5_newElt(mesh);
@@ -2673,10 +2703,10 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k) {
     }
   }
   /* Quality update */
-  pt[0]->qual=_MMG5_orcal(mesh,newtet[0]);
-  pt[1]->qual=_MMG5_orcal(mesh,newtet[1]);
-  pt[2]->qual=_MMG5_orcal(mesh,newtet[2]);
-  pt[3]->qual=_MMG5_orcal(mesh,newtet[3]);
+  pt[0]->qual=_MMG5_orcal(mesh,met,newtet[0]);
+  pt[1]->qual=_MMG5_orcal(mesh,met,newtet[1]);
+  pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
+  pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
 
   return(1);
 }
@@ -2954,7 +2984,7 @@ void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   for (i=0; i<6; i++) {
-    pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+    pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
   }
 }
 
@@ -3204,7 +3234,7 @@ void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   for (i=0; i<6; i++) {
-    pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+    pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
   }
 }
 
@@ -3453,7 +3483,7 @@ void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   for (i=0; i<7; i++) {
-    pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+    pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
   }
 }
 
@@ -3810,6 +3840,6 @@ void _MMG5_split6(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6]) {
     }
   }
   for (i=0; i<8; i++) {
-    pt[i]->qual=_MMG5_orcal(mesh,newtet[i]);
+    pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
   }
 }
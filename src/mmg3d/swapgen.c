@@ -36,11 +36,13 @@
 
 /**
  * \param mesh pointer toward the mesh structure
+ * \param met pointer toward the metric structure.
  * \param start tetrahedra in which the swap should be performed
  * \param ia edge that we want to swap
  * \param ilist pointer to store the size of the shell of the edge
  * \param list pointer to store the shell of the edge
  * \param crit improvment coefficient
+ * \param ani 1 to measure the qualities in the aniso metric.
  * \return 0 if fail, the index of point corresponding to the swapped
  * configuration otherwise (\f$4*k+i\f$).
  *
@@ -49,7 +51,9 @@
  * configuration. The shell of edge is built during the process.
  *
  */
-int _MMG5_chkswpgen(MMG5_pMesh mesh,int start,int ia,int *ilist,int *list,double crit) {
+static _MMG5_ALWAYS_INLINE int
+_MMG5_chkswpgen_spe(MMG5_pMesh mesh,MMG5_pSol met,int start,int ia,
+                    int *ilist,int *list,double crit,const char ani) {
   MMG5_pTetra    pt,pt0;
   MMG5_pPoint    p0;
   double    calold,calnew,caltmp;
@@ -170,12 +174,12 @@ int _MMG5_chkswpgen(MMG5_pMesh mesh,int start,int ia,int *ilist,int *list,double
       /* First tetra obtained from iel */
       memcpy(pt0,pt,sizeof(MMG5_Tetra));
       pt0->v[_MMG5_iare[i][0]] = np;
-      caltmp = _MMG5_orcal(mesh,0);
+      caltmp = _MMG5_ORCAL(ani,mesh,met,0);
       calnew = MG_MIN(calnew,caltmp);
       /* Second tetra obtained from iel */
       memcpy(pt0,pt,sizeof(MMG5_Tetra));
       pt0->v[_MMG5_iare[i][1]] = np;
-      caltmp = _MMG5_orcal(mesh,0);
+      caltmp = _MMG5_ORCAL(ani,mesh,met,0);
       calnew = MG_MIN(calnew,caltmp);
       ier = (calnew > crit*calold);
       if ( !ier )  break;
@@ -185,6 +189,18 @@ int _MMG5_chkswpgen(MMG5_pMesh mesh,int start,int ia,int *ilist,int *list,double
   return(0);
 }
 
+/** iso. instance of \ref _MMG5_chkswpgen_spe */
+int _MMG5_chkswpgen_iso(MMG5_pMesh mesh,MMG5_pSol met,int start,int ia,
+                        int *ilist,int *list,double crit) {
+  return(_MMG5_chkswpgen_spe(mesh,met,start,ia,ilist,list,crit,0));
+}
+
+/** aniso. instance of \ref _MMG5_chkswpgen_spe */
+int _MMG5_chkswpgen_ani(MMG5_pMesh mesh,MMG5_pSol met,int start,int ia,
+                        int *ilist,int *list,double crit) {
+  return(_MMG5_chkswpgen_spe(mesh,met,start,ia,ilist,list,crit,1));
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -238,7 +254,7 @@ int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,_MM
                           ,m,0);
     }
   }
-  if ( met->m )  met->m[np] = 0.5*(met->m[na]+met->m[nb]);
+  if ( met->m )  _MMG5_intmet(mesh,met,na,nb,np,0.5);
 
   /** First step : split of edge (na,nb) */
   ret = 2*ilist + 0;
@@ -265,7 +281,7 @@ int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,_MM
   memset(list,0,(_MMG5_LMAX+2)*sizeof(int));
   nball = _MMG5_boulevolp(mesh,start,ip,list);
 
-  ier = _MMG5_colver(mesh,list,nball,iq);
+  ier = _MMG5_colver(mesh,met,list,nball,iq);
   if ( ier < 0 ) {
     fprintf(stdout,"  ## Warning: unable to swap internal edge.\n");
     return(-1);
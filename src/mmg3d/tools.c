@@ -910,3 +910,68 @@ void _MMG5_printTetra(MMG5_pMesh mesh,char* fileName) {
     fprintf(inm,"---------> END _MMG5_TETRAHEDRAS <--------\n");
     fclose(inm);
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 1 if the time budget of the run is exhausted, 0 otherwise.
+ *
+ * Check the wall-clock time elapsed since \a mesh->info.tini against the
+ * budget \a mesh->info.tmax. Once exhausted, the budget stays exhausted until
+ * the next run, so the remaining operators are skipped.
+ *
+ */
+int _MMG5_timeout(MMG5_pMesh mesh) {
+  struct timeval tv;
+
+  if ( mesh->info.tout )  return(1);
+  if ( mesh->info.tmax <= 0. )  return(0);
+
+  gettimeofday(&tv,NULL);
+  if ( tv.tv_sec + tv.tv_usec*BIG1 - mesh->info.tini < mesh->info.tmax )
+    return(0);
+
+  mesh->info.tout = 1;
+  if ( mesh->info.imprim )
+    fprintf(stdout,"  ## Warning: time budget of %g s exhausted."
+            " Remeshing interrupted.\n",mesh->info.tmax);
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param step current step of the run (see \ref MMG5_step).
+ * \param it iteration of the step.
+ * \param ns number of splits of the iteration.
+ * \param nc number of collapses of the iteration.
+ * \param nf number of swaps of the iteration.
+ * \param nm number of moves of the iteration.
+ *
+ * Report the progress of the run to the progress function of the user, if
+ * any. If it returns 0, the run is flagged as interrupted and the remaining
+ * operators are skipped (see \ref _MMG5_timeout).
+ *
+ */
+void _MMG5_progress(MMG5_pMesh mesh,int step,int it,int ns,int nc,int nf,int nm) {
+  MMG5_Progress  prog;
+  struct timeval tv;
+
+  if ( !mesh->prog || mesh->info.tout )  return;
+
+  gettimeofday(&tv,NULL);
+  prog.step = step;
+  prog.it   = it;
+  prog.ns   = ns;
+  prog.nc   = nc;
+  prog.nf   = nf;
+  prog.nm   = nm;
+  prog.np   = mesh->np;
+  prog.ne   = mesh->ne;
+  prog.time = tv.tv_sec + tv.tv_usec*BIG1 - mesh->info.tini;
+
+  if ( mesh->prog->fct(mesh,&prog,mesh->prog->data) )  return;
+
+  mesh->info.tout = 2;
+  if ( mesh->info.imprim )
+    fprintf(stdout,"  ## Warning: run stopped by the progress function."
+            " Remeshing interrupted.\n");
+}
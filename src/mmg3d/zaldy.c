@@ -45,7 +45,13 @@ int _MMG5_newPt(MMG5_pMesh mesh,double c[3],char tag) {
   if ( mesh->npnil > mesh->np )  mesh->np = mesh->npnil;
   ppt   = &mesh->point[curpt];
   memcpy(ppt->c,c,3*sizeof(double));
-  mesh->npnil = ppt->tmp;
+  if ( curpt < mesh->nplnk )
+    mesh->npnil = ppt->tmp;
+  else {
+    /* first use of this slot: the next one is chained on the fly */
+    mesh->nplnk = curpt+1;
+    mesh->npnil = ( curpt < mesh->npmax-1 ) ? curpt+1 : 0;
+  }
   ppt->tmp    = 0;
 
   ppt->ref = 0;
@@ -53,14 +59,22 @@ int _MMG5_newPt(MMG5_pMesh mesh,double c[3],char tag) {
   ppt->flag = 0;
   /* point on geometry */
   if ( tag & MG_BDY ) {
-    mesh->xp++;
-    if(mesh->xp > mesh->xpmax){
-      /* reallocation of xpoint table */
-      _MMG5_TAB_RECALLOC(mesh,mesh->xpoint,mesh->xpmax,0.2,MMG5_xPoint,
-                         "larger xpoint table",
-                         return(0));
+    if ( mesh->xpnil ) {
+      /* reuse a recycled xpoint (linked through n1[0]) */
+      ppt->xp     = mesh->xpnil;
+      mesh->xpnil = (int)mesh->xpoint[ppt->xp].n1[0];
+      mesh->xpoint[ppt->xp].n1[0] = 0.;
+    }
+    else {
+      mesh->xp++;
+      if(mesh->xp > mesh->xpmax){
+        /* reallocation of xpoint table */
+        _MMG5_TAB_RECALLOC(mesh,mesh->xpoint,mesh->xpmax,0.2,MMG5_xPoint,
+                           "larger xpoint table",
+                           return(0));
+      }
+      ppt->xp  = mesh->xp;
     }
-    ppt->xp  = mesh->xp;
   }
   assert(tag < 127);
   assert(tag >= 0);
@@ -77,6 +91,8 @@ void _MMG5_delPt(MMG5_pMesh mesh,int ip) {
   if ( ppt->xp ) {
     pxp = &mesh->xpoint[ppt->xp];
     memset(pxp,0,sizeof(MMG5_xPoint));
+    pxp->n1[0]  = (double)mesh->xpnil;
+    mesh->xpnil = ppt->xp;
   }
   memset(ppt,0,sizeof(MMG5_Point));
   ppt->tag    = MG_NUL;
@@ -95,10 +111,23 @@ int _MMG5_newElt(MMG5_pMesh mesh) {
   curiel = mesh->nenil;
 
   if ( mesh->nenil > mesh->ne )  mesh->ne = mesh->nenil;
-  mesh->nenil = mesh->tetra[curiel].v[3];
+  if ( curiel < mesh->nelnk )
+    mesh->nenil = mesh->tetra[curiel].v[3];
+  else {
+    /* first use of this slot: the next one is chained on the fly */
+    mesh->nelnk = curiel+1;
+    mesh->nenil = ( curiel < mesh->nemax-1 ) ? curiel+1 : 0;
+  }
   mesh->tetra[curiel].v[3] = 0;
   mesh->tetra[curiel].mark=0;
 
+  /* local remeshing: a slot never used since the freezing of the mesh is
+   * added to the remeshed region (the other ones are already listed) */
+  if ( mesh->nereg && curiel > mesh->nereg ) {
+    mesh->nereg = curiel;
+    mesh->lreg[mesh->nlreg++] = curiel;
+  }
+
   return(curiel);
 }
 
@@ -123,6 +152,135 @@ void _MMG5_delElt(MMG5_pMesh mesh,int iel) {
   }
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return index of the new xtetra, 0 if fail.
+ *
+ * Get a new xtetra: reuse a recycled one if available, otherwise take the
+ * next one of the table (reallocated if needed).
+ *
+ */
+int _MMG5_newXTet(MMG5_pMesh mesh) {
+  int     curxt;
+
+  if ( mesh->xtnil ) {
+    curxt       = mesh->xtnil;
+    mesh->xtnil = mesh->xtetra[curxt].ref[0];
+    mesh->xtetra[curxt].ref[0] = 0;
+    return(curxt);
+  }
+
+  mesh->xt++;
+  if ( mesh->xt > mesh->xtmax ) {
+    /* realloc of xtetras table */
+    _MMG5_TAB_RECALLOC(mesh,mesh->xtetra,mesh->xtmax,0.2,MMG5_xTetra,
+                       "larger xtetra table",
+                       mesh->xt--;
+                       return(0));
+  }
+  return(mesh->xt);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ixt index of the xtetra to recycle.
+ *
+ * Put the xtetra \a ixt in the list of unused xtetras. The caller must
+ * ensure that no tetrahedron still points toward \a ixt.
+ *
+ */
+void _MMG5_delXTet(MMG5_pMesh mesh,int ixt) {
+  MMG5_pxTetra  pxt;
+
+  pxt = &mesh->xtetra[ixt];
+  memset(pxt,0,sizeof(MMG5_xTetra));
+  pxt->ref[0] = mesh->xtnil;
+  mesh->xtnil = ixt;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Pack the xtetra and xpoint tables: remove the holes left by the recycled
+ * (or lost) entities and empty the lists of unused xtetras and xpoints.
+ * Nothing is done if the tables contain less than 10% of holes, or if the mesh
+ * is frozen for a local remeshing (the tables are not swept: their holes are
+ * only recycled).
+ *
+ */
+int _MMG5_pakXEnt(MMG5_pMesh mesh) {
+  MMG5_pTetra   pt;
+  MMG5_pPoint   ppt;
+  int           *perm,k,nxt,nxp,siz;
+
+  if ( mesh->nereg )  return(1);
+
+  nxt = nxp = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( MG_EOK(pt) && pt->xt )  nxt++;
+  }
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( MG_VOK(ppt) && ppt->xp )  nxp++;
+  }
+  if ( 10*(mesh->xt-nxt) <= mesh->xt && 10*(mesh->xp-nxp) <= mesh->xp )
+    return(1);
+
+  siz = MG_MAX(mesh->xt,mesh->xp)+1;
+  _MMG5_ADD_MEM(mesh,siz*sizeof(int),"compaction table",return(0));
+  _MMG5_SAFE_CALLOC(perm,siz,int);
+
+  /* xtetras: old indices are renumbered in increasing order, so the new
+   * index is never greater than the old one and the copy may be done in
+   * place */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( MG_EOK(pt) && pt->xt )  perm[pt->xt] = 1;
+  }
+  nxt = 0;
+  for (k=1; k<=mesh->xt; k++) {
+    if ( !perm[k] )  continue;
+    perm[k] = ++nxt;
+    if ( nxt < k )
+      memcpy(&mesh->xtetra[nxt],&mesh->xtetra[k],sizeof(MMG5_xTetra));
+  }
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( MG_EOK(pt) && pt->xt )  pt->xt = perm[pt->xt];
+  }
+  if ( nxt < mesh->xt )
+    memset(&mesh->xtetra[nxt+1],0,(mesh->xt-nxt)*sizeof(MMG5_xTetra));
+  mesh->xt    = nxt;
+  mesh->xtnil = 0;
+
+  /* xpoints */
+  memset(perm,0,siz*sizeof(int));
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( MG_VOK(ppt) && ppt->xp )  perm[ppt->xp] = 1;
+  }
+  nxp = 0;
+  for (k=1; k<=mesh->xp; k++) {
+    if ( !perm[k] )  continue;
+    perm[k] = ++nxp;
+    if ( nxp < k )
+      memcpy(&mesh->xpoint[nxp],&mesh->xpoint[k],sizeof(MMG5_xPoint));
+  }
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( MG_VOK(ppt) && ppt->xp )  ppt->xp = perm[ppt->xp];
+  }
+  if ( nxp < mesh->xp )
+    memset(&mesh->xpoint[nxp+1],0,(mesh->xp-nxp)*sizeof(MMG5_xPoint));
+  mesh->xp    = nxp;
+  mesh->xpnil = 0;
+
+  _MMG5_DEL_MEM(mesh,perm,siz*sizeof(int));
+  return(1);
+}
+
 /** memory repartition for the -m option */
 void _MMG5_memOption(MMG5_pMesh mesh) {
   long long  million = 1048576L;
@@ -209,7 +367,6 @@ void _MMG5_memOption(MMG5_pMesh mesh) {
 
 /** allocate main structure */
 int _MMG5_zaldy(MMG5_pMesh mesh) {
-  int     k;
 
   _MMG5_memOption(mesh);
 
@@ -233,15 +390,11 @@ int _MMG5_zaldy(MMG5_pMesh mesh) {
     _MMG5_SAFE_CALLOC(mesh->edge,(mesh->na+1),MMG5_Edge);
   }
 
-  /* keep track of empty links */
+  /* keep track of empty links (chained on demand by newPt/newElt) */
   mesh->npnil = mesh->np + 1;
   mesh->nenil = mesh->ne + 1;
-
-  for (k=mesh->npnil; k<mesh->npmax-1; k++)
-    mesh->point[k].tmp  = k+1;
-
-  for (k=mesh->nenil; k<mesh->nemax-1; k++)
-    mesh->tetra[k].v[3] = k+1;
+  mesh->nplnk = mesh->npnil;
+  mesh->nelnk = mesh->nenil;
 
   return(1);
 }
@@ -262,5 +415,6 @@ void _MMG5_freeXTets(MMG5_pMesh mesh) {
   }
   if ( mesh->xtetra )
     _MMG5_DEL_MEM(mesh,mesh->xtetra,(mesh->xtmax+1)*sizeof(MMG5_xTetra));
-  mesh->xt = 0;
+  mesh->xt    = 0;
+  mesh->xtnil = 0;
 }
@@ -53,10 +53,7 @@ static void paktri(MMG5_pMesh mesh) {
 
   /* Recreate nil chain */
   mesh->nenil = mesh->nt + 1;
-
-  for(k=mesh->nenil; k<=mesh->ntmax-1; k++){
-    mesh->tria[k].v[2] = k+1;
-  }
+  mesh->nelnk = mesh->nenil;
 }
 
 /**
@@ -39,66 +39,18 @@
 #define sw 4
 #define sd 8
 
-int swapbin(int sbin)
-{
-  int inv;
-  char *p_in = (char *) &sbin;
-  char *p = (char *)&inv;
-
-
-  p[0] = p_in[3];
-  p[1] = p_in[2];
-  p[2] = p_in[1];
-  p[3] = p_in[0];
-
-  return(inv);
-  /*unsigned char c1, c2, c3, c4;
-
-    c1 = sbin & 255;
-    c2 = (sbin >> 8) & 255;
-    c3 = (sbin >> 16) & 255;
-    c4 = (sbin >> 24) & 255;
-
-    return ((int)c1 << 24) + ((int)c2 << 16) + ((int)c3 << 8) + c4;   */
-
-}
-float swapf(float sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  p_out[0] = p_in[3];
-  p_out[1] = p_in[2];
-  p_out[2] = p_in[1];
-  p_out[3] = p_in[0];
-
-  return(out);
-}
-double swapd(double sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  int i;
-
-  for(i=0;i<8;i++)
-  {
-    p_out[i] = p_in[7-i];
-  }
-  //printf("CONVERTION DOUBLE\n");
-  return(out);
-}
 int loadMesh(MMG5_pMesh mesh) {
   FILE        *inm;
+  _MMG5_Abuf  ab;
   MMG5_pTria  pt1,pt2;
   MMG5_pPoint ppt;
   double      *norm,*n,dd;
-  float       fc;
-  int         i,k,ia,nq,nri,nr,ip,idn,ng;
+  float       fc,fcr[3];
+  int         i,k,ia,nq,nri,nr,ip,idn,ng,v[3];
   char        *ptr,*name,data[256],chaine[128];
-  int         posnp,posnt,posne,posncor,posnq,posned,posnr;
-  int         posnpreq,npreq,ntreq,posnormal,posnc1,posntreq;
-  int         ncor,bin,iswp,nedreq,posnedreq,bdim,binch,bpos;
+  long        posnp,posnt,posne,posncor,posnq,posned,posnr;
+  long        posnpreq,posnormal,posnc1,posntreq,posnedreq;
+  int         npreq,ntreq,ncor,bin,iswp,nedreq,bdim,binch,bpos;
 
   posnp = posnt = posne = posncor = posnq = posntreq = 0;
   posned = posnr = posnpreq = posnc1 = npreq = 0;
@@ -161,84 +113,87 @@ int loadMesh(MMG5_pMesh mesh) {
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+  /* parse the file from memory */
+  fclose(inm);
+  if ( !_MMG5_openAscii(data,&ab) ) {
+    fprintf(stderr,"  ** UNABLE TO READ %s.\n",data);
+    return(0);
+  }
+
   if (!bin) {
     strcpy(chaine,"D");
-    while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
+    while(_MMG5_readWord(&ab,chaine,128)!=EOF && strncmp(chaine,"End",strlen("End")) ) {
       if(!strncmp(chaine,"MeshVersionFormatted",strlen("MeshVersionFormatted"))) {
-        fscanf(inm,"%d",&mesh->ver);
+        _MMG5_readInt(&ab,&mesh->ver);
         continue;
       } else if(!strncmp(chaine,"Dimension",strlen("Dimension"))) {
-        fscanf(inm,"%d",&mesh->dim);
+        _MMG5_readInt(&ab,&mesh->dim);
         if(mesh->dim!=3) {
           fprintf(stdout,"BAD DIMENSION : %d\n",mesh->dim);
+          _MMG5_closeAscii(&ab);
           return(0);
         }
         continue;
       } else if(!strncmp(chaine,"Vertices",strlen("Vertices"))) {
-        fscanf(inm,"%d",&mesh->npi);
-        posnp = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->npi);
+        posnp = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredVertices",strlen("RequiredVertices"))) {
-        fscanf(inm,"%d",&npreq);
-        posnpreq = ftell(inm);
+        _MMG5_readInt(&ab,&npreq);
+        posnpreq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Triangles",strlen("Triangles"))) {
-        fscanf(inm,"%d",&mesh->nti);
-        posnt = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->nti);
+        posnt = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredTriangles",strlen("RequiredTriangles"))) {
-        fscanf(inm,"%d",&ntreq);
-        posntreq = ftell(inm);
+        _MMG5_readInt(&ab,&ntreq);
+        posntreq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Quadrilaterals",strlen("Quadrilaterals"))) {
-        fscanf(inm,"%d",&nq);
-        posnq = ftell(inm);
+        _MMG5_readInt(&ab,&nq);
+        posnq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Corners",strlen("Corners"))) {
-        fscanf(inm,"%d",&ncor);
-        posncor = ftell(inm);
+        _MMG5_readInt(&ab,&ncor);
+        posncor = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Edges",strlen("Edges"))) {
-        fscanf(inm,"%d",&mesh->na);
-        posned = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->na);
+        posned = ab.pos;
         continue;
       } else if(!strncmp(chaine,"RequiredEdges",strlen("RequiredEdges"))) {
-        fscanf(inm,"%d",&nedreq);
-        posnedreq = ftell(inm);
+        _MMG5_readInt(&ab,&nedreq);
+        posnedreq = ab.pos;
         continue;
       } else if(!strncmp(chaine,"Ridges",strlen("Ridges"))) {
-        fscanf(inm,"%d",&nri);
-        posnr = ftell(inm);
+        _MMG5_readInt(&ab,&nri);
+        posnr = ab.pos;
         continue;
       } else if(!ng && !strncmp(chaine,"Normals",strlen("Normals"))) {
-        fscanf(inm,"%d",&ng);
-        posnormal = ftell(inm);
+        _MMG5_readInt(&ab,&ng);
+        posnormal = ab.pos;
         continue;
       } else if(!strncmp(chaine,"NormalsAtVertices",strlen("NormalsAtVertices"))) {
-        fscanf(inm,"%d",&mesh->nc1);
-        posnc1 = ftell(inm);
+        _MMG5_readInt(&ab,&mesh->nc1);
+        posnc1 = ab.pos;
         continue;
       }
     }
   } else { //binary file
     bdim = 0;
-    fread(&mesh->ver,sw,1,inm);
+    _MMG5_readBin(&ab,&mesh->ver,sw,0);
     iswp=0;
     if(mesh->ver==16777216)
       iswp=1;
     else if(mesh->ver!=1) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
-    fread(&mesh->ver,sw,1,inm);
-    if(iswp) mesh->ver = swapbin(mesh->ver);
-    while(fread(&binch,sw,1,inm)!=0 && binch!=54 ) {
-      if(iswp) binch=swapbin(binch);
-      if(binch==54) break;
+    _MMG5_readBin(&ab,&mesh->ver,sw,iswp);
+    while(_MMG5_readBin(&ab,&binch,sw,iswp) && binch!=54 ) {
       if(!bdim && binch==3) {  //Dimension
-        fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=swapbin(bdim);
-        fread(&bdim,sw,1,inm);
-        if(iswp) bdim=swapbin(bdim);
+        _MMG5_readBin(&ab,&bdim,sw,iswp);  //NulPos=>20
+        _MMG5_readBin(&ab,&bdim,sw,iswp);
         mesh->dim = bdim;
         if(bdim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",mesh->dim);
@@ -247,176 +202,138 @@ int loadMesh(MMG5_pMesh mesh) {
         }
         continue;
       } else if(!mesh->npi && binch==4) {  //Vertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&mesh->npi,sw,1,inm);
-        if(iswp) mesh->npi=swapbin(mesh->npi);
-        posnp = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->npi,sw,iswp);
+        posnp = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==15) {  //RequiredVertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&npreq,sw,1,inm);
-        if(iswp) npreq=swapbin(npreq);
-        posnpreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&npreq,sw,iswp);
+        posnpreq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!mesh->nti && binch==6) {//Triangles
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&mesh->nti,sw,1,inm);
-        if(iswp) mesh->nti=swapbin(mesh->nti);
-        posnt = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->nti,sw,iswp);
+        posnt = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==17) {  //RequiredTriangles
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&ntreq,sw,1,inm);
-        if(iswp) ntreq=swapbin(ntreq);
-        posntreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&ntreq,sw,iswp);
+        posntreq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==7) {//Quadrilaterals
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&nq,sw,1,inm);
-        if(iswp) nq=swapbin(nq);
-        posnq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&nq,sw,iswp);
+        posnq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!ncor && binch==13) { //Corners
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&ncor,sw,1,inm);
-        if(iswp) ncor=swapbin(ncor);
-        posncor = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&ncor,sw,iswp);
+        posncor = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!mesh->na && binch==5) { //Edges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&mesh->na,sw,1,inm);
-        if(iswp) mesh->na=swapbin(mesh->na);
-        posned = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->na,sw,iswp);
+        posned = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==16) {  //RequiredEdges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&nedreq,sw,1,inm);
-        if(iswp) nedreq=swapbin(nedreq);
-        posnedreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&nedreq,sw,iswp);
+        posnedreq = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==14) {  //Ridges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&nri,sw,1,inm);
-        if(iswp) nri=swapbin(nri);
-        posnr = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&nri,sw,iswp);
+        posnr = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(!ng && binch==60) {  //Normals
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&ng,sw,1,inm);
-        if(iswp) ng=swapbin(ng);
-        posnormal = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&ng,sw,iswp);
+        posnormal = ab.pos;
+        ab.pos = bpos;
         continue;
       } else if(binch==20) {  //NormalsAtVertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
-        fread(&mesh->nc1,sw,1,inm);
-        if(iswp) mesh->nc1=swapbin(mesh->nc1);
-        posnc1 = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&mesh->nc1,sw,iswp);
+        posnc1 = ab.pos;
+        ab.pos = bpos;
         continue;
       } else {
         //printf("on traite ? %d\n",binch);
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //NulPos
         //printf("on avance... Nulpos %d\n",bpos);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        ab.pos = bpos;
       }
     }
   }
 
   if ( !mesh->npi || !mesh->nti ) {
     fprintf(stdout,"  ** MISSING DATA\n");
+    _MMG5_closeAscii(&ab);
     return(0);
   }
   mesh->np = mesh->npi;
   mesh->nt = mesh->nti + 2*nq;
 
   /* mem alloc */
-  if ( !zaldy(mesh) )  return(0);
+  if ( !zaldy(mesh) ) {
+    _MMG5_closeAscii(&ab);
+    return(0);
+  }
 
   /* read vertices */
 
-  rewind(inm);
-  fseek(inm,posnp,SEEK_SET);
+  ab.pos = posnp;
   for (k=1; k<=mesh->np; k++) {
     ppt = &mesh->point[k];
     if (mesh->ver < 2) { /*float*/
       if (!bin) {
         for (i=0 ; i<3 ; i++) {
-          fscanf(inm,"%f",&fc);
+          _MMG5_readFloat(&ab,&fc);
           ppt->c[i] = (double) fc;
         }
-        fscanf(inm,"%d",&ppt->ref);
+        _MMG5_readInt(&ab,&ppt->ref);
       } else {
-        for (i=0 ; i<3 ; i++) {
-          fread(&fc,sw,1,inm);
-          if(iswp) fc=swapf(fc);
-          ppt->c[i] = (double) fc;
-        }
-        fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=swapbin(ppt->ref);
+        _MMG5_readBinBlock(&ab,fcr,sw,3,iswp);
+        for (i=0 ; i<3 ; i++)
+          ppt->c[i] = (double) fcr[i];
+        _MMG5_readBin(&ab,&ppt->ref,sw,iswp);
       }
     } else {
-      if (!bin)
-        fscanf(inm,"%lf %lf %lf %d",&ppt->c[0],&ppt->c[1],&ppt->c[2],&ppt->ref);
-      else {
-        for (i=0 ; i<3 ; i++) {
-          fread(&ppt->c[i],sd,1,inm);
-          if(iswp) ppt->c[i]=swapd(ppt->c[i]);
-        }
-        fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=swapbin(ppt->ref);
+      if (!bin) {
+        _MMG5_readDouble(&ab,&ppt->c[0]);
+        _MMG5_readDouble(&ab,&ppt->c[1]);
+        _MMG5_readDouble(&ab,&ppt->c[2]);
+        _MMG5_readInt(&ab,&ppt->ref);
+      } else {
+        _MMG5_readBinBlock(&ab,ppt->c,sd,3,iswp);
+        _MMG5_readBin(&ab,&ppt->ref,sw,iswp);
       }
     }
     ppt->tag = MG_NUL;
   }
 
   /* read triangles and set seed */
-  rewind(inm);
-  fseek(inm,posnt,SEEK_SET);
+  ab.pos = posnt;
   for (k=1; k<=mesh->nt; k++) {
     pt1 = &mesh->tria[k];
-    if (!bin)
-      fscanf(inm,"%d %d %d %d",&pt1->v[0],&pt1->v[1],&pt1->v[2],&pt1->ref);
-    else {
-      for (i=0 ; i<3 ; i++) {
-        fread(&pt1->v[i],sw,1,inm);
-        if(iswp) pt1->v[i]=swapbin(pt1->v[i]);
-      }
-      fread(&pt1->ref,sw,1,inm);
-      if(iswp) pt1->ref=swapbin(pt1->ref);
+    if (!bin) {
+      _MMG5_readInt(&ab,&pt1->v[0]);
+      _MMG5_readInt(&ab,&pt1->v[1]);
+      _MMG5_readInt(&ab,&pt1->v[2]);
+      _MMG5_readInt(&ab,&pt1->ref);
+    } else {
+      _MMG5_readBinBlock(&ab,pt1->v,sw,3,iswp);
+      _MMG5_readBin(&ab,&pt1->ref,sw,iswp);
     }
     for (i=0; i<3; i++) {
       ppt = &mesh->point[pt1->v[i]];
@@ -425,8 +342,7 @@ int loadMesh(MMG5_pMesh mesh) {
   }
   /* read quads */
   if ( nq > 0 ) {
-    rewind(inm);
-    fseek(inm,posnq,SEEK_SET);
+    ab.pos = posnq;
 
     for (k=1; k<=nq; k++) {
       mesh->nti++;
@@ -434,17 +350,16 @@ int loadMesh(MMG5_pMesh mesh) {
       mesh->nti++;
       pt2 = &mesh->tria[mesh->nti];
 
-      if (!bin)
-        fscanf(inm,"%d %d %d %d %d",&pt1->v[0],&pt1->v[1],&pt1->v[2],&pt2->v[2],&pt1->ref);
-      else {
-        for (i=0 ; i<3 ; i++) {
-          fread(&pt1->v[i],sw,1,inm);
-          if(iswp) pt1->v[i]=swapbin(pt1->v[i]);
-        }
-        fread(&pt2->v[2],sw,1,inm);
-        if(iswp) pt2->v[2]=swapbin(pt2->v[2]);
-        fread(&pt1->ref,sw,1,inm);
-        if(iswp) pt1->ref=swapbin(pt1->ref);
+      if (!bin) {
+        _MMG5_readInt(&ab,&pt1->v[0]);
+        _MMG5_readInt(&ab,&pt1->v[1]);
+        _MMG5_readInt(&ab,&pt1->v[2]);
+        _MMG5_readInt(&ab,&pt2->v[2]);
+        _MMG5_readInt(&ab,&pt1->ref);
+      } else {
+        _MMG5_readBinBlock(&ab,pt1->v,sw,3,iswp);
+        _MMG5_readBin(&ab,&pt2->v[2],sw,iswp);
+        _MMG5_readBin(&ab,&pt1->ref,sw,iswp);
       }
       pt2->v[0] = pt1->v[0];
       pt2->v[1] = pt1->v[2];
@@ -460,14 +375,12 @@ int loadMesh(MMG5_pMesh mesh) {
   }
 
   if(ncor) {
-    rewind(inm);
-    fseek(inm,posncor,SEEK_SET);
+    ab.pos = posncor;
     for (k=1; k<=ncor; k++) {
       if(!bin)
-        fscanf(inm,"%d",&i);
+        _MMG5_readInt(&ab,&i);
       else {
-        fread(&i,sw,1,inm);
-        if(iswp) i=swapbin(i);
+        _MMG5_readBin(&ab,&i,sw,iswp);
       }
       if(i>mesh->np) {
         fprintf(stdout,"   Warning Corner number %8d IGNORED\n",i);
@@ -480,14 +393,12 @@ int loadMesh(MMG5_pMesh mesh) {
 
   /* read required vertices */
   if(npreq) {
-    rewind(inm);
-    fseek(inm,posnpreq,SEEK_SET);
+    ab.pos = posnpreq;
     for (k=1; k<=npreq; k++) {
       if(!bin)
-        fscanf(inm,"%d",&i);
+        _MMG5_readInt(&ab,&i);
       else {
-        fread(&i,sw,1,inm);
-        if(iswp) i=swapbin(i);
+        _MMG5_readBin(&ab,&i,sw,iswp);
       }
       if(i>mesh->np) {
         fprintf(stdout,"   Warning Required Vertices number %8d IGNORED\n",i);
@@ -502,18 +413,17 @@ int loadMesh(MMG5_pMesh mesh) {
   if ( mesh->na ) {
     _MMG5_ADD_MEM(mesh,(mesh->na+1)*sizeof(MMG5_Edge),"initial edges",return(0));
     _MMG5_SAFE_CALLOC(mesh->edge,mesh->na+1,MMG5_Edge);
-    rewind(inm);
-    fseek(inm,posned,SEEK_SET);
+    ab.pos = posned;
     for (k=1; k<=mesh->na; k++) {
-      if (!bin)
-        fscanf(inm,"%d %d %d",&mesh->edge[k].a,&mesh->edge[k].b,&mesh->edge[k].ref);
-      else {
-        fread(&mesh->edge[k].a,sw,1,inm);
-        if(iswp) mesh->edge[k].a=swapbin(mesh->edge[k].a);
-        fread(&mesh->edge[k].b,sw,1,inm);
-        if(iswp) mesh->edge[k].b=swapbin(mesh->edge[k].b);
-        fread(&mesh->edge[k].ref,sw,1,inm);
-        if(iswp) mesh->edge[k].ref=swapbin(mesh->edge[k].ref);
+      if (!bin) {
+        _MMG5_readInt(&ab,&mesh->edge[k].a);
+        _MMG5_readInt(&ab,&mesh->edge[k].b);
+        _MMG5_readInt(&ab,&mesh->edge[k].ref);
+      } else {
+        _MMG5_readBinBlock(&ab,v,sw,3,iswp);
+        mesh->edge[k].a   = v[0];
+        mesh->edge[k].b   = v[1];
+        mesh->edge[k].ref = v[2];
       }
       mesh->edge[k].tag |= MG_REF;
       mesh->point[mesh->edge[k].a].tag |= MG_REF;
@@ -521,27 +431,23 @@ int loadMesh(MMG5_pMesh mesh) {
     }
 
     if ( nri ) {
-      rewind(inm);
-      fseek(inm,posnr,SEEK_SET);
+      ab.pos = posnr;
       for (k=1; k<=nri; k++) {
         if(!bin)
-          fscanf(inm,"%d",&ia);
+          _MMG5_readInt(&ab,&ia);
         else {
-          fread(&ia,sw,1,inm);
-          if(iswp) ia=swapbin(ia);
+          _MMG5_readBin(&ab,&ia,sw,iswp);
         }
         if ( ia > 0 && ia <= mesh->na )  mesh->edge[ia].tag |= MG_GEO;
       }
     }
     if ( nedreq ) {
-      rewind(inm);
-      fseek(inm,posnedreq,SEEK_SET);
+      ab.pos = posnedreq;
       for (k=1; k<=nedreq; k++) {
         if(!bin)
-          fscanf(inm,"%d",&ia);
+          _MMG5_readInt(&ab,&ia);
         else {
-          fread(&ia,sw,1,inm);
-          if(iswp) ia=swapbin(ia);
+          _MMG5_readBin(&ab,&ia,sw,iswp);
         }
         if ( ia > 0 && ia <= mesh->na )   mesh->edge[ia].tag |= MG_REQ;
       }
@@ -554,32 +460,28 @@ int loadMesh(MMG5_pMesh mesh) {
   if ( ng > 0 ) {
     _MMG5_SAFE_CALLOC(norm,3*ng+1,double);
 
-    rewind(inm);
-    fseek(inm,posnormal,SEEK_SET);
+    ab.pos = posnormal;
     for (k=1; k<=ng; k++) {
       n = &norm[3*(k-1)+1];
       if ( mesh->ver == 1 ) {
         if (!bin) {
           for (i=0 ; i<3 ; i++) {
-            fscanf(inm,"%f",&fc);
+            _MMG5_readFloat(&ab,&fc);
             n[i] = (double) fc;
           }
         } else {
-          for (i=0 ; i<3 ; i++) {
-            fread(&fc,sw,1,inm);
-            if(iswp) fc=swapf(fc);
-            n[i] = (double) fc;
-          }
+          _MMG5_readBinBlock(&ab,fcr,sw,3,iswp);
+          for (i=0 ; i<3 ; i++)
+            n[i] = (double) fcr[i];
         }
       }
       else {
-        if (!bin)
-          fscanf(inm,"%lf %lf %lf",&n[0],&n[1],&n[2]);
-        else {
-          for (i=0 ; i<3 ; i++) {
-            fread(&n[i],sd,1,inm);
-            if(iswp) n[i]=swapd(n[i]);
-          }
+        if (!bin) {
+          _MMG5_readDouble(&ab,&n[0]);
+          _MMG5_readDouble(&ab,&n[1]);
+          _MMG5_readDouble(&ab,&n[2]);
+        } else {
+          _MMG5_readBinBlock(&ab,n,sd,3,iswp);
         }
       }
       dd = n[0]*n[0] + n[1]*n[1] + n[2]*n[2];
@@ -591,16 +493,15 @@ int loadMesh(MMG5_pMesh mesh) {
       }
     }
 
-    rewind(inm);
-    fseek(inm,posnc1,SEEK_SET);
+    ab.pos = posnc1;
     for (k=1; k<=mesh->nc1; k++) {
-      if (!bin)
-        fscanf(inm,"%d %d",&ip,&idn);
-      else {
-        fread(&ip,sw,1,inm);
-        if(iswp) ip=swapbin(ip);
-        fread(&idn,sw,1,inm);
-        if(iswp) idn=swapbin(idn);
+      if (!bin) {
+        _MMG5_readInt(&ab,&ip);
+        _MMG5_readInt(&ab,&idn);
+      } else {
+        _MMG5_readBinBlock(&ab,v,sw,2,iswp);
+        ip  = v[0];
+        idn = v[1];
       }
       if ( idn > 0 && ip < mesh->np+1 )
         memcpy(&mesh->point[ip].n,&norm[3*(idn-1)+1],3*sizeof(double));
@@ -614,12 +515,13 @@ int loadMesh(MMG5_pMesh mesh) {
       fprintf(stdout,"     NUMBER OF EDGES      %8d  RIDGES %6d\n",mesh->na,nri);
     fprintf(stdout,"     NUMBER OF TRIANGLES  %8d / %8d\n",mesh->nti,mesh->ntmax);
   }
-  fclose(inm);
+  _MMG5_closeAscii(&ab);
   return(1);
 }
 
 int MMG5_saveMesh(MMG5_pMesh mesh) {
   FILE         *inm;
+  _MMG5_Wbuf   wb;
   MMG5_pPoint  ppt;
   MMG5_pTria   pt;
   MMG5_pEdge   edge;
@@ -657,24 +559,25 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
     }
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
+  _MMG5_openWbuf(&wb,inm);
 
   /*entete fichier*/
   if(!bin) {
     strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
     strcpy(&chaine[0],"\n\nDimension 3\n");
-    fprintf(inm,"%s ",chaine);
+    _MMG5_printWbuf(&wb,"%s ",chaine);
   } else {
     binch = 1; //MeshVersionFormatted
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 2; //version
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 3; //Dimension
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos = 20; //Pos
-    fwrite(&bpos,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
     binch = 3;
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
 
   }
   /* vertices */
@@ -693,26 +596,26 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
 
   if(!bin) {
     strcpy(&chaine[0],"\n\nVertices\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",np);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",np);
   } else {
     binch = 4; //Vertices
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 12+(1+3*mesh->ver)*4*np; //NullPos
-    fwrite(&bpos,sw,1,inm);
-    fwrite(&np,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&np,sw);
   }
   for (k=1; k<=mesh->np; k++) {
     ppt = &mesh->point[k];
     if ( MG_VOK(ppt) ) {
       if(!bin) {
-        fprintf(inm,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
+        _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ppt->c[2],abs(ppt->ref));
       } else {
-        fwrite((unsigned char*)&ppt->c[0],sd,1,inm);
-        fwrite((unsigned char*)&ppt->c[1],sd,1,inm);
-        fwrite((unsigned char*)&ppt->c[2],sd,1,inm);
+        _MMG5_writeBin(&wb,&ppt->c[0],sd);
+        _MMG5_writeBin(&wb,&ppt->c[1],sd);
+        _MMG5_writeBin(&wb,&ppt->c[2],sd);
         ppt->ref = abs(ppt->ref);
-        fwrite((unsigned char*)&ppt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&ppt->ref,sw);
       }
       if ( !(ppt->tag & MG_GEO) )  nn++;
     }
@@ -736,28 +639,28 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
   /* write triangles */
   if(!bin) {
     strcpy(&chaine[0],"\n\nTriangles\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d \n",nt);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d \n",nt);
   } else {
     binch = 6; //Triangles
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 12+16*nt; //Pos
-    fwrite(&bpos,sw,1,inm);
-    fwrite(&nt,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&nt,sw);
   }
   na = 0;
   for (k=1; k<=mesh->nt; k++) {
     pt = &mesh->tria[k];
     if ( MG_EOK(pt) ) {
       if(!bin) {
-        fprintf(inm,"%d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
+        _MMG5_printWbuf(&wb,"%d %d %d %d\n",mesh->point[pt->v[0]].tmp,mesh->point[pt->v[1]].tmp
                 ,mesh->point[pt->v[2]].tmp,abs(pt->ref));
       } else {
-        fwrite(&mesh->point[pt->v[0]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[1]].tmp,sw,1,inm);
-        fwrite(&mesh->point[pt->v[2]].tmp,sw,1,inm);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[0]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[1]].tmp,sw);
+        _MMG5_writeBin(&wb,&mesh->point[pt->v[2]].tmp,sw);
 	pt->ref = abs(pt->ref);
-        fwrite(&pt->ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&pt->ref,sw);
       }
       for (i=0; i<3; i++) {
         if ( !MG_EDG(pt->tag[i]) )  continue;
@@ -782,22 +685,22 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
   if ( nc ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nCorners\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nc);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nc);
     } else {
       binch = 13; //
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+4*nc; //NullPos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nc,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nc,sw);
     }
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && ppt->tag & MG_CRN ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ppt->tmp);
+          _MMG5_printWbuf(&wb,"%d \n",ppt->tmp);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
         }
       }
     }
@@ -805,22 +708,22 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
   if ( nre ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nRequiredVertices\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nre);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nre);
     } else {
       binch = 15; //
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+4*nre; //NullPos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nre,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nre,sw);
     }
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && ppt->tag & MG_REQ ) {
         if(!bin) {
-          fprintf(inm,"%d \n",ppt->tmp);
+          _MMG5_printWbuf(&wb,"%d \n",ppt->tmp);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
         }
       }
     }
@@ -830,23 +733,23 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
   if ( na ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nEdges\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",na);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",na);
     } else {
       binch = 5; //Edges
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 3*4*na;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&na,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&na,sw);
     }
     nre = 0;
     for (k=1; k<=na; k++) {
       if(!bin) {
-        fprintf(inm,"%d %d %d \n",edge[k].a,edge[k].b,edge[k].ref);
+        _MMG5_printWbuf(&wb,"%d %d %d \n",edge[k].a,edge[k].b,edge[k].ref);
       } else {
-        fwrite(&edge[k].a,sw,1,inm);
-        fwrite(&edge[k].b,sw,1,inm);
-        fwrite(&edge[k].ref,sw,1,inm);
+        _MMG5_writeBin(&wb,&edge[k].a,sw);
+        _MMG5_writeBin(&wb,&edge[k].b,sw);
+        _MMG5_writeBin(&wb,&edge[k].ref,sw);
       }
       if ( edge[k].tag & MG_REQ )  nre++;
     }
@@ -854,21 +757,21 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
     if ( nr ) {
       if(!bin) {
         strcpy(&chaine[0],"\n\nRidges\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",nr);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d\n",nr);
       } else {
         binch = 14; //Ridges
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12 + 4*nr;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&nr,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&nr,sw);
       }
       for (k=1; k<=na; k++) {
         if ( edge[k].tag & MG_GEO ) {
           if(!bin) {
-            fprintf(inm,"%d \n",k);
+            _MMG5_printWbuf(&wb,"%d \n",k);
           } else {
-            fwrite(&k,sw,1,inm);
+            _MMG5_writeBin(&wb,&k,sw);
           }
         }
       }
@@ -876,21 +779,21 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
     if ( nre ) {
       if(!bin) {
         strcpy(&chaine[0],"\n\nRequiredEdges\n");
-        fprintf(inm,"%s",chaine);
-        fprintf(inm,"%d\n",nre);
+        _MMG5_printWbuf(&wb,"%s",chaine);
+        _MMG5_printWbuf(&wb,"%d\n",nre);
       } else {
         binch = 16; //RequiredEdges
-        fwrite(&binch,sw,1,inm);
+        _MMG5_writeBin(&wb,&binch,sw);
         bpos += 12 + 4*nre;//Pos
-        fwrite(&bpos,sw,1,inm);
-        fwrite(&nre,sw,1,inm);
+        _MMG5_writeBin(&wb,&bpos,sw);
+        _MMG5_writeBin(&wb,&nre,sw);
       }
       for (k=1; k<=na; k++)
         if ( edge[k].tag & MG_REQ )  {
           if(!bin) {
-            fprintf(inm,"%d \n",k);
+            _MMG5_printWbuf(&wb,"%d \n",k);
           } else {
-            fwrite(&k,sw,1,inm);
+            _MMG5_writeBin(&wb,&k,sw);
           }
         }
     }
@@ -901,14 +804,14 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
   if ( nn ) {
     if(!bin) {
       strcpy(&chaine[0],"\n\nNormals\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nn);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nn);
     } else {
       binch = 60; //normals
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+(3*mesh->ver)*4*nn; //Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nn,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nn,sw);
     }
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
@@ -917,45 +820,45 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
         if ( ppt->tag & MG_REF ) {
           go = &mesh->xpoint[ppt->ig];
           if(!bin) {
-            fprintf(inm,"%.15lg %.15lg %.15lg \n",go->n1[0],go->n1[1],go->n1[2]);
+            _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg \n",go->n1[0],go->n1[1],go->n1[2]);
           } else {
-            fwrite((unsigned char*)&go->n1[0],sd,1,inm);
-            fwrite((unsigned char*)&go->n1[1],sd,1,inm);
-            fwrite((unsigned char*)&go->n1[2],sd,1,inm);
+            _MMG5_writeBin(&wb,&go->n1[0],sd);
+            _MMG5_writeBin(&wb,&go->n1[1],sd);
+            _MMG5_writeBin(&wb,&go->n1[2],sd);
           }
         }
         else {
           if(!bin) {
-            fprintf(inm,"%.15lg %.15lg %.15lg \n",ppt->n[0],ppt->n[1],ppt->n[2]);
+            _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg \n",ppt->n[0],ppt->n[1],ppt->n[2]);
           } else {
-            fwrite((unsigned char*)&ppt->n[0],sd,1,inm);
-            fwrite((unsigned char*)&ppt->n[1],sd,1,inm);
-            fwrite((unsigned char*)&ppt->n[2],sd,1,inm);
+            _MMG5_writeBin(&wb,&ppt->n[0],sd);
+            _MMG5_writeBin(&wb,&ppt->n[1],sd);
+            _MMG5_writeBin(&wb,&ppt->n[2],sd);
           }
         }
       }
     }
     if(!bin) {
       strcpy(&chaine[0],"\n\nNormalAtVertices\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",nn);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",nn);
     } else {
       binch = 20; //normalatvertices
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 2*4*nn;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&nn,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&nn,sw);
     }
     nn = 0;
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && !(ppt->tag & MG_GEO) ) {
         if(!bin) {
-          fprintf(inm,"%d %d\n",ppt->tmp,++nn);
+          _MMG5_printWbuf(&wb,"%d %d\n",ppt->tmp,++nn);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
           ++nn;
-          fwrite(&nn,sw,1,inm);
+          _MMG5_writeBin(&wb,&nn,sw);
         }
       }
     }
@@ -985,48 +888,48 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
     /* Write tangents */
     if(!bin) {
       strcpy(&chaine[0],"\n\nTangents\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",ng);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",ng);
     } else {
       binch = 59; //tangent
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12+(3*mesh->ver)*4*ng; //Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&ng,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&ng,sw);
     }
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && MG_EDG(ppt->tag) ) {
         if(!bin) {
-          fprintf(inm,"%.15lg %.15lg %.15lg \n",ppt->n[0],ppt->n[1],ppt->n[2]);
+          _MMG5_printWbuf(&wb,"%.15lg %.15lg %.15lg \n",ppt->n[0],ppt->n[1],ppt->n[2]);
         } else {
-          fwrite((unsigned char*)&ppt->n[0],sd,1,inm);
-          fwrite((unsigned char*)&ppt->n[1],sd,1,inm);
-          fwrite((unsigned char*)&ppt->n[2],sd,1,inm);
+          _MMG5_writeBin(&wb,&ppt->n[0],sd);
+          _MMG5_writeBin(&wb,&ppt->n[1],sd);
+          _MMG5_writeBin(&wb,&ppt->n[2],sd);
         }
       }
     }
     if(!bin) {
       strcpy(&chaine[0],"\n\nTangentAtVertices\n");
-      fprintf(inm,"%s",chaine);
-      fprintf(inm,"%d\n",ng);
+      _MMG5_printWbuf(&wb,"%s",chaine);
+      _MMG5_printWbuf(&wb,"%d\n",ng);
     } else {
       binch = 61; //tangentatvertices
-      fwrite(&binch,sw,1,inm);
+      _MMG5_writeBin(&wb,&binch,sw);
       bpos += 12 + 2*4*ng;//Pos
-      fwrite(&bpos,sw,1,inm);
-      fwrite(&ng,sw,1,inm);
+      _MMG5_writeBin(&wb,&bpos,sw);
+      _MMG5_writeBin(&wb,&ng,sw);
     }
     ng = 0;
     for (k=1; k<=mesh->np; k++) {
       ppt = &mesh->point[k];
       if ( MG_VOK(ppt) && MG_EDG(ppt->tag) ) {
         if(!bin) {
-          fprintf(inm,"%d %d\n",ppt->tmp,++ng);
+          _MMG5_printWbuf(&wb,"%d %d\n",ppt->tmp,++ng);
         } else {
-          fwrite(&ppt->tmp,sw,1,inm);
+          _MMG5_writeBin(&wb,&ppt->tmp,sw);
           ++ng;
-          fwrite(&(ng),sw,1,inm);
+          _MMG5_writeBin(&wb,&(ng),sw);
         }
       }
     }
@@ -1043,11 +946,12 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
   /*fin fichier*/
   if(!bin) {
     strcpy(&chaine[0],"\n\nEnd\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
   } else {
     binch = 54; //End
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
+  _MMG5_closeWbuf(&wb);
   fclose(inm);
   return(1);
 }
@@ -1055,14 +959,15 @@ int MMG5_saveMesh(MMG5_pMesh mesh) {
 /* load metric field */
 int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
   FILE       *inm;
+  _MMG5_Abuf  ab;
   float       fbuf[6],tmpf;
   double      dbuf[6],tmpd;
   int         binch,bdim,iswp;
   int         k,i,type,bin,bpos;
   long        posnp;
   char        *ptr,data[128],chaine[128];
-  int         compute_hmin, compute_hmax;
-  double      lambda[3],eigenv[3][3];
+  int         compute_hmin, compute_hmax,nb,ier,ret;
+  double      lambda[3*_MMG5_EIGBATCH],eigenv[9*_MMG5_EIGBATCH];
 
   if ( !met->namein )  return(0);
   posnp = 0;
@@ -1095,49 +1000,53 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+  /* parse the file from memory */
+  fclose(inm);
+  if ( !_MMG5_openAscii(data,&ab) ) {
+    fprintf(stderr,"  ** UNABLE TO READ %s.\n",data);
+    return(-1);
+  }
+
   /* read solution or metric */
   if(!bin) {
     strcpy(chaine,"DDD");
-    while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
+    while(_MMG5_readWord(&ab,chaine,128)!=EOF && strncmp(chaine,"End",strlen("End")) ) {
       if(!strncmp(chaine,"MeshVersionFormatted",strlen("MeshVersionFormatted"))) {
-        fscanf(inm,"%d",&met->ver);
+        _MMG5_readInt(&ab,&met->ver);
         continue;
       } else if(!strncmp(chaine,"Dimension",strlen("Dimension"))) {
-        fscanf(inm,"%d",&met->dim);
+        _MMG5_readInt(&ab,&met->dim);
         if(met->dim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",met->dim);
-          return(1);
+          ret = 1;
+          goto end;
         }
         continue;
       } else if(!strncmp(chaine,"SolAtVertices",strlen("SolAtVertices"))) {
-        fscanf(inm,"%d",&met->np);
-        fscanf(inm,"%d",&type);
+        _MMG5_readInt(&ab,&met->np);
+        _MMG5_readInt(&ab,&type);
         if(type!=1) {
           fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",type);
-          return(1);
+          ret = 1;
+          goto end;
         }
-        fscanf(inm,"%d",&met->size);
-        posnp = ftell(inm);
+        _MMG5_readInt(&ab,&met->size);
+        posnp = ab.pos;
         break;
       }
     }
   } else {
-    fread(&binch,sw,1,inm);
+    _MMG5_readBin(&ab,&binch,sw,0);
     iswp=0;
     if(binch==16777216) iswp=1;
     else if(binch!=1) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
-    fread(&met->ver,sw,1,inm);
-    if(iswp) met->ver = swapbin(met->ver);
-    while(fread(&binch,sw,1,inm)!=EOF && binch!=54 ) {
-      if(iswp) binch=swapbin(binch);
-      if(binch==54) break;
+    _MMG5_readBin(&ab,&met->ver,sw,iswp);
+    while(_MMG5_readBin(&ab,&binch,sw,iswp) && binch!=54 ) {
       if(binch==3) {  //Dimension
-        fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=swapbin(bdim);
-        fread(&met->dim,sw,1,inm);
-        if(iswp) met->dim=swapbin(met->dim);
+        _MMG5_readBin(&ab,&bdim,sw,iswp);  //NulPos=>20
+        _MMG5_readBin(&ab,&met->dim,sw,iswp);
         if(met->dim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",met->dim);
           exit(0);
@@ -1145,25 +1054,20 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
         }
         continue;
       } else if(binch==62) {  //SolAtVertices
-        fread(&binch,sw,1,inm); //NulPos
-        if(iswp) binch=swapbin(binch);
-        fread(&met->np,sw,1,inm);
-        if(iswp) met->np=swapbin(met->np);
-        fread(&type,sw,1,inm); //nb sol
-        if(iswp) type=swapbin(type);
+        _MMG5_readBin(&ab,&binch,sw,iswp); //NulPos
+        _MMG5_readBin(&ab,&met->np,sw,iswp);
+        _MMG5_readBin(&ab,&type,sw,iswp); //nb sol
         if(type!=1) {
           fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",type);
-          return(1);
+          ret = 1;
+          goto end;
         }
-        fread(&met->size,sw,1,inm); //typsol
-        if(iswp) met->size=swapbin(met->size);
-        posnp = ftell(inm);
+        _MMG5_readBin(&ab,&met->size,sw,iswp); //typsol
+        posnp = ab.pos;
         break;
       } else {
-        fread(&bpos,sw,1,inm); //Pos
-        if(iswp) bpos=swapbin(bpos);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_readBin(&ab,&bpos,sw,iswp); //Pos
+        ab.pos = bpos;
       }
     }
 
@@ -1171,12 +1075,14 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
 
   if ( !met->np ) {
     fprintf(stdout,"  ** MISSING DATA.\n");
-    return(1);
+    ret = 1;
+    goto end;
   }
   if ( (type != 1) || (met->size != 1 && met->size != 3) ) {
     fprintf(stdout,"  ** DATA IGNORED %d  %d\n",type,met->size);
     met->np = met->npmax = 0;
-    return(-1);
+    ret = -1;
+    goto end;
   }
 
   if(met->size == 3) met->size = 6;
@@ -1186,11 +1092,10 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
     _MMG5_DEL_MEM(mesh,met->m,(met->size*met->npmax+1)*sizeof(double));
 
   _MMG5_ADD_MEM(mesh,(met->size*met->npmax+1)*sizeof(double),
-                "initial solution",return(0));
+                "initial solution",ret = 0;goto end);
   _MMG5_SAFE_CALLOC(met->m,met->size*met->npmax+1,double);
 
-  rewind(inm);
-  fseek(inm,posnp,SEEK_SET);
+  ab.pos = posnp;
 
   /* If they are not provided by the user, enforce default values for hmin and
    * hmax:
@@ -1212,22 +1117,19 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
     if ( met->ver == 1 ) {
       for (k=1; k<=met->np; k++) {
         if(!bin){
-          fscanf(inm,"%f",&fbuf[0]);
+          _MMG5_readFloat(&ab,&fbuf[0]);
         } else {
-          fread(&fbuf[0],sw,1,inm);
-          if(iswp) fbuf[0]=swapf(fbuf[0]);
+          _MMG5_readBin(&ab,&fbuf[0],sw,iswp);
         }
         met->m[k] = fbuf[0];
       }
     }
+    else if ( bin ) {
+      _MMG5_readBinBlock(&ab,&met->m[1],sd,met->np,iswp);
+    }
     else {
       for (k=1; k<=met->np; k++) {
-        if(!bin){
-          fscanf(inm,"%lf",&dbuf[0]);
-        } else {
-          fread(&dbuf[0],sd,1,inm);
-          if(iswp) dbuf[0]=swapd(dbuf[0]);
-        }
+        _MMG5_readDouble(&ab,&dbuf[0]);
         met->m[k] = dbuf[0];
       }
     }
@@ -1250,12 +1152,9 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
       for (k=1; k<=met->np; k++) {
         if(!bin){
           for(i=0 ; i<met->size ; i++)
-            fscanf(inm,"%f",&fbuf[i]);
+            _MMG5_readFloat(&ab,&fbuf[i]);
         } else {
-          for(i=0 ; i<met->size ; i++) {
-            fread(&fbuf[i],sw,1,inm);
-            if(iswp) fbuf[i]=swapf(fbuf[i]);
-          }
+          _MMG5_readBinBlock(&ab,fbuf,sw,met->size,iswp);
         }
         tmpf    = fbuf[2];
         fbuf[2] = fbuf[3];
@@ -1267,36 +1166,33 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
       for (k=1; k<=met->np; k++) {
         if(!bin){
           for(i=0 ; i<met->size ; i++)
-            fscanf(inm,"%lf",&dbuf[i]);
+            _MMG5_readDouble(&ab,&dbuf[i]);
         } else {
-          for(i=0 ; i<met->size ; i++) {
-            fread(&dbuf[i],sw,1,inm);
-            if(iswp) dbuf[i]=swapf(dbuf[i]);
-          }
-          tmpd    = dbuf[2];
-          dbuf[2] = dbuf[3];
-          dbuf[3] = tmpd;
-          for (i=0; i<met->size; i++)  met->m[6*k+1+i] = dbuf[i];
+          _MMG5_readBinBlock(&ab,dbuf,sd,met->size,iswp);
         }
+        tmpd    = dbuf[2];
+        dbuf[2] = dbuf[3];
+        dbuf[3] = tmpd;
+        for (i=0; i<met->size; i++)  met->m[6*k+1+i] = dbuf[i];
       }
     }
 
-    for (k=1; k<=met->np; k++) {
-      if ( ! _MMG5_eigenv(1,&met->m[6*k+1],lambda,eigenv ) ) {
+    /* the metrics are diagonalized by blocks */
+    for (k=1; k<=met->np; k+=_MMG5_EIGBATCH) {
+      nb  = MG_MIN(_MMG5_EIGBATCH,met->np-k+1);
+      ier = _MMG5_eigensym3_batch(nb,&met->m[6*k+1],lambda,eigenv);
+      if ( ier < nb ) {
         printf("Error: metric diagonalisation fail,"
                " unable to compute the sizes associated to the vertex %d.\n",
-               k);
-        return(0);
+               k+ier);
+        ret = 0;
+        goto end;
       }
-      if ( compute_hmin ) {
-        mesh->info.hmin = MG_MIN(mesh->info.hmin,1./sqrt(lambda[0]));
-        mesh->info.hmin = MG_MIN(mesh->info.hmin,1./sqrt(lambda[1]));
-        mesh->info.hmin = MG_MIN(mesh->info.hmin,1./sqrt(lambda[2]));
-      }
-      if ( compute_hmax ) {
-        mesh->info.hmax = MG_MAX(mesh->info.hmax,1./sqrt(lambda[0]));
-        mesh->info.hmax = MG_MAX(mesh->info.hmax,1./sqrt(lambda[1]));
-        mesh->info.hmax = MG_MAX(mesh->info.hmax,1./sqrt(lambda[2]));
+      for (i=0; i<3*nb; i++) {
+        if ( compute_hmin )
+          mesh->info.hmin = MG_MIN(mesh->info.hmin,1./sqrt(lambda[i]));
+        if ( compute_hmax )
+          mesh->info.hmax = MG_MAX(mesh->info.hmax,1./sqrt(lambda[i]));
       }
     }
   }
@@ -1318,13 +1214,18 @@ int MMG5_loadMet(MMG5_pMesh mesh,MMG5_pSol met) {
     }
   }
 
-  fclose(inm);
-  return(1);
+  ret = 1;
+
+end:
+  /* every exit releases the file buffer */
+  _MMG5_closeAscii(&ab);
+  return(ret);
 }
 
 /* write iso or aniso metric */
 int saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
   FILE*        inm;
+  _MMG5_Wbuf   wb;
   MMG5_pPoint  ppt;
   double       dbuf[6],tmp;
   char        *ptr,data[128],chaine[128];
@@ -1342,24 +1243,25 @@ int saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
+  _MMG5_openWbuf(&wb,inm);
 
   /*entete fichier*/
   if(!bin) {
     strcpy(&chaine[0],"MeshVersionFormatted 2\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
     strcpy(&chaine[0],"\n\nDimension 3\n");
-    fprintf(inm,"%s ",chaine);
+    _MMG5_printWbuf(&wb,"%s ",chaine);
   } else {
     binch = 1; //MeshVersionFormatted
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 2; //version
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = 3; //Dimension
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos = 20; //Pos
-    fwrite(&bpos,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
     binch = 3;
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
 
   }
 
@@ -1378,19 +1280,19 @@ int saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
 
   if(!bin) {
     strcpy(&chaine[0],"\n\nSolAtVertices\n");
-    fprintf(inm,"%s",chaine);
-    fprintf(inm,"%d\n",np);
-    fprintf(inm,"%d %d\n",1,typ);
+    _MMG5_printWbuf(&wb,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%d\n",np);
+    _MMG5_printWbuf(&wb,"%d %d\n",1,typ);
   } else {
     binch = 62; //Vertices
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     bpos += 20+(met->size*met->ver)*4*np; //Pos
-    fwrite(&bpos,sw,1,inm);
-    fwrite(&np,sw,1,inm);
+    _MMG5_writeBin(&wb,&bpos,sw);
+    _MMG5_writeBin(&wb,&np,sw);
     binch = 1; //nb sol
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
     binch = typ; //typ sol
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
 
   /* write isotropic metric */
@@ -1400,9 +1302,9 @@ int saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
       if ( MG_VOK(ppt) ) {
         dbuf[0] = met->m[k];
         if(!bin) {
-          fprintf(inm,"%.15lg \n",dbuf[0]);
+          _MMG5_printWbuf(&wb,"%.15lg \n",dbuf[0]);
         } else {
-          fwrite((unsigned char*)&dbuf[0],sd,1,inm);
+          _MMG5_writeBin(&wb,&dbuf[0],sd);
         }
       }
     }
@@ -1418,11 +1320,11 @@ int saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
         dbuf[3] = tmp;
         if(!bin) {
           for(i=0; i<met->size; i++)
-            fprintf(inm,"%.15lg  ",dbuf[i]);
-          fprintf(inm,"\n");
+            _MMG5_printWbuf(&wb,"%.15lg  ",dbuf[i]);
+          _MMG5_printWbuf(&wb,"\n");
         } else {
           for(i=0; i<met->size; i++)
-            fwrite((unsigned char*)&dbuf[i],sd,1,inm);
+            _MMG5_writeBin(&wb,&dbuf[i],sd);
         }
       }
     }
@@ -1430,11 +1332,12 @@ int saveMet(MMG5_pMesh mesh,MMG5_pSol met) {
   /*fin fichier*/
   if(!bin) {
     strcpy(&chaine[0],"\n\nEnd\n");
-    fprintf(inm,"%s",chaine);
+    _MMG5_printWbuf(&wb,"%s",chaine);
   } else {
     binch = 54; //End
-    fwrite(&binch,sw,1,inm);
+    _MMG5_writeBin(&wb,&binch,sw);
   }
+  _MMG5_closeWbuf(&wb);
   fclose(inm);
   return(1);
 }
@@ -44,8 +44,9 @@
 #define BADKAL      2.e-2
 #define NULKAL      1.e-4
 
-#define _MMG5_NPMAX     500000
-#define _MMG5_NTMAX    1000000
+/* minimal initial sizes of the tables (reallocated on demand) */
+#define _MMG5_NPMAX      10000
+#define _MMG5_NTMAX      20000
 #define _MMG5_XPMAX     500000
 
 
@@ -58,15 +59,14 @@
     of tria jel */
 #define _MMG5_TRIA_REALLOC( mesh,jel,wantedGap,law ) do                 \
   {                                                                     \
-    int klink,oldSiz;                                                   \
+    int oldSiz;                                                         \
                                                                         \
     oldSiz = mesh->ntmax;                                               \
     _MMG5_TAB_RECALLOC(mesh,mesh->tria,mesh->ntmax,wantedGap,MMG5_Tria, \
                        "larger tria table",law);                        \
                                                                         \
     mesh->nenil = mesh->nt+1;                                           \
-    for (klink=mesh->nenil; klink<mesh->ntmax-1; klink++)               \
-      mesh->tria[klink].v[2]  = klink+1;                                \
+    mesh->nelnk = mesh->nenil;                                          \
                                                                         \
     if ( mesh->adja ) {                                                 \
       /* adja table */                                                  \
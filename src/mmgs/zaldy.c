@@ -48,7 +48,13 @@ int _MMG5_newPt(MMG5_pMesh mesh,double c[3],double n[3]) {
   memcpy(ppt->c,c,3*sizeof(double));
   memcpy(ppt->n,n,3*sizeof(double));
   ppt->tag   &= ~MG_NUL;
-  mesh->npnil = ppt->tmp;
+  if ( curpt < mesh->nplnk )
+    mesh->npnil = ppt->tmp;
+  else {
+    /* first use of this slot: the next one is chained on the fly */
+    mesh->nplnk = curpt+1;
+    mesh->npnil = ( curpt < mesh->npmax-1 ) ? curpt+1 : 0;
+  }
   ppt->tmp    = 0;
 
   return(curpt);
@@ -74,7 +80,13 @@ int _MMG5_newElt(MMG5_pMesh mesh) {
   curiel = mesh->nenil;
 
   if ( mesh->nenil > mesh->nt )  mesh->nt = mesh->nenil;
-  mesh->nenil = mesh->tria[curiel].v[2];
+  if ( curiel < mesh->nelnk )
+    mesh->nenil = mesh->tria[curiel].v[2];
+  else {
+    /* first use of this slot: the next one is chained on the fly */
+    mesh->nelnk = curiel+1;
+    mesh->nenil = ( curiel < mesh->ntmax-1 ) ? curiel+1 : 0;
+  }
   mesh->tria[curiel].v[2] = 0;
 
   return(curiel);
@@ -171,7 +183,6 @@ void _MMG5_memOption(MMG5_pMesh mesh) {
 }
 
 int zaldy(MMG5_pMesh mesh) {
-  int     k;
 
   _MMG5_memOption(mesh);
 
@@ -184,15 +195,11 @@ int zaldy(MMG5_pMesh mesh) {
                 exit(EXIT_FAILURE));
   _MMG5_SAFE_CALLOC(mesh->tria,mesh->ntmax+1,MMG5_Tria);
 
-  /* store empty links */
+  /* store empty links (chained on demand by newPt/newElt) */
   mesh->npnil = mesh->np + 1;
   mesh->nenil = mesh->nt + 1;
-
-  for (k=mesh->npnil; k<mesh->npmax-1; k++)
-    mesh->point[k].tmp  = k+1;
-
-  for (k=mesh->nenil; k<mesh->ntmax-1; k++)
-    mesh->tria[k].v[2] = k+1;
+  mesh->nplnk = mesh->npnil;
+  mesh->nelnk = mesh->nenil;
 
   return(1);
 }